@@ -0,0 +1,49 @@
+#pragma once
+#include "TorsionAngle.h"
+
+namespace xmol {
+
+/** Batched setter of torsion angles of single frame
+ *
+ * Atoms and affected atoms of each angle are resolved once and stored as index ranges. New values
+ * are applied in single sweep over atoms: transformation of each atom is composition of rotations of all
+ * angles which affect it, prefix compositions are shared between consecutive atoms.
+ *
+ * Angles must be ordered from chain start to end: atoms of an angle must not be affected by
+ * following angles and must be moved rigidly by preceding angles (as for backbone and side chain
+ * angles of polymer chains listed as omega, phi, psi, chi1, ... residue by residue).
+ * Result matches consecutive @ref TorsionAngle::set() calls in same order.
+ */
+class ConformationSetter {
+public:
+  explicit ConformationSetter(const std::vector<TorsionAngle>& angles);
+
+  /// Number of angles
+  [[nodiscard]] size_t size() const { return m_atoms.size(); }
+
+  /// Current angle values
+  [[nodiscard]] std::vector<geom::AngleValue> values() const;
+
+  /// Set all angles, @p values must contain `size()` elements
+  void set(const std::vector<geom::AngleValue>& values,
+           geom::AngleValue noop_tolerance = geom::Degrees(0.01));
+
+private:
+  /// Atoms in [begin, end) share same set of affecting angles
+  struct Segment {
+    AtomIndex begin;
+    AtomIndex end;
+    size_t n_kept;      /// number of prefix compositions kept from previous segment
+    size_t pushed_from; /// range of angles composed on top of kept ones in @ref m_pushed
+    size_t pushed_to;
+  };
+
+  [[nodiscard]] future::Span<geom::XYZ> coords() const;
+
+  std::optional<proxy::smart::AtomSmartRef> m_anchor; /// atom of the frame to track frame lifetime
+  std::vector<std::array<AtomIndex, 4>> m_atoms;
+  std::vector<Segment> m_segments;
+  std::vector<size_t> m_pushed;
+};
+
+} // namespace xmol
@@ -27,6 +27,9 @@ public:
   static std::optional<TorsionAngle> get(proxy::ResidueRef& residue, const TorsionAngleName& angleName);
 
   using four_atoms = std::tuple<proxy::AtomRef, proxy::AtomRef, proxy::AtomRef, proxy::AtomRef>;
+
+  /// Atoms of torsion angle without construction of TorsionAngle
+  static std::optional<four_atoms> get_atoms(proxy::ResidueRef& residue, const TorsionAngleName& angleName);
   using residue_to_atoms =  std::function<std::optional<four_atoms>(proxy::ResidueRef&)>;
 
 private:
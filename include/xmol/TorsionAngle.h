@@ -2,6 +2,7 @@
 
 #include "geom/AngleValue.h"
 #include "proxy/smart/references.h"
+#include <array>
 #include <functional>
 #include <optional>
 #include <set>
@@ -22,6 +23,12 @@ public:
 
   void set(const geom::AngleValue& value, geom::AngleValue noop_tolerance = geom::Degrees(0.01));
 
+  /// Atoms which define the angle
+  [[nodiscard]] std::array<ARef, 4> atoms() const;
+
+  /// Atoms rotated by @ref set()
+  [[nodiscard]] proxy::AtomSelection affected_atoms() const;
+
 private:
   ASRef a, b, c, d;
   AffectedAtomsSelector m_affected_atoms;
@@ -0,0 +1,61 @@
+#pragma once
+#include "ProteinTorsionAngleFactory.h"
+#include "trajectory/Trajectory.h"
+
+namespace xmol {
+
+/** Precompiled set of torsion angles of residues
+ *
+ * Atoms of each torsion angle are resolved once by @ref TorsionAngleFactory, values of all angles
+ * are then computed directly from frame coordinates.
+ */
+class TorsionTable {
+public:
+  /// Standard protein angles: phi, psi, omega, chi1, ..., chi5
+  static std::vector<TorsionAngleName> protein_angles();
+
+  /** Resolve angles of residues, angles with missing atoms are skipped
+   *
+   * @param residues residues of single frame
+   * @param names angle names to resolve for each residue
+   */
+  explicit TorsionTable(proxy::ResidueSpan residues, const std::vector<TorsionAngleName>& names = protein_angles());
+  explicit TorsionTable(proxy::ResidueSelection residues,
+                        const std::vector<TorsionAngleName>& names = protein_angles());
+
+  /// Number of resolved angles
+  [[nodiscard]] size_t size() const { return m_names.size(); }
+
+  /// Angle names in table order
+  [[nodiscard]] const std::vector<TorsionAngleName>& names() const { return m_names; }
+
+  /// Residue index of each angle
+  [[nodiscard]] const std::vector<ResidueIndex>& residue_indices() const { return m_residue_indices; }
+
+  /// Atom indices of each angle
+  [[nodiscard]] const std::vector<std::array<AtomIndex, 4>>& atom_indices() const { return m_atom_indices; }
+
+  /** Values of all angles in radians
+   *
+   * @param coords coordinates of all frame atoms
+   * @param result angle values, `size()` elements
+   */
+  void calc(const future::Span<geom::XYZ>& coords, future::Span<double> result) const;
+
+  /** Values of all angles in radians for trajectory frames
+   *
+   * @param slice trajectory frames
+   * @param result angle values stored frame after frame, `slice.size() * size()` elements
+   */
+  void calc(trajectory::Trajectory::Slice& slice, future::Span<double> result) const;
+
+private:
+  template <typename Residues> void resolve(Residues& residues, const std::vector<TorsionAngleName>& names);
+
+  std::vector<TorsionAngleName> m_names;
+  std::vector<ResidueIndex> m_residue_indices;
+  std::vector<std::array<AtomIndex, 4>> m_atom_indices;
+  AtomIndex m_max_atom_index = -1;
+};
+
+} // namespace xmol
@@ -0,0 +1,65 @@
+#pragma once
+#include "xmol/base.h"
+#include "xmol/future/span.h"
+#include "xmol/fwd.h"
+#include <vector>
+
+namespace xmol::algo {
+
+/** One-pass mean structure, RMSF and positional covariance of (aligned) frames
+ *
+ * Mean and per-coordinate deviations are accumulated by Welford updates. Covariance is optional, frames are
+ * buffered in blocks and folded into 3N x 3N co-moment matrix by rank-k updates. Accumulators of
+ * disjoint frame sets (e.g. processed by different threads) can be combined with @ref merge().
+ */
+class CoordStatistics {
+public:
+  /** @param n_atoms number of atoms per frame
+   *  @param covariance accumulate 3N x 3N covariance matrix
+   */
+  explicit CoordStatistics(size_t n_atoms, bool covariance = false);
+
+  /// Add frame coordinates
+  void update(const future::Span<geom::XYZ>& coords);
+  void update(proxy::CoordSpan& coords);
+  void update(proxy::CoordSelection& coords);
+
+  /// Add statistics of other frames
+  void merge(const CoordStatistics& other);
+
+  [[nodiscard]] size_t n_atoms() const { return m_mean.size() / 3; }
+
+  /// Number of added frames
+  [[nodiscard]] size_t n_frames() const { return m_n_frames; }
+
+  [[nodiscard]] bool has_covariance() const { return m_covariance; }
+
+  /// Mean coordinates
+  [[nodiscard]] std::vector<geom::XYZ> mean() const;
+
+  /// Root mean square fluctuation of each atom
+  [[nodiscard]] std::vector<double> rmsf() const;
+
+  /// Population covariance of coordinates in `x1, y1, z1, x2, ...` order
+  [[nodiscard]] Eigen::MatrixXd covariance() const;
+
+private:
+  static constexpr size_t block_size = 32;
+
+  void update_frame();
+  void flush_block();
+
+  size_t m_n_frames = 0;
+  Eigen::VectorXd m_frame; /// buffer of flattened frame coordinates
+  Eigen::VectorXd m_mean;
+  Eigen::VectorXd m_m2; /// sum of squared deviations of each coordinate
+
+  bool m_covariance;
+  size_t m_covariance_n_frames = 0; /// number of frames folded into co-moment matrix
+  Eigen::VectorXd m_covariance_mean;
+  Eigen::MatrixXd m_comoment; /// lower triangle of sum of deviation outer products
+  Eigen::MatrixXd m_block;    /// buffered frames, column per frame
+  size_t m_block_n_frames = 0;
+};
+
+} // namespace xmol::algo
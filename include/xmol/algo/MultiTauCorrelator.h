@@ -0,0 +1,67 @@
+#pragma once
+#include "vector-correlation.h"
+
+namespace xmol::algo {
+
+/** Streaming order 2 autocorrelation of many vectors by multi-tau (logarithmic block averaging) scheme
+ *
+ * Frames are fed one by one. Level 0 correlates last `points_per_level` frames exactly, each next level
+ * correlates averages of `averaging` consecutive values of previous level, so lag spacing grows
+ * geometrically and memory per vector grows as logarithm of number of frames.
+ *
+ * Correlation values have same normalization as @ref calc_autocorr_order_2 and match it exactly
+ * for lags below `points_per_level`.
+ */
+class MultiTauCorrelator {
+public:
+  /** @param n_vectors number of vectors in each frame, must be positive
+   *  @param mode normalization mode
+   *  @param points_per_level number of lags per level, must be multiple of @p averaging
+   *  @param averaging number of values averaged on transition to next level, at least 2
+   */
+  explicit MultiTauCorrelator(size_t n_vectors, AutoCorrelationMode mode = AutoCorrelationMode::NORMALIZE_VECTORS,
+                              size_t points_per_level = 16, size_t averaging = 2);
+
+  /// Add next frame, @p vectors must contain `n_vectors` non-zero elements, throws GeomError otherwise
+  void update(const future::Span<geom::XYZ>& vectors);
+
+  /// Forget all added frames
+  void reset();
+
+  /// Lags (in frames) of available correlation values in increasing order
+  [[nodiscard]] std::vector<size_t> lags() const;
+
+  /// Correlation values stored vector after vector, `n_vectors * lags().size()` elements
+  [[nodiscard]] std::vector<double> correlation() const;
+
+  [[nodiscard]] size_t n_vectors() const { return m_n_vectors; }
+
+  /// Number of added frames
+  [[nodiscard]] size_t n_frames() const { return m_n_frames; }
+
+  /// Number of components of rank 2 tensor stored per vector
+  static constexpr size_t n_components = 6;
+
+private:
+  struct Level {
+    std::vector<double> values;      /// circular buffer of last `points_per_level` tensors of all vectors
+    std::vector<double> correlation; /// sum of products of each vector, lag after lag
+    std::vector<size_t> counts;      /// number of products summed for each lag
+    std::vector<double> accumulator; /// sum of tensors to pass to next level
+    size_t n_accumulated = 0;
+    size_t n_values = 0;
+  };
+
+  void add(size_t level_index, const double* tensors);
+  [[nodiscard]] size_t first_lag(size_t level_index) const { return level_index == 0 ? 0 : m_points / m_averaging; }
+
+  size_t m_n_vectors;
+  AutoCorrelationMode m_mode;
+  size_t m_points;
+  size_t m_averaging;
+  size_t m_n_frames = 0;
+  std::vector<Level> m_levels;
+  std::vector<double> m_tensors; /// buffer of frame or block averaged tensors
+};
+
+} // namespace xmol::algo
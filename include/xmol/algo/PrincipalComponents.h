@@ -0,0 +1,69 @@
+#pragma once
+#include "CoordStatistics.h"
+#include "xmol/geom/XYZ.h"
+#include "xmol/trajectory/Trajectory.h"
+
+namespace xmol::algo {
+
+/** Principal components of atomic fluctuations (essential dynamics)
+ *
+ * Modes are eigenvectors of (optionally mass-weighted) covariance accumulated by @ref CoordStatistics.
+ * Frames are projected in blocks: centered coordinates of a block form a matrix which is multiplied by
+ * modes at once, blocks are distributed among threads.
+ */
+class PrincipalComponents {
+public:
+  /** @param statistics accumulated statistics of aligned frames, must include covariance
+   *  @param n_components number of modes with largest variance to keep
+   *  @param masses atom masses for mass-weighted analysis, empty for unweighted
+   */
+  PrincipalComponents(const CoordStatistics& statistics, size_t n_components,
+                      const future::Span<const double>& masses = {});
+
+  [[nodiscard]] size_t n_atoms() const { return m_mean.size() / 3; }
+  [[nodiscard]] size_t n_components() const { return m_eigenvalues.size(); }
+
+  /// Variance along each mode in decreasing order
+  [[nodiscard]] const Eigen::VectorXd& eigenvalues() const { return m_eigenvalues; }
+
+  /// Modes as columns of `3 * n_atoms x n_components` matrix in `x1, y1, z1, x2, ...` order
+  [[nodiscard]] const Eigen::MatrixXd& modes() const { return m_modes; }
+
+  /// Sum of variances of all modes
+  [[nodiscard]] double total_variance() const { return m_total_variance; }
+
+  /** Project frames on modes
+   *
+   * Frames must be aligned same way as frames of statistics, otherwise rigid body motion leaks into projections.
+   *
+   * @param frames coordinates stored frame after frame, `n_frames * n_atoms` elements
+   * @param result projections stored frame after frame, `n_frames * n_components` elements
+   * @param n_threads number of threads, non-positive value means all hardware threads
+   */
+  void project(const future::Span<geom::XYZ>& frames, future::Span<double> result, int n_threads = 0) const;
+
+  /** Project trajectory frames on modes, frames are read once
+   *
+   * When @p align is set analysed atoms of each frame are superimposed onto mean structure before projection,
+   * so rigid body motion is excluded as in statistics of aligned frames. Frames are not modified.
+   *
+   * @param slice trajectory frames
+   * @param indices indices of analysed atoms, `n_atoms` elements
+   * @param result projections stored frame after frame, `slice.size() * n_components` elements
+   * @param n_threads number of threads, non-positive value means all hardware threads
+   * @param align superimpose frames onto mean structure, requires at least 3 atoms
+   */
+  void project(trajectory::Trajectory::Slice& slice, const std::vector<AtomIndex>& indices,
+               future::Span<double> result, int n_threads = 0, bool align = true) const;
+
+private:
+  void project_block(const Eigen::Ref<const Eigen::MatrixXd>& block, double* result) const;
+
+  Eigen::VectorXd m_mean;
+  Eigen::VectorXd m_weights; /// square root of mass of each coordinate
+  Eigen::MatrixXd m_modes;
+  Eigen::VectorXd m_eigenvalues;
+  double m_total_variance = 0;
+};
+
+} // namespace xmol::algo
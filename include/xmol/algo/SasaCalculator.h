@@ -0,0 +1,68 @@
+#pragma once
+#include "sasa-impl.h"
+#include "xmol/geom/NeighbourList.h"
+#include <map>
+#include <optional>
+
+namespace xmol::algo {
+
+/** Per-atom SASA of consecutive frames with reuse of unchanged atoms
+ *
+ * Candidate neighbours are kept in Verlet list with skin. Area of an atom is recomputed only when the atom
+ * or one of its neighbours moved by more than `tolerance` since the last recalculation triggered by that
+ * atom, so reused areas correspond to coordinates at most `2 * tolerance` away from current ones.
+ * Zero tolerance reproduces @ref calc_sasa / @ref calc_sasa_shrake_rupley exactly.
+ */
+class SasaCalculator {
+public:
+  /** @param solvent_radius solvent probe radius
+   *  @param skin neighbour list skin
+   *  @param tolerance atom displacement which doesn't trigger recalculation
+   *  @param method calculation method
+   *  @param n_samples slices (Lee-Richards) or test points (Shrake-Rupley) per atom
+   *  @param n_threads number of threads, non-positive value means all hardware threads
+   */
+  explicit SasaCalculator(double solvent_radius, double skin = 1.0, double tolerance = 0.0,
+                          SasaMethod method = SasaMethod::LEE_RICHARDS, int n_samples = 20, int n_threads = 0);
+
+  /// Update per-atom areas for new frame, radii are taken from `vdw_radius` of frame atoms
+  future::Span<const double> update(Frame& frame);
+
+  /// Update per-atom areas for new coordinates
+  future::Span<const double> update(const future::Span<geom::XYZ>& coords, const future::Span<double>& radii);
+
+  /// Forget all cached areas
+  void reset();
+
+  /// Per-atom areas of last update
+  [[nodiscard]] future::Span<const double> sasa() const {
+    return future::Span<const double>(m_sasa.data(), m_sasa.size());
+  }
+
+  /// Number of atoms recalculated at last update
+  [[nodiscard]] size_t n_updated_atoms() const { return m_n_updated_atoms; }
+
+private:
+  void set_radii(const future::Span<double>& radii);
+
+  double m_solvent_radius;
+  double m_skin;
+  double m_tolerance;
+  SasaMethod m_method;
+  int m_n_samples;
+  int m_n_threads;
+
+  std::optional<geom::NeighbourList> m_neighbours;
+  std::vector<double> m_radii;
+  std::vector<double> m_frame_radii;        /// buffer for frame radii
+  std::vector<geom::XYZ> m_reference;       /// atom coordinates at last recalculation triggered by the atom
+  std::vector<double> m_sasa;
+  std::vector<char> m_moved;
+  std::vector<int> m_dirty;
+  std::map<double, SpherePoints> m_sphere_points; /// Shrake-Rupley points of each atom radius
+  std::vector<LeeRichardsScratch> m_lee_richards_scratch;
+  std::vector<ShrakeRupleyScratch> m_shrake_rupley_scratch;
+  size_t m_n_updated_atoms = 0;
+};
+
+} // namespace xmol::algo
@@ -71,6 +71,79 @@ geom::affine::Transformation3d calc_alignment_weighted_impl(const MatrixA& X, co
   return geom::affine::Transformation3d(R, T);
 }
 
+/** Minimal RMSD of superposition by quaternion characteristic polynomial method (Theobald, 2005)
+ *
+ * @param A correlation matrix of precentered coordinates, @f$ A = X^T W Y @f$
+ * @param E0 half of (weighted) sum of squared precentered coordinates of both sets
+ * @param total_weight sum of weights, number of points in unweighted case
+ * @param rotation if not null receives rotation which superimposes Y onto X
+ */
+double calc_rmsd_qcp_impl(const Eigen::Matrix3d& A, double E0, double total_weight,
+                          geom::affine::Rotation3d* rotation = nullptr);
+
+/// Calculate RMSD after optimal superposition in a single pass over coordinates
+///
+/// @tparam MatrixA reference coordinates, Eigen [N*3] matrix or equivalent expression
+/// @tparam MatrixB coordinates to align, Eigen [N*3] matrix or equivalent expression
+template <typename MatrixA, typename MatrixB>
+double calc_fitted_rmsd_impl(const MatrixA& X, const MatrixB& Y, geom::affine::Rotation3d* rotation = nullptr) {
+  if (X.rows() != Y.rows()) {
+    throw geom::GeomError("fitted rmsd: reference.size (=" + std::to_string(X.rows()) +
+                          ") != variable.size (=" + std::to_string(Y.rows()) + ")");
+  }
+  if (X.rows() == 0) {
+    throw geom::GeomError("fitted rmsd: empty coordinates");
+  }
+  Eigen::Matrix3d A = Eigen::Matrix3d::Zero();
+  Eigen::RowVector3d xs = Eigen::RowVector3d::Zero();
+  Eigen::RowVector3d ys = Eigen::RowVector3d::Zero();
+  double G = 0;
+  for (Eigen::Index i = 0; i < X.rows(); ++i) {
+    Eigen::RowVector3d x = X.row(i);
+    Eigen::RowVector3d y = Y.row(i);
+    A.noalias() += x.transpose() * y;
+    xs += x;
+    ys += y;
+    G += x.squaredNorm() + y.squaredNorm();
+  }
+  const double n = X.rows();
+  A.noalias() -= xs.transpose() * ys / n;
+  G -= (xs.squaredNorm() + ys.squaredNorm()) / n;
+  return calc_rmsd_qcp_impl(A, G / 2, n, rotation);
+}
+
+/// Calculate weighted RMSD after optimal weighted superposition in a single pass over coordinates
+template <typename MatrixA, typename MatrixB, typename WeightVector>
+double calc_fitted_rmsd_weighted_impl(const MatrixA& X, const MatrixB& Y, const WeightVector& weight,
+                                      geom::affine::Rotation3d* rotation = nullptr) {
+  if (X.rows() != Y.rows() || X.rows() != weight.size()) {
+    throw geom::GeomError("fitted rmsd: reference.size (=" + std::to_string(X.rows()) + "), variable.size (=" +
+                          std::to_string(Y.rows()) + ") and weight.size (=" + std::to_string(weight.size()) +
+                          ") mismatch");
+  }
+  Eigen::Matrix3d A = Eigen::Matrix3d::Zero();
+  Eigen::RowVector3d xs = Eigen::RowVector3d::Zero();
+  Eigen::RowVector3d ys = Eigen::RowVector3d::Zero();
+  double G = 0;
+  double total_weight = 0;
+  for (Eigen::Index i = 0; i < X.rows(); ++i) {
+    const double w = weight[i];
+    Eigen::RowVector3d x = X.row(i);
+    Eigen::RowVector3d y = Y.row(i);
+    A.noalias() += w * x.transpose() * y;
+    xs += w * x;
+    ys += w * y;
+    G += w * (x.squaredNorm() + y.squaredNorm());
+    total_weight += w;
+  }
+  if (total_weight < 1e-3) {
+    throw geom::GeomError("Total weight is too low, check you inputs");
+  }
+  A.noalias() -= xs.transpose() * ys / total_weight;
+  G -= (xs.squaredNorm() + ys.squaredNorm()) / total_weight;
+  return calc_rmsd_qcp_impl(A, G / 2, total_weight, rotation);
+}
+
 template <typename MatrixA, typename MatrixB> double calc_rmsd_impl(const MatrixA& reference, const MatrixB& variable) {
   return std::sqrt((reference - variable).array().square().sum() / reference.rows());
 }
@@ -20,6 +20,18 @@ namespace xmol::algo {
 [[nodiscard]] double calc_rmsd(proxy::CoordSelection& reference, proxy::CoordSpan& variable);
 [[nodiscard]] double calc_rmsd(proxy::CoordSelection& reference, proxy::CoordSelection& variable);
 
+/// RMSD after optimal superposition, computed by QCP method without building rotation matrix
+[[nodiscard]] double calc_fitted_rmsd(proxy::CoordSpan& reference, proxy::CoordSpan& variable);
+[[nodiscard]] double calc_fitted_rmsd(proxy::CoordSpan& reference, proxy::CoordSelection& variable);
+[[nodiscard]] double calc_fitted_rmsd(proxy::CoordSelection& reference, proxy::CoordSpan& variable);
+[[nodiscard]] double calc_fitted_rmsd(proxy::CoordSelection& reference, proxy::CoordSelection& variable);
+
+/// Mass-weighted RMSD after optimal mass-weighted superposition
+[[nodiscard]] double calc_weighted_fitted_rmsd(proxy::AtomSpan& reference, proxy::AtomSpan& variable);
+[[nodiscard]] double calc_weighted_fitted_rmsd(proxy::AtomSpan& reference, proxy::AtomSelection& variable);
+[[nodiscard]] double calc_weighted_fitted_rmsd(proxy::AtomSelection& reference, proxy::AtomSpan& variable);
+[[nodiscard]] double calc_weighted_fitted_rmsd(proxy::AtomSelection& reference, proxy::AtomSelection& variable);
+
 [[nodiscard]] double calc_weighted_rmsd(proxy::AtomSpan& reference, proxy::AtomSpan& variable);
 [[nodiscard]] double calc_weighted_rmsd(proxy::AtomSpan& reference, proxy::AtomSelection& variable);
 [[nodiscard]] double calc_weighted_rmsd(proxy::AtomSelection& reference, proxy::AtomSpan& variable);
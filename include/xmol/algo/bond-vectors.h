@@ -0,0 +1,25 @@
+#pragma once
+#include "xmol/future/span.h"
+#include "xmol/fwd.h"
+#include "xmol/geom/XYZ.h"
+#include "xmol/trajectory/Trajectory.h"
+#include <vector>
+
+namespace xmol::algo {
+
+/** Time series of vectors between atom pairs, e.g. N-H bonds for @ref calc_autocorr_order_2
+ *
+ * Only coordinates of frames are touched. When @p reference is not empty each frame is superimposed onto it
+ * by @p alignment_indices atoms and vectors are rotated accordingly.
+ *
+ * @param slice trajectory frames
+ * @param pairs atom indices, vector points from first to second atom of pair
+ * @param result vectors stored pair after pair, `pairs.size() * slice.size()` elements
+ * @param reference coordinates of alignment atoms in reference frame
+ * @param alignment_indices indices of atoms to superimpose, `reference.size()` elements
+ */
+void extract_bond_vectors(trajectory::Trajectory::Slice& slice, const std::vector<std::pair<AtomIndex, AtomIndex>>& pairs,
+                          future::Span<geom::XYZ> result, const future::Span<geom::XYZ>& reference = {},
+                          const std::vector<AtomIndex>& alignment_indices = {});
+
+} // namespace xmol::algo
@@ -0,0 +1,121 @@
+#pragma once
+#include "xmol/base.h"
+#include "xmol/future/span.h"
+#include "xmol/geom/XYZ.h"
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace xmol::algo {
+
+/** Symmetric matrix of distances between frames
+ *
+ * Clustering algorithms access matrix row by row, so implementations may keep only part of it in memory
+ */
+class DistanceMatrix {
+public:
+  virtual ~DistanceMatrix() = default;
+
+  /// Number of frames
+  [[nodiscard]] virtual size_t size() const = 0;
+
+  /// Distance between i-th and j-th frames
+  virtual double distance(size_t i, size_t j) = 0;
+
+  /// Distances from i-th frame to all frames, valid until next call to @ref row()
+  virtual future::Span<const double> row(size_t i) = 0;
+};
+
+/// View of precomputed condensed upper triangle of distance matrix (see @ref calc_pairwise_fitted_rmsd)
+class CondensedDistanceMatrix : public DistanceMatrix {
+public:
+  explicit CondensedDistanceMatrix(future::Span<const double> condensed);
+
+  [[nodiscard]] size_t size() const final { return m_size; }
+  double distance(size_t i, size_t j) final;
+  future::Span<const double> row(size_t i) final;
+
+private:
+  future::Span<const double> m_condensed;
+  size_t m_size;
+  std::vector<double> m_row;
+};
+
+/** Fitted RMSD matrix computed on demand
+ *
+ * Keeps at most `cache_rows` recently used rows, so memory grows linearly with number of frames
+ */
+class CachedRmsdMatrix : public DistanceMatrix {
+public:
+  /** @param frames coordinates of all frames stored frame after frame
+   *  @param n_atoms number of atoms per frame
+   *  @param cache_rows maximal number of cached rows
+   *  @param n_threads number of threads to compute row, non-positive value means all hardware threads
+   */
+  CachedRmsdMatrix(const future::Span<geom::XYZ>& frames, size_t n_atoms, size_t cache_rows = 64, int n_threads = 0);
+
+  [[nodiscard]] size_t size() const final { return m_half_norm2.size(); }
+  double distance(size_t i, size_t j) final;
+  future::Span<const double> row(size_t i) final;
+
+  /// Number of computed rows since construction
+  [[nodiscard]] size_t n_computed_rows() const { return m_n_computed_rows; }
+
+private:
+  size_t m_n_atoms;
+  size_t m_cache_rows;
+  int m_n_threads;
+  size_t m_n_computed_rows = 0;
+  CoordEigenMatrix m_coords;        /// centered coordinates
+  std::vector<double> m_half_norm2; /// half of squared norm of centered frame
+  std::list<std::pair<size_t, std::vector<double>>> m_cache; /// most recently used rows first
+  std::unordered_map<size_t, decltype(m_cache)::iterator> m_cache_index;
+};
+
+/// Result of clustering, clusters are ordered by decreasing size
+struct Clustering {
+  std::vector<size_t> medoids; /// representative frame of each cluster
+  std::vector<int> labels;     /// cluster of each frame
+};
+
+/** Neighbour-count clustering of Daura et al. (GROMOS)
+ *
+ * Frame with largest number of neighbours within @p cutoff forms a cluster with all its neighbours,
+ * clustered frames are removed and procedure is repeated until all frames are clustered.
+ */
+Clustering gromos_clustering(DistanceMatrix& distances, double cutoff);
+
+/** k-medoids clustering by alternating assignment and medoid update steps
+ *
+ * Initial medoids are chosen by k-means++ procedure seeded with @p seed
+ */
+Clustering k_medoids_clustering(DistanceMatrix& distances, size_t n_clusters, size_t max_iterations = 100,
+                                unsigned seed = 0);
+
+/// Cluster distance update rule of agglomerative clustering
+enum class Linkage { SINGLE, COMPLETE, AVERAGE };
+
+/// Merge of two clusters in agglomerative clustering, same convention as `scipy.cluster.hierarchy.linkage`
+struct LinkageStep {
+  size_t first;    /// index of first merged cluster, indices >= n_frames refer to clusters formed at previous steps
+  size_t second;   /// index of second merged cluster
+  double distance; /// distance between merged clusters
+  size_t size;     /// number of frames in new cluster
+};
+
+/** Agglomerative clustering dendrogram, steps are sorted by distance
+ *
+ * Single linkage is computed via minimum spanning tree row by row, complete and average linkages
+ * require dense copy of the matrix
+ */
+std::vector<LinkageStep> calc_linkage(DistanceMatrix& distances, Linkage method);
+
+/// Cut dendrogram into @p n_clusters clusters
+Clustering hierarchical_clustering(DistanceMatrix& distances, const std::vector<LinkageStep>& linkage,
+                                   size_t n_clusters);
+
+/// Cut dendrogram at @p threshold, clusters merged at larger distance are kept apart
+Clustering hierarchical_clustering_by_distance(DistanceMatrix& distances, const std::vector<LinkageStep>& linkage,
+                                               double threshold);
+
+} // namespace xmol::algo
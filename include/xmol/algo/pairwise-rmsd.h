@@ -0,0 +1,40 @@
+#pragma once
+#include "xmol/future/span.h"
+#include "xmol/fwd.h"
+#include "xmol/geom/XYZ.h"
+#include "xmol/trajectory/Trajectory.h"
+#include <vector>
+
+namespace xmol::algo {
+
+/// Number of elements in condensed upper triangle of `n x n` matrix (without diagonal)
+constexpr size_t condensed_size(size_t n) { return n * (n - 1) / 2; }
+
+/// Position of (i, j), i < j element in condensed upper triangle of `n x n` matrix
+constexpr size_t condensed_index(size_t n, size_t i, size_t j) { return n * i - i * (i + 1) / 2 + j - i - 1; }
+
+/** All-vs-all RMSD after optimal superposition
+ *
+ * Each frame is centred once, pairs are processed in cache-sized tiles of frames across @p n_threads threads
+ *
+ * @param frames coordinates of all frames stored frame after frame, `n_frames * n_atoms` elements
+ * @param n_atoms number of atoms per frame
+ * @param result condensed upper triangle of RMSD matrix, `condensed_size(n_frames)` elements
+ * @param n_threads number of threads, non-positive value means all hardware threads
+ */
+template <typename T>
+void calc_pairwise_fitted_rmsd(const future::Span<geom::XYZ>& frames, size_t n_atoms, future::Span<T> result,
+                               int n_threads = 0);
+
+/** All-vs-all RMSD after optimal superposition of trajectory frames
+ *
+ * @param slice trajectory frames
+ * @param indices indices of atoms to superimpose
+ * @param result condensed upper triangle of RMSD matrix, `condensed_size(slice.size())` elements
+ * @param n_threads number of threads, non-positive value means all hardware threads
+ */
+template <typename T>
+void calc_pairwise_fitted_rmsd(trajectory::Trajectory::Slice& slice, const std::vector<AtomIndex>& indices,
+                               future::Span<T> result, int n_threads = 0);
+
+} // namespace xmol::algo
@@ -0,0 +1,37 @@
+#pragma once
+#include "xmol/future/span.h"
+#include "xmol/fwd.h"
+#include "xmol/geom/UnitCell.h"
+#include <vector>
+
+namespace xmol::algo {
+
+/// Translate coordinates into the cell spanned from @p origin
+void wrap(const geom::UnitCell& cell, proxy::CoordSpan& coords, const geom::XYZ& origin = geom::XYZ(0, 0, 0));
+void wrap(const geom::UnitCell& cell, proxy::CoordSelection& coords, const geom::XYZ& origin = geom::XYZ(0, 0, 0));
+
+/// Move every coordinate to periodic image closest to the previous one
+void unwrap_sequential(const geom::UnitCell& cell, proxy::CoordSpan& coords);
+void unwrap_sequential(const geom::UnitCell& cell, proxy::CoordSelection& coords);
+
+/** Make bonded coordinates whole
+ *
+ * Bonds are pairs of positions within @p coords, each connected component is traversed
+ * from its lowest index in breadth first order
+ */
+void unwrap_bonded(const geom::UnitCell& cell, proxy::CoordSpan& coords, const std::vector<std::pair<int, int>>& bonds);
+void unwrap_bonded(const geom::UnitCell& cell, proxy::CoordSelection& coords,
+                   const std::vector<std::pair<int, int>>& bonds);
+
+/** Make molecules whole following residue order
+ *
+ * First atom of each residue is moved to the image closest to the first atom of the previous residue,
+ * the rest of residue atoms follow the first atom of their residue
+ */
+void make_molecules_whole(const geom::UnitCell& cell, proxy::MoleculeSpan& molecules);
+void make_molecules_whole(const geom::UnitCell& cell, proxy::MoleculeSelection& molecules);
+
+/// Replace each displacement with its minimum image
+void calc_minimum_image(const geom::UnitCell& cell, future::Span<geom::XYZ> displacements);
+
+} // namespace xmol::algo
@@ -0,0 +1,79 @@
+#pragma once
+#include "sasa.h"
+#include <cstdint>
+
+namespace xmol::algo {
+
+/// Slice-independent part of neighbour sphere overlap test of Lee-Richards method
+struct LeeRichardsNeighbour {
+  double dz; /// z distance from central atom
+  double Rm; /// neighbour radius including solvent
+  double dx;
+  double dy;
+  double d;    /// distance from central atom in xy plane
+  double beta; /// direction from central atom in xy plane
+};
+
+/// Buffers of Lee-Richards method reused between atoms
+struct LeeRichardsScratch {
+  std::vector<LeeRichardsNeighbour> neighbours;
+  std::vector<std::pair<double, double>> segments;
+};
+
+/// Extra distance at which nearly touching spheres are still passed to slice test of Lee-Richards method
+constexpr double lee_richards_touch_margin = 1e-4;
+
+/** Lee-Richards area of single atom
+ *
+ * @param candidates superset of atoms which spheres intersect sphere of atom @p n, may include @p n itself
+ */
+double calc_atom_sasa_lee_richards_impl(const future::Span<geom::XYZ>& coords,
+                                        const future::Span<double>& coord_radii, double solvent_radii, int n,
+                                        const future::Span<const int>& candidates, int n_samples,
+                                        LeeRichardsScratch& scratch);
+
+/// Test points of Shrake-Rupley method in blocks of 64 points, coordinates are stored as separate arrays (padded)
+struct SpherePoints {
+  static constexpr size_t block_size = 64;
+
+  SpherePoints() = default;
+
+  /// Golden spiral points on sphere of given radius
+  SpherePoints(size_t n_points, double radius);
+
+  static size_t padded_size(size_t n) { return (n + block_size - 1) / block_size * block_size; }
+  [[nodiscard]] size_t n_blocks() const { return x.size() / block_size; }
+
+  size_t n_points = 0;
+  double radius = 0;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> z;
+};
+
+/// Neighbour sphere relative to central atom in Shrake-Rupley method
+struct OcclusionNeighbour {
+  double x;
+  double y;
+  double z;
+  double R2; /// squared radius including solvent
+  double distance2;
+};
+
+/// Buffers of Shrake-Rupley method reused between atoms
+struct ShrakeRupleyScratch {
+  std::vector<OcclusionNeighbour> neighbours;
+  SpherePoints points;
+};
+
+/** Shrake-Rupley area of single atom
+ *
+ * @param candidates superset of atoms which spheres intersect sphere of atom @p n, may include @p n itself
+ * @param points test points on sphere of atom @p n radius (including solvent), centered at origin
+ */
+double calc_atom_sasa_shrake_rupley_impl(const future::Span<geom::XYZ>& coords,
+                                         const future::Span<double>& coord_radii, double solvent_radii, int n,
+                                         const future::Span<const int>& candidates, const SpherePoints& points,
+                                         ShrakeRupleyScratch& scratch);
+
+} // namespace xmol::algo
@@ -7,7 +7,43 @@
 
 namespace xmol::algo {
 
+/** Solvent accessible surface area by Lee-Richards slices
+ *
+ * Atoms are distributed across @p n_threads threads, result doesn't depend on number of threads
+ *
+ * @param coords atom coordinates
+ * @param coord_radii atom radii
+ * @param solvent_radii solvent probe radius
+ * @param result per-atom area of atoms from @p sasa_points_indices (all atoms if empty)
+ * @param n_samples number of slices per atom
+ * @param sasa_points_indices indices of atoms to calculate area for
+ * @param n_threads number of threads, non-positive value means all hardware threads
+ */
 void calc_sasa(const future::Span<geom::XYZ>& coords, future::Span<double> coord_radii, double solvent_radii,
-               future::Span<double> result, int n_samples = 20, const future::Span<int>& sasa_points_indices = {});
+               future::Span<double> result, int n_samples = 20, const future::Span<int>& sasa_points_indices = {},
+               int n_threads = 0);
+
+/// SASA calculation method
+enum class SasaMethod {
+  LEE_RICHARDS, /// slices of atom sphere, see @ref calc_sasa
+  SHRAKE_RUPLEY /// test points on atom sphere, see @ref calc_sasa_shrake_rupley
+};
+
+/** Solvent accessible surface area by Shrake-Rupley test points
+ *
+ * Points are placed on golden spiral, area of atom is proportional to fraction of points not buried by neighbours.
+ * Larger @p n_points improves accuracy at proportional cost.
+ *
+ * @param coords atom coordinates
+ * @param coord_radii atom radii
+ * @param solvent_radii solvent probe radius
+ * @param result per-atom area of atoms from @p sasa_points_indices (all atoms if empty)
+ * @param n_points number of test points per atom
+ * @param sasa_points_indices indices of atoms to calculate area for
+ * @param n_threads number of threads, non-positive value means all hardware threads
+ */
+void calc_sasa_shrake_rupley(const future::Span<geom::XYZ>& coords, future::Span<double> coord_radii,
+                             double solvent_radii, future::Span<double> result, int n_points = 100,
+                             const future::Span<int>& sasa_points_indices = {}, int n_threads = 0);
 
 }
\ No newline at end of file
@@ -11,4 +11,18 @@ enum class AutoCorrelationMode { NORMALIZE_VECTORS, NORMALIZE_AND_DIVIDE_BY_CUBE
 void calc_autocorr_order_2(const future::Span<geom::XYZ>& v, future::Span<double> result,
                            const AutoCorrelationMode& mode = AutoCorrelationMode::NORMALIZE_VECTORS);
 
+/** Order 2 autocorrelation of many vector series
+ *
+ * Series are processed in parallel, each thread reuses its FFT plan and buffers
+ *
+ * @param vectors series stored one after another, `n_vectors * n_frames` elements
+ * @param n_vectors number of series
+ * @param result autocorrelations stored one after another, `n_vectors * limit` elements, `limit <= n_frames`
+ * @param mode normalization mode
+ * @param n_threads number of threads, non-positive value means all hardware threads
+ */
+void calc_autocorr_order_2(const future::Span<geom::XYZ>& vectors, size_t n_vectors, future::Span<double> result,
+                           const AutoCorrelationMode& mode = AutoCorrelationMode::NORMALIZE_VECTORS,
+                           int n_threads = 0);
+
 } // namespace xmol::algo
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+#include "SpatialIndex.h"
+#include "XYZ.h"
+#include "xmol/future/span.h"
+#include <vector>
+
+namespace xmol::geom {
+
+/** Verlet neighbour list with skin
+ *
+ * Stores all pairs closer than `cutoff + skin` at the moment of last rebuild.
+ * The list is rebuilt by @ref update() only when some point moved by more than `skin / 2`
+ * since last rebuild, otherwise stored pairs remain a superset of pairs within `cutoff`.
+ */
+class NeighbourList {
+public:
+  using index_t = SpatialIndex::index_t;
+  using pair_t = std::pair<index_t, index_t>;
+
+  enum class Mode {
+    HALF, /// each pair is stored once as (i, j) with i < j
+    FULL  /// each pair is stored twice as (i, j) and (j, i)
+  };
+
+  NeighbourList(double cutoff, double skin, Mode mode = Mode::HALF);
+
+  /// Rebuild list if any point moved beyond half of the skin, returns true if list was rebuilt
+  bool update(const future::Span<XYZ>& coords);
+
+  /// Unconditionally rebuild list
+  void rebuild(const future::Span<XYZ>& coords);
+
+  /// Candidate neighbours of i-th point (within `cutoff + skin` at last rebuild),
+  /// throws GeomError if list was not built yet or @p i is out of range
+  [[nodiscard]] future::Span<const index_t> neighbours(index_t i) const {
+    check_index(i);
+    return future::Span<const index_t>(m_neighbours.data() + m_offsets[i], m_neighbours.data() + m_offsets[i + 1]);
+  }
+
+  /// Pairs closer than cutoff for given coordinates, @p coords must be the ones passed to last @ref update()
+  [[nodiscard]] std::vector<pair_t> pairs_within_cutoff(const future::Span<XYZ>& coords) const;
+
+  /// Number of points in the list
+  [[nodiscard]] size_t size() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+
+  /// Total number of stored neighbours
+  [[nodiscard]] size_t n_pairs() const { return m_neighbours.size(); }
+
+  /// Number of rebuilds since construction
+  [[nodiscard]] size_t n_rebuilds() const { return m_n_rebuilds; }
+
+  [[nodiscard]] double cutoff() const { return m_cutoff; }
+  [[nodiscard]] double skin() const { return m_skin; }
+  [[nodiscard]] Mode mode() const { return m_mode; }
+
+private:
+  inline void check_index(index_t i) const {
+    if (m_offsets.empty()) {
+      throw GeomError("NeighbourList::neighbours(): list is not built, call update() first");
+    }
+    if (i < 0 || size_t(i) >= size()) {
+      throw GeomError("NeighbourList::neighbours(): index " + std::to_string(i) + " is out of range [0, " +
+                      std::to_string(size()) + ")");
+    }
+  }
+
+  double m_cutoff;
+  double m_skin;
+  Mode m_mode;
+  size_t m_n_rebuilds = 0;
+  std::vector<XYZ> m_reference;      /// coordinates at last rebuild
+  std::vector<size_t> m_offsets;     /// CSR offsets, size() + 1 elements
+  std::vector<index_t> m_neighbours; /// CSR neighbour indices
+};
+
+} // namespace xmol::geom
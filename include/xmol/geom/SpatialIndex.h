@@ -13,7 +13,10 @@ public:
   using indices_t = std::vector<index_t>;
 
   SpatialIndex(const future::Span<XYZ>& coords, double bin_side_length);
-  indices_t within(double distance, const XYZ& point);
+  indices_t within(double distance, const XYZ& point) const;
+
+  /// Same as above, but writes indices to @p result buffer to avoid allocation
+  void within(double distance, const XYZ& point, indices_t& result) const;
 
 private:
   std::map<bin_id_t, indices_t> m_bins;
@@ -1,6 +1,8 @@
 #pragma once
 #include "AngleValue.h"
 #include "XYZ.h"
+#include "xmol/future/span.h"
+#include <vector>
 
 namespace xmol::geom {
 
@@ -42,21 +44,35 @@ public:
 
   const XYZ& operator[](int i) const { return v[i]; }
 
-  AngleValue alpha() { return v[1].angle(v[2]); }
+  AngleValue alpha() const { return v[1].angle(v[2]); }
 
-  AngleValue beta() { return v[0].angle(v[2]); }
+  AngleValue beta() const { return v[0].angle(v[2]); }
 
-  AngleValue gamma() { return v[0].angle(v[1]); }
+  AngleValue gamma() const { return v[0].angle(v[1]); }
 
-  double a() { return v[0].len(); }
-  double b() { return v[1].len(); }
-  double c() { return v[2].len(); }
+  double a() const { return v[0].len(); }
+  double b() const { return v[1].len(); }
+  double c() const { return v[2].len(); }
 
   double volume() const { return ::fabs(v[0].cross(v[1]).dot(v[2])); }
 
   void scale_to_volume(double vol) { scale_by(::cbrt(vol / volume())); }
 
   [[nodiscard]] ClosestImage closest_image_to(const XYZ& ref, const XYZ& var) const;
+
+  /// Replace every displacement vector with its minimum image, batched analogue of closest_image_to()
+  void minimum_image(future::Span<XYZ> displacements) const;
+
+  /// Translate every point into the cell spanned from @p origin
+  void wrap(future::Span<XYZ> coords, const XYZ& origin = XYZ(0, 0, 0)) const;
+
+  /** Make connected points whole
+   *
+   * For each (a, b) edge in order moves `coords[b]` to its periodic image closest to `coords[a]`.
+   * Edges must be ordered such that `coords[a]` is already placed (e.g. tree traversal order)
+   */
+  void unwrap(future::Span<XYZ> coords, const std::vector<std::pair<int, int>>& edges) const;
+
   [[nodiscard]] static UnitCell unit_cubic_cell(); // Returns cubic cell of volume 1
 
 private:
@@ -72,6 +88,15 @@ private:
     }
     A_inv = A.inverse();
   }
+
+  /// Rounding of fractional coordinates gives exact minimum image only in rectangular cells
+  bool is_rectangular() const {
+    auto orthogonal = [](const XYZ& a, const XYZ& b) { return std::fabs(a.dot(b)) < 1e-9 * a.len() * b.len(); };
+    return orthogonal(v[0], v[1]) && orthogonal(v[0], v[2]) && orthogonal(v[1], v[2]);
+  }
+
+  /// Minimum image of single displacement vector, @p refine enables search over neighbour images
+  XYZ minimum_image(const XYZ& delta, bool refine) const;
 };
 
 } // namespace xmol::geom
\ No newline at end of file
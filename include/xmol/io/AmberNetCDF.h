@@ -33,6 +33,8 @@ private:
   mutable bool m_has_cell;
   mutable int m_cell_lengths_id;
   mutable int m_cell_angles_id;
+  mutable bool m_has_time;
+  mutable int m_time_id;
   mutable bool m_is_open = false;
 
   size_t m_current_frame = 0;
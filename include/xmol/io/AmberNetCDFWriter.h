@@ -0,0 +1,101 @@
+#pragma once
+#include "xmol/fwd.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace xmol::io {
+
+class AmberNetCDFWriteError : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+/** Writes frames in AMBER NetCDF trajectory format
+ *
+ * File follows AMBER convention (https://ambermd.org/netcdf/nctraj.xhtml): `coordinates` (float, angstrom),
+ * `time` (picosecond), optional `cell_lengths` and `cell_angles`, and is readable by @ref AmberNetCDF.
+ * File layout is defined by first written frame, next frames must have same number of atoms.
+ * File closed before first frame has only global attributes (number of atoms is unknown, and zero-length
+ * `atom` dimension would be unlimited) and can't be read by @ref AmberNetCDF.
+ *
+ * If frames can't be written to file (e.g. disk is full), writer becomes unusable:
+ * next writes throw, buffered frames are discarded on close.
+ *
+ * Frames are accumulated in memory and written in blocks of several frames.
+ *
+ * NetCDF-4 files store coordinates in chunks of `frames_per_chunk x atoms_per_chunk x 3`:
+ *  - chunk of 1 frame and all atoms is best for frame-by-frame reading (e.g. trajectory traverse)
+ *  - chunk of many frames and few atoms is best for reading time series of selected atoms
+ *
+ * and may be compressed with deflate (lossless, with shuffle filter).
+ * Classic (64-bit offset) format as written by AMBER itself has no chunking and compression,
+ * but can be read by NetCDF-3 only tools.
+ */
+class AmberNetCDFWriter {
+public:
+  enum class Format {
+    NETCDF4,       /// NetCDF-4 (HDF5-based), supports chunking and compression
+    CLASSIC_64BIT, /// NetCDF-3 64-bit offset, as written by AMBER
+  };
+
+  /** @param write_cell write `cell_lengths` and `cell_angles` of every frame; cell is not written if first frame
+   *                    has no box (unit cubic placeholder cell), frames without box can't follow frames with box
+   *  @param frames_per_chunk number of frames in chunk of coordinates (NetCDF-4 only)
+   *  @param atoms_per_chunk number of atoms in chunk of coordinates, zero means all atoms (NetCDF-4 only)
+   *  @param deflate_level compression level from 0 (no compression) to 9 (NetCDF-4 only)
+   *  @param buffer_frames number of frames accumulated before write to file,
+   *                       NetCDF-4 file buffers at least `frames_per_chunk` frames to write whole chunks */
+  explicit AmberNetCDFWriter(std::string filename, Format format = Format::NETCDF4, bool write_cell = true,
+                             size_t frames_per_chunk = 1, size_t atoms_per_chunk = 0, int deflate_level = 0,
+                             size_t buffer_frames = 16);
+  AmberNetCDFWriter(const AmberNetCDFWriter&) = delete;
+  AmberNetCDFWriter& operator=(const AmberNetCDFWriter&) = delete;
+
+  /// Flushes buffered frames and closes file, errors are ignored
+  ~AmberNetCDFWriter();
+
+  /// Append frame, throws AmberNetCDFWriteError if file is closed or previous write failed
+  void write(xmol::Frame& frame);
+
+  /// Write buffered frames to file, throws AmberNetCDFWriteError if previous write failed
+  void flush();
+
+  /// Write buffered frames (unless previous write failed) and close file, no frames may be written after
+  void close();
+
+  /// Number of written frames (including buffered)
+  [[nodiscard]] size_t n_frames() const { return m_n_written + m_n_buffered; }
+
+private:
+  void define(size_t n_atoms);
+  void check_not_failed() const;
+
+  std::string m_filename;
+  Format m_format;
+  bool m_write_cell;
+  size_t m_frames_per_chunk;
+  size_t m_atoms_per_chunk;
+  int m_deflate_level;
+  size_t m_buffer_frames;
+
+  int m_ncid = -1;
+  int m_coords_id = -1;
+  int m_time_id = -1;
+  int m_cell_lengths_id = -1;
+  int m_cell_angles_id = -1;
+  bool m_defined = false;
+  bool m_closed = false;
+  bool m_failed = false;
+
+  size_t m_n_atoms = 0;
+  size_t m_n_written = 0;
+  size_t m_n_buffered = 0;
+  std::vector<float> m_coords;
+  std::vector<float> m_time;
+  std::vector<double> m_cell_lengths;
+  std::vector<double> m_cell_angles;
+};
+
+} // namespace xmol::io
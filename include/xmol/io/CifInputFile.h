@@ -0,0 +1,60 @@
+#pragma once
+#include "xmol/Frame.h"
+#include "xmol/io/cif/CifBufferReader.h"
+#include "xmol/io/cif/exceptions.h"
+#include "xmol/trajectory/TrajectoryFile.h"
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace xmol::utils {
+class FileContent;
+}
+
+namespace xmol::io {
+
+/** mmCIF (PDBx) file
+ *
+ * Unlike PDB format mmCIF has no limits on number of atoms or length of chain names.
+ * Atoms of every model of `_atom_site` loop become a frame, see @ref cif::CifBufferReader for details.
+ *
+ * File is read in one of two modes:
+ *  - all models are parsed on construction and available via @ref frames()
+ *  - (streaming) only model positions are recorded on construction, model coordinates are parsed
+ *    by @ref read_frame() when file is read as trajectory, so memory doesn't depend on number of models
+ *
+ * gzip and zstd compressed files are decompressed transparently, see @ref utils::FileContent
+ */
+class CifInputFile : public trajectory::TrajectoryInputFile {
+public:
+  /** @param read_now parse all models on construction, otherwise file is opened in streaming mode
+   *  @param n_threads number of threads to parse models of multi-model file,
+   *                    and to decompress file, non-positive value means all hardware threads */
+  explicit CifInputFile(std::string filename, bool read_now = true, int n_threads = 0);
+
+  /// Parse all models
+  CifInputFile& read();
+  [[nodiscard]] const std::vector<Frame>& frames() const { return m_frames; }
+
+  [[nodiscard]] size_t n_frames() const final;
+  [[nodiscard]] size_t n_atoms() const final;
+  void read_frame(size_t index, Frame& frame) final;
+  void advance(size_t shift) final;
+
+private:
+  void open();
+
+  std::string m_filename;
+  std::vector<Frame> m_frames;
+  size_t m_current_frame = 0;
+  size_t m_n_frames = 0;
+  size_t m_n_atoms = 0;
+  int m_n_threads;
+
+  // streaming mode
+  bool m_streaming;
+  std::shared_ptr<const utils::FileContent> m_file;
+  std::optional<cif::CifBufferReader> m_reader;
+};
+
+} // namespace xmol::io
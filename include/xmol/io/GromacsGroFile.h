@@ -0,0 +1,60 @@
+#pragma once
+#include "xmol/Frame.h"
+#include "xmol/io/gro/GroBufferReader.h"
+#include "xmol/io/gro/exceptions.h"
+#include "xmol/trajectory/TrajectoryFile.h"
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace xmol::utils {
+class FileContent;
+}
+
+namespace xmol::io {
+
+/** Gromacs `.gro` file
+ *
+ * Every block of (multi-frame) file becomes a frame, see @ref gro::GroBufferReader for details.
+ *
+ * File is read in one of two modes:
+ *  - all frames are parsed on construction and available via @ref frames()
+ *  - (streaming) only frame positions are recorded on construction, frame coordinates are parsed
+ *    by @ref read_frame() when file is read as trajectory, so memory doesn't depend on number of frames
+ *
+ * gzip and zstd compressed files are decompressed transparently, see @ref utils::FileContent
+ */
+class GromacsGroFile : public trajectory::TrajectoryInputFile {
+public:
+  /** @param read_now parse all frames on construction, otherwise file is opened in streaming mode
+   *  @param n_threads number of threads to parse frames of multi-frame file,
+   *                    and to decompress file, non-positive value means all hardware threads */
+  explicit GromacsGroFile(std::string filename, bool read_now = true, int n_threads = 0);
+
+  /// Parse all frames
+  GromacsGroFile& read();
+  [[nodiscard]] const std::vector<Frame>& frames() const { return m_frames; }
+
+  [[nodiscard]] size_t n_frames() const final;
+  [[nodiscard]] size_t n_atoms() const final;
+  void read_frame(size_t index, Frame& frame) final;
+  void advance(size_t shift) final;
+
+private:
+  void open();
+
+  std::string m_filename;
+  std::vector<Frame> m_frames;
+  size_t m_current_frame = 0;
+  size_t m_n_frames = 0;
+  size_t m_n_atoms = 0;
+  int m_n_threads;
+
+  // streaming mode
+  bool m_streaming;
+  std::shared_ptr<const utils::FileContent> m_file;
+  std::optional<gro::GroBufferReader> m_reader;
+  std::vector<gro::GroBufferReader::Block> m_blocks;
+};
+
+} // namespace xmol::io
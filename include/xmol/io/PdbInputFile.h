@@ -1,8 +1,15 @@
 #pragma once
 #include "xmol/Frame.h"
+#include "xmol/io/pdb/PdbBufferReader.h"
 #include "xmol/trajectory/TrajectoryFile.h"
+#include <memory>
+#include <optional>
 #include <vector>
 
+namespace xmol::utils {
+class FileContent;
+}
+
 namespace xmol::io {
 
 class PdbReadError : public std::runtime_error {
@@ -10,7 +17,15 @@ public:
   using std::runtime_error::runtime_error;
 };
 
-/// PDB file
+/** PDB file
+ *
+ * File is read in one of two modes:
+ *  - all models are parsed on construction and available via @ref frames()
+ *  - (streaming) only model positions are recorded on construction, model coordinates are parsed
+ *    by @ref read_frame() when file is read as trajectory, so memory doesn't depend on number of models
+ *
+ * gzip and zstd compressed files are decompressed transparently, see @ref utils::FileContent
+ */
 class PdbInputFile : public trajectory::TrajectoryInputFile {
 public:
   /// PDB file dialect
@@ -19,7 +34,13 @@ public:
     AMBER_99     /// compatibility with AMBER tools
   };
 
-  explicit PdbInputFile(std::string filename, Dialect dialect = Dialect::STANDARD_V3, bool read_now=true);
+  /** @param read_now parse all models on construction, otherwise file is opened in streaming mode
+   *  @param n_threads number of threads to parse models of multi-model file,
+   *                    and to decompress file, non-positive value means all hardware threads */
+  explicit PdbInputFile(std::string filename, Dialect dialect = Dialect::STANDARD_V3, bool read_now = true,
+                        int n_threads = 0);
+
+  /// Parse all models
   PdbInputFile& read();
   [[nodiscard]] const std::vector<Frame>& frames() const { return m_frames; }
 
@@ -29,12 +50,21 @@ public:
   void advance(size_t shift) final;
 
 private:
+  void open();
+
   std::string m_filename;
   std::vector<Frame> m_frames;
   size_t m_current_frame=0;
   size_t m_n_frames=0;
   size_t m_n_atoms=0;
   Dialect m_dialect;
+  int m_n_threads;
+
+  // streaming mode
+  bool m_streaming;
+  std::shared_ptr<const utils::FileContent> m_file;
+  std::optional<pdb::PdbBufferReader> m_reader;
+  std::vector<pdb::PdbBufferReader::Model> m_models;
 };
 
 } // namespace xmol::io
\ No newline at end of file
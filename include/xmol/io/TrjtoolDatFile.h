@@ -1,10 +1,22 @@
 #pragma once
 #include "xmol/trajectory/TrajectoryFile.h"
-#include <fstream>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace xmol::utils {
+class FileContent;
+}
 
 namespace xmol::io {
 
-/// 3d MD coordinates in "trjtool .dat" format
+/** 3d MD coordinates in "trjtool .dat" format
+ *
+ * gzip and zstd compressed files are decompressed transparently, see @ref utils::FileContent.
+ * Header and number of frames are read in streaming pass which doesn't keep decompressed content,
+ * content is decompressed on traverse and released after last frame is read.
+ */
 class TrjtoolDatFile : public trajectory::TrajectoryInputFile {
   struct Header {
     int32_t nitems;
@@ -12,11 +24,6 @@ class TrjtoolDatFile : public trajectory::TrajectoryInputFile {
     int32_t dtype;
   };
 
-  union HeaderUnion {
-    Header header;
-    char bytes[sizeof(Header)];
-  };
-
 public:
   explicit TrjtoolDatFile(std::string filename);
   [[nodiscard]] size_t n_frames() const final;
@@ -26,13 +33,16 @@ public:
 
 private:
   std::string m_filename;
-  std::unique_ptr<std::istream> m_stream;
+  std::shared_ptr<const utils::FileContent> m_file;
   Header m_header;
   std::vector<float> m_buffer;
   size_t m_n_frames;
   size_t m_current_frame = 0;
-  std::streampos m_offset;
+  size_t m_offset;
 
   void read_header();
+
+  /// Parse header from the beginning of content, returns payload offset or nullopt if header is incomplete
+  static std::optional<size_t> parse_header(std::string_view content, Header& header);
 };
 } // namespace xmol::trajectory
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+#include "xmol/Frame.h"
+#include <array>
+#include <string_view>
+#include <vector>
+
+namespace xmol::io::cif {
+
+/** Reader of mmCIF (PDBx) content held in memory, e.g. memory-mapped file
+ *
+ * Only the first data block is read: atoms are taken from `_atom_site` loop, unit cell from `_cell` items,
+ * other categories are skipped. Values are tokenized in place, no temporary strings are created.
+ *
+ * Content is scanned once on construction to locate models (consecutive rows with same `pdbx_PDB_model_num`)
+ * and count their atoms, residues and chains, so frames are built into exactly preallocated storage.
+ *
+ * Author identifiers (`auth_*`) are preferred over `label_*` ones as in PDB files. New molecule starts
+ * whenever chain (`auth_asym_id`) or entity instance (`label_asym_id`) changes, so polymer, ligands and waters
+ * of same chain become separate molecules as with TER records of PDB files.
+ */
+class CifBufferReader {
+public:
+  explicit CifBufferReader(std::string_view buffer);
+
+  /// Byte range of `_atom_site` rows of model and sizes of model frame
+  struct Model {
+    size_t begin;
+    size_t end;
+    size_t n_atoms;
+    size_t n_residues;
+    size_t n_molecules;
+  };
+
+  /// Models in order of appearance
+  [[nodiscard]] const std::vector<Model>& models() const { return m_models; }
+
+  /** Read all frames (models)
+   *
+   * @param n_threads number of threads to read models concurrently, non-positive value means all hardware threads
+   */
+  [[nodiscard]] std::vector<Frame> read_frames(int n_threads = 0) const;
+
+  /// Read model as new frame
+  [[nodiscard]] Frame read_model(const Model& model) const;
+
+  /** Read coordinates and cell of model into @p frame of same topology
+   *
+   * Only number of atoms and atom names are checked against @p frame, mismatch results in CifReadError
+   */
+  void read_model_coords(const Model& model, Frame& frame) const;
+
+  /// `_atom_site` items used by reader
+  enum Item { ID, ATOM_NAME, RESIDUE_NAME, CHAIN, ENTITY_INSTANCE, RESIDUE_SERIAL, INSERTION_CODE, X, Y, Z, MODEL, N_ITEMS };
+
+  /// Value of data item, quoted values are never treated as null (`.` or `?`)
+  struct Token {
+    std::string_view text;
+    bool quoted = false;
+  };
+
+private:
+  /// Values of all columns of row, followed by empty value of absent items
+  using Row = std::vector<Token>;
+
+  class Tokenizer;
+
+  void read_atom_site_header(Tokenizer& tokenizer);
+  void scan_atom_site_rows(Tokenizer& tokenizer);
+  bool read_row(Tokenizer& tokenizer, Row& row) const;
+  [[nodiscard]] const Token& at(const Row& row, Item item) const { return row[m_column_of_item[item]]; }
+
+  [[nodiscard]] std::string_view name(const Token& token, size_t max_length, const char* what) const;
+  [[nodiscard]] int int_value(const Token& token, const char* what) const;
+  [[nodiscard]] double double_value(const Token& token, const char* what) const;
+  [[noreturn]] void throw_error(const char* position, const std::string& what) const;
+
+  std::string_view m_buffer;
+  geom::UnitCell m_cell = geom::UnitCell::unit_cubic_cell();
+  size_t m_n_columns = 0;
+  std::array<size_t, N_ITEMS> m_column_of_item{}; /// Column of item in `_atom_site` loop or m_n_columns if absent
+  std::vector<Model> m_models;
+};
+
+} // namespace xmol::io::cif
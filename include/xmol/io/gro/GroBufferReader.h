@@ -0,0 +1,65 @@
+#pragma once
+#include "xmol/Frame.h"
+#include <string_view>
+#include <vector>
+
+namespace xmol::io::gro {
+
+/** Reader of GROMACS `.gro` content held in memory, e.g. memory-mapped file
+ *
+ * Atom lines are parsed in place by fixed columns, width of coordinate columns is deduced from positions of
+ * decimal points of first atom line, so files of any precision are read. Velocities are ignored.
+ * Coordinates and box vectors are converted from nanometers to angstroms.
+ *
+ * Consecutive atoms with same residue number and name form a residue. Format has no chains:
+ * new unnamed molecule starts whenever residue number decreases (wrap from 99999 to 0 excluded).
+ */
+class GroBufferReader {
+public:
+  explicit GroBufferReader(std::string_view buffer);
+
+  /// Byte range of atom lines of frame, frame time (`t=` of title) and box
+  struct Block {
+    size_t begin;
+    size_t end;
+    size_t n_atoms;
+    double time;
+    geom::UnitCell cell;
+  };
+
+  /// Find all frames, atom lines are not parsed
+  [[nodiscard]] std::vector<Block> find_blocks() const;
+
+  /** Read all frames
+   *
+   * @param n_threads number of threads to read frames concurrently, non-positive value means all hardware threads
+   */
+  [[nodiscard]] std::vector<Frame> read_frames(int n_threads = 0) const;
+
+  /// Read block as new frame
+  [[nodiscard]] Frame read_block(const Block& block) const;
+
+  /** Read coordinates, time and cell of block into @p frame of same topology
+   *
+   * Only number of atoms and atom names are checked against @p frame, mismatch results in GroReadError
+   */
+  void read_block_coords(const Block& block, Frame& frame) const;
+
+private:
+  /// Columns of atom lines
+  struct Layout {
+    size_t coord_width;
+    size_t min_length;
+  };
+
+  [[nodiscard]] Layout layout_of(const Block& block) const;
+  [[nodiscard]] geom::UnitCell read_box(std::string_view line) const;
+  [[nodiscard]] std::string_view name_field(std::string_view line, size_t first, size_t max_length) const;
+  [[nodiscard]] int int_field(std::string_view line, size_t first) const;
+  [[nodiscard]] XYZ coords(std::string_view line, const Layout& layout) const;
+  [[noreturn]] void throw_error(std::string_view line, const std::string& what) const;
+
+  std::string_view m_buffer;
+};
+
+} // namespace xmol::io::gro
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "xmol/fwd.h"
+
+#include <fstream>
+#include <string>
+
+namespace xmol::io::gro {
+
+/** Writes frames in GROMACS `.gro` format
+ *
+ * Every frame is appended as next block, so several frames make multi-frame `.gro` trajectory.
+ * Coordinates and box are converted from angstroms to nanometers, coordinates are written with 3 decimals
+ * as by GROMACS tools, velocities are not written. Residue and atom numbers which don't fit into
+ * 5 columns are wrapped. Frame without box (unit cubic placeholder cell) is written with zero box.
+ */
+class GroWriter {
+public:
+  explicit GroWriter(const std::string& filename);
+  GroWriter(const GroWriter&) = delete;
+  GroWriter& operator=(const GroWriter&) = delete;
+
+  /** Write frame as next block, frame time is appended to @p title as `t= <time>`
+   *
+   * Frame is formatted in memory and written at once, file is left unchanged if GroWriteError is thrown */
+  void write(xmol::Frame& frame, const std::string& title = "Generated by xmolpp2");
+
+private:
+  void flush();
+
+  std::ofstream m_out;
+  std::string m_buffer;
+};
+
+} // namespace xmol::io::gro
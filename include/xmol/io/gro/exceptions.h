@@ -0,0 +1,16 @@
+#pragma once
+#include <stdexcept>
+
+namespace xmol::io::gro {
+
+class GroReadError : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+class GroWriteError : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "PdbLayout.h"
+#include "xmol/Frame.h"
+#include <string_view>
+
+namespace xmol::io::pdb {
+
+/** Reader of PDB content held in memory, e.g. memory-mapped file
+ *
+ * Lines are parsed in place, columns of all fields are resolved at construction, so no per-line lookups
+ * in records table and no temporary strings are needed. Atoms are added directly to preallocated frames.
+ *
+ * Only ATOM, HETATM, TER, MODEL, ENDMDL and CRYST1 records are interpreted, other records are skipped.
+ * Frames are split into chains and residues as by @ref PdbReader.
+ */
+class PdbBufferReader {
+public:
+  explicit PdbBufferReader(std::string_view buffer, const basic_PdbRecords& db = StandardPdbRecords::instance());
+
+  /** Read all frames (models)
+   *
+   * Model boundaries are found by a fast scan first, then models are parsed concurrently
+   *
+   * @param n_threads number of threads, non-positive value means all hardware threads
+   */
+  std::vector<Frame> read_frames(int n_threads = 0) const;
+
+  /// Byte range of model lines (excluding MODEL/ENDMDL records) and unit cell in effect for the model
+  struct Model {
+    size_t begin;
+    size_t end;
+    geom::UnitCell cell;
+  };
+
+  /// Find all models, model lines are not parsed
+  [[nodiscard]] std::vector<Model> find_models() const;
+
+  /// Read model as new frame
+  [[nodiscard]] Frame read_model(const Model& model) const;
+
+  /// Number of atoms in model
+  [[nodiscard]] size_t count_atoms(const Model& model) const;
+
+  /** Read coordinates and cell of model into @p frame of same topology
+   *
+   * Only number of atoms and atom names are checked against @p frame, mismatch results in PdbException
+   */
+  void read_model_coords(const Model& model, Frame& frame) const;
+
+private:
+  [[nodiscard]] geom::UnitCell read_cell(std::string_view line) const;
+  [[nodiscard]] std::string_view field(std::string_view line, const PdbColumns& columns) const;
+  [[nodiscard]] std::string_view name_field(std::string_view line, const PdbColumns& columns, size_t max_length) const;
+  [[nodiscard]] int int_field(std::string_view line, const PdbColumns& columns) const;
+  [[nodiscard]] double double_field(std::string_view line, const PdbColumns& columns) const;
+  [[noreturn]] void throw_field_error(std::string_view line, const std::string& what, const PdbColumns& columns) const;
+
+  std::string_view m_buffer;
+  PdbAtomRecordLayout m_atom;
+  PdbAtomRecordLayout m_hetatm;
+  PdbCellRecordLayout m_cell;
+};
+
+} // namespace xmol::io::pdb
@@ -0,0 +1,45 @@
+#pragma once
+#include "PdbRecord.h"
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace xmol::io::pdb {
+
+/// Zero-based position of record field in line
+struct PdbColumns {
+  PdbColumns() = default;
+  /// Convert one-based inclusive colons of @ref PdbRecordType
+  explicit PdbColumns(const PdbFieldColons& colons) : first(at(colons, 0) - 1), n(at(colons, 1) - at(colons, 0) + 1) {}
+
+  [[nodiscard]] size_t end() const { return first + n; }
+  [[nodiscard]] std::string_view of(std::string_view line) const { return line.substr(first, n); }
+
+  int first = 0;
+  int n = 0;
+
+private:
+  static int at(const PdbFieldColons& colons, size_t i) {
+    if (i >= colons.size()) {
+      throw std::out_of_range("PdbColumns: field has no colon #" + std::to_string(i));
+    }
+    return colons[i];
+  }
+};
+
+/// Columns of ATOM/HETATM record fields resolved once from records table
+struct PdbAtomRecordLayout {
+  explicit PdbAtomRecordLayout(const PdbRecordType& record);
+
+  PdbColumns serial, name, resName, chainID, resSeq, iCode, x, y, z;
+  size_t min_length; /// line must be at least that long to contain all fields
+};
+
+/// Columns of CRYST1 record fields resolved once from records table
+struct PdbCellRecordLayout {
+  explicit PdbCellRecordLayout(const PdbRecordType& record);
+
+  PdbColumns a, b, c, alpha, beta, gamma;
+};
+
+} // namespace xmol::io::pdb
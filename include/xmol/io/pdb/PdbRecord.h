@@ -1,21 +1,42 @@
 #pragma once
 
 #include "PdbRecord_fwd.h"
+#include "xmol/future/span.h"
 
 #include <map>
 #include <vector>
 
 namespace xmol::io::pdb {
 
+/// One-based inclusive colons of record field, repeated fields have several pairs of colons
+using PdbFieldColons = future::Span<const int>;
+
+/** Field layout of PDB record
+ *
+ * Record is a view of fields table owned by records database (see @ref basic_PdbRecords),
+ * fields are looked up by perfect hash of field name
+ */
 class PdbRecordType {
 public:
-  PdbRecordType() = default;
-  explicit PdbRecordType(std::map<FieldName, std::vector<int>>&& field_colons) : fieldColons(std::move(field_colons)){};
-  const std::vector<int>& getFieldColons(const FieldName& fieldName) const;
-  void set_field(const FieldName& fieldName, const std::vector<int>& colons);
+  struct Field {
+    FieldName name;
+    PdbFieldColons colons;
+  };
+
+  constexpr PdbRecordType() = default;
+
+  /// @param slots index of field for every slot of perfect hash table with given seed (see utils/perfect_hash.h)
+  constexpr PdbRecordType(future::Span<const Field> fields, future::Span<const uint8_t> slots, uint64_t seed, int bits)
+      : m_fields(fields), m_slots(slots), m_seed(seed), m_bits(bits) {}
+
+  PdbFieldColons getFieldColons(const FieldName& fieldName) const;
+  [[nodiscard]] future::Span<const Field> fields() const { return m_fields; }
 
 private:
-  std::map<FieldName, std::vector<int>> fieldColons;
+  future::Span<const Field> m_fields;
+  future::Span<const uint8_t> m_slots;
+  uint64_t m_seed = 0;
+  int m_bits = 1;
 };
 
 class basic_PdbRecords {
@@ -24,6 +45,7 @@ public:
   virtual ~basic_PdbRecords() = default;
 };
 
+/// Records of PDB v3.3 standard, compile-time table
 class StandardPdbRecords : public basic_PdbRecords {
 public:
   virtual const PdbRecordType&
@@ -31,10 +53,10 @@ public:
   static const basic_PdbRecords& instance();
 
 private:
-  StandardPdbRecords();
-  std::map<RecordName, PdbRecordType> recordTypes;
+  StandardPdbRecords() = default;
 };
 
+/// Layer of altered and extra records on top of other records database
 class AlteredPdbRecords : public basic_PdbRecords {
 public:
   explicit AlteredPdbRecords(const basic_PdbRecords& basic) : basic(&basic){};
@@ -45,12 +67,30 @@ public:
   void alter_record(RecordName, FieldName, std::vector<int> colons);
 
 private:
+  /// Record which owns its fields table
+  struct OwnedRecord {
+    explicit OwnedRecord(const PdbRecordType& record);
+    OwnedRecord(const OwnedRecord& other);
+    OwnedRecord& operator=(const OwnedRecord& other);
+
+    void set_field(const FieldName& fieldName, std::vector<int> colons);
+
+    std::map<FieldName, std::vector<int>> colons;
+    std::vector<PdbRecordType::Field> fields;
+    std::vector<uint8_t> slots;
+    PdbRecordType record;
+
+  private:
+    void update();
+  };
+
   const basic_PdbRecords* basic;
-  std::map<RecordName, PdbRecordType> recordTypes;
+  std::map<RecordName, OwnedRecord> recordTypes;
 };
 
 namespace detail {
-std::map<RecordName, PdbRecordType> get_bundled_records();
-};
+/// Bundled record of standard table, nullptr for unknown record
+const PdbRecordType* find_bundled_record(const RecordName& recordTypeName) noexcept;
+}
 
 } // namespace xmol::io::pdb
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "PdbLayout.h"
+#include "PdbWriter.h"
+#include "exceptions.h"
+#include "xmol/fwd.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace xmol::io {
+
+namespace pdb {
+
+/** Writes frames of trajectory as models of multi-model PDB file
+ *
+ * Atom records of first frame are formatted once and cached, for every frame only coordinate columns
+ * of cached lines are overwritten. Frames are expected to share topology (atom names, residues, etc)
+ * of the first frame, cached lines are rebuilt only if number of atoms changes.
+ *
+ * Every model is preceded by CRYST1 record (if enabled and frame has non-trivial cell),
+ * `END` record is written by @ref close() or on destruction.
+ */
+class PdbTrajectoryWriter {
+public:
+  explicit PdbTrajectoryWriter(const std::string& filename, bool write_cell = true,
+                               const basic_PdbRecords& db = StandardPdbRecords::instance());
+  PdbTrajectoryWriter(const PdbTrajectoryWriter&) = delete;
+  PdbTrajectoryWriter& operator=(const PdbTrajectoryWriter&) = delete;
+  /// Closes file, errors are ignored
+  ~PdbTrajectoryWriter();
+
+  /// Write frame as next model, throws PdbWriteError if file is closed
+  void write(xmol::Frame& frame);
+
+  /// Write `END` record and close file, no models may be written after. Subsequent calls have no effect
+  void close();
+
+  /// Number of written models
+  [[nodiscard]] size_t n_models() const { return m_n_models; }
+
+private:
+  void cache_atom_lines(xmol::Frame& frame);
+
+  std::ofstream m_out;
+  const basic_PdbRecords* m_db;
+  bool m_write_cell;
+  PdbAtomRecordLayout m_layout;
+  PdbColumns m_model_serial;
+  PdbWriter m_writer;
+  std::string m_lines; /// cached ATOM and TER records
+  std::vector<size_t> m_atom_lines; /// offsets of atom lines in @ref m_lines
+  size_t m_n_models = 0;
+};
+
+} // namespace pdb
+} // namespace xmol::io
@@ -1,16 +1,26 @@
 #pragma once
 
 #include "xmol/fwd.h"
+#include "xmol/geom/UnitCell.h"
 #include "PdbRecord_fwd.h"
 
 #include <iostream>
+#include <string>
 
 namespace xmol::io::pdb {
 
+/** Writer of frames and their parts as PDB records
+ *
+ * Columns of records are resolved once per write call, lines are formatted without printf/iostreams
+ * (locale independent) into internal buffer which is passed to the stream in large blocks.
+ * Every write call leaves the stream complete, i.e. buffer is flushed before return.
+ *
+ * Atom serial and residue number which do not fit into their columns are wrapped (taken modulo power of 10),
+ * names and coordinates which do not fit result in PdbWriteError (names are never truncated).
+ */
 class PdbWriter {
 public:
-  explicit PdbWriter(std::ostream& out) : m_old_locale(std::locale::global(std::locale::classic())), m_ostream(&out) {}
-  ~PdbWriter() { std::locale::global(m_old_locale); }
+  explicit PdbWriter(std::ostream& out) : m_ostream(&out) {}
 
   void write(xmol::Frame& frame);
   void write(xmol::proxy::MoleculeRef& chain);
@@ -30,9 +40,15 @@ public:
   void write(xmol::proxy::ResidueSpan& residueSelection, const basic_PdbRecords& db);
   void write(xmol::proxy::AtomSpan& atomSelection, const basic_PdbRecords& db);
 
+  /// Write CRYST1 record
+  void write(const xmol::geom::UnitCell& cell, const basic_PdbRecords& db);
+
 private:
-  std::locale m_old_locale;
+  void append_cell(const xmol::geom::UnitCell& cell, const basic_PdbRecords& db);
+  void flush();
+
   std::ostream* m_ostream;
+  std::string m_buffer; /// formatted lines not passed to stream yet
 };
 
-}
\ No newline at end of file
+} // namespace xmol::io::pdb
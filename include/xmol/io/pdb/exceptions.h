@@ -26,3 +26,13 @@ public:
 };
 
 }
+
+namespace xmol::io {
+
+/// Frame or its part can't be written as PDB records
+class PdbWriteError : public pdb::PdbException {
+public:
+  using pdb::PdbException::PdbException;
+};
+
+} // namespace xmol::io
@@ -0,0 +1,46 @@
+#pragma once
+#include "xmol/utils/MappedFile.h"
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace xmol::utils {
+
+/** Read-only content of whole file, transparently decompressed
+ *
+ * Compression is detected by magic bytes, not by file extension:
+ *  - plain file is memory-mapped, see @ref MappedFile
+ *  - gzip file (including multi-member) is inflated into memory;
+ *    BGZF files (`bgzip`) consist of independent blocks of known size which are inflated concurrently
+ *  - zstd file is decompressed into memory (only if library is built with zstd support);
+ *    frames of multi-frame files (`pzstd`, `zstd -T`) are decompressed concurrently if their sizes are known
+ */
+class FileContent {
+public:
+  /** Map or decompress file, throws std::runtime_error if file can't be read or decompressed
+   *  @param n_threads number of threads for concurrent decompression, non-positive value means all hardware threads */
+  explicit FileContent(const std::string& filename, int n_threads = 0);
+
+  /// Decompressed file content
+  [[nodiscard]] std::string_view view() const {
+    return m_mapped ? m_mapped->view() : std::string_view(m_decompressed);
+  }
+
+  /// True if file was decompressed
+  [[nodiscard]] bool compressed() const { return !m_mapped; }
+
+  /** Pass decompressed content of file to @p consumer chunk by chunk, content is not kept in memory
+   *
+   * Consumer returns false once it doesn't need more data. Rest of content is only counted then:
+   * sizes stored in BGZF blocks and zstd frame headers are summed up, otherwise content is decompressed
+   * to fixed-size scratch buffer. Throws std::runtime_error if file can't be read or decompressed
+   * @returns decompressed size of file */
+  static size_t stream(const std::string& filename, const std::function<bool(std::string_view)>& consumer);
+
+private:
+  std::optional<MappedFile> m_mapped;
+  std::string m_decompressed;
+};
+
+} // namespace xmol::utils
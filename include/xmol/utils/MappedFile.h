@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+namespace xmol::utils {
+
+/// Read-only memory mapping of whole file
+class MappedFile {
+public:
+  /// Map file, throws std::runtime_error if file can't be opened or mapped
+  explicit MappedFile(const std::string& filename);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  ~MappedFile();
+
+  /// File content
+  [[nodiscard]] std::string_view view() const { return {m_data, m_size}; }
+
+private:
+  const char* m_data = nullptr;
+  size_t m_size = 0;
+};
+
+} // namespace xmol::utils
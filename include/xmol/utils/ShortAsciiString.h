@@ -20,7 +20,7 @@ public:
       uint64_t>::type;
   static const int max_length = MAX_LENGTH;
 
-  inline ShortAsciiString() : m_value(0){};
+  constexpr inline ShortAsciiString() : m_value(0){};
 
   explicit ShortAsciiString(const std::string& aName)
       : m_value(to_uint(aName.c_str())) {}
@@ -46,18 +46,18 @@ public:
   inline explicit ShortAsciiString(const char* aName, int exact_length)
       : m_value(to_uint(aName, exact_length)) {}
 
-  inline ShortAsciiString(const ShortAsciiString& other)
+  constexpr inline ShortAsciiString(const ShortAsciiString& other)
       : m_value(other.m_value){};
-  inline ShortAsciiString(ShortAsciiString&& other) noexcept
+  constexpr inline ShortAsciiString(ShortAsciiString&& other) noexcept
       : m_value(other.m_value) {
     other.m_value = 0;
   };
 
-  inline ShortAsciiString& operator=(const ShortAsciiString& other) {
+  constexpr inline ShortAsciiString& operator=(const ShortAsciiString& other) {
     m_value = other.m_value;
     return *this;
   }
-  inline ShortAsciiString& operator=(ShortAsciiString&& other) noexcept {
+  constexpr inline ShortAsciiString& operator=(ShortAsciiString&& other) noexcept {
     m_value = other.m_value;
     other.m_value = 0;
     return *this;
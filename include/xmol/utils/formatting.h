@@ -0,0 +1,99 @@
+#pragma once
+
+#include "parsing.h"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace xmol::utils {
+
+/// Write integer right-aligned into fixed-width field padded with spaces, e.g. `"  -12"`
+///
+/// Field is not null-terminated. Returns false and leaves field intact if number doesn't fit.
+inline bool format_int_field(char* field, int width, long long value) noexcept {
+  char digits[24];
+  int n = 0;
+  unsigned long long magnitude = value < 0 ? 0ull - static_cast<unsigned long long>(value) : value;
+  do {
+    digits[n++] = char('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude);
+  if (value < 0) {
+    digits[n++] = '-';
+  }
+  if (GSL_UNLIKELY(n > width)) {
+    return false;
+  }
+  std::memset(field, ' ', width - n);
+  for (int i = 0; i < n; ++i) {
+    field[width - 1 - i] = digits[i];
+  }
+  return true;
+}
+
+/// Same as @ref format_int_field, but number which doesn't fit is wrapped: only least significant digits are kept
+inline void format_wrapped_int_field(char* field, int width, long long value) noexcept {
+  if (format_int_field(field, width, value)) {
+    return;
+  }
+  long long limit = 1;
+  for (int i = value < 0 ? 1 : 0; i < width && limit < 1'000'000'000'000'000'000LL; ++i) {
+    limit *= 10;
+  }
+  format_int_field(field, width, value % limit);
+}
+
+/// Write fixed point number right-aligned into fixed-width field padded with spaces, e.g. `" -12.345"`
+///
+/// Same output as `printf("%*.*f")`. Digits are produced from integer arithmetic, numbers which are too close
+/// to a rounding boundary to decide it from scaled double (including exact ties) are written by `snprintf`.
+/// Field is not null-terminated. Returns false and leaves field intact if number doesn't fit or is not finite.
+inline bool format_fixed_point_field(char* field, int width, int precision, double value) noexcept {
+  assert(0 <= precision && precision <= 9);
+  const double scaled = std::fabs(value) * powers_of_10[precision];
+  if (GSL_UNLIKELY(!(scaled < 1e18))) {
+    return false;
+  }
+  // `scaled` differs from exact decimal value by at most half ulp, only fraction close to 0.5 may round wrong
+  const double floor = std::floor(scaled);
+  const double fraction = scaled - floor;
+  if (GSL_UNLIKELY(scaled >= 0x1p52 || std::fabs(fraction - 0.5) <= scaled * 0x1p-52)) {
+    char buffer[48];
+    const int n = std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+    if (n <= 0 || n > width) {
+      return false;
+    }
+    std::memset(field, ' ', width - n);
+    std::memcpy(field + width - n, buffer, n);
+    return true;
+  }
+  unsigned long long magnitude = static_cast<unsigned long long>(floor) + (fraction > 0.5 ? 1 : 0);
+  const bool negative = std::signbit(value);
+  char digits[32];
+  int n = 0;
+  for (int i = 0; i < precision; ++i) {
+    digits[n++] = char('0' + magnitude % 10);
+    magnitude /= 10;
+  }
+  if (precision > 0) {
+    digits[n++] = '.';
+  }
+  do {
+    digits[n++] = char('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude);
+  if (negative) {
+    digits[n++] = '-';
+  }
+  if (GSL_UNLIKELY(n > width)) {
+    return false;
+  }
+  std::memset(field, ' ', width - n);
+  for (int i = 0; i < n; ++i) {
+    field[width - 1 - i] = digits[i];
+  }
+  return true;
+}
+
+} // namespace xmol::utils
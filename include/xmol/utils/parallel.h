@@ -0,0 +1,59 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace xmol::utils {
+
+/// Number of worker threads to use, non-positive @p n_threads means all hardware threads
+inline int resolve_n_threads(int n_threads) {
+  if (n_threads > 0) {
+    return n_threads;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/** Call `f(task, worker)` for every task in [0, n_tasks) on a pool of worker threads
+ *
+ * Tasks are claimed dynamically in increasing order, `worker` is in [0, number of workers) and may be used
+ * to address per-thread scratch space. First exception thrown by `f` is rethrown after all workers stop.
+ */
+template <typename Function> void parallel_for(size_t n_tasks, int n_threads, Function&& f) {
+  const int n_workers = std::max(1, std::min<int>(resolve_n_threads(n_threads), n_tasks));
+  if (n_workers == 1) {
+    for (size_t task = 0; task < n_tasks; ++task) {
+      f(task, 0);
+    }
+    return;
+  }
+  std::atomic<size_t> next_task{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+  auto worker = [&](int worker_id) {
+    try {
+      for (size_t task = next_task++; task < n_tasks && !failed; task = next_task++) {
+        f(task, worker_id);
+      }
+    } catch (...) {
+      if (!failed.exchange(true)) {
+        error = std::current_exception();
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(n_workers - 1);
+  for (int i = 1; i < n_workers; ++i) {
+    threads.emplace_back(worker, i);
+  }
+  worker(0);
+  for (auto& t : threads) {
+    t.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace xmol::utils
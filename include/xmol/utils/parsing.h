@@ -3,6 +3,7 @@
 #include <cstring>
 #include <gsl/gsl_assert>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -151,4 +152,69 @@ constexpr parse_fixed_precision_fn___ parse_fixed_precision{};
 }
 
 std::pair<bool, double> parse_fixed_precision_rt(const std::string& line, int pos, int width) noexcept;
+
+/// Strip spaces from both ends of @p field
+inline std::string_view trim_field(std::string_view field) noexcept {
+  while (!field.empty() && field.front() == ' ') {
+    field.remove_prefix(1);
+  }
+  while (!field.empty() && field.back() == ' ') {
+    field.remove_suffix(1);
+  }
+  return field;
+}
+
+/// Parse integer from field padded with spaces, e.g. `"  -12 "`
+inline std::pair<bool, int> parse_int_field(std::string_view field) noexcept {
+  field = trim_field(field);
+  int sign = 1;
+  if (!field.empty() && field[0] == '-') {
+    sign = -1;
+    field.remove_prefix(1);
+  }
+  if (GSL_UNLIKELY(field.empty() || field.size() > 9)) {
+    return {false, 0};
+  }
+  bool success = true;
+  int number = 0;
+  for (char c : field) {
+    unsigned digit = static_cast<unsigned>(c) - '0';
+    success &= digit <= 9;
+    number = number * 10 + digit;
+  }
+  return {success, sign * number};
+}
+
+/// Parse fixed point number from field padded with spaces, e.g. `" -12.345"`
+///
+/// Uses same arithmetic as @ref parse_fixed_precision_rt, so both give identical values.
+/// Like it, requires digits on both sides of decimal point (`"12."` and `".5"` are rejected)
+inline std::pair<bool, double> parse_fixed_point_field(std::string_view field) noexcept {
+  field = trim_field(field);
+  int sign = 1;
+  if (!field.empty() && field[0] == '-') {
+    sign = -1;
+    field.remove_prefix(1);
+  }
+  const size_t point = field.find('.');
+  if (GSL_UNLIKELY(point == std::string_view::npos || point == 0 || point > 9 || field.size() - point > 10 ||
+                   point + 1 == field.size())) {
+    return {false, 0};
+  }
+  const size_t precision = field.size() - point - 1;
+  bool success = true;
+  int whole_part = 0;
+  for (size_t i = 0; i < point; ++i) {
+    unsigned digit = static_cast<unsigned>(field[i]) - '0';
+    success &= digit <= 9;
+    whole_part = whole_part * 10 + digit;
+  }
+  int fraction_part = 0;
+  for (size_t i = point + 1; i < field.size(); ++i) {
+    unsigned digit = static_cast<unsigned>(field[i]) - '0';
+    success &= digit <= 9;
+    fraction_part = fraction_part * 10 + digit;
+  }
+  return {success, sign * (whole_part + double(fraction_part) / powers_of_10[precision])};
+}
 }
\ No newline at end of file
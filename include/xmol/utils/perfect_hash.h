@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace xmol::utils {
+
+/// Marks empty slot of @ref find_perfect_hash_seed table
+constexpr uint8_t perfect_hash_empty_slot = 0xFF;
+
+/// Slot of key in table of `2^bits` slots
+constexpr size_t perfect_hash_slot(uint64_t key, uint64_t seed, int bits) noexcept {
+  uint64_t x = key + seed * 0x9E3779B97F4A7C15ull; // splitmix64 finalizer
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  x = x ^ (x >> 31);
+  return x >> (64 - bits);
+}
+
+/// Smallest number of bits of table for @p n keys, table is kept sparse to find seed in few attempts
+constexpr int perfect_hash_bits(size_t n) noexcept {
+  int bits = 1;
+  while ((size_t(1) << bits) < 4 * n) {
+    ++bits;
+  }
+  return bits;
+}
+
+/** Fill table of `2^bits` slots with indices of keys mapped by @p seed
+ *
+ * @param keys distinct keys, at most 254
+ * @param slots table of `2^bits` slots, on return holds index of key mapped to slot or @ref perfect_hash_empty_slot
+ * @returns false if two keys are mapped to same slot
+ */
+constexpr bool fill_perfect_hash_slots(const uint64_t* keys, size_t n, uint8_t* slots, int bits, uint64_t seed) {
+  if (n >= perfect_hash_empty_slot) {
+    throw std::invalid_argument("fill_perfect_hash_slots: too many keys");
+  }
+  const size_t n_slots = size_t(1) << bits;
+  for (size_t i = 0; i < n_slots; ++i) {
+    slots[i] = perfect_hash_empty_slot;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    auto& slot = slots[perfect_hash_slot(keys[i], seed, bits)];
+    if (slot != perfect_hash_empty_slot) {
+      return false;
+    }
+    slot = uint8_t(i);
+  }
+  return true;
+}
+
+/** Find seed which maps distinct keys to distinct slots
+ *
+ * Tables of constant keys should be built from precomputed seeds with @ref fill_perfect_hash_slots
+ * rather than searched at compile time, the search may exceed constexpr evaluation limits.
+ *
+ * @param keys distinct keys, at most 254
+ * @param slots table of `2^bits` slots, on return holds index of key mapped to slot or @ref perfect_hash_empty_slot
+ * @returns seed for @ref perfect_hash_slot
+ */
+constexpr uint64_t find_perfect_hash_seed(const uint64_t* keys, size_t n, uint8_t* slots, int bits) {
+  for (uint64_t seed = 0; seed < (1u << 20); ++seed) {
+    if (fill_perfect_hash_slots(keys, n, slots, bits, seed)) {
+      return seed;
+    }
+  }
+  throw std::invalid_argument("find_perfect_hash_seed: no seed found, keys are not distinct?");
+}
+
+} // namespace xmol::utils
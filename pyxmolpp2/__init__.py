@@ -7,26 +7,45 @@ from ._core import *
 
 __all__ = [
     'AmberNetCDF',
+    'AmberNetCDFWriteError',
+    'AmberNetCDFWriter',
     'AngleValue',
     'Atom',
     'AtomPredicate',
     'AtomSelection',
     'AtomSpan',
+    'AutoCorrelationMode',
+    'CachedRmsdMatrix',
+    'CifFile',
+    'CifReadError',
+    'Clustering',
+    'ConformationSetter',
     'CoordSelection',
     'CoordSelectionSizeMismatchError',
     'CoordSpan',
+    'CoordStatistics',
     'DeadFrameAccessError',
     'DeadObserverAccessError',
     'Degrees',
     'Frame',
     'GeomError',
+    'GroReadError',
+    'GroWriteError',
+    'GroWriter',
+    'GromacsGroFile',
     'GromacsXtcFile',
+    'Linkage',
     'Molecule',
     'MoleculePredicate',
     'MoleculeSelection',
     'MoleculeSpan',
+    'MultiTauCorrelator',
     'MultipleFramesSelectionError',
+    'NeighbourList',
     'PdbFile',
+    'PdbTrajectoryWriter',
+    'PdbWriteError',
+    'PrincipalComponents',
     'Radians',
     'Residue',
     'ResidueId',
@@ -34,9 +53,12 @@ __all__ = [
     'ResidueSelection',
     'ResidueSpan',
     'Rotation',
+    'SasaCalculator',
+    'SasaMethod',
     'SpanSplitError',
     'TorsionAngle',
     'TorsionAngleFactory',
+    'TorsionTable',
     'Trajectory',
     'TrajectoryDoubleTraverseError',
     'TrajectoryInputFile',
@@ -54,10 +76,17 @@ __all__ = [
     'calc_alignment',
     'calc_autocorr_order_2',
     'calc_autocorr_order_2_PRE',
+    'calc_fitted_rmsd',
     'calc_inertia_tensor',
+    'calc_linkage',
+    'calc_pairwise_fitted_rmsd',
     'calc_rmsd',
     'calc_sasa',
     'degrees_to_radians',
+    'extract_bond_vectors',
+    'gromos_clustering',
+    'hierarchical_clustering',
+    'k_medoids_clustering',
     'mName',
     'rId',
     'rName',
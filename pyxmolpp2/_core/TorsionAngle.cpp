@@ -1,13 +1,31 @@
 #include "TorsionAngle.h"
+#include "xmol/ConformationSetter.h"
 #include "xmol/ProteinTorsionAngleFactory.h"
 #include "xmol/TorsionAngle.h"
+#include "xmol/TorsionTable.h"
 #include "xmol/proxy/smart/selections.h"
 
 #include "pybind11/functional.h"
+#include "pybind11/numpy.h"
 #include "pybind11/stl.h"
 
 namespace py = pybind11;
 
+namespace {
+
+std::vector<xmol::TorsionAngleName> to_angle_names(const std::optional<std::vector<std::string>>& names) {
+  if (!names) {
+    return xmol::TorsionTable::protein_angles();
+  }
+  std::vector<xmol::TorsionAngleName> result;
+  for (auto& name : *names) {
+    result.emplace_back(name);
+  }
+  return result;
+}
+
+} // namespace
+
 void pyxmolpp::v1::init_TorsionAngle(pybind11::module& polymer) {
   using namespace xmol;
   using namespace xmol::proxy::smart;
@@ -40,6 +58,84 @@ Precondition:
 
 Note that this is O(N) operation where N is number of affected atoms
 )pydoc");
+  py::class_<ConformationSetter>(polymer, "ConformationSetter", "Batched setter of torsion angles of single frame")
+      .def(py::init<const std::vector<TorsionAngle>&>(), py::arg("angles"),
+           R"pydoc(Resolve atoms and affected atoms of angles once
+
+:param angles: read-write angles ordered from chain start to end (omega, phi, psi, chi1, ... residue by residue)
+)pydoc")
+      .def("__len__", &ConformationSetter::size)
+      .def("values", &ConformationSetter::values, "Current angle values")
+      .def("set", &ConformationSetter::set, py::arg("values"),
+           py::arg_v("noop_tolerance", xmol::geom::AngleValue(xmol::geom::Degrees(0.01)), "Degrees(0.01)"),
+           R"pydoc(Set all angles in single sweep over atoms
+
+Result matches consecutive :ref:`TorsionAngle.rotate_to` calls in same order
+
+:param values: new values, one per angle
+:param noop_tolerance: no-op tolerance to skip negligible rotations
+)pydoc");
+  py::class_<TorsionTable>(polymer, "TorsionTable", "Precompiled set of torsion angles of residues")
+      .def(py::init([](ResidueSmartSpan& residues, std::optional<std::vector<std::string>>& names) {
+             return TorsionTable(residues, to_angle_names(names));
+           }),
+           py::arg("residues"), py::arg("names") = std::nullopt)
+      .def(py::init([](ResidueSmartSelection& residues, std::optional<std::vector<std::string>>& names) {
+             return TorsionTable(residues, to_angle_names(names));
+           }),
+           py::arg("residues"), py::arg("names") = std::nullopt,
+           R"pydoc(Resolve angles of residues, angles with missing atoms are skipped
+
+:param residues: residues of single frame
+:param names: angle names, by default ``phi``, ``psi``, ``omega``, ``chi1``, ..., ``chi5``
+)pydoc")
+      .def("__len__", &TorsionTable::size)
+      .def_property_readonly(
+          "names",
+          [](TorsionTable& self) {
+            std::vector<std::string> result;
+            for (auto& name : self.names()) {
+              result.push_back(name.str());
+            }
+            return result;
+          },
+          "Angle names in table order")
+      .def_property_readonly(
+          "residue_indices",
+          [](TorsionTable& self) {
+            auto& indices = self.residue_indices();
+            return py::array_t<ResidueIndex>(indices.size(), indices.data());
+          },
+          "Residue index of each angle")
+      .def_property_readonly(
+          "atom_indices",
+          [](TorsionTable& self) {
+            auto& indices = self.atom_indices();
+            py::array_t<AtomIndex> result({indices.size(), size_t(4)});
+            std::copy_n(reinterpret_cast<const AtomIndex*>(indices.data()), 4 * indices.size(), result.mutable_data());
+            return result;
+          },
+          "Atom indices of each angle, shape ``(len(self), 4)``")
+      .def(
+          "calc",
+          [](TorsionTable& self, py::array_t<double, py::array::c_style | py::array::forcecast>& coords) {
+            if (coords.ndim() != 2 || coords.shape(1) != 3) {
+              throw py::type_error("coords.shape!=[N,3]");
+            }
+            py::array_t<double> result(self.size());
+            self.calc(future::Span<XYZ>(reinterpret_cast<XYZ*>(coords.mutable_data()), coords.shape(0)),
+                      future::Span<double>(result.mutable_data(), result.size()));
+            return result;
+          },
+          py::arg("coords"), "Values of all angles in radians for frame coordinates")
+      .def(
+          "calc",
+          [](TorsionTable& self, trajectory::Trajectory::Slice& slice) {
+            py::array_t<double> result({slice.size(), self.size()});
+            self.calc(slice, future::Span<double>(result.mutable_data(), result.size()));
+            return result;
+          },
+          py::arg("frames"), "Values of all angles in radians, shape ``(n_frames, len(self))``");
   py::class_<TorsionAngleFactory>(polymer, "TorsionAngleFactory", "Generates torsion angles for standard residues")
       .def_static(
           "get", [](ResidueSmartRef& r, const char* name) { return TorsionAngleFactory::get(r, TorsionAngleName(name)); },
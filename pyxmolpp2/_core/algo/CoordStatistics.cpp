@@ -0,0 +1,59 @@
+#include "algo.h"
+#include "xmol/algo/CoordStatistics.h"
+#include "xmol/proxy/smart/spans.h"
+#include "xmol/proxy/smart/selections.h"
+
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+using namespace xmol;
+using namespace xmol::algo;
+using namespace xmol::proxy::smart;
+namespace py = pybind11;
+
+void pyxmolpp::v1::define_coord_statistics(pybind11::module& m) {
+  py::class_<CoordStatistics>(m, "CoordStatistics", "One-pass mean structure, RMSF and covariance of aligned frames")
+      .def(py::init<size_t, bool>(), py::arg("n_atoms"), py::arg("covariance") = false,
+           R"pydoc(Constructor
+
+    :param n_atoms: number of atoms per frame
+    :param covariance: accumulate ``(3 * n_atoms, 3 * n_atoms)`` covariance matrix
+)pydoc")
+      .def(
+          "update",
+          [](CoordStatistics& self, py::array_t<double, py::array::c_style | py::array::forcecast>& coords) {
+            if (coords.ndim() != 2 || coords.shape(1) != 3) {
+              throw py::type_error("coords.shape!=[N,3]");
+            }
+            self.update(future::Span<XYZ>(reinterpret_cast<XYZ*>(coords.mutable_data()), coords.shape(0)));
+          },
+          py::arg("coords"), "Add frame coordinates")
+      .def(
+          "update", [](CoordStatistics& self, CoordSmartSpan& coords) { self.update(coords); }, py::arg("coords"),
+          "Add frame coordinates")
+      .def(
+          "update", [](CoordStatistics& self, CoordSmartSelection& coords) { self.update(coords); },
+          py::arg("coords"), "Add frame coordinates")
+      .def("merge", &CoordStatistics::merge, py::arg("other"), "Add statistics of other frames")
+      .def_property_readonly("n_atoms", &CoordStatistics::n_atoms, "Number of atoms per frame")
+      .def_property_readonly("n_frames", &CoordStatistics::n_frames, "Number of added frames")
+      .def_property_readonly(
+          "mean",
+          [](CoordStatistics& self) {
+            auto mean = self.mean();
+            py::array_t<double> result({mean.size(), size_t(3)});
+            std::copy_n(reinterpret_cast<const double*>(mean.data()), 3 * mean.size(), result.mutable_data());
+            return result;
+          },
+          "Mean coordinates, shape ``(n_atoms, 3)``")
+      .def_property_readonly(
+          "rmsf",
+          [](CoordStatistics& self) {
+            auto rmsf = self.rmsf();
+            return py::array_t<double>(rmsf.size(), rmsf.data());
+          },
+          "Root mean square fluctuation of each atom")
+      .def("covariance", &CoordStatistics::covariance,
+           "Population covariance of coordinates in ``x1, y1, z1, x2, ...`` order");
+}
@@ -0,0 +1,59 @@
+#include "algo.h"
+#include "xmol/algo/MultiTauCorrelator.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+using namespace xmol;
+using namespace xmol::algo;
+namespace py = pybind11;
+
+void pyxmolpp::v1::define_multi_tau_correlator(pybind11::module& m) {
+  py::enum_<AutoCorrelationMode>(m, "AutoCorrelationMode", "Normalization of vector autocorrelation")
+      .value("NORMALIZE_VECTORS", AutoCorrelationMode::NORMALIZE_VECTORS,
+             "Correlation of unit vectors, same as :ref:`calc_autocorr_order_2`")
+      .value("NORMALIZE_AND_DIVIDE_BY_CUBE", AutoCorrelationMode::NORMALIZE_AND_DIVIDE_BY_CUBE,
+             "Unit vectors divided by cube of vector length, same as :ref:`calc_autocorr_order_2_PRE`");
+
+  py::class_<MultiTauCorrelator>(m, "MultiTauCorrelator",
+                                 "Streaming order 2 autocorrelation of many vectors by multi-tau scheme")
+      .def(py::init<size_t, AutoCorrelationMode, size_t, size_t>(), py::arg("n_vectors"),
+           py::arg("mode") = AutoCorrelationMode::NORMALIZE_VECTORS, py::arg("points_per_level") = 16,
+           py::arg("averaging") = 2,
+           R"pydoc(Constructor
+
+    :param n_vectors: number of vectors in each frame
+    :param mode: normalization mode
+    :param points_per_level: number of lags per level, must be multiple of ``averaging``
+    :param averaging: number of values averaged on transition to next level
+)pydoc")
+      .def(
+          "update",
+          [](MultiTauCorrelator& self, py::array_t<double, py::array::c_style | py::array::forcecast>& vectors) {
+            if (vectors.ndim() != 2 || vectors.shape(1) != 3) {
+              throw py::type_error("vectors.shape!=[N,3]");
+            }
+            future::Span<XYZ> xyz_span(reinterpret_cast<XYZ*>(vectors.mutable_data()), vectors.shape(0));
+            self.update(xyz_span);
+          },
+          py::arg("vectors"), "Add next frame")
+      .def("reset", &MultiTauCorrelator::reset, "Forget all added frames")
+      .def_property_readonly(
+          "lags",
+          [](MultiTauCorrelator& self) {
+            auto lags = self.lags();
+            return py::array_t<size_t>(lags.size(), lags.data());
+          },
+          "Lags (in frames) of available correlation values")
+      .def(
+          "correlation",
+          [](MultiTauCorrelator& self) {
+            auto values = self.correlation();
+            py::array_t<double> result({self.n_vectors(), values.size() / std::max<size_t>(1, self.n_vectors())});
+            std::copy(values.begin(), values.end(), result.mutable_data());
+            return result;
+          },
+          "Correlation values of shape ``(n_vectors, len(lags))``")
+      .def_property_readonly("n_vectors", &MultiTauCorrelator::n_vectors, "Number of vectors in each frame")
+      .def_property_readonly("n_frames", &MultiTauCorrelator::n_frames, "Number of added frames");
+}
@@ -0,0 +1,77 @@
+#include "algo.h"
+#include "xmol/algo/PrincipalComponents.h"
+
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+using namespace xmol;
+using namespace xmol::algo;
+namespace py = pybind11;
+
+void pyxmolpp::v1::define_principal_components(pybind11::module& m) {
+  py::class_<PrincipalComponents>(m, "PrincipalComponents", "Principal components of atomic fluctuations")
+      .def(py::init([](const CoordStatistics& statistics, size_t n_components,
+                       std::optional<py::array_t<double, py::array::c_style | py::array::forcecast>> masses) {
+             future::Span<const double> masses_span;
+             if (masses) {
+               masses_span = future::Span<const double>(masses->data(), masses->size());
+             }
+             py::gil_scoped_release release;
+             return std::make_unique<PrincipalComponents>(statistics, n_components, masses_span);
+           }),
+           py::arg("statistics"), py::arg("n_components"), py::arg("masses") = std::nullopt,
+           R"pydoc(Constructor
+
+    :param statistics: statistics of aligned frames accumulated with ``covariance=True``
+    :param n_components: number of modes with largest variance to keep
+    :param masses: atom masses for mass-weighted analysis
+)pydoc")
+      .def_property_readonly("n_atoms", &PrincipalComponents::n_atoms, "Number of atoms")
+      .def_property_readonly("n_components", &PrincipalComponents::n_components, "Number of modes")
+      .def_property_readonly("eigenvalues", &PrincipalComponents::eigenvalues, "Variance along each mode")
+      .def_property_readonly("modes", &PrincipalComponents::modes,
+                             "Modes as columns of ``(3 * n_atoms, n_components)`` matrix")
+      .def_property_readonly("total_variance", &PrincipalComponents::total_variance, "Sum of variances of all modes")
+      .def(
+          "project",
+          [](PrincipalComponents& self, py::array_t<double, py::array::c_style | py::array::forcecast>& frames,
+             int n_threads) {
+            if (frames.ndim() != 3 || frames.shape(2) != 3) {
+              throw py::type_error("frames.shape!=[N_frames,N_atoms,3]");
+            }
+            const size_t n_frames = frames.shape(0);
+            py::array_t<double> result({n_frames, self.n_components()});
+            future::Span<XYZ> frames_span(reinterpret_cast<XYZ*>(frames.mutable_data()), n_frames * frames.shape(1));
+            future::Span<double> result_span(result.mutable_data(), result.size());
+            py::gil_scoped_release release;
+            self.project(frames_span, result_span, n_threads);
+            return result;
+          },
+          py::arg("frames"), py::arg("n_threads") = 0,
+          R"pydoc(Project frames on modes, returns array of shape ``(n_frames, n_components)``
+
+    Frames must be aligned same way as frames of statistics, otherwise rigid body motion leaks into projections.
+
+    :param frames: coordinates, shape ``(n_frames, n_atoms, 3)``
+    :param n_threads: number of threads, non-positive value means all hardware threads
+)pydoc")
+      .def(
+          "project",
+          [](PrincipalComponents& self, trajectory::Trajectory::Slice& slice, std::vector<AtomIndex>& indices,
+             int n_threads, bool align) {
+            py::array_t<double> result({slice.size(), self.n_components()});
+            future::Span<double> result_span(result.mutable_data(), result.size());
+            self.project(slice, indices, result_span, n_threads, align);
+            return result;
+          },
+          py::arg("frames"), py::arg("indices"), py::arg("n_threads") = 0, py::arg("align") = true,
+          R"pydoc(Project trajectory frames on modes, returns array of shape ``(n_frames, n_components)``
+
+    :param frames: trajectory slice
+    :param indices: indices of analysed atoms
+    :param n_threads: number of threads, non-positive value means all hardware threads
+    :param align: superimpose analysed atoms of each frame onto mean structure before projection,
+                  frames are not modified
+)pydoc");
+}
@@ -0,0 +1,72 @@
+#include "algo.h"
+#include "xmol/Frame.h"
+#include "xmol/algo/SasaCalculator.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+using namespace xmol;
+using namespace xmol::algo;
+namespace py = pybind11;
+
+namespace {
+
+py::array_t<double> to_array(const future::Span<const double>& values) {
+  return py::array_t<double>(values.size(), values.data());
+}
+
+} // namespace
+
+void pyxmolpp::v1::define_sasa_calculator(pybind11::module& m) {
+  py::class_<SasaCalculator>(m, "SasaCalculator", "Per-atom SASA of consecutive frames with reuse of unchanged atoms")
+      .def(py::init([](double solvent_radius, double skin, double tolerance, SasaMethod method,
+                       std::optional<int> n_samples, int n_threads) {
+             const int default_n_samples = method == SasaMethod::LEE_RICHARDS ? 20 : 100;
+             return std::make_unique<SasaCalculator>(solvent_radius, skin, tolerance, method,
+                                                     n_samples.value_or(default_n_samples), n_threads);
+           }),
+           py::arg("solvent_radius"), py::arg("skin") = 1.0, py::arg("tolerance") = 0.0,
+           py::arg("method") = SasaMethod::LEE_RICHARDS, py::arg("n_samples") = std::nullopt, py::arg("n_threads") = 0,
+           R"pydoc(Constructor
+
+    :param solvent_radius: solvent probe radius
+    :param skin: neighbour list skin
+    :param tolerance: atom displacement which doesn't trigger recalculation of its and its neighbours areas
+    :param method: calculation method
+    :param n_samples: slices (Lee-Richards, default 20) or test points (Shrake-Rupley, default 100) per atom
+    :param n_threads: number of threads, non-positive value means all hardware threads
+)pydoc")
+      .def(
+          "update",
+          [](SasaCalculator& self, Frame& frame) {
+            future::Span<const double> result;
+            {
+              py::gil_scoped_release release;
+              result = self.update(frame);
+            }
+            return to_array(result);
+          },
+          py::arg("frame"), "Update per-atom areas for new frame, radii are taken from :ref:`Atom.vdw_radius`")
+      .def(
+          "update",
+          [](SasaCalculator& self, py::array_t<double, py::array::c_style | py::array::forcecast>& coords,
+             py::array_t<double, py::array::c_style | py::array::forcecast>& radii) {
+            if (coords.ndim() != 2 || coords.shape(1) != 3) {
+              throw py::type_error("coords.shape!=[N,3]");
+            }
+            future::Span<XYZ> coord_span(reinterpret_cast<XYZ*>(coords.mutable_data()), coords.shape(0));
+            future::Span<double> radii_span(radii.mutable_data(), radii.size());
+            future::Span<const double> result;
+            {
+              py::gil_scoped_release release;
+              result = self.update(coord_span, radii_span);
+            }
+            return to_array(result);
+          },
+          py::arg("coords"), py::arg("radii"), "Update per-atom areas for new coordinates")
+      .def("reset", &SasaCalculator::reset, "Forget all cached areas")
+      .def_property_readonly(
+          "sasa", [](SasaCalculator& self) { return to_array(self.sasa()); }, "Per-atom areas of last update")
+      .def_property_readonly("n_updated_atoms", &SasaCalculator::n_updated_atoms,
+                             "Number of atoms recalculated at last update");
+}
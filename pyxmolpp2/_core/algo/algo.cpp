@@ -1,9 +1,12 @@
 #include "algo.h"
 #include "xmol/algo/alignment-impl.h"
 #include "xmol/algo/alignment.h"
+#include "xmol/algo/bond-vectors.h"
+#include "xmol/algo/pairwise-rmsd.h"
 #include "xmol/algo/sasa.h"
 #include "xmol/algo/vector-correlation.h"
 #include "xmol/base.h"
+#include "xmol/proxy/smart/selections.h"
 
 #include <iostream>
 #include <pybind11/eigen.h>
@@ -13,6 +16,64 @@
 using namespace xmol;
 namespace py = pybind11;
 
+namespace {
+
+void calc_sasa(algo::SasaMethod method, const future::Span<XYZ>& coords, future::Span<double> coord_radii,
+               double solvent_radii, future::Span<double> result, std::optional<int> n_samples,
+               const future::Span<int>& indices, int n_threads) {
+  py::gil_scoped_release release;
+  switch (method) {
+  case algo::SasaMethod::LEE_RICHARDS:
+    algo::calc_sasa(coords, coord_radii, solvent_radii, result, n_samples.value_or(20), indices, n_threads);
+    break;
+  case algo::SasaMethod::SHRAKE_RUPLEY:
+    algo::calc_sasa_shrake_rupley(coords, coord_radii, solvent_radii, result, n_samples.value_or(100), indices,
+                                  n_threads);
+    break;
+  }
+}
+
+/// Autocorrelation of (N,3) series or of (n_vectors,N,3) batch of series
+py::array_t<double> calc_autocorr_order_2(py::array_t<double, py::array::c_style | py::array::forcecast>& coords,
+                                          int limit, int n_threads, algo::AutoCorrelationMode mode) {
+  if (coords.ndim() == 2 && coords.shape(1) == 3) {
+    int N = coords.shape(0);
+    if (limit < 0 || limit > N) {
+      limit = N;
+    }
+    py::array_t<double> result(limit);
+    future::Span<XYZ> xyz_span(reinterpret_cast<XYZ*>(coords.mutable_data()), coords.shape(0));
+    algo::calc_autocorr_order_2(xyz_span, future::Span(result.mutable_data(), result.size()), mode);
+    return result;
+  }
+  if (coords.ndim() != 3 || coords.shape(2) != 3) {
+    throw py::type_error("shape!=[N,3] and shape!=[M,N,3]");
+  }
+  size_t n_vectors = coords.shape(0);
+  int N = coords.shape(1);
+  if (limit < 0 || limit > N) {
+    limit = N;
+  }
+  py::array_t<double> result({n_vectors, size_t(limit)});
+  future::Span<XYZ> xyz_span(reinterpret_cast<XYZ*>(coords.mutable_data()), n_vectors * N);
+  future::Span<double> result_span(result.mutable_data(), result.size());
+  py::gil_scoped_release release;
+  algo::calc_autocorr_order_2(xyz_span, n_vectors, result_span, mode, n_threads);
+  return result;
+}
+
+/// Bond vectors of shape (n_pairs, n_frames, 3)
+py::array_t<double> extract_bond_vectors(trajectory::Trajectory::Slice& slice,
+                                         const std::vector<std::pair<AtomIndex, AtomIndex>>& pairs,
+                                         std::vector<XYZ>& reference, const std::vector<AtomIndex>& alignment_indices) {
+  py::array_t<double> result({pairs.size(), slice.size(), size_t(3)});
+  future::Span<XYZ> result_span(reinterpret_cast<XYZ*>(result.mutable_data()), pairs.size() * slice.size());
+  algo::extract_bond_vectors(slice, pairs, result_span, future::Span(reference), alignment_indices);
+  return result;
+}
+
+} // namespace
+
 void pyxmolpp::v1::define_algo_functions(pybind11::module& m) {
   m.def(
       "calc_alignment",
@@ -27,47 +88,158 @@ void pyxmolpp::v1::define_algo_functions(pybind11::module& m) {
       },
       py::arg("ref"), py::arg("var"));
   m.def(
-      "calc_inertia_tensor", [](xmol::CoordEigenMatrix& coords) { return algo::calc_inertia_tensor_impl(coords); },
-      py::arg("coords"));
+      "calc_fitted_rmsd",
+      [](xmol::CoordEigenMatrix& reference, xmol::CoordEigenMatrix& variable,
+         std::optional<Eigen::VectorXd>& weights) {
+        if (weights) {
+          return algo::calc_fitted_rmsd_weighted_impl(reference, variable, *weights);
+        }
+        return algo::calc_fitted_rmsd_impl(reference, variable);
+      },
+      py::arg("ref"), py::arg("var"), py::arg("weights") = std::nullopt,
+      R"pydoc(RMSD after optimal superposition by QCP method
+
+    :param ref: reference coordinates
+    :param var: variable coordinates
+    :param weights: optional per-point weights
+)pydoc");
+  // registered before numpy overload, so slices are not tried as arrays
   m.def(
-      "calc_autocorr_order_2",
-      [](py::array_t<double, py::array::c_style | py::array::forcecast>& coords, int limit) {
-        if (coords.ndim() != 2 || coords.shape(1) != 3) {
-          throw py::type_error("shape!=[N,3]");
+      "calc_pairwise_fitted_rmsd",
+      [](trajectory::Trajectory::Slice& slice, std::vector<AtomIndex>& indices, int n_threads,
+         bool single_precision) -> py::array {
+        if (single_precision) {
+          py::array_t<float> result(algo::condensed_size(slice.size()));
+          future::Span<float> result_span(result.mutable_data(), (size_t)result.size());
+          algo::calc_pairwise_fitted_rmsd(slice, indices, result_span, n_threads);
+          return std::move(result);
         }
-        int N = coords.shape(0);
-        if (limit < 0 || limit > N) {
-          limit = N;
+        py::array_t<double> result(algo::condensed_size(slice.size()));
+        future::Span<double> result_span(result.mutable_data(), (size_t)result.size());
+        algo::calc_pairwise_fitted_rmsd(slice, indices, result_span, n_threads);
+        return std::move(result);
+      },
+      py::arg("frames"), py::arg("indices"), py::arg("n_threads") = 0, py::arg("single_precision") = false,
+      R"pydoc(All-vs-all RMSD after optimal superposition of trajectory frames
+
+    :param frames: trajectory slice
+    :param indices: indices of atoms to superimpose
+    :param n_threads: number of threads, non-positive value means all hardware threads
+    :param single_precision: return ``float32`` array instead of ``float64``
+)pydoc");
+  m.def(
+      "calc_pairwise_fitted_rmsd",
+      [](py::array_t<double, py::array::c_style | py::array::forcecast>& frames, int n_threads,
+         bool single_precision) -> py::array {
+        if (frames.ndim() != 3 || frames.shape(2) != 3) {
+          throw py::type_error("frames.shape!=[n_frames,n_atoms,3]");
         }
-        py::array_t<double> result(limit);
-        future::Span<XYZ> xyz_span(reinterpret_cast<XYZ*>(coords.mutable_data()), coords.shape(0));
-        algo::calc_autocorr_order_2(xyz_span, future::Span(result.mutable_data(), result.size()),
-                                    algo::AutoCorrelationMode::NORMALIZE_VECTORS);
-        return result;
+        const size_t n_frames = frames.shape(0);
+        const size_t n_atoms = frames.shape(1);
+        future::Span<XYZ> xyz_span(reinterpret_cast<XYZ*>(frames.mutable_data()), n_frames * n_atoms);
+        if (single_precision) {
+          py::array_t<float> result(algo::condensed_size(n_frames));
+          future::Span<float> result_span(result.mutable_data(), (size_t)result.size());
+          py::gil_scoped_release release;
+          algo::calc_pairwise_fitted_rmsd(xyz_span, n_atoms, result_span, n_threads);
+          return std::move(result);
+        }
+        py::array_t<double> result(algo::condensed_size(n_frames));
+        future::Span<double> result_span(result.mutable_data(), (size_t)result.size());
+        py::gil_scoped_release release;
+        algo::calc_pairwise_fitted_rmsd(xyz_span, n_atoms, result_span, n_threads);
+        return std::move(result);
       },
-      py::arg("vectors"), py::arg("limit") = -1);
+      py::arg("frames"), py::arg("n_threads") = 0, py::arg("single_precision") = false,
+      R"pydoc(All-vs-all RMSD after optimal superposition
 
+    Result is condensed upper triangle of RMSD matrix (same layout as :py:`scipy.spatial.distance.pdist`),
+    use :py:`scipy.spatial.distance.squareform` to get square matrix
+
+    :param frames: coordinates, shape ``(n_frames, n_atoms, 3)``
+    :param n_threads: number of threads, non-positive value means all hardware threads
+    :param single_precision: return ``float32`` array instead of ``float64``
+)pydoc");
   m.def(
-      "calc_autocorr_order_2_PRE",
-      [](py::array_t<double, py::array::c_style | py::array::forcecast>& coords, int limit) {
-        if (coords.ndim() != 2 || coords.shape(1) != 3) {
-          throw py::type_error("shape!=[N,3]");
+      "extract_bond_vectors",
+      [](trajectory::Trajectory::Slice& slice, const std::vector<std::pair<AtomIndex, AtomIndex>>& pairs,
+         std::optional<py::array_t<double, py::array::c_style | py::array::forcecast>> reference,
+         const std::vector<AtomIndex>& alignment_indices) {
+        std::vector<XYZ> reference_coords;
+        if (reference) {
+          if (reference->ndim() != 2 || reference->shape(1) != 3) {
+            throw py::type_error("reference.shape!=[N,3]");
+          }
+          auto data = reinterpret_cast<const XYZ*>(reference->data());
+          reference_coords.assign(data, data + reference->shape(0));
+        }
+        return ::extract_bond_vectors(slice, pairs, reference_coords, alignment_indices);
+      },
+      py::arg("frames"), py::arg("pairs"), py::arg("reference") = std::nullopt,
+      py::arg("alignment_indices") = std::vector<AtomIndex>{},
+      R"pydoc(Time series of vectors between atom pairs, shape ``(n_pairs, n_frames, 3)``
+
+    Result can be passed directly to :ref:`calc_autocorr_order_2`
+
+    :param frames: trajectory slice
+    :param pairs: atom indices, vector points from first to second atom of pair
+    :param reference: coordinates of alignment atoms to superimpose each frame onto, shape ``(len(alignment_indices), 3)``
+    :param alignment_indices: indices of atoms to superimpose
+)pydoc");
+  m.def(
+      "extract_bond_vectors",
+      [](trajectory::Trajectory::Slice& slice, proxy::smart::AtomSmartSelection& first,
+         proxy::smart::AtomSmartSelection& second, std::optional<proxy::smart::AtomSmartSelection> reference) {
+        if (first.size() != second.size()) {
+          throw py::value_error("first.size() != second.size()");
         }
-        int N = coords.shape(0);
-        if (limit < 0 || limit > N) {
-          limit = N;
+        std::vector<std::pair<AtomIndex, AtomIndex>> pairs;
+        for (size_t i = 0; i < first.size(); ++i) {
+          pairs.emplace_back(first[i].index(), second[i].index());
         }
-        py::array_t<double> result(limit);
-        future::Span<XYZ> xyz_span(reinterpret_cast<XYZ*>(coords.mutable_data()), coords.shape(0));
-        algo::calc_autocorr_order_2(xyz_span, future::Span(result.mutable_data(), result.size()),
-                                    algo::AutoCorrelationMode::NORMALIZE_AND_DIVIDE_BY_CUBE);
-        return result;
+        std::vector<XYZ> reference_coords;
+        std::vector<AtomIndex> alignment_indices;
+        if (reference) {
+          for (size_t i = 0; i < reference->size(); ++i) {
+            reference_coords.push_back((*reference)[i].r());
+            alignment_indices.push_back((*reference)[i].index());
+          }
+        }
+        return ::extract_bond_vectors(slice, pairs, reference_coords, alignment_indices);
+      },
+      py::arg("frames"), py::arg("first"), py::arg("second"), py::arg("reference") = std::nullopt,
+      R"pydoc(Time series of vectors from ``first`` to ``second`` atoms, shape ``(n_pairs, n_frames, 3)``
+
+    :param frames: trajectory slice
+    :param first: vector origin atoms
+    :param second: vector end atoms
+    :param reference: atoms of reference frame to superimpose each frame onto
+)pydoc");
+  m.def(
+      "calc_inertia_tensor", [](xmol::CoordEigenMatrix& coords) { return algo::calc_inertia_tensor_impl(coords); },
+      py::arg("coords"));
+  m.def(
+      "calc_autocorr_order_2",
+      [](py::array_t<double, py::array::c_style | py::array::forcecast>& coords, int limit, int n_threads) {
+        return ::calc_autocorr_order_2(coords, limit, n_threads, algo::AutoCorrelationMode::NORMALIZE_VECTORS);
       },
-      py::arg("vectors"), py::arg("limit") = -1);
+      py::arg("vectors"), py::arg("limit") = -1, py::arg("n_threads") = 0);
+
+  m.def(
+      "calc_autocorr_order_2_PRE",
+      [](py::array_t<double, py::array::c_style | py::array::forcecast>& coords, int limit, int n_threads) {
+        return ::calc_autocorr_order_2(coords, limit, n_threads, algo::AutoCorrelationMode::NORMALIZE_AND_DIVIDE_BY_CUBE);
+      },
+      py::arg("vectors"), py::arg("limit") = -1, py::arg("n_threads") = 0);
+  py::enum_<algo::SasaMethod>(m, "SasaMethod", "SASA calculation method")
+      .value("LEE_RICHARDS", algo::SasaMethod::LEE_RICHARDS, "Slices of atom sphere, ``n_samples`` slices per atom")
+      .value("SHRAKE_RUPLEY", algo::SasaMethod::SHRAKE_RUPLEY,
+             "Test points on atom sphere, ``n_samples`` points per atom");
   m.def(
       "calc_sasa",
       [](py::array_t<double, py::array::c_style | py::array::forcecast> coords, py::array_t<double> coord_radii,
-         double solvent_radii, std::optional<py::array_t<int>> indices_of_interest, int n_samples) {
+         double solvent_radii, std::optional<py::array_t<int>> indices_of_interest, std::optional<int> n_samples,
+         int n_threads, algo::SasaMethod method) {
         if (coords.ndim() != 2 || coords.shape(1) != 3) {
           throw std::runtime_error("coords.shape!=[N,3]");
         }
@@ -91,9 +263,60 @@ void pyxmolpp::v1::define_algo_functions(pybind11::module& m) {
         py::array_t<double> result(limit);
         future::Span<double> result_span(result.mutable_data(), (size_t)result.size());
         future::Span<double> coord_radii_span(coord_radii.mutable_data(), (size_t)coord_radii.size());
-        algo::calc_sasa(coord_span, coord_radii_span, solvent_radii, result_span, n_samples, indices);
+        calc_sasa(method, coord_span, coord_radii_span, solvent_radii, result_span, n_samples, indices, n_threads);
         return result;
       },
       py::arg("coordinates"), py::arg("vdw_radii"), py::arg("solvent_radius"),
-      py::arg("indices_of_interest") = std::nullopt, py::arg("n_samples").noconvert(true) = 20);
+      py::arg("indices_of_interest") = std::nullopt, py::arg("n_samples").noconvert(true) = std::nullopt,
+      py::arg("n_threads") = 0, py::arg("method") = algo::SasaMethod::LEE_RICHARDS,
+      R"pydoc(Solvent accessible surface area of atoms
+
+    :param coordinates: atom coordinates
+    :param vdw_radii: atom radii
+    :param solvent_radius: solvent probe radius
+    :param indices_of_interest: indices of atoms to calculate area for, all atoms if None
+    :param n_samples: slices (Lee-Richards, default 20) or test points (Shrake-Rupley, default 100) per atom
+    :param n_threads: number of threads, non-positive value means all hardware threads
+    :param method: calculation method
+)pydoc");
+  m.def(
+      "calc_sasa",
+      [](proxy::smart::AtomSmartSelection& atoms, double solvent_radii, std::optional<int> n_samples, int n_threads,
+         algo::SasaMethod method, bool per_residue) {
+        CoordEigenMatrix coords = atoms.coords()._eigen();
+        std::vector<double> radii;
+        radii.reserve(atoms.size());
+        for (auto atom : atoms) {
+          radii.push_back(atom.vdw_radius());
+        }
+        std::vector<double> sasa(atoms.size());
+        future::Span<XYZ> coord_span(reinterpret_cast<XYZ*>(coords.data()), coords.rows());
+        calc_sasa(method, coord_span, future::Span(radii), solvent_radii, future::Span(sasa), n_samples, {},
+                  n_threads);
+        if (!per_residue) {
+          return py::array_t<double>(sasa.size(), sasa.data());
+        }
+        std::vector<double> residue_sasa;
+        std::optional<proxy::ResidueRef> prev_residue;
+        size_t i = 0;
+        for (auto atom : atoms) { // atoms are ordered, so atoms of residue are adjacent
+          if (!prev_residue || *prev_residue != atom.residue()) {
+            prev_residue = atom.residue();
+            residue_sasa.push_back(0);
+          }
+          residue_sasa.back() += sasa[i++];
+        }
+        return py::array_t<double>(residue_sasa.size(), residue_sasa.data());
+      },
+      py::arg("atoms"), py::arg("solvent_radius"), py::arg("n_samples").noconvert(true) = std::nullopt,
+      py::arg("n_threads") = 0, py::arg("method") = algo::SasaMethod::LEE_RICHARDS, py::arg("per_residue") = false,
+      R"pydoc(Solvent accessible surface area of atoms with their :ref:`Atom.vdw_radius`
+
+    :param atoms: atoms
+    :param solvent_radius: solvent probe radius
+    :param n_samples: slices (Lee-Richards, default 20) or test points (Shrake-Rupley, default 100) per atom
+    :param n_threads: number of threads, non-positive value means all hardware threads
+    :param method: calculation method
+    :param per_residue: return total area of each residue of :py:`atoms.residues` instead of per-atom areas
+)pydoc");
 }
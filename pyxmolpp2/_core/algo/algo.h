@@ -5,5 +5,10 @@
 namespace pyxmolpp::v1 {
 
 void define_algo_functions(pybind11::module& coords);
+void define_clustering(pybind11::module& m);
+void define_sasa_calculator(pybind11::module& m);
+void define_multi_tau_correlator(pybind11::module& m);
+void define_coord_statistics(pybind11::module& m);
+void define_principal_components(pybind11::module& m);
 
 }
\ No newline at end of file
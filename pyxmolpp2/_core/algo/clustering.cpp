@@ -0,0 +1,191 @@
+#include "algo.h"
+#include "xmol/algo/clustering.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <cmath>
+
+using namespace xmol;
+using namespace xmol::algo;
+namespace py = pybind11;
+
+namespace {
+
+/// Call `f` with matrix view of condensed numpy array or with CachedRmsdMatrix
+template <typename Function> auto with_distance_matrix(py::object& distances, Function&& f) {
+  if (py::isinstance<CachedRmsdMatrix>(distances)) {
+    return f(distances.cast<CachedRmsdMatrix&>());
+  }
+  auto condensed = distances.cast<py::array_t<double, py::array::c_style | py::array::forcecast>>();
+  if (condensed.ndim() != 1) {
+    throw py::type_error("distances must be condensed 1d matrix or CachedRmsdMatrix");
+  }
+  CondensedDistanceMatrix matrix(future::Span<const double>(condensed.data(), condensed.size()));
+  return f(matrix);
+}
+
+py::array_t<double> linkage_to_array(const std::vector<LinkageStep>& linkage) {
+  py::array_t<double> result({linkage.size(), size_t{4}});
+  auto r = result.mutable_unchecked<2>();
+  for (size_t i = 0; i < linkage.size(); ++i) {
+    r(i, 0) = linkage[i].first;
+    r(i, 1) = linkage[i].second;
+    r(i, 2) = linkage[i].distance;
+    r(i, 3) = linkage[i].size;
+  }
+  return result;
+}
+
+/// Convert dendrogram checking that it refers only to frames and previously formed clusters
+std::vector<LinkageStep> linkage_from_array(py::array_t<double, py::array::c_style | py::array::forcecast>& array) {
+  if (array.ndim() != 2 || array.shape(1) != 4) {
+    throw py::type_error("linkage.shape!=[N,4]");
+  }
+  auto a = array.unchecked<2>();
+  const size_t n = array.shape(0) + 1;
+  std::vector<size_t> cluster_size(2 * n - 1, 1);
+  std::vector<bool> merged(2 * n - 1, false);
+  auto as_index = [&](double value, size_t upper_bound) {
+    if (!(value >= 0 && value < upper_bound && value == std::floor(value))) {
+      throw py::value_error("linkage: invalid cluster index " + std::to_string(value));
+    }
+    return static_cast<size_t>(value);
+  };
+  std::vector<LinkageStep> result(array.shape(0));
+  for (size_t i = 0; i < result.size(); ++i) {
+    const size_t first = as_index(a(i, 0), n + i);
+    const size_t second = as_index(a(i, 1), n + i);
+    if (first == second || merged[first] || merged[second]) {
+      throw py::value_error("linkage: cluster is merged twice at step " + std::to_string(i));
+    }
+    const size_t size = cluster_size[first] + cluster_size[second];
+    if (a(i, 3) != size) {
+      throw py::value_error("linkage: size of cluster at step " + std::to_string(i) + " (=" +
+                            std::to_string(a(i, 3)) + ") doesn't match sizes of merged clusters");
+    }
+    merged[first] = merged[second] = true;
+    cluster_size[n + i] = size;
+    result[i] = {first, second, a(i, 2), size};
+  }
+  return result;
+}
+
+} // namespace
+
+void pyxmolpp::v1::define_clustering(pybind11::module& m) {
+  py::class_<CachedRmsdMatrix>(m, "CachedRmsdMatrix", "Fitted RMSD matrix computed on demand")
+      .def(py::init([](py::array_t<double, py::array::c_style | py::array::forcecast>& frames, size_t cache_rows,
+                       int n_threads) {
+             if (frames.ndim() != 3 || frames.shape(2) != 3) {
+               throw py::type_error("frames.shape!=[n_frames,n_atoms,3]");
+             }
+             future::Span<XYZ> xyz_span(reinterpret_cast<XYZ*>(frames.mutable_data()),
+                                        frames.shape(0) * frames.shape(1));
+             return std::make_unique<CachedRmsdMatrix>(xyz_span, frames.shape(1), cache_rows, n_threads);
+           }),
+           py::arg("frames"), py::arg("cache_rows") = 64, py::arg("n_threads") = 0,
+           R"pydoc(Constructor
+
+    :param frames: coordinates, shape ``(n_frames, n_atoms, 3)``
+    :param cache_rows: maximal number of cached matrix rows
+    :param n_threads: number of threads, non-positive value means all hardware threads
+)pydoc")
+      .def("__len__", &CachedRmsdMatrix::size)
+      .def("distance", &CachedRmsdMatrix::distance, py::arg("i"), py::arg("j"), "RMSD between i-th and j-th frames")
+      .def(
+          "row",
+          [](CachedRmsdMatrix& self, size_t i) {
+            if (i >= self.size()) {
+              throw py::index_error("CachedRmsdMatrix row index out of range");
+            }
+            auto row = self.row(i);
+            return py::array_t<double>(row.size(), row.data());
+          },
+          py::arg("i"), "RMSD between i-th frame and all frames")
+      .def_property_readonly("n_computed_rows", &CachedRmsdMatrix::n_computed_rows,
+                             "Number of computed rows since construction");
+
+  py::class_<Clustering>(m, "Clustering", "Result of clustering, clusters are ordered by decreasing size")
+      .def_property_readonly(
+          "medoids", [](Clustering& self) { return py::array_t<size_t>(self.medoids.size(), self.medoids.data()); },
+          "Representative frame of each cluster")
+      .def_property_readonly(
+          "labels", [](Clustering& self) { return py::array_t<int>(self.labels.size(), self.labels.data()); },
+          "Cluster of each frame");
+
+  py::enum_<Linkage>(m, "Linkage", "Cluster distance update rule of agglomerative clustering")
+      .value("SINGLE", Linkage::SINGLE)
+      .value("COMPLETE", Linkage::COMPLETE)
+      .value("AVERAGE", Linkage::AVERAGE);
+
+  m.def(
+      "gromos_clustering",
+      [](py::object& distances, double cutoff) {
+        return with_distance_matrix(distances, [&](DistanceMatrix& matrix) {
+          py::gil_scoped_release release;
+          return gromos_clustering(matrix, cutoff);
+        });
+      },
+      py::arg("distances"), py::arg("cutoff"),
+      R"pydoc(Neighbour-count clustering of Daura et al. (GROMOS)
+
+    :param distances: condensed distance matrix (see :ref:`calc_pairwise_fitted_rmsd`) or :ref:`CachedRmsdMatrix`
+    :param cutoff: maximal distance between cluster members and its center
+)pydoc");
+  m.def(
+      "k_medoids_clustering",
+      [](py::object& distances, size_t n_clusters, size_t max_iterations, unsigned seed) {
+        return with_distance_matrix(distances, [&](DistanceMatrix& matrix) {
+          py::gil_scoped_release release;
+          return k_medoids_clustering(matrix, n_clusters, max_iterations, seed);
+        });
+      },
+      py::arg("distances"), py::arg("n_clusters"), py::arg("max_iterations") = 100, py::arg("seed") = 0,
+      R"pydoc(k-medoids clustering
+
+    :param distances: condensed distance matrix (see :ref:`calc_pairwise_fitted_rmsd`) or :ref:`CachedRmsdMatrix`
+    :param n_clusters: number of clusters
+    :param max_iterations: maximal number of assignment/update iterations
+    :param seed: seed of initial medoids choice
+)pydoc");
+  m.def(
+      "calc_linkage",
+      [](py::object& distances, Linkage method) {
+        auto linkage = with_distance_matrix(distances, [&](DistanceMatrix& matrix) {
+          py::gil_scoped_release release;
+          return calc_linkage(matrix, method);
+        });
+        return linkage_to_array(linkage);
+      },
+      py::arg("distances"), py::arg("method"),
+      R"pydoc(Agglomerative clustering dendrogram in :py:`scipy.cluster.hierarchy.linkage` format
+
+    :param distances: condensed distance matrix (see :ref:`calc_pairwise_fitted_rmsd`) or :ref:`CachedRmsdMatrix`
+    :param method: linkage method
+)pydoc");
+  m.def(
+      "hierarchical_clustering",
+      [](py::object& distances, py::array_t<double, py::array::c_style | py::array::forcecast>& linkage_array,
+         std::optional<size_t> n_clusters, std::optional<double> threshold) {
+        if (n_clusters.has_value() == threshold.has_value()) {
+          throw py::value_error("exactly one of n_clusters and threshold must be specified");
+        }
+        auto linkage = linkage_from_array(linkage_array);
+        return with_distance_matrix(distances, [&](DistanceMatrix& matrix) {
+          py::gil_scoped_release release;
+          if (n_clusters) {
+            return hierarchical_clustering(matrix, linkage, *n_clusters);
+          }
+          return hierarchical_clustering_by_distance(matrix, linkage, *threshold);
+        });
+      },
+      py::arg("distances"), py::arg("linkage"), py::arg("n_clusters") = std::nullopt,
+      py::arg("threshold") = std::nullopt,
+      R"pydoc(Cut dendrogram into clusters
+
+    :param distances: condensed distance matrix (see :ref:`calc_pairwise_fitted_rmsd`) or :ref:`CachedRmsdMatrix`
+    :param linkage: dendrogram (see :ref:`calc_linkage`)
+    :param n_clusters: number of clusters
+    :param threshold: maximal merge distance within cluster
+)pydoc");
+}
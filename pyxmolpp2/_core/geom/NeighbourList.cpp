@@ -0,0 +1,70 @@
+#include "NeighbourList.h"
+
+#include <pybind11/numpy.h>
+
+namespace py = pybind11;
+using namespace xmol::geom;
+
+namespace {
+
+xmol::future::Span<XYZ> as_xyz_span(py::array_t<double, py::array::c_style | py::array::forcecast>& coords) {
+  if (coords.ndim() != 2 || coords.shape(1) != 3) {
+    throw py::type_error("coords.shape!=[N,3]");
+  }
+  return xmol::future::Span<XYZ>(reinterpret_cast<XYZ*>(coords.mutable_data()), coords.shape(0));
+}
+
+} // namespace
+
+void pyxmolpp::v1::populate(pybind11::class_<NeighbourList>& pyNeighbourList) {
+  py::enum_<NeighbourList::Mode>(pyNeighbourList, "Mode", "Pair list storage mode")
+      .value("HALF", NeighbourList::Mode::HALF, "Each pair is stored once as (i, j), i < j")
+      .value("FULL", NeighbourList::Mode::FULL, "Each pair is stored for both (i, j) and (j, i)")
+      .export_values();
+
+  pyNeighbourList
+      .def(py::init<double, double, NeighbourList::Mode>(), py::arg("cutoff"), py::arg("skin"),
+           py::arg("mode") = NeighbourList::Mode::HALF, "Constructor")
+      .def(
+          "update",
+          [](NeighbourList& self, py::array_t<double, py::array::c_style | py::array::forcecast>& coords) {
+            return self.update(as_xyz_span(coords));
+          },
+          py::arg("coords"), "Rebuild list if any point moved by more than half of skin. Returns True on rebuild")
+      .def(
+          "rebuild",
+          [](NeighbourList& self, py::array_t<double, py::array::c_style | py::array::forcecast>& coords) {
+            self.rebuild(as_xyz_span(coords));
+          },
+          py::arg("coords"), "Unconditionally rebuild list")
+      .def(
+          "neighbours",
+          [](NeighbourList& self, int i) {
+            if (i < 0 || i >= self.size()) {
+              throw py::index_error("NeighbourList index out of range");
+            }
+            auto neighbours = self.neighbours(i);
+            py::array_t<int> result(neighbours.size());
+            std::copy(neighbours.begin(), neighbours.end(), result.mutable_data());
+            return result;
+          },
+          py::arg("i"), "Candidate neighbours of i-th point")
+      .def(
+          "pairs",
+          [](NeighbourList& self, py::array_t<double, py::array::c_style | py::array::forcecast>& coords) {
+            auto pairs = self.pairs_within_cutoff(as_xyz_span(coords));
+            py::array_t<int> result({pairs.size(), size_t{2}});
+            auto r = result.mutable_unchecked<2>();
+            for (size_t k = 0; k < pairs.size(); ++k) {
+              r(k, 0) = pairs[k].first;
+              r(k, 1) = pairs[k].second;
+            }
+            return result;
+          },
+          py::arg("coords"), "Pairs closer than cutoff as [N,2] array")
+      .def_property_readonly("cutoff", &NeighbourList::cutoff, "Cutoff distance")
+      .def_property_readonly("skin", &NeighbourList::skin, "Skin width")
+      .def_property_readonly("n_pairs", &NeighbourList::n_pairs, "Number of stored pairs")
+      .def_property_readonly("n_rebuilds", &NeighbourList::n_rebuilds, "Number of list rebuilds")
+      .def("__len__", &NeighbourList::size);
+}
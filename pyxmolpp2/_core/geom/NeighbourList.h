@@ -0,0 +1,9 @@
+#pragma once
+#include "xmol/geom/NeighbourList.h"
+#include <pybind11/pybind11.h>
+
+namespace pyxmolpp::v1 {
+
+void populate(pybind11::class_<xmol::geom::NeighbourList>& pyNeighbourList);
+
+}
@@ -1,11 +1,17 @@
 #include "UnitCell.h"
+#include "xmol/algo/pbc.h"
+#include "xmol/proxy/smart/selections.h"
+#include "xmol/proxy/smart/spans.h"
 
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 namespace py = pybind11;
 using namespace xmol::geom;
+using namespace xmol::proxy::smart;
 
 void pyxmolpp::v1::populate(pybind11::class_<xmol::geom::UnitCell>& pyUniCell) {
   py::class_<UnitCell::ClosestImage>(pyUniCell, "ClosestImage", "Result of closest periodic image search")
@@ -39,6 +45,67 @@ void pyxmolpp::v1::populate(pybind11::class_<xmol::geom::UnitCell>& pyUniCell) {
     :param ref: reference point
     :param var: variable point
 )pydoc")
+      .def(
+          "minimum_image",
+          [](UnitCell& self, py::array_t<double, py::array::c_style | py::array::forcecast>& displacements) {
+            if (displacements.ndim() != 2 || displacements.shape(1) != 3) {
+              throw py::type_error("displacements.shape!=[N,3]");
+            }
+            py::array_t<double> result({displacements.shape(0), displacements.shape(1)});
+            std::copy(displacements.data(), displacements.data() + displacements.size(), result.mutable_data());
+            xmol::future::Span<XYZ> span(reinterpret_cast<XYZ*>(result.mutable_data()), result.shape(0));
+            self.minimum_image(span);
+            return result;
+          },
+          py::arg("displacements"), "Minimum image of each displacement vector")
+      .def(
+          "wrap",
+          [](UnitCell& self, CoordSmartSpan& coords, const XYZ& origin) { xmol::algo::wrap(self, coords, origin); },
+          py::arg("coords"), py::arg("origin") = XYZ(0, 0, 0), "Translate coordinates into cell spanned from origin")
+      .def(
+          "wrap",
+          [](UnitCell& self, CoordSmartSelection& coords, const XYZ& origin) {
+            xmol::algo::wrap(self, coords, origin);
+          },
+          py::arg("coords"), py::arg("origin") = XYZ(0, 0, 0), "Translate coordinates into cell spanned from origin")
+      .def(
+          "unwrap",
+          [](UnitCell& self, CoordSmartSpan& coords, std::optional<std::vector<std::pair<int, int>>>& bonds) {
+            if (bonds) {
+              xmol::algo::unwrap_bonded(self, coords, *bonds);
+            } else {
+              xmol::algo::unwrap_sequential(self, coords);
+            }
+          },
+          py::arg("coords"), py::arg("bonds") = std::nullopt,
+          R"pydoc(Make coordinates whole
+
+    :param coords: coordinates to unwrap inplace
+    :param bonds: pairs of bonded positions within `coords`, if omitted coordinates are unwrapped sequentially
+)pydoc")
+      .def(
+          "unwrap",
+          [](UnitCell& self, CoordSmartSelection& coords, std::optional<std::vector<std::pair<int, int>>>& bonds) {
+            if (bonds) {
+              xmol::algo::unwrap_bonded(self, coords, *bonds);
+            } else {
+              xmol::algo::unwrap_sequential(self, coords);
+            }
+          },
+          py::arg("coords"), py::arg("bonds") = std::nullopt,
+          R"pydoc(Make coordinates whole
+
+    :param coords: coordinates to unwrap inplace
+    :param bonds: pairs of bonded positions within `coords`, if omitted coordinates are unwrapped sequentially
+)pydoc")
+      .def(
+          "make_molecules_whole",
+          [](UnitCell& self, MoleculeSmartSpan& molecules) { xmol::algo::make_molecules_whole(self, molecules); },
+          py::arg("molecules"), "Make molecules whole following residue order")
+      .def(
+          "make_molecules_whole",
+          [](UnitCell& self, MoleculeSmartSelection& molecules) { xmol::algo::make_molecules_whole(self, molecules); },
+          py::arg("molecules"), "Make molecules whole following residue order")
       .def_static("from_rst7_line",
                   [](std::string& line) {
                     if (line.size() < 6 * 12) {
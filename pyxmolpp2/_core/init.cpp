@@ -7,10 +7,13 @@
 #include "algo/algo.h"
 #include "base.h"
 #include "geom/AngleValue.h"
+#include "geom/NeighbourList.h"
 #include "geom/Transformation3d.h"
 #include "geom/UnitCell.h"
 #include "geom/XYZ.h"
 #include "io/AmberNetCDF.h"
+#include "io/CifFile.h"
+#include "io/GromacsGroFile.h"
 #include "io/GromacsXtcFile.h"
 #include "io/PdbFile.h"
 #include "io/TrjtoolDatFile.h"
@@ -32,6 +35,7 @@ void pyxmolpp::v1::init(pybind11::module& v1) {
   auto&& pyXYZ = py::class_<XYZ>(v1, "XYZ", "3D Vector");
   auto&& pyAngleValue = py::class_<AngleValue>(v1, "AngleValue", "Angular value");
   auto&& pyUnitCell = py::class_<UnitCell>(v1, "UnitCell", "Unit cell");
+  auto&& pyNeighbourList = py::class_<NeighbourList>(v1, "NeighbourList", "Verlet neighbour list with skin");
 
   auto pyResidueId = py::class_<ResidueId>(v1, "ResidueId", "Residue id");
 
@@ -61,10 +65,15 @@ void pyxmolpp::v1::init(pybind11::module& v1) {
   auto pyTrajectoryInputFile = py::class_<trajectory::TrajectoryInputFile, PyTrajectoryInputFile>(v1, "TrajectoryInputFile", "Trajectory input file ABC");
 
   auto pyPdbInputFile = py::class_<io::PdbInputFile, trajectory::TrajectoryInputFile>(v1, "PdbFile", "PDB file");
+  auto pyCifInputFile = py::class_<io::CifInputFile, trajectory::TrajectoryInputFile>(v1, "CifFile", "mmCIF (PDBx) file");
   auto pyTrjtoolDatFile = py::class_<io::TrjtoolDatFile, trajectory::TrajectoryInputFile>(v1, "TrjtoolDatFile", "Trajtool trajectory file");
   auto pyAmberNetCDF = py::class_<io::AmberNetCDF, trajectory::TrajectoryInputFile>(v1, "AmberNetCDF", "Amber trajectory file");
   auto pyGromacsXtc = py::class_<io::GromacsXtcFile, trajectory::TrajectoryInputFile>(v1, "GromacsXtcFile", "Gromacs binary `.xtc` input file");
+  auto pyGromacsGro = py::class_<io::GromacsGroFile, trajectory::TrajectoryInputFile>(v1, "GromacsGroFile", "Gromacs `.gro` file");
   auto pyXtcWriter = py::class_<io::xdr::XtcWriter>(v1, "XtcWriter", "Writes frames in `.xtc` binary format");
+  auto pyPdbTrajectoryWriter = py::class_<io::pdb::PdbTrajectoryWriter>(v1, "PdbTrajectoryWriter", "Writes frames as models of multi-model PDB file");
+  auto pyAmberNetCDFWriter = py::class_<io::AmberNetCDFWriter>(v1, "AmberNetCDFWriter", "Writes frames in AMBER NetCDF trajectory format");
+  auto pyGroWriter = py::class_<io::gro::GroWriter>(v1, "GroWriter", "Writes frames as blocks of `.gro` file");
 
   py::implicitly_convertible<AtomSmartSpan,AtomSmartSelection>();
   py::implicitly_convertible<ResidueSmartSpan,ResidueSmartSelection>();
@@ -75,6 +84,7 @@ void pyxmolpp::v1::init(pybind11::module& v1) {
   populate(pyXYZ);
   populate(pyAngleValue);
   populate(pyUnitCell);
+  populate(pyNeighbourList);
 
   define_angle_free_functions(v1);
 
@@ -102,12 +112,22 @@ void pyxmolpp::v1::init(pybind11::module& v1) {
   populate(pyTrajectoryInputFile);
 
   populate(pyPdbInputFile);
+  populate(pyCifInputFile);
   populate(pyTrjtoolDatFile);
   populate(pyAmberNetCDF);
   populate(pyGromacsXtc);
+  populate(pyGromacsGro);
   populate(pyXtcWriter);
+  populate(pyPdbTrajectoryWriter);
+  populate(pyGroWriter);
+  populate(pyAmberNetCDFWriter);
 
   define_algo_functions(v1);
+  define_clustering(v1);
+  define_sasa_calculator(v1);
+  define_multi_tau_correlator(v1);
+  define_coord_statistics(v1);
+  define_principal_components(v1);
   init_TorsionAngle(v1);
 
   py::register_exception<DeadFrameAccessError>(v1, "DeadFrameAccessError");
@@ -118,5 +138,10 @@ void pyxmolpp::v1::init(pybind11::module& v1) {
   py::register_exception<xmol::geom::GeomError>(v1, "GeomError");
   py::register_exception<xmol::io::XtcReadError>(v1, "XtcReadError");
   py::register_exception<xmol::io::XtcWriteError>(v1, "XtcWriteError");
+  py::register_exception<xmol::io::PdbWriteError>(v1, "PdbWriteError");
+  py::register_exception<xmol::io::cif::CifReadError>(v1, "CifReadError");
+  py::register_exception<xmol::io::gro::GroReadError>(v1, "GroReadError");
+  py::register_exception<xmol::io::gro::GroWriteError>(v1, "GroWriteError");
+  py::register_exception<xmol::io::AmberNetCDFWriteError>(v1, "AmberNetCDFWriteError");
   py::register_exception<xmol::utils::DeadObserverAccessError>(v1, "DeadObserverAccessError");
 }
\ No newline at end of file
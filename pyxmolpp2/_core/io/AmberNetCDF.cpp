@@ -15,3 +15,39 @@ void pyxmolpp::v1::populate(py::class_<AmberNetCDF, xmol::trajectory::Trajectory
       .def("advance", &AmberNetCDF::advance, py::arg("shift"), "Shift internal pointer by `shift`");
   ;
 }
+
+void pyxmolpp::v1::populate(py::class_<AmberNetCDFWriter>& pyAmberNetCDFWriter) {
+  using Format = AmberNetCDFWriter::Format;
+
+  py::enum_<Format>(pyAmberNetCDFWriter, "Format", "NetCDF file format")
+      .value("NETCDF4", Format::NETCDF4, "NetCDF-4 (HDF5-based), supports chunking and compression")
+      .value("CLASSIC_64BIT", Format::CLASSIC_64BIT, "NetCDF-3 64-bit offset, as written by AMBER")
+      .export_values();
+
+  pyAmberNetCDFWriter
+      .def(py::init<std::string, Format, bool, size_t, size_t, int, size_t>(), py::arg("filename"),
+           py::arg("format") = Format::NETCDF4, py::arg("write_cell") = true, py::arg("frames_per_chunk") = 1,
+           py::arg("atoms_per_chunk") = 0, py::arg("deflate_level") = 0, py::arg("buffer_frames") = 16,
+           R"pydoc(Create file for writing
+
+File follows AMBER NetCDF trajectory convention and can be read by :py:class:`AmberNetCDF`.
+NetCDF-4 file stores coordinates in chunks of ``frames_per_chunk x atoms_per_chunk x 3``:
+chunk of single frame is best for frame-by-frame reading, chunk of many frames and few atoms
+is best for reading time series of selected atoms.
+File layout is defined by first frame, file closed without frames can't be read.
+After failed write (e.g. disk is full) writer raises on next writes and discards buffered frames on close.
+
+:param filename: name of file
+:param format: file format
+:param write_cell: write cell of every frame; cell is not written if first frame has no box,
+                   frames without box can't follow frames with box
+:param frames_per_chunk: number of frames in chunk of coordinates (NetCDF-4 only)
+:param atoms_per_chunk: number of atoms in chunk of coordinates, zero means all atoms (NetCDF-4 only)
+:param deflate_level: compression level from 0 (no compression) to 9 (NetCDF-4 only)
+:param buffer_frames: number of frames accumulated before write to file
+)pydoc")
+      .def("write", &AmberNetCDFWriter::write, py::arg("frame"), "Append frame")
+      .def("flush", &AmberNetCDFWriter::flush, "Write buffered frames to file")
+      .def("close", &AmberNetCDFWriter::close, "Write buffered frames and close file")
+      .def("n_frames", &AmberNetCDFWriter::n_frames, "Number of written frames");
+}
@@ -0,0 +1,30 @@
+#include "CifFile.h"
+#include "xmol/proxy/smart/spans.h"
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace xmol::io;
+
+void pyxmolpp::v1::populate(py::class_<CifInputFile, xmol::trajectory::TrajectoryInputFile>& pyCifInputFile) {
+  pyCifInputFile
+      .def(py::init<std::string, bool, int>(), py::arg("filename"), py::arg("read_now") = true,
+           py::arg("n_threads") = 0, py::call_guard<py::gil_scoped_release>(),
+           R"pydoc(Read file
+
+Atoms are read from ``_atom_site`` loop of first data block, every model becomes a frame.
+Author chain names (``auth_asym_id``) of up to 4 characters and residue names (``auth_comp_id``) of up to
+5 characters are supported, longer values result in :ref:`CifReadError`.
+
+:param filename: name of file
+:param read_now: if false, file is opened in streaming mode: only model offsets are recorded,
+    coordinates of model are parsed on :py:meth:`read_frame` into frame of same topology,
+    e.g. when file is used as part of :ref:`Trajectory`
+:param n_threads: number of threads to parse models of multi-model file, non-positive value means all hardware threads
+)pydoc")
+      .def("frames", &CifInputFile::frames, "Get copy of frames")
+      .def("n_frames", &CifInputFile::n_frames, "Number of frames")
+      .def("n_atoms", &CifInputFile::n_atoms, "Number of atoms in first frame")
+      .def("read_frame", &CifInputFile::read_frame, py::arg("index"), py::arg("frame"),
+           "Assign `index` frame coordinates, cell, etc")
+      .def("advance", &CifInputFile::advance, py::arg("shift"), "Releases file when shifted past the end");
+}
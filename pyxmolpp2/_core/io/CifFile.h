@@ -0,0 +1,10 @@
+#pragma once
+
+#include "xmol/io/CifInputFile.h"
+#include <pybind11/pybind11.h>
+
+namespace pyxmolpp::v1 {
+
+void populate(pybind11::class_<xmol::io::CifInputFile, xmol::trajectory::TrajectoryInputFile>& pyCifInputFile);
+
+}
@@ -0,0 +1,41 @@
+#include "GromacsGroFile.h"
+#include "xmol/Frame.h"
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace xmol::io;
+
+void pyxmolpp::v1::populate(py::class_<GromacsGroFile, xmol::trajectory::TrajectoryInputFile>& pyGromacsGroFile) {
+  pyGromacsGroFile
+      .def(py::init<std::string, bool, int>(), py::arg("filename"), py::arg("read_now") = true,
+           py::arg("n_threads") = 0, py::call_guard<py::gil_scoped_release>(),
+           R"pydoc(Read file
+
+Every block of (multi-frame) file becomes a frame. Coordinates and box are converted from nanometers to angstroms,
+frame time is taken from ``t=`` of title line. Residue names of up to 5 characters (full GRO column) are supported.
+
+:param filename: name of file
+:param read_now: if false, file is opened in streaming mode: only block offsets are recorded,
+    coordinates of block are parsed on :py:meth:`read_frame` into frame of same topology,
+    e.g. when file is used as part of :ref:`Trajectory`
+:param n_threads: number of threads to parse blocks of multi-frame file, non-positive value means all hardware threads
+)pydoc")
+      .def("frames", &GromacsGroFile::frames, "Get copy of frames")
+      .def("n_frames", &GromacsGroFile::n_frames, "Number of frames")
+      .def("n_atoms", &GromacsGroFile::n_atoms, "Number of atoms in first frame")
+      .def("read_frame", &GromacsGroFile::read_frame, py::arg("index"), py::arg("frame"),
+           "Assign `index` frame coordinates, cell, etc")
+      .def("advance", &GromacsGroFile::advance, py::arg("shift"), "Releases file when shifted past the end");
+}
+
+void pyxmolpp::v1::populate(py::class_<gro::GroWriter>& pyGroWriter) {
+
+  pyGroWriter
+      .def(py::init<std::string>(), py::arg("filename"),
+           R"pydoc(Open file for writing
+
+:param filename: name of file
+)pydoc")
+      .def("write", &gro::GroWriter::write, py::arg("frame"), py::arg("title") = "Generated by xmolpp2",
+           "Write frame as next block");
+}
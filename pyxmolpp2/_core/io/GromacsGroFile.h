@@ -0,0 +1,12 @@
+#pragma once
+
+#include "xmol/io/GromacsGroFile.h"
+#include "xmol/io/gro/GroWriter.h"
+#include <pybind11/pybind11.h>
+
+namespace pyxmolpp::v1 {
+
+void populate(pybind11::class_<xmol::io::GromacsGroFile, xmol::trajectory::TrajectoryInputFile>& pyGromacsGroFile);
+void populate(pybind11::class_<xmol::io::gro::GroWriter>& pyGroWriter);
+
+}
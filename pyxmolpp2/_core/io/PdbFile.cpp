@@ -15,12 +15,41 @@ void pyxmolpp::v1::populate(py::class_<PdbInputFile, xmol::trajectory::Trajector
       .export_values();
 
   pyPdbInputFile
-      .def(py::init<std::string, PdbInputFile::Dialect>(), py::arg("filename"),
-           py::arg("dialect") = PdbInputFile::Dialect::AMBER_99, "Constructor")
+      .def(py::init<std::string, PdbInputFile::Dialect, bool, int>(), py::arg("filename"),
+           py::arg("dialect") = PdbInputFile::Dialect::AMBER_99, py::arg("read_now") = true, py::arg("n_threads") = 0,
+           py::call_guard<py::gil_scoped_release>(),
+           R"pydoc(Read file
+
+:param filename: name of file
+:param dialect: PDB dialect
+:param read_now: if false, file is opened in streaming mode: only model offsets are recorded,
+    coordinates of model are parsed on :py:meth:`read_frame` into frame of same topology,
+    e.g. when file is used as part of :ref:`Trajectory`
+:param n_threads: number of threads to parse models of multi-model file, non-positive value means all hardware threads
+)pydoc")
       .def("frames", &PdbInputFile::frames, "Get copy of frames")
       .def("n_frames", &PdbInputFile::n_frames, "Number of frames")
       .def("n_atoms", &PdbInputFile::n_atoms, "Number of atoms in first frame")
       .def("read_frame", &PdbInputFile::read_frame, py::arg("index"), py::arg("frame"),
            "Assign `index` frame coordinates, cell, etc")
-      .def("advance", &PdbInputFile::advance, "No-op");
+      .def("advance", &PdbInputFile::advance, py::arg("shift"), "Releases file when shifted past the end");
+}
+
+void pyxmolpp::v1::populate(py::class_<pdb::PdbTrajectoryWriter>& pyPdbTrajectoryWriter) {
+
+  pyPdbTrajectoryWriter
+      .def(py::init<std::string, bool>(), py::arg("filename"), py::arg("write_cell") = true,
+           R"pydoc(Open file for writing
+
+:param filename: name of file
+:param write_cell: write CRYST1 record before every model
+)pydoc")
+      .def("write", &pdb::PdbTrajectoryWriter::write, py::arg("frame"), "Write frame as next model")
+      .def("n_models", &pdb::PdbTrajectoryWriter::n_models, "Number of written models")
+      .def("close", &pdb::PdbTrajectoryWriter::close, "Write END record and close file, subsequent calls have no effect")
+      .def(
+          "__enter__", [](pdb::PdbTrajectoryWriter& self) -> pdb::PdbTrajectoryWriter& { return self; },
+          py::return_value_policy::reference)
+      .def("__exit__", [](pdb::PdbTrajectoryWriter& self, const py::object&, const py::object&,
+                          const py::object&) { self.close(); });
 }
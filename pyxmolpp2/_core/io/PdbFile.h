@@ -1,10 +1,12 @@
 #pragma once
 
 #include "xmol/io/PdbInputFile.h"
+#include "xmol/io/pdb/PdbTrajectoryWriter.h"
 #include <pybind11/pybind11.h>
 
 namespace pyxmolpp::v1 {
 
 void populate(pybind11::class_<xmol::io::PdbInputFile, xmol::trajectory::TrajectoryInputFile>& pyPdbInputFile);
+void populate(pybind11::class_<xmol::io::pdb::PdbTrajectoryWriter>& pyPdbTrajectoryWriter);
 
 }
\ No newline at end of file
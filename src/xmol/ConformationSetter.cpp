@@ -0,0 +1,146 @@
+#include "xmol/ConformationSetter.h"
+#include "xmol/Frame.h"
+#include "xmol/geom/affine/Transformation3d.h"
+#include "xmol/proxy/selections.h"
+
+using namespace xmol;
+using namespace xmol::geom;
+using namespace xmol::geom::affine;
+
+ConformationSetter::ConformationSetter(const std::vector<TorsionAngle>& angles) {
+  if (angles.empty()) {
+    return;
+  }
+  const auto first_atoms = angles.front().atoms();
+  m_anchor = proxy::smart::AtomSmartRef(first_atoms[0]);
+  const Frame* frame = &first_atoms[0].frame();
+  const size_t n_atoms = frame->n_atoms();
+
+  // Affected atoms of each angle as sorted index ranges, events are (atom index, angle, is_start)
+  std::vector<std::tuple<AtomIndex, size_t, bool>> events;
+  for (size_t k = 0; k < angles.size(); ++k) {
+    auto atoms = angles[k].atoms();
+    for (auto& atom : atoms) {
+      if (&atom.frame() != frame) {
+        throw GeomError("ConformationSetter: all angles must belong to same frame");
+      }
+    }
+    m_atoms.push_back({atoms[0].index(), atoms[1].index(), atoms[2].index(), atoms[3].index()});
+    std::vector<AtomIndex> affected;
+    for (auto& atom : angles[k].affected_atoms()) {
+      affected.push_back(atom.index());
+    }
+    std::sort(affected.begin(), affected.end());
+    for (size_t i = 0; i < affected.size();) {
+      size_t j = i + 1;
+      while (j < affected.size() && affected[j] == affected[j - 1] + 1) {
+        ++j;
+      }
+      events.emplace_back(affected[i], k, true);
+      events.emplace_back(affected[j - 1] + 1, k, false);
+      i = j;
+    }
+  }
+  std::sort(events.begin(), events.end());
+
+  // Sweep over atoms, composition stack holds affecting angles in increasing order
+  std::vector<int> last_affecting(n_atoms, -1);
+  std::set<size_t> affecting;
+  std::vector<size_t> stack;
+  for (size_t e = 0; e < events.size();) {
+    const AtomIndex begin = std::get<0>(events[e]);
+    size_t min_changed = angles.size();
+    for (; e < events.size() && std::get<0>(events[e]) == begin; ++e) {
+      auto [index, k, is_start] = events[e];
+      if (is_start) {
+        affecting.insert(k);
+      } else {
+        affecting.erase(k);
+      }
+      min_changed = std::min(min_changed, k);
+    }
+    if (affecting.empty()) {
+      stack.clear();
+      continue;
+    }
+    const AtomIndex end = std::get<0>(events[e]); // there is always closing event after non-empty set
+    Segment segment{begin, end, 0, m_pushed.size(), 0};
+    while (!stack.empty() && stack.back() >= min_changed) {
+      stack.pop_back();
+    }
+    segment.n_kept = stack.size();
+    for (auto it = affecting.lower_bound(min_changed); it != affecting.end(); ++it) {
+      stack.push_back(*it);
+      m_pushed.push_back(*it);
+    }
+    segment.pushed_to = m_pushed.size();
+    m_segments.push_back(segment);
+    std::fill(last_affecting.begin() + begin, last_affecting.begin() + end, static_cast<int>(*affecting.rbegin()));
+  }
+
+  for (size_t k = 0; k < m_atoms.size(); ++k) {
+    for (auto index : m_atoms[k]) {
+      if (last_affecting[index] > static_cast<int>(k)) {
+        throw GeomError("ConformationSetter: atom " + std::to_string(index) + " of angle #" + std::to_string(k) +
+                        " is affected by following angle #" + std::to_string(last_affecting[index]) +
+                        ", angles must be ordered from chain start to end");
+      }
+    }
+  }
+}
+
+future::Span<XYZ> ConformationSetter::coords() const {
+  auto frame_coords = const_cast<proxy::smart::AtomSmartRef&>(*m_anchor).frame().coords();
+  auto X = frame_coords._eigen();
+  return future::Span<XYZ>(reinterpret_cast<XYZ*>(X.data()), X.rows());
+}
+
+std::vector<AngleValue> ConformationSetter::values() const {
+  std::vector<AngleValue> result;
+  if (m_atoms.empty()) {
+    return result;
+  }
+  auto r = coords();
+  for (auto& [a, b, c, d] : m_atoms) {
+    result.push_back(dihedral_angle(r[a], r[b], r[c], r[d]));
+  }
+  return result;
+}
+
+void ConformationSetter::set(const std::vector<AngleValue>& values, AngleValue noop_tolerance) {
+  if (values.size() != size()) {
+    throw GeomError("ConformationSetter: values.size (=" + std::to_string(values.size()) + ") != size (=" +
+                    std::to_string(size()) + ")");
+  }
+  if (m_atoms.empty()) {
+    return;
+  }
+  auto r = coords();
+
+  // Atoms of each angle are moved rigidly by preceding angles, so rotations can be computed from initial
+  // coordinates and composed with rotations of preceding angles applied last
+  std::vector<Transformation3d> rotations(size());
+  std::vector<bool> is_noop(size());
+  for (size_t k = 0; k < size(); ++k) {
+    auto& [a, b, c, d] = m_atoms[k];
+    auto delta = (values[k] - dihedral_angle(r[a], r[b], r[c], r[d])).to_standard_range();
+    is_noop[k] = fabs(delta) <= noop_tolerance;
+    if (!is_noop[k]) {
+      auto rotation = Rotation3d(r[c] - r[b], delta);
+      rotations[k] = Transformation3d(rotation, Translation3d(r[c] - rotation.transform(r[c])));
+    }
+  }
+
+  std::vector<Transformation3d> stack;
+  for (auto& segment : m_segments) {
+    stack.resize(segment.n_kept);
+    for (size_t p = segment.pushed_from; p < segment.pushed_to; ++p) {
+      const size_t k = m_pushed[p];
+      stack.push_back(stack.empty() ? rotations[k] : (is_noop[k] ? stack.back() : stack.back() * rotations[k]));
+    }
+    const auto& transformation = stack.back();
+    for (AtomIndex i = segment.begin; i < segment.end; ++i) {
+      r[i] = transformation.transform(r[i]);
+    }
+  }
+}
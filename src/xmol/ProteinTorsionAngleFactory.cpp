@@ -161,6 +161,16 @@ std::optional<TorsionAngle> TorsionAngleFactory::get(proxy::ResidueRef& residue,
   return instance()._get(residue, angleName);
 }
 
+std::optional<TorsionAngleFactory::four_atoms> TorsionAngleFactory::get_atoms(proxy::ResidueRef& residue,
+                                                                             const TorsionAngleName& angleName) {
+  auto& bindings = instance().bindings;
+  auto it = bindings.find(std::make_pair(residue.name(), angleName));
+  if (it == bindings.end()) {
+    return {};
+  }
+  return it->second.first(residue);
+}
+
 std::optional<TorsionAngle> TorsionAngleFactory::_get(proxy::ResidueRef& r, const TorsionAngleName& angle_name) {
   auto it = bindings.find(std::make_pair(r.name(), angle_name));
   if (it == bindings.end()) {
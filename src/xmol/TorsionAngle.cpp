@@ -49,3 +49,16 @@ void TorsionAngle::set(const xmol::geom::AngleValue& value, xmol::geom::AngleVal
     }
   }
 }
+
+std::array<TorsionAngle::ARef, 4> TorsionAngle::atoms() const {
+  return {static_cast<const ARef&>(a), static_cast<const ARef&>(b), static_cast<const ARef&>(c),
+          static_cast<const ARef&>(d)};
+}
+
+proxy::AtomSelection TorsionAngle::affected_atoms() const {
+  if (!m_affected_atoms) {
+    throw GeomError("TorsionAngle: affected AtomSelection are not set");
+  }
+  auto [a_, b_, c_, d_] = atoms();
+  return m_affected_atoms(a_, b_, c_, d_);
+}
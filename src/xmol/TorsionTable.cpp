@@ -0,0 +1,71 @@
+#include "xmol/TorsionTable.h"
+#include "xmol/proxy/selections.h"
+#include "xmol/proxy/spans.h"
+
+using namespace xmol;
+using namespace xmol::geom;
+
+std::vector<TorsionAngleName> TorsionTable::protein_angles() {
+  return {TorsionAngleName("phi"),  TorsionAngleName("psi"),  TorsionAngleName("omega"),
+          TorsionAngleName("chi1"), TorsionAngleName("chi2"), TorsionAngleName("chi3"),
+          TorsionAngleName("chi4"), TorsionAngleName("chi5")};
+}
+
+TorsionTable::TorsionTable(proxy::ResidueSpan residues, const std::vector<TorsionAngleName>& names) {
+  resolve(residues, names);
+}
+
+TorsionTable::TorsionTable(proxy::ResidueSelection residues, const std::vector<TorsionAngleName>& names) {
+  resolve(residues, names);
+}
+
+template <typename Residues> void TorsionTable::resolve(Residues& residues, const std::vector<TorsionAngleName>& names) {
+  for (auto& residue : residues) {
+    for (auto& name : names) {
+      auto atoms = TorsionAngleFactory::get_atoms(residue, name);
+      if (!atoms) {
+        continue;
+      }
+      auto& [a, b, c, d] = *atoms;
+      m_names.push_back(name);
+      m_residue_indices.push_back(residue.index());
+      m_atom_indices.push_back({a.index(), b.index(), c.index(), d.index()});
+      m_max_atom_index = std::max({m_max_atom_index, a.index(), b.index(), c.index(), d.index()});
+    }
+  }
+}
+
+void TorsionTable::calc(const future::Span<XYZ>& coords, future::Span<double> result) const {
+  if (result.size() != size()) {
+    throw GeomError("TorsionTable: result.size (=" + std::to_string(result.size()) + ") != size (=" +
+                    std::to_string(size()) + ")");
+  }
+  if (m_max_atom_index >= static_cast<AtomIndex>(coords.size())) {
+    throw GeomError("TorsionTable: coords.size (=" + std::to_string(coords.size()) + ") is too small");
+  }
+  // Same formula as geom::dihedral_angle on plain vectors
+  for (size_t i = 0; i < m_atom_indices.size(); ++i) {
+    auto& [ia, ib, ic, id] = m_atom_indices[i];
+    const Eigen::Vector3d ba = coords[ia]._eigen() - coords[ib]._eigen();
+    const Eigen::Vector3d bc = coords[ic]._eigen() - coords[ib]._eigen();
+    const Eigen::Vector3d cd = coords[id]._eigen() - coords[ic]._eigen();
+    const Eigen::Vector3d abc = -ba.cross(bc);
+    const Eigen::Vector3d bcd = bc.cross(cd);
+    result[i] = std::atan2(abc.cross(bcd).dot(bc) / bc.norm(), abc.dot(bcd));
+  }
+}
+
+void TorsionTable::calc(trajectory::Trajectory::Slice& slice, future::Span<double> result) const {
+  if (result.size() != slice.size() * size()) {
+    throw GeomError("TorsionTable: result.size (=" + std::to_string(result.size()) +
+                    ") != n_frames * size (=" + std::to_string(slice.size() * size()) + ")");
+  }
+  size_t frame_index = 0;
+  for (auto& frame : slice) {
+    auto coords = frame.coords();
+    auto X = coords._eigen();
+    calc(future::Span<XYZ>(reinterpret_cast<XYZ*>(X.data()), X.rows()),
+         future::Span<double>(result.data() + frame_index * size(), size()));
+    ++frame_index;
+  }
+}
@@ -0,0 +1,160 @@
+#include "xmol/algo/CoordStatistics.h"
+#include "xmol/proxy/selections.h"
+#include "xmol/proxy/spans.h"
+
+using namespace xmol;
+using namespace xmol::algo;
+using namespace xmol::geom;
+
+namespace {
+
+/** Fold frames of @p block into lower triangle of co-moment and mean of @p n_a frames
+ *
+ * Block statistics are combined with accumulated ones by pairwise update of Chan et al.,
+ * frames of block are centered in place */
+void fold_block(Eigen::MatrixXd& comoment, Eigen::VectorXd& mean, double n_a, Eigen::Ref<Eigen::MatrixXd> block) {
+  const double n_b = block.cols();
+  Eigen::VectorXd block_mean = block.rowwise().mean();
+  block.colwise() -= block_mean;
+  Eigen::VectorXd delta = block_mean - mean;
+  comoment.selfadjointView<Eigen::Lower>().rankUpdate(block);
+  comoment.selfadjointView<Eigen::Lower>().rankUpdate(delta, n_a * n_b / (n_a + n_b));
+  mean += delta * (n_b / (n_a + n_b));
+}
+
+} // namespace
+
+CoordStatistics::CoordStatistics(size_t n_atoms, bool covariance)
+    : m_frame(3 * n_atoms), m_mean(Eigen::VectorXd::Zero(3 * n_atoms)), m_m2(Eigen::VectorXd::Zero(3 * n_atoms)),
+      m_covariance(covariance) {
+  if (m_covariance) {
+    m_covariance_mean = Eigen::VectorXd::Zero(3 * n_atoms);
+    m_comoment = Eigen::MatrixXd::Zero(3 * n_atoms, 3 * n_atoms);
+    m_block.resize(3 * n_atoms, block_size);
+  }
+}
+
+void CoordStatistics::update(const future::Span<XYZ>& coords) {
+  if (coords.size() != n_atoms()) {
+    throw GeomError("CoordStatistics: coords.size (=" + std::to_string(coords.size()) + ") != n_atoms (=" +
+                    std::to_string(n_atoms()) + ")");
+  }
+  for (size_t i = 0; i < coords.size(); ++i) {
+    m_frame.segment<3>(3 * i) = coords[i]._eigen();
+  }
+  update_frame();
+}
+
+void CoordStatistics::update(proxy::CoordSpan& coords) {
+  auto X = coords._eigen();
+  update(future::Span<XYZ>(reinterpret_cast<XYZ*>(X.data()), X.rows()));
+}
+
+void CoordStatistics::update(proxy::CoordSelection& coords) {
+  if (coords.size() != n_atoms()) {
+    throw GeomError("CoordStatistics: coords.size (=" + std::to_string(coords.size()) + ") != n_atoms (=" +
+                    std::to_string(n_atoms()) + ")");
+  }
+  size_t i = 0;
+  for (auto& r : coords) {
+    m_frame.segment<3>(i) << r.x(), r.y(), r.z();
+    i += 3;
+  }
+  update_frame();
+}
+
+void CoordStatistics::update_frame() {
+  ++m_n_frames;
+  Eigen::VectorXd delta = m_frame - m_mean;
+  m_mean += delta / m_n_frames;
+  m_m2 += delta.cwiseProduct(m_frame - m_mean);
+  if (m_covariance) {
+    m_block.col(m_block_n_frames++) = m_frame;
+    if (m_block_n_frames == block_size) {
+      flush_block();
+    }
+  }
+}
+
+void CoordStatistics::flush_block() {
+  if (m_block_n_frames == 0) {
+    return;
+  }
+  fold_block(m_comoment, m_covariance_mean, m_covariance_n_frames, m_block.leftCols(m_block_n_frames));
+  m_covariance_n_frames += m_block_n_frames;
+  m_block_n_frames = 0;
+}
+
+void CoordStatistics::merge(const CoordStatistics& other) {
+  if (other.n_atoms() != n_atoms() || other.m_covariance != m_covariance) {
+    throw GeomError("CoordStatistics: can't merge statistics of different shape");
+  }
+  if (other.m_n_frames == 0) {
+    return;
+  }
+  const double n_a = m_n_frames;
+  const double n_b = other.m_n_frames;
+  Eigen::VectorXd delta = other.m_mean - m_mean;
+  m_m2 += other.m_m2 + delta.cwiseAbs2() * (n_a * n_b / (n_a + n_b));
+  m_mean += delta * (n_b / (n_a + n_b));
+  m_n_frames += other.m_n_frames;
+
+  if (m_covariance) {
+    flush_block();
+    if (other.m_covariance_n_frames > 0) {
+      const double c_a = m_covariance_n_frames;
+      const double c_b = other.m_covariance_n_frames;
+      Eigen::VectorXd covariance_delta = other.m_covariance_mean - m_covariance_mean;
+      m_comoment.triangularView<Eigen::Lower>() += other.m_comoment;
+      m_comoment.selfadjointView<Eigen::Lower>().rankUpdate(covariance_delta, c_a * c_b / (c_a + c_b));
+      m_covariance_mean += covariance_delta * (c_b / (c_a + c_b));
+      m_covariance_n_frames += other.m_covariance_n_frames;
+    }
+    for (size_t k = 0; k < other.m_block_n_frames; ++k) {
+      m_block.col(m_block_n_frames++) = other.m_block.col(k);
+    }
+    if (m_block_n_frames == block_size) {
+      flush_block();
+    }
+  }
+}
+
+std::vector<XYZ> CoordStatistics::mean() const {
+  std::vector<XYZ> result;
+  result.reserve(n_atoms());
+  for (size_t i = 0; i < n_atoms(); ++i) {
+    result.emplace_back(m_mean[3 * i], m_mean[3 * i + 1], m_mean[3 * i + 2]);
+  }
+  return result;
+}
+
+std::vector<double> CoordStatistics::rmsf() const {
+  std::vector<double> result(n_atoms());
+  if (m_n_frames == 0) {
+    return result;
+  }
+  for (size_t i = 0; i < n_atoms(); ++i) {
+    result[i] = std::sqrt(m_m2.segment<3>(3 * i).sum() / m_n_frames);
+  }
+  return result;
+}
+
+Eigen::MatrixXd CoordStatistics::covariance() const {
+  if (!m_covariance) {
+    throw GeomError("CoordStatistics: covariance was not requested on construction");
+  }
+  Eigen::MatrixXd result = m_comoment;
+  size_t n_frames = m_covariance_n_frames;
+  if (m_block_n_frames > 0) {
+    // pending frames are folded into result, accumulator stays intact
+    Eigen::VectorXd mean = m_covariance_mean;
+    Eigen::MatrixXd block = m_block.leftCols(m_block_n_frames);
+    fold_block(result, mean, n_frames, block);
+    n_frames += m_block_n_frames;
+  }
+  result.triangularView<Eigen::StrictlyUpper>() = result.transpose();
+  if (n_frames > 0) {
+    result /= n_frames;
+  }
+  return result;
+}
@@ -0,0 +1,138 @@
+#include "xmol/algo/MultiTauCorrelator.h"
+
+using namespace xmol;
+using namespace xmol::algo;
+using namespace xmol::geom;
+
+namespace {
+
+/// Weights of tensor components (xx, yy, zz, xy, xz, yz) in scalar product of symmetric tensors
+constexpr double component_weights[MultiTauCorrelator::n_components] = {1, 1, 1, 2, 2, 2};
+
+} // namespace
+
+MultiTauCorrelator::MultiTauCorrelator(size_t n_vectors, AutoCorrelationMode mode, size_t points_per_level,
+                                       size_t averaging)
+    : m_n_vectors(n_vectors), m_mode(mode), m_points(points_per_level), m_averaging(averaging),
+      m_tensors(n_vectors * n_components) {
+  if (n_vectors == 0) {
+    throw GeomError("MultiTauCorrelator: n_vectors must be positive");
+  }
+  if (averaging < 2) {
+    throw GeomError("MultiTauCorrelator: averaging (=" + std::to_string(averaging) + ") must be at least 2");
+  }
+  if (points_per_level < averaging || points_per_level % averaging != 0) {
+    throw GeomError("MultiTauCorrelator: points_per_level (=" + std::to_string(points_per_level) +
+                    ") must be positive multiple of averaging (=" + std::to_string(averaging) + ")");
+  }
+}
+
+void MultiTauCorrelator::update(const future::Span<XYZ>& vectors) {
+  if (vectors.size() != m_n_vectors) {
+    throw GeomError("MultiTauCorrelator: vectors.size (=" + std::to_string(vectors.size()) +
+                    ") != n_vectors (=" + std::to_string(m_n_vectors) + ")");
+  }
+  // P2(cos(u,v)) = 3/2 * (u u^T - I/3) : (v v^T - I/3) for unit vectors, so correlation of the traceless
+  // tensor reproduces sum of spherical harmonics correlations and allows block averaging
+  for (size_t i = 0; i < m_n_vectors; ++i) {
+    const double len = vectors[i].len();
+    if (len == 0) {
+      // correlator state is not modified yet, frame is rejected as a whole
+      throw GeomError("MultiTauCorrelator: vector #" + std::to_string(i) + " has zero length");
+    }
+    const XYZ u = vectors[i] / len;
+    const double scale = m_mode == AutoCorrelationMode::NORMALIZE_AND_DIVIDE_BY_CUBE ? 1.0 / (len * len * len) : 1.0;
+    double* t = m_tensors.data() + i * n_components;
+    t[0] = scale * (u.x() * u.x() - 1.0 / 3);
+    t[1] = scale * (u.y() * u.y() - 1.0 / 3);
+    t[2] = scale * (u.z() * u.z() - 1.0 / 3);
+    t[3] = scale * u.x() * u.y();
+    t[4] = scale * u.x() * u.z();
+    t[5] = scale * u.y() * u.z();
+  }
+  ++m_n_frames;
+  add(0, m_tensors.data());
+}
+
+void MultiTauCorrelator::add(size_t level_index, const double* tensors) {
+  const size_t stride = m_n_vectors * n_components;
+  while (true) {
+    if (level_index == m_levels.size()) {
+      Level& level = m_levels.emplace_back();
+      level.values.resize(m_points * stride);
+      level.correlation.resize(m_points * m_n_vectors);
+      level.counts.resize(m_points);
+      level.accumulator.resize(stride);
+    }
+    Level& level = m_levels[level_index];
+    const size_t position = level.n_values % m_points;
+    std::copy(tensors, tensors + stride, level.values.begin() + position * stride);
+    ++level.n_values;
+
+    for (size_t lag = first_lag(level_index); lag < std::min(m_points, level.n_values); ++lag) {
+      const double* previous = level.values.data() + (position + m_points - lag) % m_points * stride;
+      double* correlation = level.correlation.data() + lag * m_n_vectors;
+      for (size_t i = 0; i < m_n_vectors; ++i) {
+        double product = 0;
+        for (size_t c = 0; c < n_components; ++c) {
+          product += component_weights[c] * tensors[i * n_components + c] * previous[i * n_components + c];
+        }
+        correlation[i] += product;
+      }
+      ++level.counts[lag];
+    }
+
+    for (size_t k = 0; k < stride; ++k) {
+      level.accumulator[k] += tensors[k];
+    }
+    if (++level.n_accumulated < m_averaging) {
+      return;
+    }
+    // tensors of current level are consumed, buffer can be reused for block average
+    for (size_t k = 0; k < stride; ++k) {
+      m_tensors[k] = level.accumulator[k] / m_averaging;
+    }
+    std::fill(level.accumulator.begin(), level.accumulator.end(), 0.0);
+    level.n_accumulated = 0;
+    tensors = m_tensors.data();
+    ++level_index;
+  }
+}
+
+void MultiTauCorrelator::reset() {
+  m_levels.clear();
+  m_n_frames = 0;
+}
+
+std::vector<size_t> MultiTauCorrelator::lags() const {
+  std::vector<size_t> result;
+  size_t spacing = 1;
+  for (size_t level_index = 0; level_index < m_levels.size(); ++level_index) {
+    for (size_t lag = first_lag(level_index); lag < m_points; ++lag) {
+      if (m_levels[level_index].counts[lag] > 0) {
+        result.push_back(lag * spacing);
+      }
+    }
+    spacing *= m_averaging;
+  }
+  return result;
+}
+
+std::vector<double> MultiTauCorrelator::correlation() const {
+  const size_t n_lags = lags().size();
+  std::vector<double> result(m_n_vectors * n_lags);
+  size_t column = 0;
+  for (size_t level_index = 0; level_index < m_levels.size(); ++level_index) {
+    const Level& level = m_levels[level_index];
+    for (size_t lag = first_lag(level_index); lag < m_points; ++lag) {
+      if (level.counts[lag] == 0) {
+        continue;
+      }
+      for (size_t i = 0; i < m_n_vectors; ++i) {
+        result[i * n_lags + column] = 1.5 * level.correlation[lag * m_n_vectors + i] / level.counts[lag];
+      }
+      ++column;
+    }
+  }
+  return result;
+}
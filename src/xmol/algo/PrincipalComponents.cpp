@@ -0,0 +1,140 @@
+#include "xmol/algo/PrincipalComponents.h"
+#include "xmol/algo/alignment-impl.h"
+#include "xmol/utils/parallel.h"
+
+using namespace xmol;
+using namespace xmol::algo;
+using namespace xmol::geom;
+
+namespace {
+
+/// Number of frames projected by single matrix product
+constexpr size_t block_size = 64;
+
+} // namespace
+
+PrincipalComponents::PrincipalComponents(const CoordStatistics& statistics, size_t n_components,
+                                         const future::Span<const double>& masses) {
+  const size_t n_atoms = statistics.n_atoms();
+  if (statistics.n_frames() < 2) {
+    throw GeomError("PrincipalComponents: at least two frames are required");
+  }
+  if (n_components == 0 || n_components > 3 * n_atoms) {
+    throw GeomError("PrincipalComponents: n_components (=" + std::to_string(n_components) +
+                    ") must be in range [1, 3 * n_atoms]");
+  }
+  if (!masses.empty() && masses.size() != n_atoms) {
+    throw GeomError("PrincipalComponents: masses.size (=" + std::to_string(masses.size()) + ") != n_atoms (=" +
+                    std::to_string(n_atoms) + ")");
+  }
+  m_mean.resize(3 * n_atoms);
+  auto mean = statistics.mean();
+  for (size_t i = 0; i < n_atoms; ++i) {
+    m_mean.segment<3>(3 * i) = mean[i]._eigen();
+  }
+  m_weights = Eigen::VectorXd::Ones(3 * n_atoms);
+  for (size_t i = 0; i < masses.size(); ++i) {
+    m_weights.segment<3>(3 * i).setConstant(std::sqrt(masses[i]));
+  }
+
+  Eigen::MatrixXd covariance = statistics.covariance();
+  covariance = m_weights.asDiagonal() * covariance * m_weights.asDiagonal();
+  m_total_variance = covariance.trace();
+
+  // eigenvalues are in increasing order
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(covariance);
+  if (solver.info() != Eigen::Success) {
+    throw GeomError("PrincipalComponents: eigendecomposition failed");
+  }
+  m_eigenvalues = solver.eigenvalues().tail(n_components).reverse();
+  m_modes = solver.eigenvectors().rightCols(n_components).rowwise().reverse();
+}
+
+void PrincipalComponents::project_block(const Eigen::Ref<const Eigen::MatrixXd>& block, double* result) const {
+  Eigen::MatrixXd centered = (block.colwise() - m_mean).array().colwise() * m_weights.array();
+  Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>(result, block.cols(),
+                                                                                    n_components())
+      .noalias() = centered.transpose() * m_modes;
+}
+
+void PrincipalComponents::project(const future::Span<XYZ>& frames, future::Span<double> result,
+                                  int n_threads) const {
+  if (frames.size() % n_atoms() != 0) {
+    throw GeomError("PrincipalComponents: frames.size (=" + std::to_string(frames.size()) +
+                    ") is not multiple of n_atoms (=" + std::to_string(n_atoms()) + ")");
+  }
+  const size_t n_frames = frames.size() / n_atoms();
+  if (result.size() != n_frames * n_components()) {
+    throw GeomError("PrincipalComponents: result.size (=" + std::to_string(result.size()) +
+                    ") != n_frames * n_components (=" + std::to_string(n_frames * n_components()) + ")");
+  }
+  // frames are contiguous, so block of frames is a column-major `3 * n_atoms x n_block` matrix
+  const double* data = frames.empty() ? nullptr : frames[0]._eigen().data();
+  utils::parallel_for((n_frames + block_size - 1) / block_size, n_threads, [&](size_t block, int) {
+    const size_t first = block * block_size;
+    const size_t n_block = std::min(block_size, n_frames - first);
+    Eigen::Map<const Eigen::MatrixXd> block_coords(data + first * 3 * n_atoms(), 3 * n_atoms(), n_block);
+    project_block(block_coords, result.data() + first * n_components());
+  });
+}
+
+void PrincipalComponents::project(trajectory::Trajectory::Slice& slice, const std::vector<AtomIndex>& indices,
+                                  future::Span<double> result, int n_threads, bool align) const {
+  if (indices.size() != n_atoms()) {
+    throw GeomError("PrincipalComponents: indices.size (=" + std::to_string(indices.size()) + ") != n_atoms (=" +
+                    std::to_string(n_atoms()) + ")");
+  }
+  for (auto index : indices) {
+    if (index < 0 || index >= slice.n_atoms()) {
+      throw GeomError("PrincipalComponents: atom index " + std::to_string(index) + " is out of range");
+    }
+  }
+  if (result.size() != slice.size() * n_components()) {
+    throw GeomError("PrincipalComponents: result.size (=" + std::to_string(result.size()) +
+                    ") != n_frames * n_components (=" + std::to_string(slice.size() * n_components()) + ")");
+  }
+  // frames are read serially into buffer of several blocks which are then projected in parallel
+  const size_t buffer_frames = block_size * utils::resolve_n_threads(n_threads);
+  std::vector<XYZ> buffer;
+  buffer.reserve(buffer_frames * n_atoms());
+  size_t n_projected = 0;
+  auto flush = [&] {
+    const size_t n_buffered = buffer.size() / n_atoms();
+    project(future::Span(buffer), future::Span(result.data() + n_projected * n_components(),
+                                               n_buffered * n_components()),
+            n_threads);
+    n_projected += n_buffered;
+    buffer.clear();
+  };
+  if (align && n_atoms() < 3) {
+    throw GeomError("PrincipalComponents: alignment requires at least 3 atoms");
+  }
+  CoordEigenMatrix reference(n_atoms(), 3);
+  for (size_t k = 0; k < n_atoms(); ++k) {
+    reference.row(k) = m_mean.segment<3>(3 * k);
+  }
+  const Eigen::RowVector3d reference_center = reference.colwise().mean();
+  reference.rowwise() -= reference_center;
+
+  CoordEigenMatrix variable(n_atoms(), 3);
+  for (auto& frame : slice) {
+    auto coords = frame.coords();
+    auto X = coords._eigen();
+    for (size_t k = 0; k < n_atoms(); ++k) {
+      variable.row(k) = X.row(indices[k]);
+    }
+    if (align) {
+      variable.rowwise() -= variable.colwise().mean().eval();
+      const Eigen::Matrix3d rotation =
+          calc_alignment_precentered_impl(reference, variable).get_underlying_matrix();
+      variable = (variable * rotation.transpose()).rowwise() + reference_center;
+    }
+    for (size_t k = 0; k < n_atoms(); ++k) {
+      buffer.emplace_back(variable.row(k));
+    }
+    if (buffer.size() == buffer_frames * n_atoms()) {
+      flush();
+    }
+  }
+  flush();
+}
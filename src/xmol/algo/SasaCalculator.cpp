@@ -0,0 +1,129 @@
+#include "xmol/algo/SasaCalculator.h"
+#include "xmol/Frame.h"
+#include "xmol/proxy/spans.h"
+#include "xmol/utils/parallel.h"
+#include <numeric>
+
+using namespace xmol;
+using namespace xmol::algo;
+
+SasaCalculator::SasaCalculator(double solvent_radius, double skin, double tolerance, SasaMethod method,
+                               int n_samples, int n_threads)
+    : m_solvent_radius(solvent_radius), m_skin(skin), m_tolerance(tolerance), m_method(method),
+      m_n_samples(n_samples), m_n_threads(n_threads) {
+  if (n_samples <= 0) {
+    throw geom::GeomError("SasaCalculator: n_samples must be positive");
+  }
+  if (tolerance < 0) {
+    throw geom::GeomError("SasaCalculator: tolerance must be non-negative");
+  }
+  const size_t n_workers = utils::resolve_n_threads(n_threads);
+  m_lee_richards_scratch.resize(n_workers);
+  m_shrake_rupley_scratch.resize(n_workers);
+}
+
+future::Span<const double> SasaCalculator::update(Frame& frame) {
+  auto coords = frame.coords();
+  future::Span<geom::XYZ> coord_span(reinterpret_cast<geom::XYZ*>(coords._eigen().data()), coords.size());
+  m_frame_radii.clear();
+  for (auto atom : frame.atoms()) {
+    m_frame_radii.push_back(atom.vdw_radius());
+  }
+  return update(coord_span, future::Span(m_frame_radii));
+}
+
+future::Span<const double> SasaCalculator::update(const future::Span<geom::XYZ>& coords,
+                                                  const future::Span<double>& radii) {
+  if (coords.size() != radii.size()) {
+    throw geom::GeomError("SasaCalculator: coords.size() != radii.size()");
+  }
+  if (!m_neighbours || radii.size() != m_radii.size() || !std::equal(radii.begin(), radii.end(), m_radii.begin())) {
+    set_radii(radii);
+  }
+  const bool rebuilt = m_neighbours->update(coords);
+  const size_t n = coords.size();
+
+  m_dirty.clear();
+  if (rebuilt || m_reference.size() != n) {
+    m_reference.assign(coords.begin(), coords.end());
+    m_dirty.resize(n);
+    std::iota(m_dirty.begin(), m_dirty.end(), 0);
+  } else {
+    const double tolerance2 = m_tolerance * m_tolerance;
+    m_moved.assign(n, false);
+    for (size_t i = 0; i < n; ++i) {
+      m_moved[i] = coords[i].distance2(m_reference[i]) > tolerance2;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      bool dirty = m_moved[i];
+      for (int j : m_neighbours->neighbours(i)) {
+        dirty = dirty || m_moved[j];
+      }
+      if (dirty) {
+        m_dirty.push_back(i);
+      }
+    }
+    for (size_t i = 0; i < n; ++i) {
+      if (m_moved[i]) {
+        m_reference[i] = coords[i];
+      }
+    }
+  }
+  m_sasa.resize(n);
+
+  constexpr size_t chunk = 64;
+  utils::parallel_for((m_dirty.size() + chunk - 1) / chunk, m_n_threads, [&](size_t task, int worker) {
+    for (size_t k = task * chunk; k < std::min(m_dirty.size(), (task + 1) * chunk); ++k) {
+      const int i = m_dirty[k];
+      auto candidates = m_neighbours->neighbours(i);
+      if (m_method == SasaMethod::LEE_RICHARDS) {
+        m_sasa[i] = calc_atom_sasa_lee_richards_impl(coords, future::Span(m_radii), m_solvent_radius, i, candidates,
+                                                     m_n_samples, m_lee_richards_scratch[worker]);
+      } else {
+        auto& scratch = m_shrake_rupley_scratch[worker];
+        const double R = m_radii[i] + m_solvent_radius;
+        auto radius_class = m_sphere_points.find(R);
+        if (radius_class == m_sphere_points.end() && scratch.points.radius != R) {
+          scratch.points = SpherePoints(m_n_samples, R);
+        }
+        const SpherePoints& points = radius_class == m_sphere_points.end() ? scratch.points : radius_class->second;
+        m_sasa[i] = calc_atom_sasa_shrake_rupley_impl(coords, future::Span(m_radii), m_solvent_radius, i,
+                                                      candidates, points, scratch);
+      }
+    }
+  });
+  m_n_updated_atoms = m_dirty.size();
+  return sasa();
+}
+
+void SasaCalculator::reset() {
+  m_neighbours.reset();
+  m_radii.clear();
+  m_reference.clear();
+  m_sasa.clear();
+  m_sphere_points.clear();
+  m_n_updated_atoms = 0;
+}
+
+void SasaCalculator::set_radii(const future::Span<double>& radii) {
+  m_radii.assign(radii.begin(), radii.end());
+  m_reference.clear();
+  const double max_radius = std::accumulate(m_radii.begin(), m_radii.end(), 0.0,
+                                            [](const double& a, const double& b) { return std::max(a, b); });
+  const double cutoff = 2 * (max_radius + m_solvent_radius) + lee_richards_touch_margin;
+  m_neighbours.emplace(cutoff, m_skin, geom::NeighbourList::Mode::FULL);
+  m_sphere_points.clear();
+  if (m_method == SasaMethod::SHRAKE_RUPLEY) {
+    // point sets are shared by atoms of same radius unless radii take too many distinct values
+    constexpr size_t max_radius_classes = 256;
+    for (size_t i = 0; i < m_radii.size() && m_sphere_points.size() <= max_radius_classes; ++i) {
+      m_sphere_points.try_emplace(m_radii[i] + m_solvent_radius);
+    }
+    if (m_sphere_points.size() > max_radius_classes) {
+      m_sphere_points.clear();
+    }
+    for (auto& [radius, points] : m_sphere_points) {
+      points = SpherePoints(m_n_samples, radius);
+    }
+  }
+}
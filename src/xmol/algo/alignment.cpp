@@ -53,6 +53,30 @@ Transformation3d calc_alignment_atoms_impl(AtomsA& reference, AtomsB& variable)
   return calc_alignment_weighted_impl(reference.coords()._eigen(), variable.coords()._eigen(), mass_map);
 }
 
+template <typename AtomsA, typename AtomsB>
+double calc_weighted_fitted_rmsd_atoms_impl(AtomsA& reference, AtomsB& variable) {
+  if (reference.size() != variable.size()) {
+    throw xmol::geom::GeomError("can't calc rmsd on atom selections of different size");
+  }
+  std::vector<double> mass;
+  mass.reserve(reference.size());
+
+  auto it2 = variable.begin();
+  bool mass_mismatch = false;
+  for (auto&& x : reference) {
+    mass.push_back(x.mass());
+    mass_mismatch |= x.mass() != (it2->mass());
+    ++it2;
+  }
+
+  if (mass_mismatch) {
+    throw xmol::geom::GeomError("Mass of atoms is different."
+                                "If you want ignore mass use rmsd of coordinates instead.");
+  }
+  Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, 1>> mass_map(mass.data(), mass.size(), 1);
+  return calc_fitted_rmsd_weighted_impl(reference.coords()._eigen(), variable.coords()._eigen(), mass_map);
+}
+
 template <typename Atoms> Eigen::Matrix3d calc_intertia_tensor_atoms_impl(Atoms& reference) {
   std::vector<double> mass;
   mass.reserve(reference.size());
@@ -105,6 +129,32 @@ double xmol::algo::calc_rmsd(proxy::CoordSelection& reference, proxy::CoordSelec
   return calc_rmsd_impl(reference._eigen(), variable._eigen());
 }
 
+double xmol::algo::calc_fitted_rmsd(proxy::CoordSpan& reference, proxy::CoordSpan& variable) {
+  return calc_fitted_rmsd_impl(reference._eigen(), variable._eigen());
+}
+double xmol::algo::calc_fitted_rmsd(proxy::CoordSpan& reference, proxy::CoordSelection& variable) {
+  return calc_fitted_rmsd_impl(reference._eigen(), variable._eigen());
+}
+double xmol::algo::calc_fitted_rmsd(proxy::CoordSelection& reference, proxy::CoordSpan& variable) {
+  return calc_fitted_rmsd_impl(reference._eigen(), variable._eigen());
+}
+double xmol::algo::calc_fitted_rmsd(proxy::CoordSelection& reference, proxy::CoordSelection& variable) {
+  return calc_fitted_rmsd_impl(reference._eigen(), variable._eigen());
+}
+
+double xmol::algo::calc_weighted_fitted_rmsd(proxy::AtomSpan& reference, proxy::AtomSpan& variable) {
+  return calc_weighted_fitted_rmsd_atoms_impl(reference, variable);
+}
+double xmol::algo::calc_weighted_fitted_rmsd(proxy::AtomSpan& reference, proxy::AtomSelection& variable) {
+  return calc_weighted_fitted_rmsd_atoms_impl(reference, variable);
+}
+double xmol::algo::calc_weighted_fitted_rmsd(proxy::AtomSelection& reference, proxy::AtomSpan& variable) {
+  return calc_weighted_fitted_rmsd_atoms_impl(reference, variable);
+}
+double xmol::algo::calc_weighted_fitted_rmsd(proxy::AtomSelection& reference, proxy::AtomSelection& variable) {
+  return calc_weighted_fitted_rmsd_atoms_impl(reference, variable);
+}
+
 double xmol::algo::calc_weighted_rmsd(proxy::AtomSpan& reference, proxy::AtomSpan& variable) {
   return calc_weighted_rmsd_atoms_impl(reference, variable);
 }
@@ -140,3 +190,124 @@ Eigen::Matrix3d xmol::algo::calc_inertia_tensor(xmol::proxy::AtomSelection& atom
 Eigen::Matrix3d xmol::algo::calc_inertia_tensor(xmol::proxy::AtomSpan& atoms) {
   return calc_intertia_tensor_atoms_impl(atoms);
 }
+
+double xmol::algo::calc_rmsd_qcp_impl(const Eigen::Matrix3d& A, double E0, double total_weight, Rotation3d* rotation) {
+  constexpr double eigenvalue_precision = 1e-11;
+  constexpr double eigenvector_precision = 1e-6;
+
+  const double Sxx = A(0, 0), Sxy = A(0, 1), Sxz = A(0, 2);
+  const double Syx = A(1, 0), Syy = A(1, 1), Syz = A(1, 2);
+  const double Szx = A(2, 0), Szy = A(2, 1), Szz = A(2, 2);
+
+  const double Sxx2 = Sxx * Sxx, Syy2 = Syy * Syy, Szz2 = Szz * Szz;
+  const double Sxy2 = Sxy * Sxy, Syz2 = Syz * Syz, Sxz2 = Sxz * Sxz;
+  const double Syx2 = Syx * Syx, Szy2 = Szy * Szy, Szx2 = Szx * Szx;
+
+  const double SyzSzymSyySzz2 = 2.0 * (Syz * Szy - Syy * Szz);
+  const double Sxx2Syy2Szz2Syz2Szy2 = Syy2 + Szz2 - Sxx2 + Syz2 + Szy2;
+
+  const double SxzpSzx = Sxz + Szx, SyzpSzy = Syz + Szy, SxypSyx = Sxy + Syx;
+  const double SyzmSzy = Syz - Szy, SxzmSzx = Sxz - Szx, SxymSyx = Sxy - Syx;
+  const double SxxpSyy = Sxx + Syy, SxxmSyy = Sxx - Syy;
+  const double Sxy2Sxz2Syx2Szx2 = Sxy2 + Sxz2 - Syx2 - Szx2;
+
+  // coefficients of characteristic polynomial x^4 + c2 x^2 + c1 x + c0 of the key 4x4 matrix
+  const double c2 = -2.0 * (Sxx2 + Syy2 + Szz2 + Sxy2 + Syx2 + Sxz2 + Szx2 + Syz2 + Szy2);
+  const double c1 =
+      8.0 * (Sxx * Syz * Szy + Syy * Szx * Sxz + Szz * Sxy * Syx - Sxx * Syy * Szz - Syz * Szx * Sxy - Szy * Syx * Sxz);
+  const double c0 = Sxy2Sxz2Syx2Szx2 * Sxy2Sxz2Syx2Szx2 +
+                    (Sxx2Syy2Szz2Syz2Szy2 + SyzSzymSyySzz2) * (Sxx2Syy2Szz2Syz2Szy2 - SyzSzymSyySzz2) +
+                    (-(SxzpSzx) * (SyzmSzy) + (SxymSyx) * (SxxmSyy - Szz)) *
+                        (-(SxzmSzx) * (SyzpSzy) + (SxymSyx) * (SxxmSyy + Szz)) +
+                    (-(SxzpSzx) * (SyzpSzy) - (SxypSyx) * (SxxpSyy - Szz)) *
+                        (-(SxzmSzx) * (SyzmSzy) - (SxypSyx) * (SxxpSyy + Szz)) +
+                    (+(SxypSyx) * (SyzpSzy) + (SxzpSzx) * (SxxmSyy + Szz)) *
+                        (-(SxymSyx) * (SyzmSzy) + (SxzpSzx) * (SxxpSyy + Szz)) +
+                    (+(SxypSyx) * (SyzmSzy) + (SxzmSzx) * (SxxmSyy - Szz)) *
+                        (-(SxymSyx) * (SyzpSzy) + (SxzmSzx) * (SxxpSyy - Szz));
+
+  // Newton-Raphson iterations for the largest eigenvalue starting from its upper bound E0
+  double lambda = E0;
+  for (int i = 0; i < 50; ++i) {
+    const double prev = lambda;
+    const double x2 = lambda * lambda;
+    const double b = (x2 + c2) * lambda;
+    const double a = b + c1;
+    lambda -= (a * lambda + c0) / (2.0 * x2 * lambda + b + a);
+    if (std::fabs(lambda - prev) < std::fabs(eigenvalue_precision * lambda)) {
+      break;
+    }
+  }
+
+  const double rmsd = std::sqrt(std::fabs(2.0 * (E0 - lambda) / total_weight));
+
+  if (!rotation) {
+    return rmsd;
+  }
+
+  // Eigenvector of the largest eigenvalue from adjoint of (K - lambda I)
+  const double a11 = SxxpSyy + Szz - lambda, a12 = SyzmSzy, a13 = -SxzmSzx, a14 = SxymSyx;
+  const double a21 = SyzmSzy, a22 = SxxmSyy - Szz - lambda, a23 = SxypSyx, a24 = SxzpSzx;
+  const double a31 = a13, a32 = a23, a33 = Syy - Sxx - Szz - lambda, a34 = SyzpSzy;
+  const double a41 = a14, a42 = a24, a43 = a34, a44 = Szz - SxxpSyy - lambda;
+  const double a3344_4334 = a33 * a44 - a43 * a34, a3244_4234 = a32 * a44 - a42 * a34;
+  const double a3243_4233 = a32 * a43 - a42 * a33, a3143_4133 = a31 * a43 - a41 * a33;
+  const double a3144_4134 = a31 * a44 - a41 * a34, a3142_4132 = a31 * a42 - a41 * a32;
+
+  double q1 = a22 * a3344_4334 - a23 * a3244_4234 + a24 * a3243_4233;
+  double q2 = -a21 * a3344_4334 + a23 * a3144_4134 - a24 * a3143_4133;
+  double q3 = a21 * a3244_4234 - a22 * a3144_4134 + a24 * a3142_4132;
+  double q4 = -a21 * a3243_4233 + a22 * a3143_4133 - a23 * a3142_4132;
+  double qsqr = q1 * q1 + q2 * q2 + q3 * q3 + q4 * q4;
+
+  // fall back to other columns of adjoint matrix when the first one degenerates
+  if (qsqr < eigenvector_precision) {
+    q1 = a12 * a3344_4334 - a13 * a3244_4234 + a14 * a3243_4233;
+    q2 = -a11 * a3344_4334 + a13 * a3144_4134 - a14 * a3143_4133;
+    q3 = a11 * a3244_4234 - a12 * a3144_4134 + a14 * a3142_4132;
+    q4 = -a11 * a3243_4233 + a12 * a3143_4133 - a13 * a3142_4132;
+    qsqr = q1 * q1 + q2 * q2 + q3 * q3 + q4 * q4;
+
+    if (qsqr < eigenvector_precision) {
+      const double a1324_1423 = a13 * a24 - a14 * a23, a1224_1422 = a12 * a24 - a14 * a22;
+      const double a1223_1322 = a12 * a23 - a13 * a22, a1124_1421 = a11 * a24 - a14 * a21;
+      const double a1123_1321 = a11 * a23 - a13 * a21, a1122_1221 = a11 * a22 - a12 * a21;
+
+      q1 = a42 * a1324_1423 - a43 * a1224_1422 + a44 * a1223_1322;
+      q2 = -a41 * a1324_1423 + a43 * a1124_1421 - a44 * a1123_1321;
+      q3 = a41 * a1224_1422 - a42 * a1124_1421 + a44 * a1122_1221;
+      q4 = -a41 * a1223_1322 + a42 * a1123_1321 - a43 * a1122_1221;
+      qsqr = q1 * q1 + q2 * q2 + q3 * q3 + q4 * q4;
+
+      if (qsqr < eigenvector_precision) {
+        q1 = a32 * a1324_1423 - a33 * a1224_1422 + a34 * a1223_1322;
+        q2 = -a31 * a1324_1423 + a33 * a1124_1421 - a34 * a1123_1321;
+        q3 = a31 * a1224_1422 - a32 * a1124_1421 + a34 * a1122_1221;
+        q4 = -a31 * a1223_1322 + a32 * a1123_1321 - a33 * a1122_1221;
+        qsqr = q1 * q1 + q2 * q2 + q3 * q3 + q4 * q4;
+
+        if (qsqr < eigenvector_precision) {
+          // coordinates are already superimposed
+          *rotation = Rotation3d(Eigen::Matrix3d::Identity());
+          return rmsd;
+        }
+      }
+    }
+  }
+
+  const double normq = std::sqrt(qsqr);
+  q1 /= normq;
+  q2 /= normq;
+  q3 /= normq;
+  q4 /= normq;
+
+  const double a2 = q1 * q1, x2 = q2 * q2, y2 = q3 * q3, z2 = q4 * q4;
+  const double xy = q2 * q3, az = q1 * q4, zx = q4 * q2, ay = q1 * q3, yz = q3 * q4, ax = q1 * q2;
+
+  Eigen::Matrix3d R;
+  R << a2 + x2 - y2 - z2, 2 * (xy + az), 2 * (zx - ay), //
+      2 * (xy - az), a2 - x2 + y2 - z2, 2 * (yz + ax),  //
+      2 * (zx + ay), 2 * (yz - ax), a2 - x2 - y2 + z2;
+  *rotation = Rotation3d(R);
+  return rmsd;
+}
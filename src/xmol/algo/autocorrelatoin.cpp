@@ -1,4 +1,5 @@
 #include "xmol/algo/vector-correlation.h"
+#include "xmol/utils/parallel.h"
 
 #include "unsupported/Eigen/FFT"
 #include <iostream>
@@ -38,61 +39,75 @@ void divide_by_cube(const xmol::future::Span<xmol::geom::XYZ>& v, std::vector<st
   }
 }
 
-void autocorr(std::vector<std::complex<double>>& series, std::vector<std::complex<double>>& tmp) {
-
+/// FFT plan and buffers reused between vector series of same length
+struct AutoCorrelationWorkspace {
   Eigen::FFT<double> fft;
-
-  fft.fwd(tmp, series);
-  for (auto& x : tmp) {
-    x *= std::conj(x);
+  std::vector<std::complex<double>> Y;
+  std::vector<std::complex<double>> tmp;
+  std::vector<std::complex<double>> power; /// weighted sum of power spectra of harmonics
+};
+
+/// Add weighted power spectrum of zero-padded series stored in `workspace.Y`
+void add_power_spectrum(AutoCorrelationWorkspace& workspace, double weight) {
+  workspace.fft.fwd(workspace.tmp, workspace.Y);
+  for (size_t i = 0; i < workspace.tmp.size(); ++i) {
+    workspace.power[i] += weight * std::norm(workspace.tmp[i]);
   }
-  fft.inv(series, tmp);
 }
 
-} // namespace
-void xmol::algo::calc_autocorr_order_2(const xmol::future::Span<xmol::geom::XYZ>& v, xmol::future::Span<double> result,
-                                       const AutoCorrelationMode& mode) {
+void calc_autocorr_order_2_impl(const xmol::future::Span<XYZ>& v, xmol::future::Span<double> result,
+                                const AutoCorrelationMode& mode, AutoCorrelationWorkspace& workspace) {
   const long long limit = result.size();
   long long N = v.size();
 
-  std::vector<std::complex<double>> Y(2 * N);
-  std::vector<std::complex<double>> tmp(2 * N);
-
-  std::fill(Y.begin() + N, Y.end(), 0);
-
-  ::calc_Y20(v, Y);
-  if (mode == AutoCorrelationMode::NORMALIZE_AND_DIVIDE_BY_CUBE) {
-    divide_by_cube(v, Y);
+  auto& Y = workspace.Y;
+  Y.resize(2 * N);
+  workspace.tmp.resize(2 * N);
+  workspace.power.assign(2 * N, 0);
+
+  // Sum of harmonic autocorrelations is inverse transform of sum of their power spectra
+  for (auto [calc_Y, weight] : {std::make_pair(::calc_Y20, 1.0), std::make_pair(::calc_Y21, 2.0),
+                                std::make_pair(::calc_Y22, 2.0)}) {
+    std::fill(Y.begin() + N, Y.end(), 0);
+    calc_Y(v, Y);
+    if (mode == AutoCorrelationMode::NORMALIZE_AND_DIVIDE_BY_CUBE) {
+      divide_by_cube(v, Y);
+    }
+    add_power_spectrum(workspace, weight);
   }
-  ::autocorr(Y, tmp);
+  workspace.fft.inv(Y, workspace.power);
 
   for (long long i = 0; i < limit; i++) {
-    result[i] = Y[i].real();
+    result[i] = Y[i].real() * 4 * M_PI / 5.0 / (N - i);
   }
+}
 
-  std::fill(Y.begin() + N, Y.end(), 0);
-  ::calc_Y21(v, Y);
-  if (mode == AutoCorrelationMode::NORMALIZE_AND_DIVIDE_BY_CUBE) {
-    divide_by_cube(v, Y);
-  }
-  ::autocorr(Y, tmp);
+} // namespace
 
-  for (long long i = 0; i < limit; i++) {
-    result[i] += 2 * Y[i].real();
-  }
+void xmol::algo::calc_autocorr_order_2(const xmol::future::Span<xmol::geom::XYZ>& v, xmol::future::Span<double> result,
+                                       const AutoCorrelationMode& mode) {
+  AutoCorrelationWorkspace workspace;
+  calc_autocorr_order_2_impl(v, result, mode, workspace);
+}
 
-  std::fill(Y.begin() + N, Y.end(), 0);
-  ::calc_Y22(v, Y);
-  if (mode == AutoCorrelationMode::NORMALIZE_AND_DIVIDE_BY_CUBE) {
-    divide_by_cube(v, Y);
+void xmol::algo::calc_autocorr_order_2(const future::Span<geom::XYZ>& vectors, size_t n_vectors,
+                                       future::Span<double> result, const AutoCorrelationMode& mode, int n_threads) {
+  if (n_vectors == 0) {
+    return;
   }
-  ::autocorr(Y, tmp);
-
-  for (long long i = 0; i < limit; i++) {
-    result[i] += 2 * Y[i].real();
+  if (vectors.size() % n_vectors != 0) {
+    throw GeomError("calc_autocorr_order_2: vectors.size (=" + std::to_string(vectors.size()) +
+                    ") is not multiple of n_vectors (=" + std::to_string(n_vectors) + ")");
   }
-
-  for (long long i = 0; i < limit; i++) {
-    result[i] *= 4 * M_PI / 5.0 / (N - i);
+  const size_t n_frames = vectors.size() / n_vectors;
+  const size_t limit = result.size() / n_vectors;
+  if (result.size() % n_vectors != 0 || limit > n_frames) {
+    throw GeomError("calc_autocorr_order_2: result.size (=" + std::to_string(result.size()) +
+                    ") must be n_vectors * limit with limit <= n_frames (=" + std::to_string(n_frames) + ")");
   }
-}
\ No newline at end of file
+  std::vector<AutoCorrelationWorkspace> workspaces(utils::resolve_n_threads(n_threads));
+  utils::parallel_for(n_vectors, n_threads, [&](size_t i, int worker) {
+    calc_autocorr_order_2_impl(future::Span<XYZ>(vectors.data() + i * n_frames, n_frames),
+                               future::Span<double>(result.data() + i * limit, limit), mode, workspaces[worker]);
+  });
+}
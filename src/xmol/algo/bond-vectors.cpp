@@ -0,0 +1,64 @@
+#include "xmol/algo/bond-vectors.h"
+#include "xmol/algo/alignment-impl.h"
+
+using namespace xmol;
+using namespace xmol::geom;
+
+namespace {
+
+void check_index(AtomIndex index, size_t n_atoms) {
+  if (index < 0 || index >= n_atoms) {
+    throw GeomError("extract_bond_vectors: atom index " + std::to_string(index) + " is out of range");
+  }
+}
+
+} // namespace
+
+void xmol::algo::extract_bond_vectors(trajectory::Trajectory::Slice& slice,
+                                      const std::vector<std::pair<AtomIndex, AtomIndex>>& pairs,
+                                      future::Span<XYZ> result, const future::Span<XYZ>& reference,
+                                      const std::vector<AtomIndex>& alignment_indices) {
+  const size_t n_frames = slice.size();
+  if (result.size() != pairs.size() * n_frames) {
+    throw GeomError("extract_bond_vectors: result.size (=" + std::to_string(result.size()) +
+                    ") != n_pairs * n_frames (=" + std::to_string(pairs.size() * n_frames) + ")");
+  }
+  if (reference.size() != alignment_indices.size()) {
+    throw GeomError("extract_bond_vectors: reference.size (=" + std::to_string(reference.size()) +
+                    ") != alignment_indices.size (=" + std::to_string(alignment_indices.size()) + ")");
+  }
+  for (auto& [first, second] : pairs) {
+    check_index(first, slice.n_atoms());
+    check_index(second, slice.n_atoms());
+  }
+  for (auto index : alignment_indices) {
+    check_index(index, slice.n_atoms());
+  }
+
+  const bool align = !reference.empty();
+  CoordEigenMatrix reference_coords(reference.size(), 3);
+  CoordEigenMatrix variable_coords(reference.size(), 3);
+  for (size_t k = 0; k < reference.size(); ++k) {
+    reference_coords.row(k) = reference[k]._eigen();
+  }
+  reference_coords.rowwise() -= reference_coords.colwise().mean().eval();
+
+  size_t frame_index = 0;
+  for (auto& frame : slice) {
+    auto coords = frame.coords();
+    auto X = coords._eigen();
+    affine::Rotation3d rotation;
+    if (align) {
+      for (size_t k = 0; k < alignment_indices.size(); ++k) {
+        variable_coords.row(k) = X.row(alignment_indices[k]);
+      }
+      variable_coords.rowwise() -= variable_coords.colwise().mean().eval();
+      rotation = calc_alignment_precentered_impl(reference_coords, variable_coords);
+    }
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      const XYZ v(X.row(pairs[i].second) - X.row(pairs[i].first));
+      result[i * n_frames + frame_index] = align ? rotation.transform(v) : v;
+    }
+    ++frame_index;
+  }
+}
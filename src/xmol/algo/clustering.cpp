@@ -0,0 +1,459 @@
+#include "xmol/algo/clustering.h"
+#include "xmol/algo/alignment-impl.h"
+#include "xmol/algo/pairwise-rmsd.h"
+#include "xmol/utils/parallel.h"
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+using namespace xmol;
+using namespace xmol::algo;
+
+namespace {
+
+/// Number of frames with given size of condensed matrix
+size_t condensed_n_frames(size_t condensed_size) {
+  const auto n = static_cast<size_t>(std::round((1 + std::sqrt(1 + 8.0 * condensed_size)) / 2));
+  if (n * (n - 1) / 2 != condensed_size) {
+    throw std::runtime_error("clustering: condensed matrix size (=" + std::to_string(condensed_size) +
+                             ") is not n * (n - 1) / 2");
+  }
+  return n;
+}
+
+/// Renumber clusters by decreasing size and find medoids (if not known)
+Clustering make_clustering(DistanceMatrix& distances, std::vector<int> labels, std::vector<size_t> medoids = {}) {
+  int n_clusters = 0;
+  for (int label : labels) {
+    n_clusters = std::max(n_clusters, label + 1);
+  }
+  std::vector<size_t> cluster_size(n_clusters);
+  for (int label : labels) {
+    ++cluster_size[label];
+  }
+  if (medoids.empty()) {
+    std::vector<double> best_sum(n_clusters, std::numeric_limits<double>::infinity());
+    medoids.resize(n_clusters);
+    for (size_t i = 0; i < labels.size(); ++i) {
+      auto row = distances.row(i);
+      double sum = 0;
+      for (size_t j = 0; j < labels.size(); ++j) {
+        if (labels[j] == labels[i]) {
+          sum += row[j];
+        }
+      }
+      if (sum < best_sum[labels[i]]) {
+        best_sum[labels[i]] = sum;
+        medoids[labels[i]] = i;
+      }
+    }
+  }
+  std::vector<int> order(n_clusters);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return cluster_size[a] > cluster_size[b] || (cluster_size[a] == cluster_size[b] && medoids[a] < medoids[b]);
+  });
+  std::vector<int> new_label(n_clusters);
+  Clustering result;
+  for (int k = 0; k < n_clusters; ++k) {
+    new_label[order[k]] = k;
+    result.medoids.push_back(medoids[order[k]]);
+  }
+  for (int& label : labels) {
+    label = new_label[label];
+  }
+  result.labels = std::move(labels);
+  return result;
+}
+
+/// Member with least sum of distances to other members, only distances within cluster are evaluated
+size_t cluster_medoid(DistanceMatrix& distances, const std::vector<size_t>& members) {
+  std::vector<double> sum(members.size(), 0.0);
+  for (size_t a = 0; a < members.size(); ++a) {
+    for (size_t b = a + 1; b < members.size(); ++b) {
+      const double d = distances.distance(members[a], members[b]);
+      sum[a] += d;
+      sum[b] += d;
+    }
+  }
+  return members[std::min_element(sum.begin(), sum.end()) - sum.begin()];
+}
+
+/// Disjoint set of frames and merged clusters
+struct DisjointSet {
+  explicit DisjointSet(size_t n) : parent(n) { std::iota(parent.begin(), parent.end(), 0); }
+  size_t find(size_t i) {
+    while (parent[i] != i) {
+      i = parent[i] = parent[parent[i]];
+    }
+    return i;
+  }
+  std::vector<size_t> parent;
+};
+
+/// Convert unsorted merges of frame representatives into scipy-like sorted dendrogram
+std::vector<LinkageStep> make_linkage(size_t n, std::vector<LinkageStep> merges) {
+  std::stable_sort(merges.begin(), merges.end(),
+                   [](const LinkageStep& a, const LinkageStep& b) { return a.distance < b.distance; });
+  DisjointSet set(n);
+  std::vector<size_t> cluster_id(n);
+  std::vector<size_t> cluster_size(n, 1);
+  std::iota(cluster_id.begin(), cluster_id.end(), 0);
+  for (size_t step = 0; step < merges.size(); ++step) {
+    auto& merge = merges[step];
+    const size_t a = set.find(merge.first);
+    const size_t b = set.find(merge.second);
+    merge.first = std::min(cluster_id[a], cluster_id[b]);
+    merge.second = std::max(cluster_id[a], cluster_id[b]);
+    merge.size = cluster_size[a] + cluster_size[b];
+    set.parent[b] = a;
+    cluster_id[a] = n + step;
+    cluster_size[a] = merge.size;
+  }
+  return merges;
+}
+
+std::vector<LinkageStep> calc_single_linkage(DistanceMatrix& distances) {
+  const size_t n = distances.size();
+  std::vector<LinkageStep> merges;
+  std::vector<double> min_distance(n, std::numeric_limits<double>::infinity());
+  std::vector<size_t> nearest(n, 0);
+  std::vector<bool> in_tree(n, false);
+  size_t current = 0;
+  for (size_t step = 0; step + 1 < n; ++step) {
+    in_tree[current] = true;
+    auto row = distances.row(current);
+    size_t next = n;
+    for (size_t j = 0; j < n; ++j) {
+      if (in_tree[j]) {
+        continue;
+      }
+      if (row[j] < min_distance[j]) {
+        min_distance[j] = row[j];
+        nearest[j] = current;
+      }
+      if (next == n || min_distance[j] < min_distance[next]) {
+        next = j;
+      }
+    }
+    merges.push_back({nearest[next], next, min_distance[next], 0});
+    current = next;
+  }
+  return make_linkage(n, std::move(merges));
+}
+
+/// Nearest-neighbour chain algorithm on dense matrix with Lance-Williams updates (complete or average linkage)
+std::vector<LinkageStep> calc_nn_chain_linkage(DistanceMatrix& distances, Linkage method) {
+  assert(method == Linkage::COMPLETE || method == Linkage::AVERAGE);
+  const size_t n = distances.size();
+  std::vector<double> D(condensed_size(n));
+  auto d = [&](size_t i, size_t j) -> double& {
+    return i < j ? D[condensed_index(n, i, j)] : D[condensed_index(n, j, i)];
+  };
+  for (size_t i = 0; i < n; ++i) {
+    auto row = distances.row(i);
+    std::copy(row.begin() + i + 1, row.end(), D.begin() + condensed_index(n, i, i + 1));
+  }
+  std::vector<size_t> size(n, 1);
+  std::vector<bool> active(n, true);
+  std::vector<size_t> chain;
+  std::vector<LinkageStep> merges;
+  while (merges.size() + 1 < n) {
+    if (chain.empty()) {
+      chain.push_back(std::find(active.begin(), active.end(), true) - active.begin());
+    }
+    size_t a, b;
+    while (true) {
+      a = chain.back();
+      const size_t prev = chain.size() > 1 ? chain[chain.size() - 2] : n;
+      b = prev;
+      double best = prev == n ? std::numeric_limits<double>::infinity() : d(a, prev);
+      for (size_t x = 0; x < n; ++x) {
+        if (active[x] && x != a && d(a, x) < best) {
+          best = d(a, x);
+          b = x;
+        }
+      }
+      if (b == prev) {
+        break;
+      }
+      chain.push_back(b);
+    }
+    chain.pop_back();
+    chain.pop_back();
+    merges.push_back({a, b, d(a, b), 0});
+    active[a] = false;
+    for (size_t x = 0; x < n; ++x) {
+      if (!active[x] || x == b) {
+        continue;
+      }
+      if (method == Linkage::COMPLETE) {
+        d(b, x) = std::max(d(a, x), d(b, x));
+      } else {
+        d(b, x) = (size[a] * d(a, x) + size[b] * d(b, x)) / (size[a] + size[b]);
+      }
+    }
+    size[b] += size[a];
+  }
+  return make_linkage(n, std::move(merges));
+}
+
+Clustering cut_linkage(DistanceMatrix& distances, const std::vector<LinkageStep>& linkage, size_t n_merges) {
+  const size_t n = distances.size();
+  if (linkage.size() + 1 != n) {
+    throw std::runtime_error("clustering: linkage size (=" + std::to_string(linkage.size()) +
+                             ") doesn't match number of frames (=" + std::to_string(n) + ")");
+  }
+  DisjointSet set(2 * n - 1);
+  for (size_t step = 0; step < n_merges; ++step) {
+    if (linkage[step].first >= n + step || linkage[step].second >= n + step) {
+      throw std::runtime_error("clustering: linkage step " + std::to_string(step) +
+                               " refers to cluster which is not formed yet");
+    }
+    set.parent[linkage[step].first] = n + step;
+    set.parent[linkage[step].second] = n + step;
+  }
+  std::vector<int> labels(n);
+  std::unordered_map<size_t, int> root_label;
+  for (size_t i = 0; i < n; ++i) {
+    labels[i] = root_label.emplace(set.find(i), root_label.size()).first->second;
+  }
+  return make_clustering(distances, std::move(labels));
+}
+
+} // namespace
+
+CondensedDistanceMatrix::CondensedDistanceMatrix(future::Span<const double> condensed)
+    : m_condensed(condensed), m_size(condensed_n_frames(condensed.size())), m_row(m_size) {}
+
+double CondensedDistanceMatrix::distance(size_t i, size_t j) {
+  if (i == j) {
+    return 0;
+  }
+  return i < j ? m_condensed[condensed_index(m_size, i, j)] : m_condensed[condensed_index(m_size, j, i)];
+}
+
+future::Span<const double> CondensedDistanceMatrix::row(size_t i) {
+  for (size_t j = 0; j < i; ++j) {
+    m_row[j] = m_condensed[condensed_index(m_size, j, i)];
+  }
+  m_row[i] = 0;
+  if (i + 1 < m_size) {
+    auto first = m_condensed.begin() + condensed_index(m_size, i, i + 1);
+    std::copy(first, first + (m_size - i - 1), m_row.begin() + i + 1);
+  }
+  return future::Span<const double>(m_row.data(), m_row.size());
+}
+
+CachedRmsdMatrix::CachedRmsdMatrix(const future::Span<geom::XYZ>& frames, size_t n_atoms, size_t cache_rows,
+                                   int n_threads)
+    : m_n_atoms(n_atoms), m_cache_rows(std::max<size_t>(1, cache_rows)), m_n_threads(n_threads) {
+  if (n_atoms == 0 || frames.size() % n_atoms != 0) {
+    throw geom::GeomError("CachedRmsdMatrix: frames.size (=" + std::to_string(frames.size()) +
+                          ") is not multiple of n_atoms (=" + std::to_string(n_atoms) + ")");
+  }
+  const size_t n_frames = frames.size() / n_atoms;
+  m_coords = Eigen::Map<const CoordEigenMatrix>(frames.data()->_eigen().data(), frames.size(), 3);
+  m_half_norm2.resize(n_frames);
+  for (size_t i = 0; i < n_frames; ++i) {
+    auto X = m_coords.middleRows(i * n_atoms, n_atoms);
+    X.rowwise() -= X.colwise().mean();
+    m_half_norm2[i] = X.squaredNorm() / 2;
+  }
+}
+
+double CachedRmsdMatrix::distance(size_t i, size_t j) {
+  if (i == j) {
+    return 0;
+  }
+  for (size_t k : {i, j}) {
+    auto it = m_cache_index.find(k);
+    if (it != m_cache_index.end()) {
+      return it->second->second[k == i ? j : i];
+    }
+  }
+  Eigen::Matrix3d A = m_coords.middleRows(i * m_n_atoms, m_n_atoms).transpose() *
+                      m_coords.middleRows(j * m_n_atoms, m_n_atoms);
+  return calc_rmsd_qcp_impl(A, m_half_norm2[i] + m_half_norm2[j], m_n_atoms);
+}
+
+future::Span<const double> CachedRmsdMatrix::row(size_t i) {
+  auto it = m_cache_index.find(i);
+  if (it != m_cache_index.end()) {
+    m_cache.splice(m_cache.begin(), m_cache, it->second);
+    return future::Span<const double>(m_cache.front().second.data(), size());
+  }
+  std::vector<double> values;
+  if (m_cache.size() == m_cache_rows) {
+    m_cache_index.erase(m_cache.back().first);
+    values = std::move(m_cache.back().second);
+    m_cache.pop_back();
+  }
+  values.resize(size());
+  constexpr size_t chunk = 64;
+  const auto X = m_coords.middleRows(i * m_n_atoms, m_n_atoms);
+  utils::parallel_for((size() + chunk - 1) / chunk, m_n_threads, [&](size_t task, int) {
+    for (size_t j = task * chunk; j < std::min(size(), (task + 1) * chunk); ++j) {
+      if (j == i) {
+        values[j] = 0;
+        continue;
+      }
+      Eigen::Matrix3d A = X.transpose() * m_coords.middleRows(j * m_n_atoms, m_n_atoms);
+      values[j] = calc_rmsd_qcp_impl(A, m_half_norm2[i] + m_half_norm2[j], m_n_atoms);
+    }
+  });
+  ++m_n_computed_rows;
+  m_cache.emplace_front(i, std::move(values));
+  m_cache_index[i] = m_cache.begin();
+  return future::Span<const double>(m_cache.front().second.data(), size());
+}
+
+Clustering xmol::algo::gromos_clustering(DistanceMatrix& distances, double cutoff) {
+  const size_t n = distances.size();
+  std::vector<size_t> offsets{0};
+  std::vector<size_t> neighbours;
+  for (size_t i = 0; i < n; ++i) {
+    auto row = distances.row(i);
+    for (size_t j = 0; j < n; ++j) {
+      if (j != i && row[j] <= cutoff) {
+        neighbours.push_back(j);
+      }
+    }
+    offsets.push_back(neighbours.size());
+  }
+  std::vector<size_t> count(n);
+  for (size_t i = 0; i < n; ++i) {
+    count[i] = offsets[i + 1] - offsets[i];
+  }
+  std::vector<int> labels(n, -1);
+  std::vector<size_t> medoids;
+  size_t n_unassigned = n;
+  std::vector<size_t> members;
+  while (n_unassigned > 0) {
+    size_t center = n;
+    for (size_t i = 0; i < n; ++i) {
+      if (labels[i] == -1 && (center == n || count[i] > count[center])) {
+        center = i;
+      }
+    }
+    const int label = medoids.size();
+    medoids.push_back(center);
+    members.assign({center});
+    labels[center] = label;
+    for (size_t k = offsets[center]; k < offsets[center + 1]; ++k) {
+      if (labels[neighbours[k]] == -1) {
+        labels[neighbours[k]] = label;
+        members.push_back(neighbours[k]);
+      }
+    }
+    n_unassigned -= members.size();
+    for (size_t m : members) {
+      for (size_t k = offsets[m]; k < offsets[m + 1]; ++k) {
+        if (labels[neighbours[k]] == -1) {
+          --count[neighbours[k]];
+        }
+      }
+    }
+  }
+  return make_clustering(distances, std::move(labels), std::move(medoids));
+}
+
+Clustering xmol::algo::k_medoids_clustering(DistanceMatrix& distances, size_t n_clusters, size_t max_iterations,
+                                            unsigned seed) {
+  const size_t n = distances.size();
+  if (n_clusters == 0 || n_clusters > n) {
+    throw std::runtime_error("k_medoids_clustering: n_clusters (=" + std::to_string(n_clusters) +
+                             ") must be in [1, n_frames] (n_frames=" + std::to_string(n) + ")");
+  }
+  std::mt19937 gen(seed);
+  std::vector<size_t> medoids{std::uniform_int_distribution<size_t>(0, n - 1)(gen)};
+  std::vector<double> nearest(n, std::numeric_limits<double>::infinity());
+  while (medoids.size() < n_clusters) {
+    auto row = distances.row(medoids.back());
+    std::vector<double> weights(n);
+    for (size_t j = 0; j < n; ++j) {
+      nearest[j] = std::min(nearest[j], row[j]);
+      weights[j] = nearest[j] * nearest[j];
+    }
+    for (size_t m : medoids) {
+      weights[m] = 0;
+    }
+    size_t next = 0;
+    if (std::all_of(weights.begin(), weights.end(), [](double w) { return w == 0; })) { // duplicated frames
+      while (std::find(medoids.begin(), medoids.end(), next) != medoids.end()) {
+        ++next;
+      }
+    } else {
+      next = std::discrete_distribution<size_t>(weights.begin(), weights.end())(gen);
+    }
+    medoids.push_back(next);
+  }
+
+  std::vector<int> labels(n);
+  std::vector<std::vector<size_t>> members(n_clusters);
+  std::vector<std::vector<size_t>> previous_members(n_clusters);
+  for (size_t iteration = 0; iteration < max_iterations; ++iteration) {
+    std::fill(nearest.begin(), nearest.end(), std::numeric_limits<double>::infinity());
+    for (size_t k = 0; k < n_clusters; ++k) {
+      auto row = distances.row(medoids[k]);
+      for (size_t j = 0; j < n; ++j) {
+        if (row[j] < nearest[j]) {
+          nearest[j] = row[j];
+          labels[j] = k;
+        }
+      }
+    }
+    for (size_t k = 0; k < n_clusters; ++k) {
+      labels[medoids[k]] = k;
+    }
+    for (auto& cluster : members) {
+      cluster.clear();
+    }
+    for (size_t i = 0; i < n; ++i) {
+      members[labels[i]].push_back(i);
+    }
+    auto new_medoids = medoids;
+    for (size_t k = 0; k < n_clusters; ++k) {
+      // medoid of cluster with same members is already known
+      if (members[k] != previous_members[k]) {
+        new_medoids[k] = cluster_medoid(distances, members[k]);
+      }
+    }
+    std::swap(members, previous_members);
+    if (new_medoids == medoids) {
+      break;
+    }
+    medoids = std::move(new_medoids);
+  }
+  return make_clustering(distances, std::move(labels), std::move(medoids));
+}
+
+std::vector<LinkageStep> xmol::algo::calc_linkage(DistanceMatrix& distances, Linkage method) {
+  if (distances.size() < 2) {
+    return {};
+  }
+  if (method == Linkage::SINGLE) {
+    return calc_single_linkage(distances);
+  }
+  return calc_nn_chain_linkage(distances, method);
+}
+
+Clustering xmol::algo::hierarchical_clustering(DistanceMatrix& distances, const std::vector<LinkageStep>& linkage,
+                                               size_t n_clusters) {
+  if (n_clusters == 0 || n_clusters > distances.size()) {
+    throw std::runtime_error("hierarchical_clustering: n_clusters (=" + std::to_string(n_clusters) +
+                             ") must be in [1, n_frames] (n_frames=" + std::to_string(distances.size()) + ")");
+  }
+  return cut_linkage(distances, linkage, distances.size() - n_clusters);
+}
+
+Clustering xmol::algo::hierarchical_clustering_by_distance(DistanceMatrix& distances,
+                                                           const std::vector<LinkageStep>& linkage, double threshold) {
+  size_t n_merges = 0;
+  while (n_merges < linkage.size() && linkage[n_merges].distance <= threshold) {
+    ++n_merges;
+  }
+  return cut_linkage(distances, linkage, n_merges);
+}
@@ -0,0 +1,121 @@
+#include "xmol/algo/pairwise-rmsd.h"
+#include "xmol/algo/alignment-impl.h"
+#include "xmol/utils/parallel.h"
+#include <cmath>
+
+using namespace xmol;
+using namespace xmol::algo;
+
+namespace {
+
+/// Precentered coordinates of frames stored frame after frame
+struct CenteredFrames {
+  CenteredFrames(size_t n_frames, size_t n_atoms)
+      : n_frames(n_frames), n_atoms(n_atoms), coords(n_frames * n_atoms, 3), half_norm2(n_frames) {}
+
+  void center(size_t frame) {
+    auto X = coords.middleRows(frame * n_atoms, n_atoms);
+    X.rowwise() -= X.colwise().mean();
+    half_norm2[frame] = X.squaredNorm() / 2;
+  }
+
+  size_t n_frames;
+  size_t n_atoms;
+  CoordEigenMatrix coords;
+  std::vector<double> half_norm2;
+};
+
+/// Row and column of @p k-th element of upper triangle (with diagonal) of `n x n` matrix stored row by row
+std::pair<size_t, size_t> upper_triangle_position(size_t n, size_t k) {
+  // rows before i-th hold i * n - i * (i - 1) / 2 elements, initial guess solves quadratic equation for i
+  auto row_begin = [n](size_t i) { return i * n - i * (i - 1) / 2; };
+  const double b = 2.0 * n + 1;
+  size_t i = static_cast<size_t>((b - std::sqrt(std::max(0.0, b * b - 8.0 * k))) / 2);
+  while (i > 0 && row_begin(i) > k) {
+    --i;
+  }
+  while (i + 1 < n && row_begin(i + 1) <= k) {
+    ++i;
+  }
+  return {i, i + (k - row_begin(i))};
+}
+
+template <typename T> void calc_pairwise_fitted_rmsd_impl(const CenteredFrames& frames, future::Span<T> result,
+                                                          int n_threads) {
+  const size_t n_frames = frames.n_frames;
+  const size_t n_atoms = frames.n_atoms;
+  if (result.size() != condensed_size(n_frames)) {
+    throw geom::GeomError("pairwise rmsd: result.size (=" + std::to_string(result.size()) +
+                          ") != n_frames * (n_frames - 1) / 2 (=" + std::to_string(condensed_size(n_frames)) + ")");
+  }
+  if (n_frames < 2) {
+    return;
+  }
+  // two tiles of frames should fit into L2 cache
+  constexpr size_t tile_bytes = 128 * 1024;
+  const size_t tile = std::max<size_t>(1, tile_bytes / (n_atoms * sizeof(geom::XYZ)));
+  const size_t n_tiles = (n_frames + tile - 1) / tile;
+
+  utils::parallel_for(n_tiles * (n_tiles + 1) / 2, n_threads, [&](size_t task, int) {
+    auto [ti, tj] = upper_triangle_position(n_tiles, task);
+    const size_t i_end = std::min(n_frames, (ti + 1) * tile);
+    const size_t j_end = std::min(n_frames, (tj + 1) * tile);
+    for (size_t i = ti * tile; i < i_end; ++i) {
+      auto X = frames.coords.middleRows(i * n_atoms, n_atoms);
+      for (size_t j = std::max(i + 1, tj * tile); j < j_end; ++j) {
+        auto Y = frames.coords.middleRows(j * n_atoms, n_atoms);
+        Eigen::Matrix3d A = X.transpose() * Y;
+        result[condensed_index(n_frames, i, j)] =
+            calc_rmsd_qcp_impl(A, frames.half_norm2[i] + frames.half_norm2[j], n_atoms);
+      }
+    }
+  });
+}
+
+} // namespace
+
+template <typename T>
+void xmol::algo::calc_pairwise_fitted_rmsd(const future::Span<geom::XYZ>& frames, size_t n_atoms, future::Span<T> result,
+                                           int n_threads) {
+  if (n_atoms == 0 || frames.size() % n_atoms != 0) {
+    throw geom::GeomError("pairwise rmsd: frames.size (=" + std::to_string(frames.size()) +
+                          ") is not multiple of n_atoms (=" + std::to_string(n_atoms) + ")");
+  }
+  const size_t n_frames = frames.size() / n_atoms;
+  CenteredFrames centered(n_frames, n_atoms);
+  centered.coords = Eigen::Map<const CoordEigenMatrix>(frames.data()->_eigen().data(), frames.size(), 3);
+  for (size_t i = 0; i < n_frames; ++i) {
+    centered.center(i);
+  }
+  calc_pairwise_fitted_rmsd_impl(centered, result, n_threads);
+}
+
+template <typename T>
+void xmol::algo::calc_pairwise_fitted_rmsd(trajectory::Trajectory::Slice& slice, const std::vector<AtomIndex>& indices,
+                                           future::Span<T> result, int n_threads) {
+  if (indices.empty()) {
+    throw geom::GeomError("pairwise rmsd: empty atom indices");
+  }
+  CenteredFrames centered(slice.size(), indices.size());
+  size_t frame_index = 0;
+  for (auto& frame : slice) {
+    auto coords = frame.coords();
+    auto X = coords._eigen();
+    for (size_t k = 0; k < indices.size(); ++k) {
+      if (indices[k] < 0 || indices[k] >= X.rows()) {
+        throw geom::GeomError("pairwise rmsd: atom index " + std::to_string(indices[k]) + " is out of range");
+      }
+      centered.coords.row(frame_index * indices.size() + k) = X.row(indices[k]);
+    }
+    centered.center(frame_index++);
+  }
+  calc_pairwise_fitted_rmsd_impl(centered, result, n_threads);
+}
+
+template void xmol::algo::calc_pairwise_fitted_rmsd<float>(const future::Span<geom::XYZ>&, size_t, future::Span<float>, int);
+template void xmol::algo::calc_pairwise_fitted_rmsd<double>(const future::Span<geom::XYZ>&, size_t, future::Span<double>,
+                                                            int);
+template void xmol::algo::calc_pairwise_fitted_rmsd<float>(trajectory::Trajectory::Slice&,
+                                                           const std::vector<AtomIndex>&, future::Span<float>, int);
+template void xmol::algo::calc_pairwise_fitted_rmsd<double>(trajectory::Trajectory::Slice&,
+                                                            const std::vector<AtomIndex>&, future::Span<double>, int);
@@ -0,0 +1,126 @@
+#include "xmol/algo/pbc.h"
+#include "xmol/proxy/selections.h"
+#include "xmol/proxy/spans.h"
+#include <queue>
+
+using namespace xmol;
+using namespace xmol::geom;
+using namespace xmol::proxy;
+
+namespace {
+
+future::Span<XYZ> as_span(CoordSpan& coords) {
+  return future::Span<XYZ>(reinterpret_cast<XYZ*>(coords._eigen().data()), coords.size());
+}
+
+/// Applies in-place span algorithm to scattered selection coordinates
+template <typename Function> void apply_to_selection(CoordSelection& coords, Function&& f) {
+  CoordEigenMatrix matrix = coords._eigen();
+  f(future::Span<XYZ>(reinterpret_cast<XYZ*>(matrix.data()), coords.size()));
+  coords._eigen(matrix);
+}
+
+std::vector<std::pair<int, int>> sequential_edges(size_t n) {
+  std::vector<std::pair<int, int>> edges;
+  edges.reserve(n);
+  for (int i = 1; i < n; ++i) {
+    edges.emplace_back(i - 1, i);
+  }
+  return edges;
+}
+
+std::vector<std::pair<int, int>> spanning_tree_edges(size_t n, const std::vector<std::pair<int, int>>& bonds) {
+  std::vector<std::vector<int>> adjacent(n);
+  for (auto& [a, b] : bonds) {
+    if (a < 0 || b < 0 || a >= n || b >= n) {
+      throw GeomError("unwrap_bonded: bond (" + std::to_string(a) + ", " + std::to_string(b) + ") is out of range");
+    }
+    adjacent[a].push_back(b);
+    adjacent[b].push_back(a);
+  }
+  std::vector<std::pair<int, int>> edges;
+  edges.reserve(n);
+  std::vector<bool> visited(n, false);
+  std::queue<int> queue;
+  for (int root = 0; root < n; ++root) {
+    if (visited[root]) {
+      continue;
+    }
+    visited[root] = true;
+    queue.push(root);
+    while (!queue.empty()) {
+      int a = queue.front();
+      queue.pop();
+      for (int b : adjacent[a]) {
+        if (!visited[b]) {
+          visited[b] = true;
+          edges.emplace_back(a, b);
+          queue.push(b);
+        }
+      }
+    }
+  }
+  return edges;
+}
+
+template <typename Molecules> void make_molecules_whole_impl(const UnitCell& cell, Molecules& molecules) {
+  std::vector<std::pair<int, int>> edges;
+  for (auto& mol : molecules) {
+    edges.clear();
+    int residue_first = 0;
+    int prev_residue_first = -1;
+    for (auto& residue : mol.residues()) {
+      if (prev_residue_first >= 0) {
+        edges.emplace_back(prev_residue_first, residue_first);
+      }
+      for (int i = 1; i < residue.size(); ++i) {
+        edges.emplace_back(residue_first, residue_first + i);
+      }
+      prev_residue_first = residue_first;
+      residue_first += residue.size();
+    }
+    auto coords = mol.coords();
+    cell.unwrap(as_span(coords), edges);
+  }
+}
+
+} // namespace
+
+void xmol::algo::wrap(const UnitCell& cell, CoordSpan& coords, const XYZ& origin) {
+  cell.wrap(as_span(coords), origin);
+}
+
+void xmol::algo::wrap(const UnitCell& cell, CoordSelection& coords, const XYZ& origin) {
+  apply_to_selection(coords, [&](future::Span<XYZ> span) { cell.wrap(span, origin); });
+}
+
+void xmol::algo::unwrap_sequential(const UnitCell& cell, CoordSpan& coords) {
+  cell.unwrap(as_span(coords), sequential_edges(coords.size()));
+}
+
+void xmol::algo::unwrap_sequential(const UnitCell& cell, CoordSelection& coords) {
+  auto edges = sequential_edges(coords.size());
+  apply_to_selection(coords, [&](future::Span<XYZ> span) { cell.unwrap(span, edges); });
+}
+
+void xmol::algo::unwrap_bonded(const UnitCell& cell, CoordSpan& coords, const std::vector<std::pair<int, int>>& bonds) {
+  cell.unwrap(as_span(coords), spanning_tree_edges(coords.size(), bonds));
+}
+
+void xmol::algo::unwrap_bonded(const UnitCell& cell, CoordSelection& coords,
+                               const std::vector<std::pair<int, int>>& bonds) {
+  auto edges = spanning_tree_edges(coords.size(), bonds);
+  apply_to_selection(coords, [&](future::Span<XYZ> span) { cell.unwrap(span, edges); });
+}
+
+void xmol::algo::make_molecules_whole(const UnitCell& cell, MoleculeSpan& molecules) {
+  make_molecules_whole_impl(cell, molecules);
+}
+
+void xmol::algo::make_molecules_whole(const UnitCell& cell, MoleculeSelection& molecules) {
+  make_molecules_whole_impl(cell, molecules);
+}
+
+void xmol::algo::calc_minimum_image(const UnitCell& cell, future::Span<XYZ> displacements) {
+  cell.minimum_image(displacements);
+}
@@ -1,14 +1,20 @@
-#include "xmol/algo/sasa.h"
+#include "xmol/algo/sasa-impl.h"
 #include "xmol/geom/SpatialIndex.h"
+#include "xmol/utils/parallel.h"
 #include <algorithm>
 #include <gsl/gsl_assert>
+#include <map>
 #include <numeric>
 
+using namespace xmol;
+using namespace xmol::algo;
 using namespace xmol::geom;
 
-void xmol::algo::calc_sasa(const future::Span<geom::XYZ>& coords, future::Span<double> coord_radii,
-                           double solvent_radii, future::Span<double> result, int n_samples,
-                           const future::Span<int>& sasa_points_indices) {
+namespace {
+
+/// Validate arguments, returns number of atoms to calculate area for
+size_t check_sasa_arguments(const future::Span<XYZ>& coords, const future::Span<double>& coord_radii,
+                            const future::Span<double>& result, const future::Span<int>& sasa_points_indices) {
   auto limit = sasa_points_indices.empty() ? coords.size() : sasa_points_indices.size();
   if (coords.size() != coord_radii.size()) {
     throw GeomError("xmol::algo::calc_sasa: coords.size() != radii.size()");
@@ -19,95 +25,265 @@ void xmol::algo::calc_sasa(const future::Span<geom::XYZ>& coords, future::Span<d
   if (limit != result.size()) {
     throw GeomError("xmol::algo::calc_sasa: result.size() != limit");
   }
-  const double max_radii = std::accumulate(coord_radii.begin(), coord_radii.end(), 0.0,
-                                           [](const double& a, const double& b) { return std::max(a, b); });
-  const double neighbour_cell_size = (max_radii + solvent_radii) * 2;
-
-  SpatialIndex spatial_index(coords, neighbour_cell_size);
+  for (int n : sasa_points_indices) {
+    if (GSL_UNLIKELY(n < 0 || n >= coords.size())) {
+      throw GeomError("xmol::geometry::calculate_sasa: invalid index `" + std::to_string(n) + "`");
+    }
+  }
+  return limit;
+}
 
-  auto segments_length = [](std::vector<std::pair<double, double>>& segments) {
-    double result = 0;
-    std::sort(segments.begin(), segments.end());
-    auto it = segments.begin();
-    if (it == segments.end()) {
-      return result;
+double segments_length(std::vector<std::pair<double, double>>& segments) {
+  double result = 0;
+  std::sort(segments.begin(), segments.end());
+  auto it = segments.begin();
+  if (it == segments.end()) {
+    return result;
+  }
+  auto prev = *it;
+  ++it;
+  while (it != segments.end()) {
+    if (it->first > prev.second) {
+      result += prev.second - prev.first;
+      prev = *it;
+    } else {
+      prev.second = std::max(prev.second, it->second);
     }
-    auto prev = *it;
     ++it;
-    while (it != segments.end()) {
-      if (it->first > prev.second) {
-        result += prev.second - prev.first;
-        prev = *it;
+  }
+  result += prev.second - prev.first;
+  return result;
+}
+
+/** Clear exposed flags of block points buried by neighbour, returns non-zero if some points are still exposed
+ *
+ * Flags are 64-bit integers (0 or 1) of same width as coordinates, so distance test, flag select and
+ * "any exposed" reduction are compiled to packed SIMD instructions (checked with `-fopt-info-vec` at -O2)
+ */
+int64_t bury_points(const SpherePoints& points, size_t block, const OcclusionNeighbour& neighbour,
+                    int64_t* exposed) {
+  const double* x = points.x.data() + block * SpherePoints::block_size;
+  const double* y = points.y.data() + block * SpherePoints::block_size;
+  const double* z = points.z.data() + block * SpherePoints::block_size;
+  const double nx = neighbour.x;
+  const double ny = neighbour.y;
+  const double nz = neighbour.z;
+  const double R2 = neighbour.R2;
+  int64_t any_exposed = 0;
+  for (size_t k = 0; k < SpherePoints::block_size; ++k) {
+    const double dx = x[k] - nx;
+    const double dy = y[k] - ny;
+    const double dz = z[k] - nz;
+    exposed[k] = dx * dx + dy * dy + dz * dz < R2 ? 0 : exposed[k];
+    any_exposed |= exposed[k];
+  }
+  return any_exposed;
+}
+
+} // namespace
+
+double xmol::algo::calc_atom_sasa_lee_richards_impl(const future::Span<XYZ>& coords,
+                                                    const future::Span<double>& coord_radii, double solvent_radii,
+                                                    int n, const future::Span<const int>& candidates, int n_samples,
+                                                    LeeRichardsScratch& scratch) {
+  double Rn = coord_radii[n] + solvent_radii;
+  double atom_area = 4 * M_PI * Rn * Rn;
+  double delta = 2 * Rn / n_samples;
+
+  // Spheres which do not intersect central one can't cover any of its slices,
+  // small margin keeps nearly touching spheres to reproduce rounding of slice test exactly
+  auto& neighbours = scratch.neighbours;
+  neighbours.clear();
+  for (int m : candidates) {
+    if (m == n) {
+      continue;
+    }
+    double Rm = coord_radii[m] + solvent_radii;
+    double max_overlap_distance = Rn + Rm + lee_richards_touch_margin;
+    if (coords[n].distance2(coords[m]) >= max_overlap_distance * max_overlap_distance) {
+      continue;
+    }
+    double dx = coords[m].x() - coords[n].x();
+    double dy = coords[m].y() - coords[n].y();
+    double d = std::sqrt(dx * dx + dy * dy);
+    neighbours.push_back({coords[n].z() - coords[m].z(), Rm, dx, dy, d, std::atan2(dy, dx)});
+  }
+
+  auto& segments = scratch.segments;
+  for (int slice_i = 0; slice_i < n_samples; ++slice_i) {
+    double dz = -Rn + delta / 2 + delta * slice_i;
+    double Rn_ = std::sqrt(Rn * Rn - dz * dz);
+    segments.clear();
+
+    for (auto& neighbour : neighbours) {
+      double Rm = neighbour.Rm;
+      double dz2 = neighbour.dz + dz;
+      if (std::fabs(dz2) >= Rm) {
+        continue;
+      }
+      double Rm_ = std::sqrt(Rm * Rm - dz2 * dz2);
+      double d = neighbour.d;
+
+      if (d >= Rn_ + Rm_) {
+        continue;
+      } // no overlap
+      if (Rn_ >= d + Rm_) {
+        continue;
+      }                     // second circle within first circle
+      if (Rm_ >= d + Rn_) { // first circle within second circle
+        segments.emplace_back(-M_PI, M_PI);
+        continue;
+      }
+
+      double alpha = std::acos((Rn_ * Rn_ + d * d - Rm_ * Rm_) / (2 * Rn_ * d));
+      double beta = neighbour.beta;
+
+      double l = beta - alpha;
+      double r = beta + alpha;
+
+      if (-M_PI < l && r < M_PI) {
+        segments.emplace_back(l, r);
+      } else if (l < -M_PI) {
+        segments.emplace_back(l + M_PI * 2, M_PI);
+        segments.emplace_back(-M_PI, r);
       } else {
-        prev.second = std::max(prev.second, it->second);
+        segments.emplace_back(l, M_PI);
+        segments.emplace_back(-M_PI, r - M_PI * 2);
       }
-      ++it;
     }
-    result += prev.second - prev.first;
-    return result;
-  };
+    atom_area -= segments_length(segments) * Rn * delta;
+  }
+  return atom_area;
+}
 
-  for (int i1 = 0; i1 < limit; ++i1) {
-    int n = sasa_points_indices.empty() ? i1 : sasa_points_indices[i1];
-    if (GSL_UNLIKELY(n < 0 && n >= coords.size())) {
-      throw GeomError("xmol::geometry::calculate_sasa: invalid index `" + std::to_string(n) + "`");
+SpherePoints::SpherePoints(size_t n_points, double radius)
+    : n_points(n_points), radius(radius), x(padded_size(n_points)), y(padded_size(n_points)),
+      z(padded_size(n_points)) {
+  const double golden_angle = M_PI * (3 - std::sqrt(5.0));
+  for (size_t i = 0; i < n_points; ++i) {
+    const double h = 1 - (2 * i + 1.0) / n_points;
+    const double r = std::sqrt(1 - h * h);
+    x[i] = radius * r * std::cos(golden_angle * i);
+    y[i] = radius * r * std::sin(golden_angle * i);
+    z[i] = radius * h;
+  }
+}
+
+double xmol::algo::calc_atom_sasa_shrake_rupley_impl(const future::Span<XYZ>& coords,
+                                                     const future::Span<double>& coord_radii, double solvent_radii,
+                                                     int n, const future::Span<const int>& candidates,
+                                                     const SpherePoints& points, ShrakeRupleyScratch& scratch) {
+  const double Rn = coord_radii[n] + solvent_radii;
+  auto& neighbours = scratch.neighbours;
+  neighbours.clear();
+  for (int m : candidates) {
+    if (m == n) {
+      continue;
+    }
+    const double Rm = coord_radii[m] + solvent_radii;
+    const XYZ r = coords[m] - coords[n];
+    const double distance2 = r.len2();
+    if (distance2 < (Rn + Rm) * (Rn + Rm)) {
+      neighbours.push_back({r.x(), r.y(), r.z(), Rm * Rm, distance2});
     }
+  }
+  // closest neighbours bury most of points, testing them first allows early exit
+  std::sort(neighbours.begin(), neighbours.end(),
+            [](const OcclusionNeighbour& a, const OcclusionNeighbour& b) { return a.distance2 < b.distance2; });
 
-    double Rn = coord_radii[n] + solvent_radii;
-    double atom_area = 4 * M_PI * Rn * Rn;
-
-    double delta = 2 * Rn / n_samples;
-    double max_distance = (coord_radii[n] + max_radii + 2 * solvent_radii);
-    std::vector<int> neigh_indecies = spatial_index.within(max_distance, coords[n]);
-
-    for (int slice_i = 0; slice_i < n_samples; ++slice_i) {
-      double dz = -Rn + delta / 2 + delta * slice_i;
-      double Rn_ = std::sqrt(Rn * Rn - dz * dz);
-      std::vector<std::pair<double, double>> segments;
-
-      for (int m : neigh_indecies) {
-        if (m == n) {
-          continue;
-        }
-        double Rm = coord_radii[m] + solvent_radii;
-        double dz2 = coords[n].z() - coords[m].z() + dz;
-        if (std::fabs(dz2) >= Rm) {
-          continue;
-        }
-        double Rm_ = std::sqrt(Rm * Rm - dz2 * dz2);
-        double dx = coords[m].x() - coords[n].x();
-        double dy = coords[m].y() - coords[n].y();
-        double d = std::sqrt(dx * dx + dy * dy);
-
-        if (d >= Rn_ + Rm_) {
-          continue;
-        } // no overlap
-        if (Rn_ >= d + Rm_) {
-          continue;
-        }                     // second circle within first circle
-        if (Rm_ >= d + Rn_) { // first circle within second circle
-          segments.emplace_back(-M_PI, M_PI);
-          continue;
-        }
-
-        double alpha = std::acos((Rn_ * Rn_ + d * d - Rm_ * Rm_) / (2 * Rn_ * d));
-        double beta = std::atan2(dy, dx);
-
-        double l = beta - alpha;
-        double r = beta + alpha;
-
-        if (-M_PI < l && r < M_PI) {
-          segments.emplace_back(l, r);
-        } else if (l < -M_PI) {
-          segments.emplace_back(l + M_PI * 2, M_PI);
-          segments.emplace_back(-M_PI, r);
-        } else {
-          segments.emplace_back(l, M_PI);
-          segments.emplace_back(-M_PI, r - M_PI * 2);
-        }
+  int64_t n_exposed = 0;
+  int64_t exposed[SpherePoints::block_size];
+  for (size_t block = 0; block < points.n_blocks(); ++block) {
+    // padding points of last block are never exposed
+    const size_t n_block_points = std::min(SpherePoints::block_size, points.n_points - block * SpherePoints::block_size);
+    std::fill(exposed, exposed + n_block_points, 1);
+    std::fill(exposed + n_block_points, exposed + SpherePoints::block_size, 0);
+    for (auto& neighbour : neighbours) {
+      if (!bury_points(points, block, neighbour, exposed)) {
+        break;
       }
-      atom_area -= segments_length(segments) * Rn * delta;
     }
-    result[i1] = atom_area;
+    n_exposed += std::accumulate(exposed, exposed + SpherePoints::block_size, int64_t{0});
   }
+  return 4 * M_PI * Rn * Rn * n_exposed / points.n_points;
+}
+
+void xmol::algo::calc_sasa(const future::Span<geom::XYZ>& coords, future::Span<double> coord_radii,
+                           double solvent_radii, future::Span<double> result, int n_samples,
+                           const future::Span<int>& sasa_points_indices, int n_threads) {
+  const size_t limit = check_sasa_arguments(coords, coord_radii, result, sasa_points_indices);
+  const double max_radii = std::accumulate(coord_radii.begin(), coord_radii.end(), 0.0,
+                                           [](const double& a, const double& b) { return std::max(a, b); });
+  const double neighbour_cell_size = (max_radii + solvent_radii) * 2;
+
+  const SpatialIndex spatial_index(coords, neighbour_cell_size);
+
+  struct Scratch {
+    SpatialIndex::indices_t indices;
+    LeeRichardsScratch buffers;
+  };
+  constexpr size_t chunk = 64;
+  std::vector<Scratch> scratch(utils::resolve_n_threads(n_threads));
+
+  utils::parallel_for((limit + chunk - 1) / chunk, n_threads, [&](size_t task, int worker) {
+    auto& [indices, buffers] = scratch[worker];
+    for (size_t i1 = task * chunk; i1 < std::min(limit, (task + 1) * chunk); ++i1) {
+      int n = sasa_points_indices.empty() ? i1 : sasa_points_indices[i1];
+      double max_distance = (coord_radii[n] + max_radii + 2 * solvent_radii);
+      spatial_index.within(max_distance, coords[n], indices);
+      result[i1] = calc_atom_sasa_lee_richards_impl(coords, coord_radii, solvent_radii, n,
+                                                    future::Span<const int>(indices.data(), indices.size()),
+                                                    n_samples, buffers);
+    }
+  });
+}
+
+void xmol::algo::calc_sasa_shrake_rupley(const future::Span<geom::XYZ>& coords, future::Span<double> coord_radii,
+                                         double solvent_radii, future::Span<double> result, int n_points,
+                                         const future::Span<int>& sasa_points_indices, int n_threads) {
+  const size_t limit = check_sasa_arguments(coords, coord_radii, result, sasa_points_indices);
+  if (n_points <= 0) {
+    throw GeomError("xmol::algo::calc_sasa_shrake_rupley: n_points must be positive");
+  }
+  const double max_radii = std::accumulate(coord_radii.begin(), coord_radii.end(), 0.0,
+                                           [](const double& a, const double& b) { return std::max(a, b); });
+  const SpatialIndex spatial_index(coords, (max_radii + solvent_radii) * 2);
+
+  // Atom radii usually take few distinct values, point sets of such radius classes are computed once
+  constexpr size_t max_radius_classes = 256;
+  std::map<double, SpherePoints> radius_classes;
+  for (size_t i1 = 0; i1 < limit && radius_classes.size() <= max_radius_classes; ++i1) {
+    int n = sasa_points_indices.empty() ? i1 : sasa_points_indices[i1];
+    radius_classes.try_emplace(coord_radii[n] + solvent_radii);
+  }
+  if (radius_classes.size() > max_radius_classes) {
+    radius_classes.clear();
+  }
+  for (auto& [radius, points] : radius_classes) {
+    points = SpherePoints(n_points, radius);
+  }
+
+  struct Scratch {
+    SpatialIndex::indices_t indices;
+    ShrakeRupleyScratch buffers;
+  };
+  constexpr size_t chunk = 64;
+  std::vector<Scratch> scratch(utils::resolve_n_threads(n_threads));
+
+  utils::parallel_for((limit + chunk - 1) / chunk, n_threads, [&](size_t task, int worker) {
+    auto& [indices, buffers] = scratch[worker];
+    for (size_t i1 = task * chunk; i1 < std::min(limit, (task + 1) * chunk); ++i1) {
+      int n = sasa_points_indices.empty() ? i1 : sasa_points_indices[i1];
+      const double Rn = coord_radii[n] + solvent_radii;
+      auto radius_class = radius_classes.find(Rn);
+      if (radius_class == radius_classes.end() && buffers.points.radius != Rn) {
+        buffers.points = SpherePoints(n_points, Rn);
+      }
+      const SpherePoints& points = radius_class == radius_classes.end() ? buffers.points : radius_class->second;
+      spatial_index.within(Rn + max_radii + solvent_radii, coords[n], indices);
+      result[i1] = calc_atom_sasa_shrake_rupley_impl(coords, coord_radii, solvent_radii, n,
+                                                     future::Span<const int>(indices.data(), indices.size()),
+                                                     points, buffers);
+    }
+  });
 }
@@ -0,0 +1,68 @@
+#include "xmol/geom/NeighbourList.h"
+#include <algorithm>
+
+using namespace xmol::geom;
+
+NeighbourList::NeighbourList(double cutoff, double skin, Mode mode) : m_cutoff(cutoff), m_skin(skin), m_mode(mode) {
+  if (cutoff <= 0) {
+    throw GeomError("NeighbourList: cutoff must be positive");
+  }
+  if (skin < 0) {
+    throw GeomError("NeighbourList: skin must be non-negative");
+  }
+}
+
+bool NeighbourList::update(const future::Span<XYZ>& coords) {
+  if (coords.size() != m_reference.size() || m_offsets.empty()) {
+    rebuild(coords);
+    return true;
+  }
+  const double max_displacement2 = m_skin * m_skin / 4;
+  for (size_t i = 0; i < coords.size(); ++i) {
+    if (coords[i].distance2(m_reference[i]) > max_displacement2) {
+      rebuild(coords);
+      return true;
+    }
+  }
+  return false;
+}
+
+void NeighbourList::rebuild(const future::Span<XYZ>& coords) {
+  const double radius = m_cutoff + m_skin;
+  SpatialIndex spatial_index(coords, radius);
+
+  m_reference.assign(coords.begin(), coords.end());
+  m_offsets.resize(coords.size() + 1);
+  m_neighbours.clear();
+  m_offsets[0] = 0;
+
+  SpatialIndex::indices_t candidates;
+  for (index_t i = 0; i < coords.size(); ++i) {
+    spatial_index.within(radius, coords[i], candidates);
+    std::sort(candidates.begin(), candidates.end());
+    auto first = std::upper_bound(candidates.begin(), candidates.end(), i);
+    if (m_mode == Mode::FULL) {
+      m_neighbours.insert(m_neighbours.end(), candidates.begin(), first - 1); // skip i itself
+    }
+    m_neighbours.insert(m_neighbours.end(), first, candidates.end());
+    m_offsets[i + 1] = m_neighbours.size();
+  }
+  ++m_n_rebuilds;
+}
+
+std::vector<NeighbourList::pair_t> NeighbourList::pairs_within_cutoff(const future::Span<XYZ>& coords) const {
+  if (coords.size() != size()) {
+    throw GeomError("NeighbourList: coords.size() (=" + std::to_string(coords.size()) +
+                    ") != list.size() (=" + std::to_string(size()) + ")");
+  }
+  const double cutoff2 = m_cutoff * m_cutoff;
+  std::vector<pair_t> result;
+  for (index_t i = 0; i < size(); ++i) {
+    for (index_t j : neighbours(i)) {
+      if (coords[i].distance2(coords[j]) < cutoff2) {
+        result.emplace_back(i, j);
+      }
+    }
+  }
+  return result;
+}
@@ -12,9 +12,15 @@ SpatialIndex::SpatialIndex(const xmol::future::Span<XYZ>& coords, double bin_sid
     m_bins[{to_bin_id(r.x()), to_bin_id(r.y()), to_bin_id(r.z())}].push_back(i);
   }
 }
-SpatialIndex::indices_t SpatialIndex::within(double distance, const XYZ& point) {
-  auto to_bin_id = [&](double x) { return int(std::round(x / m_bin_side_length)); };
+SpatialIndex::indices_t SpatialIndex::within(double distance, const XYZ& point) const {
   indices_t result;
+  within(distance, point, result);
+  return result;
+}
+
+void SpatialIndex::within(double distance, const XYZ& point, indices_t& result) const {
+  auto to_bin_id = [&](double x) { return int(std::round(x / m_bin_side_length)); };
+  result.clear();
 
   const int n_neigh_cells = std::ceil(distance / m_bin_side_length);
 
@@ -39,5 +45,4 @@ SpatialIndex::indices_t SpatialIndex::within(double distance, const XYZ& point)
       }
     }
   }
-  return result;
 }
@@ -21,7 +21,7 @@ UnitCell::ClosestImage UnitCell::closest_image_to(const XYZ& ref, const XYZ& var
       for (int dk = -1; dk < 2; dk++) {
         auto shift = translation_vector(i + di, j + dj, k + dk);
         auto length2 = (ref - (var + shift)).len2();
-        if (length2 < result.distance) {
+        if (length2 < distance2) {
           result.shift = shift;
           result.shift_int = std::make_tuple(i + di, j + dj, k + dk);
           distance2 = length2; // temporary store squared value
@@ -32,4 +32,59 @@ UnitCell::ClosestImage UnitCell::closest_image_to(const XYZ& ref, const XYZ& var
   return result;
 }
 
+XYZ UnitCell::minimum_image(const XYZ& delta, bool refine) const {
+  Eigen::Vector3d approx = *A_inv * Eigen::Vector3d(delta.dot(v[0]), delta.dot(v[1]), delta.dot(v[2]));
+  XYZ best = delta - translation_vector(std::round(approx[0]), std::round(approx[1]), std::round(approx[2]));
+  if (!refine) {
+    return best;
+  }
+  double best_distance2 = best.len2();
+  for (int di = -1; di < 2; di++)
+    for (int dj = -1; dj < 2; dj++)
+      for (int dk = -1; dk < 2; dk++) {
+        auto candidate = best - translation_vector(di, dj, dk);
+        auto length2 = candidate.len2();
+        if (length2 < best_distance2) {
+          best = candidate;
+          best_distance2 = length2;
+        }
+      }
+  return best;
+}
+
+void UnitCell::minimum_image(future::Span<XYZ> displacements) const {
+  if (!A_inv) {
+    update_matrix();
+  }
+  const bool refine = !is_rectangular();
+  for (auto& delta : displacements) {
+    delta = minimum_image(delta, refine);
+  }
+}
+
+void UnitCell::wrap(future::Span<XYZ> coords, const XYZ& origin) const {
+  if (!A_inv) {
+    update_matrix();
+  }
+  for (auto& r : coords) {
+    auto delta = r - origin;
+    Eigen::Vector3d approx = *A_inv * Eigen::Vector3d(delta.dot(v[0]), delta.dot(v[1]), delta.dot(v[2]));
+    r -= translation_vector(std::floor(approx[0]), std::floor(approx[1]), std::floor(approx[2]));
+  }
+}
+
+void UnitCell::unwrap(future::Span<XYZ> coords, const std::vector<std::pair<int, int>>& edges) const {
+  if (!A_inv) {
+    update_matrix();
+  }
+  const bool refine = !is_rectangular();
+  for (auto& [a, b] : edges) {
+    if (a < 0 || b < 0 || a >= coords.size() || b >= coords.size()) {
+      throw GeomError("UnitCell::unwrap: edge (" + std::to_string(a) + ", " + std::to_string(b) +
+                      ") is out of range");
+    }
+    coords[b] = coords[a] + minimum_image(coords[b] - coords[a], refine);
+  }
+}
+
 UnitCell UnitCell::unit_cubic_cell() { return UnitCell(geom::XYZ(1, 0, 0), geom::XYZ(0, 1, 0), geom::XYZ(0, 0, 1)); }
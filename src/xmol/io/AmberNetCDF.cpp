@@ -94,6 +94,14 @@ void xmol::io::AmberNetCDF::read_frame(size_t index, Frame& frame) {
     frame.cell = geom::UnitCell(lengths[0], lengths[1], lengths[2], geom::Degrees(angles[0]), geom::Degrees(angles[1]),
                                 geom::Degrees(angles[2]));
   }
+
+  if (m_has_time) {
+    float time;
+    size_t start[] = {static_cast<size_t>(m_current_frame)};
+    size_t count[] = {1};
+    check_netcdf_call(nc_get_vara_float(m_ncid, m_time_id, start, count, &time), NC_NOERR, "nc_get_vara_float");
+    frame.time = time;
+  }
 }
 
 void xmol::io::AmberNetCDF::advance(size_t shift) {
@@ -131,4 +139,6 @@ void AmberNetCDF::read_header() {
   auto cell_angles_status = nc_inq_varid(m_ncid, "cell_angles", &m_cell_angles_id);
 
   m_has_cell = cell_length_status == NC_NOERR && cell_angles_status == NC_NOERR;
+
+  m_has_time = nc_inq_varid(m_ncid, "time", &m_time_id) == NC_NOERR;
 }
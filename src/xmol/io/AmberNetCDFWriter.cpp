@@ -0,0 +1,231 @@
+#include "xmol/io/AmberNetCDFWriter.h"
+#include "xmol/Frame.h"
+#include "xmol/geom/AngleValue.h"
+#include "xmol_version_info.h"
+#include <algorithm>
+#include <netcdf.h>
+#include <utility>
+
+using namespace xmol::io;
+
+namespace {
+
+void check_netcdf_call(int status, const char* const nc_function_name) {
+  if (status != NC_NOERR) {
+    throw AmberNetCDFWriteError(std::string(nc_function_name) + " failed: " + nc_strerror(status));
+  }
+}
+
+void put_text_attr(int ncid, int varid, const char* name, const std::string& value) {
+  check_netcdf_call(nc_put_att_text(ncid, varid, name, value.size(), value.c_str()), "nc_put_att_text()");
+}
+
+} // namespace
+
+AmberNetCDFWriter::AmberNetCDFWriter(std::string filename, Format format, bool write_cell, size_t frames_per_chunk,
+                                     size_t atoms_per_chunk, int deflate_level, size_t buffer_frames)
+    : m_filename(std::move(filename)), m_format(format), m_write_cell(write_cell),
+      m_frames_per_chunk(frames_per_chunk), m_atoms_per_chunk(atoms_per_chunk), m_deflate_level(deflate_level),
+      m_buffer_frames(std::max<size_t>(buffer_frames, 1)) {
+  if (deflate_level < 0 || deflate_level > 9) {
+    throw AmberNetCDFWriteError("Deflate level must be in range [0, 9], got " + std::to_string(deflate_level));
+  }
+  if (frames_per_chunk == 0) {
+    throw AmberNetCDFWriteError("Number of frames per chunk must be positive");
+  }
+  if (format == Format::CLASSIC_64BIT && deflate_level > 0) {
+    throw AmberNetCDFWriteError("Compression requires NetCDF-4 format");
+  }
+  if (format == Format::NETCDF4) {
+    m_buffer_frames = std::max(m_buffer_frames, m_frames_per_chunk);
+  }
+
+  const int mode = NC_CLOBBER | (format == Format::NETCDF4 ? NC_NETCDF4 : NC_64BIT_OFFSET);
+  const int status = nc_create(m_filename.c_str(), mode, &m_ncid);
+  if (status != NC_NOERR) {
+    throw AmberNetCDFWriteError("Can't create `" + m_filename + "`: " + nc_strerror(status));
+  }
+  try {
+    put_text_attr(m_ncid, NC_GLOBAL, "Conventions", "AMBER");
+    put_text_attr(m_ncid, NC_GLOBAL, "ConventionVersion", "1.0");
+    put_text_attr(m_ncid, NC_GLOBAL, "program", "xmolpp2");
+    put_text_attr(m_ncid, NC_GLOBAL, "programVersion", xmol::version::version_number);
+  } catch (AmberNetCDFWriteError&) {
+    nc_close(m_ncid);
+    throw;
+  }
+}
+
+AmberNetCDFWriter::~AmberNetCDFWriter() {
+  try {
+    close();
+  } catch (AmberNetCDFWriteError&) {
+  }
+}
+
+void AmberNetCDFWriter::define(size_t n_atoms) {
+  m_n_atoms = n_atoms;
+
+  int frame_dim, spatial_dim, atom_dim;
+  check_netcdf_call(nc_def_dim(m_ncid, "frame", NC_UNLIMITED, &frame_dim), "nc_def_dim()");
+  check_netcdf_call(nc_def_dim(m_ncid, "spatial", 3, &spatial_dim), "nc_def_dim()");
+  check_netcdf_call(nc_def_dim(m_ncid, "atom", n_atoms, &atom_dim), "nc_def_dim()");
+
+  int spatial_id;
+  check_netcdf_call(nc_def_var(m_ncid, "spatial", NC_CHAR, 1, &spatial_dim, &spatial_id), "nc_def_var()");
+
+  check_netcdf_call(nc_def_var(m_ncid, "time", NC_FLOAT, 1, &frame_dim, &m_time_id), "nc_def_var()");
+  put_text_attr(m_ncid, m_time_id, "units", "picosecond");
+
+  const int coords_dims[] = {frame_dim, atom_dim, spatial_dim};
+  check_netcdf_call(nc_def_var(m_ncid, "coordinates", NC_FLOAT, 3, coords_dims, &m_coords_id), "nc_def_var()");
+  put_text_attr(m_ncid, m_coords_id, "units", "angstrom");
+
+  if (m_format == Format::NETCDF4) {
+    const size_t atoms_per_chunk =
+        std::max<size_t>(1, m_atoms_per_chunk == 0 ? n_atoms : std::min(m_atoms_per_chunk, n_atoms));
+    const size_t chunk[] = {m_frames_per_chunk, atoms_per_chunk, 3};
+    check_netcdf_call(nc_def_var_chunking(m_ncid, m_coords_id, NC_CHUNKED, chunk), "nc_def_var_chunking()");
+    if (m_deflate_level > 0) {
+      // shuffle filter groups bytes of same significance together and improves compression of floats
+      check_netcdf_call(nc_def_var_deflate(m_ncid, m_coords_id, 1, 1, m_deflate_level), "nc_def_var_deflate()");
+    }
+    // buffered frames span row of chunks along atom dimension, keep whole row in cache
+    const size_t n_row_chunks = (std::max<size_t>(n_atoms, 1) + atoms_per_chunk - 1) / atoms_per_chunk;
+    const size_t row_bytes = n_row_chunks * m_frames_per_chunk * atoms_per_chunk * 3 * sizeof(float);
+    check_netcdf_call(nc_set_var_chunk_cache(m_ncid, m_coords_id, row_bytes, 4 * n_row_chunks + 1, 0.75f),
+                      "nc_set_var_chunk_cache()");
+  }
+
+  int cell_spatial_id, cell_angular_id;
+  if (m_write_cell) {
+    int cell_spatial_dim, cell_angular_dim, label_dim;
+    check_netcdf_call(nc_def_dim(m_ncid, "cell_spatial", 3, &cell_spatial_dim), "nc_def_dim()");
+    check_netcdf_call(nc_def_dim(m_ncid, "cell_angular", 3, &cell_angular_dim), "nc_def_dim()");
+    check_netcdf_call(nc_def_dim(m_ncid, "label", 5, &label_dim), "nc_def_dim()");
+
+    check_netcdf_call(nc_def_var(m_ncid, "cell_spatial", NC_CHAR, 1, &cell_spatial_dim, &cell_spatial_id),
+                      "nc_def_var()");
+    const int cell_angular_dims[] = {cell_angular_dim, label_dim};
+    check_netcdf_call(nc_def_var(m_ncid, "cell_angular", NC_CHAR, 2, cell_angular_dims, &cell_angular_id),
+                      "nc_def_var()");
+
+    const int cell_lengths_dims[] = {frame_dim, cell_spatial_dim};
+    check_netcdf_call(nc_def_var(m_ncid, "cell_lengths", NC_DOUBLE, 2, cell_lengths_dims, &m_cell_lengths_id),
+                      "nc_def_var()");
+    put_text_attr(m_ncid, m_cell_lengths_id, "units", "angstrom");
+    const int cell_angles_dims[] = {frame_dim, cell_angular_dim};
+    check_netcdf_call(nc_def_var(m_ncid, "cell_angles", NC_DOUBLE, 2, cell_angles_dims, &m_cell_angles_id),
+                      "nc_def_var()");
+    put_text_attr(m_ncid, m_cell_angles_id, "units", "degree");
+  }
+
+  // every value is written, prefill is a waste of I/O
+  int old_fill_mode;
+  check_netcdf_call(nc_set_fill(m_ncid, NC_NOFILL, &old_fill_mode), "nc_set_fill()");
+  check_netcdf_call(nc_enddef(m_ncid), "nc_enddef()");
+
+  check_netcdf_call(nc_put_var_text(m_ncid, spatial_id, "xyz"), "nc_put_var_text()");
+  if (m_write_cell) {
+    check_netcdf_call(nc_put_var_text(m_ncid, cell_spatial_id, "abc"), "nc_put_var_text()");
+    check_netcdf_call(nc_put_var_text(m_ncid, cell_angular_id, "alphabeta gamma"), "nc_put_var_text()");
+  }
+
+  m_coords.resize(m_buffer_frames * n_atoms * 3);
+  m_time.resize(m_buffer_frames);
+  if (m_write_cell) {
+    m_cell_lengths.resize(m_buffer_frames * 3);
+    m_cell_angles.resize(m_buffer_frames * 3);
+  }
+  m_defined = true;
+}
+
+void AmberNetCDFWriter::check_not_failed() const {
+  if (m_failed) {
+    throw AmberNetCDFWriteError("Can't write to `" + m_filename + "` after previous write failure");
+  }
+}
+
+void AmberNetCDFWriter::write(xmol::Frame& frame) {
+  if (m_closed) {
+    throw AmberNetCDFWriteError("Can't write frame to closed file `" + m_filename + "`");
+  }
+  check_not_failed();
+  if (!m_defined) {
+    // unit cubic cell is placeholder of frame without box (see PdbWriter), 1 angstrom box would be imaged by AMBER
+    m_write_cell = m_write_cell && frame.cell.volume() != 1.0;
+    try {
+      define(frame.n_atoms());
+    } catch (AmberNetCDFWriteError&) {
+      m_failed = true;
+      throw;
+    }
+  }
+  if (frame.n_atoms() != m_n_atoms) {
+    throw AmberNetCDFWriteError("Frame has " + std::to_string(frame.n_atoms()) + " atoms, expected " +
+                                std::to_string(m_n_atoms));
+  }
+  if (m_write_cell && frame.cell.volume() == 1.0) {
+    throw AmberNetCDFWriteError("Frame has no box, but cell is written for `" + m_filename + "`");
+  }
+
+  const size_t i = m_n_buffered;
+  CoordEigenMatrixMapf(m_coords.data() + i * m_n_atoms * 3, m_n_atoms, 3) = frame.coords()._eigen().cast<float>();
+  m_time[i] = frame.time;
+  if (m_write_cell) {
+    const geom::UnitCell& cell = frame.cell;
+    double* lengths = m_cell_lengths.data() + i * 3;
+    double* angles = m_cell_angles.data() + i * 3;
+    lengths[0] = cell.a();
+    lengths[1] = cell.b();
+    lengths[2] = cell.c();
+    angles[0] = cell.alpha().degrees();
+    angles[1] = cell.beta().degrees();
+    angles[2] = cell.gamma().degrees();
+  }
+  if (++m_n_buffered == m_buffer_frames) {
+    flush();
+  }
+}
+
+void AmberNetCDFWriter::flush() {
+  check_not_failed();
+  if (m_n_buffered == 0) {
+    return;
+  }
+  const size_t start[] = {m_n_written, 0, 0};
+  const size_t count[] = {m_n_buffered, m_n_atoms, 3};
+  try {
+    check_netcdf_call(nc_put_vara_float(m_ncid, m_coords_id, start, count, m_coords.data()), "nc_put_vara_float()");
+    check_netcdf_call(nc_put_vara_float(m_ncid, m_time_id, start, count, m_time.data()), "nc_put_vara_float()");
+    if (m_write_cell) {
+      const size_t cell_count[] = {m_n_buffered, 3};
+      check_netcdf_call(nc_put_vara_double(m_ncid, m_cell_lengths_id, start, cell_count, m_cell_lengths.data()),
+                        "nc_put_vara_double()");
+      check_netcdf_call(nc_put_vara_double(m_ncid, m_cell_angles_id, start, cell_count, m_cell_angles.data()),
+                        "nc_put_vara_double()");
+    }
+  } catch (AmberNetCDFWriteError&) {
+    // buffered frames may be partially written, file can't be extended consistently
+    m_failed = true;
+    throw;
+  }
+  m_n_written += m_n_buffered;
+  m_n_buffered = 0;
+}
+
+void AmberNetCDFWriter::close() {
+  if (m_closed) {
+    return;
+  }
+  m_closed = true;
+  try {
+    if (!m_failed) {
+      flush();
+    }
+  } catch (AmberNetCDFWriteError&) {
+    nc_close(m_ncid);
+    throw;
+  }
+  check_netcdf_call(nc_close(m_ncid), "nc_close()");
+}
@@ -0,0 +1,83 @@
+#include "xmol/io/CifInputFile.h"
+#include "xmol/utils/FileContent.h"
+
+using namespace xmol::io;
+using namespace xmol::io::cif;
+
+namespace {
+
+std::shared_ptr<const xmol::utils::FileContent> open_file(const std::string& filename, int n_threads) {
+  try {
+    return std::make_shared<const xmol::utils::FileContent>(filename, n_threads);
+  } catch (std::runtime_error& e) {
+    throw CifReadError(e.what());
+  }
+}
+
+} // namespace
+
+CifInputFile::CifInputFile(std::string filename, bool read_now, int n_threads)
+    : m_filename(std::move(filename)), m_n_threads(n_threads), m_streaming(!read_now) {
+  if (read_now) {
+    read();
+  } else {
+    open();
+    m_n_frames = m_reader->models().size();
+    m_n_atoms = m_reader->models().empty() ? 0 : m_reader->models()[0].n_atoms;
+  }
+}
+
+CifInputFile& CifInputFile::read() {
+  auto file = open_file(m_filename, m_n_threads);
+  m_frames = CifBufferReader(file->view()).read_frames(m_n_threads);
+
+  m_n_frames = m_frames.size();
+  if (!m_frames.empty()) {
+    m_n_atoms = m_frames[0].n_atoms();
+  }
+  return *this;
+}
+
+void CifInputFile::open() {
+  m_file = open_file(m_filename, m_n_threads);
+  m_reader.emplace(m_file->view());
+}
+
+size_t CifInputFile::n_frames() const { return m_n_frames; }
+size_t CifInputFile::n_atoms() const { return m_n_atoms; }
+void CifInputFile::read_frame(size_t index, Frame& frame) {
+  assert(m_current_frame == index);
+  if (m_streaming) {
+    assert(m_reader);
+    m_reader->read_model_coords(m_reader->models()[index], frame);
+    return;
+  }
+
+  auto coordinates = frame.coords();
+  assert(!m_frames.empty());
+
+  Frame& _frame = m_frames[index];
+  if (coordinates.size() != _frame.n_atoms()) {
+    throw CifReadError("Wrong number of atoms in " + std::to_string(index) + " frame in `" + m_filename +
+                       "`. Expected " + std::to_string(coordinates.size()));
+  }
+  coordinates._eigen() = _frame.coords()._eigen();
+  frame.cell = _frame.cell;
+}
+void CifInputFile::advance(size_t shift) {
+  m_current_frame += shift;
+  if (m_current_frame >= n_frames()) {
+    m_frames.clear();
+    m_reader.reset();
+    m_file.reset();
+    m_current_frame = 0;
+    return;
+  }
+  if (m_streaming) {
+    if (!m_reader) {
+      open();
+    }
+  } else if (m_frames.empty()) {
+    read();
+  }
+}
@@ -0,0 +1,85 @@
+#include "xmol/io/GromacsGroFile.h"
+#include "xmol/utils/FileContent.h"
+
+using namespace xmol::io;
+using namespace xmol::io::gro;
+
+namespace {
+
+std::shared_ptr<const xmol::utils::FileContent> open_file(const std::string& filename, int n_threads) {
+  try {
+    return std::make_shared<const xmol::utils::FileContent>(filename, n_threads);
+  } catch (std::runtime_error& e) {
+    throw GroReadError(e.what());
+  }
+}
+
+} // namespace
+
+GromacsGroFile::GromacsGroFile(std::string filename, bool read_now, int n_threads)
+    : m_filename(std::move(filename)), m_n_threads(n_threads), m_streaming(!read_now) {
+  if (read_now) {
+    read();
+  } else {
+    open();
+    m_blocks = m_reader->find_blocks();
+    m_n_frames = m_blocks.size();
+    m_n_atoms = m_blocks.empty() ? 0 : m_blocks[0].n_atoms;
+  }
+}
+
+GromacsGroFile& GromacsGroFile::read() {
+  auto file = open_file(m_filename, m_n_threads);
+  m_frames = GroBufferReader(file->view()).read_frames(m_n_threads);
+
+  m_n_frames = m_frames.size();
+  if (!m_frames.empty()) {
+    m_n_atoms = m_frames[0].n_atoms();
+  }
+  return *this;
+}
+
+void GromacsGroFile::open() {
+  m_file = open_file(m_filename, m_n_threads);
+  m_reader.emplace(m_file->view());
+}
+
+size_t GromacsGroFile::n_frames() const { return m_n_frames; }
+size_t GromacsGroFile::n_atoms() const { return m_n_atoms; }
+void GromacsGroFile::read_frame(size_t index, Frame& frame) {
+  assert(m_current_frame == index);
+  if (m_streaming) {
+    assert(m_reader);
+    m_reader->read_block_coords(m_blocks[index], frame);
+    return;
+  }
+
+  auto coordinates = frame.coords();
+  assert(!m_frames.empty());
+
+  Frame& _frame = m_frames[index];
+  if (coordinates.size() != _frame.n_atoms()) {
+    throw GroReadError("Wrong number of atoms in " + std::to_string(index) + " frame in `" + m_filename +
+                       "`. Expected " + std::to_string(coordinates.size()));
+  }
+  coordinates._eigen() = _frame.coords()._eigen();
+  frame.cell = _frame.cell;
+  frame.time = _frame.time;
+}
+void GromacsGroFile::advance(size_t shift) {
+  m_current_frame += shift;
+  if (m_current_frame >= n_frames()) {
+    m_frames.clear();
+    m_reader.reset();
+    m_file.reset();
+    m_current_frame = 0;
+    return;
+  }
+  if (m_streaming) {
+    if (!m_reader) {
+      open();
+    }
+  } else if (m_frames.empty()) {
+    read();
+  }
+}
@@ -1,33 +1,50 @@
-#include "xmol/io/pdb/PdbReader.h"
+#include "xmol/io/pdb/PdbBufferReader.h"
 #include "xmol/io/pdb/PdbRecord.h"
 #include "xmol/io/PdbInputFile.h"
-#include <fstream>
+#include "xmol/utils/FileContent.h"
 
 using namespace xmol::io;
 using namespace xmol::io::pdb;
 
-PdbInputFile::PdbInputFile(std::string filename, Dialect dialect, bool read_now)
-    : m_filename(std::move(filename)), m_dialect(dialect) {
-  if (read_now) {
-    read();
-  }
-}
+namespace {
 
-PdbInputFile& PdbInputFile::read() {
+AlteredPdbRecords dialect_records(PdbInputFile::Dialect dialect) {
   AlteredPdbRecords alteredPdbRecords(StandardPdbRecords::instance());
-  switch (m_dialect) {
-  case (Dialect::AMBER_99):
+  switch (dialect) {
+  case (PdbInputFile::Dialect::AMBER_99):
     alteredPdbRecords.alter_record(pdb::RecordName("ATOM"), pdb::FieldName("serial"), {7, 12});
     break;
-  case (Dialect::STANDARD_V3):
+  case (PdbInputFile::Dialect::STANDARD_V3):
     break;
   }
+  return alteredPdbRecords;
+}
 
-  std::ifstream in(m_filename);
-  if (!in){
-    throw PdbReadError("Can't read `"+m_filename+"`");
+std::shared_ptr<const xmol::utils::FileContent> open_file(const std::string& filename, int n_threads) {
+  try {
+    return std::make_shared<const xmol::utils::FileContent>(filename, n_threads);
+  } catch (std::runtime_error& e) {
+    throw PdbReadError(e.what());
   }
-  m_frames = PdbReader(in).read_frames(alteredPdbRecords);
+}
+
+} // namespace
+
+PdbInputFile::PdbInputFile(std::string filename, Dialect dialect, bool read_now, int n_threads)
+    : m_filename(std::move(filename)), m_dialect(dialect), m_n_threads(n_threads), m_streaming(!read_now) {
+  if (read_now) {
+    read();
+  } else {
+    open();
+    m_models = m_reader->find_models();
+    m_n_frames = m_models.size();
+    m_n_atoms = m_models.empty() ? 0 : m_reader->count_atoms(m_models[0]);
+  }
+}
+
+PdbInputFile& PdbInputFile::read() {
+  auto file = open_file(m_filename, m_n_threads);
+  m_frames = PdbBufferReader(file->view(), dialect_records(m_dialect)).read_frames(m_n_threads);
 
   m_n_frames = m_frames.size();
   if (!m_frames.empty()) {
@@ -36,12 +53,23 @@ PdbInputFile& PdbInputFile::read() {
   return *this;
 }
 
+void PdbInputFile::open() {
+  m_file = open_file(m_filename, m_n_threads);
+  m_reader.emplace(m_file->view(), dialect_records(m_dialect));
+}
+
 size_t PdbInputFile::n_frames() const { return m_n_frames; }
 size_t PdbInputFile::n_atoms() const { return m_n_atoms; }
 void PdbInputFile::read_frame(size_t index, Frame& frame) {
+  assert(m_current_frame == index);
+  if (m_streaming) {
+    assert(m_reader);
+    m_reader->read_model_coords(m_models[index], frame);
+    return;
+  }
+
   auto coordinates = frame.coords();
   assert(!m_frames.empty());
-  assert(m_current_frame == index);
 
   Frame& _frame = m_frames[index];
   if (coordinates.size() != _frame.n_atoms()) {
@@ -54,10 +82,16 @@ void PdbInputFile::advance(size_t shift) {
   m_current_frame += shift;
   if (m_current_frame >= n_frames()) {
     m_frames.clear();
+    m_reader.reset();
+    m_file.reset();
     m_current_frame = 0;
     return;
   }
-  if (m_frames.empty()) {
+  if (m_streaming) {
+    if (!m_reader) {
+      open();
+    }
+  } else if (m_frames.empty()) {
     read();
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,420 @@
+#include "xmol/io/cif/CifBufferReader.h"
+#include "xmol/io/cif/exceptions.h"
+#include "xmol/utils/parallel.h"
+#include "xmol/utils/parsing.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <iterator>
+#include <locale>
+#include <optional>
+#include <sstream>
+
+using namespace xmol;
+using namespace xmol::io::cif;
+using xmol::utils::parse_fixed_point_field;
+using xmol::utils::parse_int_field;
+using Token = CifBufferReader::Token;
+
+namespace {
+
+/// `_atom_site` tags of items, item is taken from tag of lowest rank present in loop
+struct ItemTag {
+  CifBufferReader::Item item;
+  std::string_view tag;
+  int rank;
+};
+
+constexpr ItemTag atom_site_tags[] = {
+    {CifBufferReader::ID, "_atom_site.id", 0},
+    {CifBufferReader::ATOM_NAME, "_atom_site.auth_atom_id", 0},
+    {CifBufferReader::ATOM_NAME, "_atom_site.label_atom_id", 1},
+    {CifBufferReader::RESIDUE_NAME, "_atom_site.auth_comp_id", 0},
+    {CifBufferReader::RESIDUE_NAME, "_atom_site.label_comp_id", 1},
+    {CifBufferReader::CHAIN, "_atom_site.auth_asym_id", 0},
+    {CifBufferReader::CHAIN, "_atom_site.label_asym_id", 1},
+    {CifBufferReader::ENTITY_INSTANCE, "_atom_site.label_asym_id", 0},
+    {CifBufferReader::RESIDUE_SERIAL, "_atom_site.auth_seq_id", 0},
+    {CifBufferReader::RESIDUE_SERIAL, "_atom_site.label_seq_id", 1},
+    {CifBufferReader::INSERTION_CODE, "_atom_site.pdbx_pdb_ins_code", 0},
+    {CifBufferReader::X, "_atom_site.cartn_x", 0},
+    {CifBufferReader::Y, "_atom_site.cartn_y", 0},
+    {CifBufferReader::Z, "_atom_site.cartn_z", 0},
+    {CifBufferReader::MODEL, "_atom_site.pdbx_pdb_model_num", 0},
+};
+
+/// Names of items for error messages
+constexpr const char* item_names[CifBufferReader::N_ITEMS] = {
+    "_atom_site.id",           "_atom_site.auth_atom_id",      "_atom_site.auth_comp_id",
+    "_atom_site.auth_asym_id", "_atom_site.label_asym_id",     "_atom_site.auth_seq_id",
+    "_atom_site.pdbx_PDB_ins_code", "_atom_site.Cartn_x",      "_atom_site.Cartn_y",
+    "_atom_site.Cartn_z",      "_atom_site.pdbx_PDB_model_num",
+};
+
+constexpr bool is_optional_item(CifBufferReader::Item item) {
+  return item == CifBufferReader::ENTITY_INSTANCE || item == CifBufferReader::INSERTION_CODE ||
+         item == CifBufferReader::MODEL;
+}
+
+constexpr std::string_view cell_tags[] = {"_cell.length_a",    "_cell.length_b",   "_cell.length_c",
+                                          "_cell.angle_alpha", "_cell.angle_beta", "_cell.angle_gamma"};
+
+/// Whitespace or other control character, which are not allowed in CIF otherwise
+inline bool is_space(char c) { return static_cast<unsigned char>(c) <= ' '; }
+
+/// Case-insensitive comparison with lowercase @p name, CIF tags and reserved words are case-insensitive
+bool equals_lowercase(std::string_view text, std::string_view name) {
+  return text.size() == name.size() && std::equal(text.begin(), text.end(), name.begin(), [](char a, char b) {
+           return std::tolower(static_cast<unsigned char>(a)) == b;
+         });
+}
+
+bool starts_with_lowercase(std::string_view text, std::string_view prefix) {
+  return text.size() >= prefix.size() && equals_lowercase(text.substr(0, prefix.size()), prefix);
+}
+
+bool is_null(const Token& token) { return !token.quoted && (token.text == "." || token.text == "?"); }
+
+/// Tag or reserved word, i.e. token which ends values of loop
+bool is_keyword(const Token& token) {
+  if (token.quoted || token.text.empty()) {
+    return false;
+  }
+  switch (token.text[0]) {
+  case '_':
+    return true;
+  case 'l':
+  case 'L':
+    return equals_lowercase(token.text, "loop_");
+  case 'd':
+  case 'D':
+    return starts_with_lowercase(token.text, "data_");
+  case 's':
+  case 'S':
+    return starts_with_lowercase(token.text, "save_") || equals_lowercase(token.text, "stop_");
+  case 'g':
+  case 'G':
+    return equals_lowercase(token.text, "global_");
+  default:
+    return false;
+  }
+}
+
+} // namespace
+
+/// Splits CIF content into values, tags and reserved words, comments are skipped
+class CifBufferReader::Tokenizer {
+public:
+  Tokenizer(const CifBufferReader& reader, size_t pos) : m_reader(reader), m_buffer(reader.m_buffer), m_pos(pos) {}
+
+  /// Read next token, returns false at end of buffer
+  bool next(Token& token) {
+    const char* data = m_buffer.data();
+    const size_t size = m_buffer.size();
+    size_t begin = m_pos;
+    while (true) {
+      while (begin < size && is_space(data[begin])) {
+        ++begin;
+      }
+      if (begin == size) {
+        m_pos = size;
+        return false;
+      }
+      if (data[begin] != '#') {
+        break;
+      }
+      begin = std::min(m_buffer.find('\n', begin), size);
+    }
+
+    const char c = data[begin];
+    if (c == ';' && (begin == 0 || data[begin - 1] == '\n')) {
+      const size_t end = m_buffer.find("\n;", begin);
+      if (end == std::string_view::npos) {
+        m_reader.throw_error(data + begin, "mmCIF: unterminated text field");
+      }
+      token = {std::string_view(data + begin + 1, end - begin - 1), true};
+      m_pos = end + 2;
+      return true;
+    }
+    if (c == '\'' || c == '"') {
+      // quote character followed by non-space doesn't close value, e.g. 'O5'' or "N1"A"
+      size_t end = begin + 1;
+      while (end < size && data[end] != '\n' && !(data[end] == c && (end + 1 == size || is_space(data[end + 1])))) {
+        ++end;
+      }
+      if (end == size || data[end] != c) {
+        m_reader.throw_error(data + begin, "mmCIF: unterminated quoted value");
+      }
+      token = {std::string_view(data + begin + 1, end - begin - 1), true};
+      m_pos = end + 1;
+      return true;
+    }
+    size_t end = begin + 1;
+    while (end < size && !is_space(data[end])) {
+      ++end;
+    }
+    token = {std::string_view(data + begin, end - begin), false};
+    m_pos = end;
+    return true;
+  }
+
+  [[nodiscard]] size_t pos() const { return m_pos; }
+  void seek(size_t pos) { m_pos = pos; }
+
+private:
+  const CifBufferReader& m_reader;
+  std::string_view m_buffer;
+  size_t m_pos;
+};
+
+CifBufferReader::CifBufferReader(std::string_view buffer) : m_buffer(buffer) {
+  double cell[] = {1, 1, 1, 90, 90, 90};
+  bool has_cell = false;
+  bool in_data_block = false;
+
+  Tokenizer tokenizer(*this, 0);
+  Token token;
+  while (tokenizer.next(token)) {
+    if (!is_keyword(token)) {
+      continue;
+    }
+    if (starts_with_lowercase(token.text, "data_")) {
+      if (in_data_block) {
+        break;
+      }
+      in_data_block = true;
+    } else if (equals_lowercase(token.text, "loop_")) {
+      const size_t header = tokenizer.pos();
+      if (m_n_columns == 0 && tokenizer.next(token) && starts_with_lowercase(token.text, "_atom_site.")) {
+        tokenizer.seek(header);
+        read_atom_site_header(tokenizer);
+        scan_atom_site_rows(tokenizer);
+        continue;
+      }
+      // skip tags and values of other loops
+      tokenizer.seek(header);
+      bool in_values = false;
+      size_t pos = header;
+      while (tokenizer.next(token) && (!is_keyword(token) || (!in_values && token.text[0] == '_'))) {
+        in_values |= !is_keyword(token);
+        pos = tokenizer.pos();
+      }
+      tokenizer.seek(pos);
+    } else if (token.text[0] == '_') {
+      const std::string_view tag = token.text;
+      const size_t value_pos = tokenizer.pos();
+      if (!tokenizer.next(token) || is_keyword(token)) {
+        tokenizer.seek(value_pos);
+        continue;
+      }
+      if (starts_with_lowercase(tag, "_atom_site.")) {
+        throw_error(tag.data(), "mmCIF: `_atom_site` category is expected to be a loop");
+      }
+      for (size_t i = 0; i < std::size(cell_tags); ++i) {
+        if (equals_lowercase(tag, cell_tags[i]) && !is_null(token)) {
+          cell[i] = double_value(token, cell_tags[i].data());
+          has_cell = true;
+        }
+      }
+    }
+  }
+  if (has_cell) {
+    m_cell = geom::UnitCell(cell[0], cell[1], cell[2], geom::Degrees(cell[3]), geom::Degrees(cell[4]),
+                            geom::Degrees(cell[5]));
+  }
+}
+
+void CifBufferReader::read_atom_site_header(Tokenizer& tokenizer) {
+  std::array<int, N_ITEMS> rank;
+  rank.fill(INT_MAX);
+  Token token;
+  size_t pos = tokenizer.pos();
+  while (tokenizer.next(token) && !token.quoted && starts_with_lowercase(token.text, "_atom_site.")) {
+    for (auto& item_tag : atom_site_tags) {
+      if (item_tag.rank < rank[item_tag.item] && equals_lowercase(token.text, item_tag.tag)) {
+        rank[item_tag.item] = item_tag.rank;
+        m_column_of_item[item_tag.item] = m_n_columns;
+      }
+    }
+    ++m_n_columns;
+    pos = tokenizer.pos();
+  }
+  tokenizer.seek(pos);
+
+  for (int item = 0; item < N_ITEMS; ++item) {
+    if (rank[item] == INT_MAX) {
+      if (!is_optional_item(Item(item))) {
+        throw CifReadError(std::string("mmCIF: `_atom_site` loop has no `") + item_names[item] + "` column");
+      }
+      m_column_of_item[item] = m_n_columns; // points to empty value past row columns
+    }
+  }
+}
+
+void CifBufferReader::scan_atom_site_rows(Tokenizer& tokenizer) {
+  Row row(m_n_columns + 1);
+  std::string_view model_id, chain, entity_instance, residue_serial, insertion_code;
+  size_t row_begin = tokenizer.pos();
+  while (read_row(tokenizer, row)) {
+    if (m_models.empty() || at(row, MODEL).text != model_id) {
+      model_id = at(row, MODEL).text;
+      m_models.push_back({row_begin, row_begin, 0, 0, 0});
+    }
+    Model& model = m_models.back();
+    const bool new_molecule =
+        model.n_atoms == 0 || at(row, CHAIN).text != chain || at(row, ENTITY_INSTANCE).text != entity_instance;
+    if (new_molecule || at(row, RESIDUE_SERIAL).text != residue_serial ||
+        at(row, INSERTION_CODE).text != insertion_code) {
+      model.n_residues += 1;
+    }
+    model.n_molecules += new_molecule;
+    model.n_atoms += 1;
+    chain = at(row, CHAIN).text;
+    entity_instance = at(row, ENTITY_INSTANCE).text;
+    residue_serial = at(row, RESIDUE_SERIAL).text;
+    insertion_code = at(row, INSERTION_CODE).text;
+    row_begin = model.end = tokenizer.pos();
+  }
+}
+
+bool CifBufferReader::read_row(Tokenizer& tokenizer, Row& row) const {
+  const size_t begin = tokenizer.pos();
+  if (!tokenizer.next(row[0]) || is_keyword(row[0])) {
+    tokenizer.seek(begin);
+    return false;
+  }
+  for (size_t column = 1; column < m_n_columns; ++column) {
+    // reserved word following incomplete row is taken as value, but tags of next category are not
+    if (!tokenizer.next(row[column]) || (!row[column].quoted && row[column].text[0] == '_')) {
+      throw_error(row[0].text.data(), "mmCIF: `_atom_site` row has " + std::to_string(column) + " values, expected " +
+                                          std::to_string(m_n_columns));
+    }
+  }
+  return true;
+}
+
+std::vector<Frame> CifBufferReader::read_frames(int n_threads) const {
+  std::vector<Frame> frames(m_models.size());
+  utils::parallel_for(m_models.size(), n_threads,
+                      [&](size_t task, int) { frames[task] = read_model(m_models[task]); });
+  return frames;
+}
+
+Frame CifBufferReader::read_model(const Model& model) const {
+  Frame frame;
+  frame.reserve_molecules(model.n_molecules);
+  frame.reserve_residues(model.n_residues);
+  frame.reserve_atoms(model.n_atoms);
+  frame.cell = m_cell;
+
+  std::optional<proxy::MoleculeRef> molecule;
+  std::optional<proxy::ResidueRef> residue;
+  std::string_view chain, entity_instance, residue_serial, insertion_code;
+  Tokenizer tokenizer(*this, model.begin);
+  Row row(m_n_columns + 1);
+  while (tokenizer.pos() < model.end && read_row(tokenizer, row)) {
+    if (!molecule || at(row, CHAIN).text != chain || at(row, ENTITY_INSTANCE).text != entity_instance) {
+      chain = at(row, CHAIN).text;
+      entity_instance = at(row, ENTITY_INSTANCE).text;
+      auto molecule_name = name(at(row, CHAIN), MoleculeName::max_length, item_names[CHAIN]);
+      molecule = frame.add_molecule().name(MoleculeName(molecule_name.data(), molecule_name.size()));
+      residue = {};
+    }
+    if (!residue || at(row, RESIDUE_SERIAL).text != residue_serial ||
+        at(row, INSERTION_CODE).text != insertion_code) {
+      residue_serial = at(row, RESIDUE_SERIAL).text;
+      insertion_code = at(row, INSERTION_CODE).text;
+      auto residue_name = name(at(row, RESIDUE_NAME), ResidueName::max_length, item_names[RESIDUE_NAME]);
+      auto i_code = name(at(row, INSERTION_CODE), ResidueInsertionCode::max_length, item_names[INSERTION_CODE]);
+      residue = molecule->add_residue()
+                    .name(ResidueName(residue_name.data(), residue_name.size()))
+                    .id(ResidueId(int_value(at(row, RESIDUE_SERIAL), item_names[RESIDUE_SERIAL]),
+                                  ResidueInsertionCode(i_code.data(), i_code.size())));
+    }
+    auto atom_name = name(at(row, ATOM_NAME), AtomName::max_length, item_names[ATOM_NAME]);
+    residue->add_atom()
+        .name(AtomName(atom_name.data(), atom_name.size()))
+        .id(int_value(at(row, ID), item_names[ID]))
+        .r(XYZ(double_value(at(row, X), item_names[X]), double_value(at(row, Y), item_names[Y]),
+               double_value(at(row, Z), item_names[Z])));
+  }
+  return frame;
+}
+
+void CifBufferReader::read_model_coords(const Model& model, Frame& frame) const {
+  auto atoms = frame.atoms();
+  auto coords = frame.coords();
+  size_t i = 0;
+  Tokenizer tokenizer(*this, model.begin);
+  Row row(m_n_columns + 1);
+  while (tokenizer.pos() < model.end && read_row(tokenizer, row)) {
+    if (i == atoms.size()) {
+      throw_error(row[0].text.data(), "mmCIF: model has more atoms than frame (" + std::to_string(atoms.size()) + ")");
+    }
+    auto atom_name = name(at(row, ATOM_NAME), AtomName::max_length, item_names[ATOM_NAME]);
+    if (AtomName(atom_name.data(), atom_name.size()) != atoms[i].name()) {
+      throw_error(atom_name.data(), "mmCIF: atom name `" + std::string(atom_name) + "` doesn't match frame atom `" +
+                                        atoms[i].name().str() + "`");
+    }
+    coords[i].set(XYZ(double_value(at(row, X), item_names[X]), double_value(at(row, Y), item_names[Y]),
+                      double_value(at(row, Z), item_names[Z])));
+    ++i;
+  }
+  if (i != atoms.size()) {
+    throw CifReadError("mmCIF model has " + std::to_string(i) + " atoms, expected " + std::to_string(atoms.size()));
+  }
+  frame.cell = m_cell;
+}
+
+std::string_view CifBufferReader::name(const Token& token, size_t max_length, const char* what) const {
+  if (is_null(token)) {
+    return {};
+  }
+  if (GSL_UNLIKELY(token.text.size() > max_length)) {
+    throw_error(token.text.data(), std::string("mmCIF: `") + what + "` value `" + std::string(token.text) +
+                                       "` is longer than " + std::to_string(max_length) + " characters");
+  }
+  return token.text;
+}
+
+int CifBufferReader::int_value(const Token& token, const char* what) const {
+  if (is_null(token)) {
+    return 0;
+  }
+  auto [success, value] = parse_int_field(token.text);
+  if (GSL_UNLIKELY(!success)) {
+    throw_error(token.text.data(), std::string("mmCIF: can't read int `") + what + "` value `" +
+                                       std::string(token.text) + "`");
+  }
+  return value;
+}
+
+double CifBufferReader::double_value(const Token& token, const char* what) const {
+  std::string_view text = token.text;
+  if (!text.empty() && text.back() == ')') { // standard uncertainty, e.g. `12.345(6)`
+    text = text.substr(0, text.find('('));
+  }
+  auto [success, value] = parse_fixed_point_field(text);
+  if (GSL_LIKELY(success)) {
+    return value;
+  }
+  // integers and exponent forms are rare, classic locale keeps `.` decimal point regardless of global locale
+  if (!text.empty() && text.size() < 32) {
+    std::istringstream in{std::string(text)};
+    in.imbue(std::locale::classic());
+    double result;
+    if (in >> result && in.peek() == std::char_traits<char>::eof()) {
+      return result;
+    }
+  }
+  throw_error(token.text.data(),
+              std::string("mmCIF: can't read double `") + what + "` value `" + std::string(token.text) + "`");
+}
+
+void CifBufferReader::throw_error(const char* position, const std::string& what) const {
+  if (position < m_buffer.data() || position > m_buffer.data() + m_buffer.size()) {
+    throw CifReadError(what);
+  }
+  const size_t line_number = 1 + std::count(m_buffer.data(), position, '\n');
+  throw CifReadError(what + " at line " + std::to_string(line_number));
+}
@@ -0,0 +1,256 @@
+#include "xmol/io/gro/GroBufferReader.h"
+#include "xmol/io/gro/exceptions.h"
+#include "xmol/utils/parallel.h"
+#include "xmol/utils/parsing.h"
+#include <algorithm>
+#include <optional>
+
+using namespace xmol;
+using namespace xmol::io::gro;
+using xmol::utils::parse_fixed_point_field;
+using xmol::utils::parse_int_field;
+using xmol::utils::trim_field;
+
+namespace {
+
+/// Fixed columns of atom line preceding coordinates
+constexpr size_t residue_serial_column = 0;
+constexpr size_t residue_name_column = 5;
+constexpr size_t atom_name_column = 10;
+constexpr size_t atom_id_column = 15;
+constexpr size_t coords_column = 20;
+constexpr size_t name_width = 5;
+
+constexpr size_t default_coord_width = 8;
+
+constexpr double angstroms_per_nm = 10;
+
+/// Line which starts at given position without line terminator and position of next line
+struct Line {
+  std::string_view text;
+  size_t next;
+};
+
+Line line_at(std::string_view buffer, size_t pos) {
+  auto eol = std::min(buffer.find('\n', pos), buffer.size());
+  auto text = buffer.substr(pos, eol - pos);
+  if (!text.empty() && text.back() == '\r') {
+    text.remove_suffix(1);
+  }
+  return {text, std::min(eol + 1, buffer.size())};
+}
+
+/// Time from `t=` part of title, e.g. `Protein in water t= 10.00000 step= 5000`, zero if absent
+double read_time(std::string_view title) {
+  const size_t pos = title.find("t=");
+  if (pos == std::string_view::npos) {
+    return 0;
+  }
+  auto value = trim_field(title.substr(pos + 2));
+  value = value.substr(0, value.find(' '));
+  auto [success, time] = parse_fixed_point_field(value);
+  return success ? time : 0;
+}
+
+/// Residue numbers decrease at chain boundaries, but wrap around at 5 digits within chain
+bool starts_molecule(int previous_serial, int serial) {
+  return serial < previous_serial && !(previous_serial == 99999 && serial == 0);
+}
+
+} // namespace
+
+GroBufferReader::GroBufferReader(std::string_view buffer) : m_buffer(buffer) {}
+
+std::vector<GroBufferReader::Block> GroBufferReader::find_blocks() const {
+  std::vector<Block> blocks;
+  size_t pos = 0;
+  while (m_buffer.find_first_not_of(" \t\r\n", pos) != std::string_view::npos) {
+    auto title = line_at(m_buffer, pos);
+    auto count = line_at(m_buffer, title.next);
+    auto [success, n_atoms] = parse_int_field(count.text);
+    if (!success || n_atoms < 0) {
+      throw_error(count.text, "GRO: can't read number of atoms");
+    }
+    size_t end = count.next;
+    for (int i = 0; i < n_atoms; ++i) {
+      if (end == m_buffer.size()) {
+        throw_error(count.text, "GRO: unexpected end of file, expected " + std::to_string(n_atoms) + " atoms");
+      }
+      end = line_at(m_buffer, end).next;
+    }
+    if (end == m_buffer.size()) {
+      throw_error(count.text, "GRO: unexpected end of file, expected box line");
+    }
+    auto box = line_at(m_buffer, end);
+    blocks.push_back({count.next, end, size_t(n_atoms), read_time(title.text), read_box(box.text)});
+    pos = box.next;
+  }
+  return blocks;
+}
+
+std::vector<Frame> GroBufferReader::read_frames(int n_threads) const {
+  auto blocks = find_blocks();
+  std::vector<Frame> frames(blocks.size());
+  utils::parallel_for(blocks.size(), n_threads, [&](size_t task, int) { frames[task] = read_block(blocks[task]); });
+  return frames;
+}
+
+Frame GroBufferReader::read_block(const Block& block) const {
+  const Layout layout = layout_of(block);
+
+  // Count residues and molecules to preallocate frame storage, residues are compared by raw text of fields here
+  size_t n_residues = 0;
+  size_t n_molecules = 0;
+  {
+    std::string_view residue_serial, residue_name;
+    int serial = 0;
+    for (size_t pos = block.begin; pos < block.end;) {
+      auto [line, next] = line_at(m_buffer, pos);
+      pos = next;
+      if (line.size() < layout.min_length) {
+        throw_error(line, "GRO: atom line is too short");
+      }
+      if (n_residues == 0 || line.substr(residue_serial_column, name_width) != residue_serial ||
+          line.substr(residue_name_column, name_width) != residue_name) {
+        residue_serial = line.substr(residue_serial_column, name_width);
+        residue_name = line.substr(residue_name_column, name_width);
+        const int previous_serial = serial;
+        serial = int_field(line, residue_serial_column);
+        n_molecules += n_residues == 0 || starts_molecule(previous_serial, serial);
+        ++n_residues;
+      }
+    }
+  }
+
+  Frame frame;
+  frame.reserve_molecules(n_molecules);
+  frame.reserve_residues(n_residues);
+  frame.reserve_atoms(block.n_atoms);
+  frame.cell = block.cell;
+  frame.time = block.time;
+
+  std::optional<proxy::MoleculeRef> molecule;
+  std::optional<proxy::ResidueRef> residue;
+  std::string_view residue_serial, residue_name;
+  int serial = 0;
+  for (size_t pos = block.begin; pos < block.end;) {
+    auto [line, next] = line_at(m_buffer, pos);
+    pos = next;
+    if (!residue || line.substr(residue_serial_column, name_width) != residue_serial ||
+        line.substr(residue_name_column, name_width) != residue_name) {
+      residue_serial = line.substr(residue_serial_column, name_width);
+      residue_name = line.substr(residue_name_column, name_width);
+      const int previous_serial = serial;
+      serial = int_field(line, residue_serial_column);
+      if (!molecule || starts_molecule(previous_serial, serial)) {
+        molecule = frame.add_molecule();
+      }
+      auto name = name_field(line, residue_name_column, ResidueName::max_length);
+      residue = molecule->add_residue().name(ResidueName(name.data(), name.size())).id(serial);
+    }
+    auto atom_name = name_field(line, atom_name_column, AtomName::max_length);
+    residue->add_atom()
+        .name(AtomName(atom_name.data(), atom_name.size()))
+        .id(int_field(line, atom_id_column))
+        .r(coords(line, layout));
+  }
+  return frame;
+}
+
+void GroBufferReader::read_block_coords(const Block& block, Frame& frame) const {
+  if (block.n_atoms != frame.n_atoms()) {
+    throw GroReadError("GRO frame has " + std::to_string(block.n_atoms) + " atoms, expected " +
+                       std::to_string(frame.n_atoms()));
+  }
+  const Layout layout = layout_of(block);
+  auto atoms = frame.atoms();
+  auto coordinates = frame.coords();
+  size_t i = 0;
+  for (size_t pos = block.begin; pos < block.end; ++i) {
+    auto [line, next] = line_at(m_buffer, pos);
+    pos = next;
+    if (line.size() < layout.min_length) {
+      throw_error(line, "GRO: atom line is too short");
+    }
+    auto atom_name = name_field(line, atom_name_column, AtomName::max_length);
+    if (AtomName(atom_name.data(), atom_name.size()) != atoms[i].name()) {
+      throw_error(line, "GRO: atom name doesn't match frame atom `" + atoms[i].name().str() + "`");
+    }
+    coordinates[i].set(coords(line, layout));
+  }
+  frame.cell = block.cell;
+  frame.time = block.time;
+}
+
+GroBufferReader::Layout GroBufferReader::layout_of(const Block& block) const {
+  size_t width = default_coord_width;
+  if (block.n_atoms > 0) {
+    // precision is variable, distance between decimal points gives width of coordinate fields
+    auto line = line_at(m_buffer, block.begin).text;
+    const size_t first = line.find('.', coords_column);
+    const size_t second = first == std::string_view::npos ? first : line.find('.', first + 1);
+    if (second != std::string_view::npos) {
+      width = second - first;
+    }
+  }
+  return {width, coords_column + 3 * width};
+}
+
+geom::UnitCell GroBufferReader::read_box(std::string_view line) const {
+  // v1(x) v2(y) v3(z) [v1(y) v1(z) v2(x) v2(z) v3(x) v3(y)]
+  double box[9] = {};
+  size_t n = 0;
+  for (auto rest = trim_field(line); !rest.empty(); rest = trim_field(rest)) {
+    const size_t length = std::min(rest.find(' '), rest.size());
+    auto [success, value] = parse_fixed_point_field(rest.substr(0, length));
+    if (!success || n == 9) {
+      throw_error(line, "GRO: can't read box vectors");
+    }
+    box[n++] = value * angstroms_per_nm;
+    rest.remove_prefix(length);
+  }
+  if (n != 3 && n != 9) {
+    throw_error(line, "GRO: box line should have 3 or 9 values, got " + std::to_string(n));
+  }
+  geom::UnitCell cell(XYZ(box[0], box[3], box[4]), XYZ(box[5], box[1], box[6]), XYZ(box[7], box[8], box[2]));
+  if (cell.volume() == 0) { // no periodic boundaries
+    return geom::UnitCell::unit_cubic_cell();
+  }
+  return cell;
+}
+
+std::string_view GroBufferReader::name_field(std::string_view line, size_t first, size_t max_length) const {
+  auto value = trim_field(line.substr(first, name_width));
+  if (GSL_UNLIKELY(value.size() > max_length)) {
+    throw_error(line, "GRO: name `" + std::string(value) + "` is longer than " + std::to_string(max_length) +
+                          " characters");
+  }
+  return value;
+}
+
+int GroBufferReader::int_field(std::string_view line, size_t first) const {
+  auto [success, value] = parse_int_field(line.substr(first, name_width));
+  if (GSL_UNLIKELY(!success)) {
+    throw_error(line, "GRO: can't read int at column " + std::to_string(first + 1));
+  }
+  return value;
+}
+
+XYZ GroBufferReader::coords(std::string_view line, const Layout& layout) const {
+  double r[3];
+  for (size_t i = 0; i < 3; ++i) {
+    auto [success, value] = parse_fixed_point_field(line.substr(coords_column + i * layout.coord_width,
+                                                                layout.coord_width));
+    if (GSL_UNLIKELY(!success)) {
+      throw_error(line, "GRO: can't read coordinate at column " +
+                            std::to_string(coords_column + i * layout.coord_width + 1));
+    }
+    r[i] = value * angstroms_per_nm;
+  }
+  return XYZ(r[0], r[1], r[2]);
+}
+
+void GroBufferReader::throw_error(std::string_view line, const std::string& what) const {
+  const size_t line_number = 1 + std::count(m_buffer.data(), line.data(), '\n');
+  throw GroReadError(what + "\nat line " + std::to_string(line_number) + "\n" + std::string(line));
+}
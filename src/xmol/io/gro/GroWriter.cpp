@@ -0,0 +1,104 @@
+#include "xmol/io/gro/GroWriter.h"
+#include "xmol/Frame.h"
+#include "xmol/io/gro/exceptions.h"
+#include "xmol/proxy/spans.h"
+#include "xmol/utils/formatting.h"
+
+using namespace xmol;
+using namespace xmol::io::gro;
+using xmol::utils::format_fixed_point_field;
+using xmol::utils::format_wrapped_int_field;
+
+namespace {
+
+constexpr double nm_per_angstrom = 0.1;
+
+/// `%5d%-5s%5s%5d%8.3f%8.3f%8.3f`
+constexpr size_t atom_line_width = 44;
+
+template <typename Name> void write_name(char* field, const Name& name, bool left_aligned) {
+  int length = 0;
+  while (length < Name::max_length && name[length] != '\0') {
+    ++length;
+  }
+  char* text = left_aligned ? field : field + 5 - length;
+  std::fill(field, field + 5, ' ');
+  for (int i = 0; i < length; ++i) {
+    text[i] = name[i];
+  }
+}
+
+bool append_fixed_point(std::string& buffer, int width, int precision, double value) {
+  const size_t offset = buffer.size();
+  buffer.resize(offset + width);
+  return format_fixed_point_field(buffer.data() + offset, width, precision, value);
+}
+
+} // namespace
+
+GroWriter::GroWriter(const std::string& filename) : m_out(filename, std::ios::binary) {
+  if (m_out.fail()) {
+    throw GroWriteError("Can't open file `" + filename + "` for writing");
+  }
+}
+
+void GroWriter::write(Frame& frame, const std::string& title) {
+  // whole frame is formatted before write, so frame which can't be written leaves file intact
+  m_buffer = title;
+  m_buffer += " t= ";
+  char time[24];
+  if (!format_fixed_point_field(time, sizeof(time), 5, frame.time)) {
+    throw GroWriteError("GRO writer: can't write time " + std::to_string(frame.time));
+  }
+  m_buffer.append(std::find_if(time, time + sizeof(time), [](char c) { return c != ' '; }), time + sizeof(time));
+  m_buffer += '\n';
+  m_buffer += std::to_string(frame.n_atoms());
+  m_buffer += '\n';
+
+  std::string line(atom_line_width, ' ');
+  for (auto& residue : frame.residues()) {
+    format_wrapped_int_field(line.data(), 5, residue.id().serial);
+    write_name(line.data() + 5, residue.name(), true);
+    for (auto& atom : residue.atoms()) {
+      write_name(line.data() + 10, atom.name(), false);
+      format_wrapped_int_field(line.data() + 15, 5, atom.id());
+      const XYZ& r = atom.r();
+      if (!format_fixed_point_field(line.data() + 20, 8, 3, r.x() * nm_per_angstrom) ||
+          !format_fixed_point_field(line.data() + 28, 8, 3, r.y() * nm_per_angstrom) ||
+          !format_fixed_point_field(line.data() + 36, 8, 3, r.z() * nm_per_angstrom)) {
+        m_buffer.clear();
+        throw GroWriteError("GRO writer: coordinates of atom " + to_string(atom) + " do not fit into atom line");
+      }
+      m_buffer += line;
+      m_buffer += '\n';
+    }
+  }
+
+  // v1(x) v2(y) v3(z), off-diagonal v1(y) v1(z) v2(x) v2(z) v3(x) v3(y) only for triclinic box
+  const XYZ v1 = frame.cell[0] * nm_per_angstrom;
+  const XYZ v2 = frame.cell[1] * nm_per_angstrom;
+  const XYZ v3 = frame.cell[2] * nm_per_angstrom;
+  std::vector<double> box = {v1.x(), v2.y(), v3.z()};
+  if (frame.cell.volume() == 1.0) {
+    // placeholder cell of frame without box (see PdbWriter), GROMACS reads zero box as absent
+    box = {0, 0, 0};
+  } else if (v1.y() != 0 || v1.z() != 0 || v2.x() != 0 || v2.z() != 0 || v3.x() != 0 || v3.y() != 0) {
+    box.insert(box.end(), {v1.y(), v1.z(), v2.x(), v2.z(), v3.x(), v3.y()});
+  }
+  for (double value : box) {
+    if (!append_fixed_point(m_buffer, 10, 5, value)) {
+      m_buffer.clear();
+      throw GroWriteError("GRO writer: box doesn't fit into box line");
+    }
+  }
+  m_buffer += '\n';
+  flush();
+  if (m_out.fail()) {
+    throw GroWriteError("GRO writer: can't write frame");
+  }
+}
+
+void GroWriter::flush() {
+  m_out.write(m_buffer.data(), m_buffer.size());
+  m_buffer.clear();
+}
@@ -1,459 +1,529 @@
 #include "xmol/io/pdb/PdbRecord.h"
+#include "xmol/utils/perfect_hash.h"
+#include <array>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
 
 using namespace xmol::io::pdb;
+using xmol::utils::fill_perfect_hash_slots;
+using xmol::utils::perfect_hash_bits;
+using xmol::utils::perfect_hash_empty_slot;
+using xmol::utils::perfect_hash_slot;
 
-std::map<RecordName,PdbRecordType> detail::get_bundled_records() {
+/*
+ * Standard records table is packed at compile time into flat arrays of colons, fields and records
+ * with perfect hash tables of record and field names, so no work is done at runtime on first use.
+ * Hash seeds are precomputed by tools/generate_pdb_record_seeds.py, rerun it after changing the table
+ */
 
-  auto as_field = [](const std::string& fieldName, std::vector<int> colons){
-    auto shortend = fieldName.substr(0,std::min(size_t(FieldName::max_length),fieldName.size()));
-    return std::make_pair(FieldName(shortend),std::move(colons));
-  };
-  auto as_record = [](const char* recordName, std::map<FieldName,std::vector<int>> fields){
-    return std::pair<RecordName,PdbRecordType>(RecordName(recordName),PdbRecordType(std::move(fields)));
-  };
-  std::map<RecordName,PdbRecordType> result {
-      as_record("ANISOU",{
-          as_field("serial",{7,11}),
-          as_field("name",{13,16}),
-          as_field("altLoc",{17,17}),
-          as_field("resName",{18,20}),
-          as_field("chainID",{22,22}),
-          as_field("resSeq",{23,26}),
-          as_field("iCode",{27,27}),
-          as_field("u[0][0]",{29,35}),
-          as_field("u[1][1]",{36,42}),
-          as_field("u[2][2]",{43,49}),
-          as_field("u[0][1]",{50,56}),
-          as_field("u[0][2]",{57,63}),
-          as_field("u[1][2]",{64,70}),
-          as_field("element",{77,78}),
-          as_field("charge",{79,80}),
-      }), // ANISOU
-      as_record("ATOM",{
-          as_field("serial",{7,11}),
-          as_field("name",{13,16}),
-          as_field("altLoc",{17,17}),
-          as_field("resName",{18,20}),
-          as_field("chainID",{22,22}),
-          as_field("resSeq",{23,26}),
-          as_field("iCode",{27,27}),
-          as_field("x",{31,38}),
-          as_field("y",{39,46}),
-          as_field("z",{47,54}),
-          as_field("occupancy",{55,60}),
-          as_field("tempFactor",{61,66}),
-          as_field("element",{77,78}),
-          as_field("charge",{79,80}),
-      }), // ATOM
-      as_record("AUTHOR",{
-          as_field("continuation",{9,10}),
-          as_field("authorList",{11,79}),
-      }), // AUTHOR
-      as_record("CAVEAT",{
-          as_field("continuation",{9,10}),
-          as_field("idCode",{12,15}),
-          as_field("comment",{20,79}),
-      }), // CAVEAT
-      as_record("CISPEP",{
-          as_field("serNum",{8,10}),
-          as_field("pep1",{12,14}),
-          as_field("chainID1",{16,16}),
-          as_field("seqNum1",{18,21}),
-          as_field("icode1",{22,22}),
-          as_field("pep2",{26,28}),
-          as_field("chainID2",{30,30}),
-          as_field("seqNum2",{32,35}),
-          as_field("icode2",{36,36}),
-          as_field("modNum",{44,46}),
-          as_field("measure",{54,59}),
-      }), // CISPEP
-      as_record("COMPND",{
-          as_field("continuation",{8,10}),
-          as_field("compound",{11,80}),
-      }), // COMPND
-      as_record("CONECT",{
-          as_field("serial",{7,11,12,16,17,21,22,26,27,31}),
-      }), // CONECT
-      as_record("CRYST1",{
-          as_field("a",{7,15}),
-          as_field("b",{16,24}),
-          as_field("c",{25,33}),
-          as_field("alpha",{34,40}),
-          as_field("beta",{41,47}),
-          as_field("gamma",{48,54}),
-          as_field("sGroup",{56,66}),
-          as_field("z",{67,70}),
-      }), // CRYST1
-      as_record("DBREF",{
-          as_field("idCode",{8,11}),
-          as_field("chainID",{13,13}),
-          as_field("seqBegin",{15,18}),
-          as_field("insertBegin",{19,19}),
-          as_field("seqEnd",{21,24}),
-          as_field("insertEnd",{25,25}),
-          as_field("database",{27,32}),
-          as_field("dbAccession",{34,41}),
-          as_field("dbIdCode",{43,54}),
-          as_field("dbseqBegin",{56,60}),
-          as_field("idbnsBeg",{61,61}),
-          as_field("dbseqEnd",{63,67}),
-          as_field("dbinsEnd",{68,68}),
-      }), // DBREF
-      as_record("DBREF1",{
-          as_field("idCode",{8,11}),
-          as_field("chainID",{13,13}),
-          as_field("seqBegin",{15,18}),
-          as_field("insertBegin",{19,19}),
-          as_field("seqEnd",{21,24}),
-          as_field("insertEnd",{25,25}),
-          as_field("database",{27,32}),
-          as_field("dbIdCode",{48,67}),
-      }), // DBREF1
-      as_record("DBREF2",{
-          as_field("idCode",{8,11}),
-          as_field("chainID",{13,13}),
-          as_field("dbAccession",{19,40}),
-          as_field("seqBegin",{46,55}),
-          as_field("seqEnd",{58,67}),
-      }), // DBREF2
-      as_record("END",{
-      }), // END
-      as_record("ENDMDL",{
-      }), // ENDMDL
-      as_record("EXPDTA",{
-          as_field("continuation",{9,10}),
-          as_field("technique",{11,79}),
-      }), // EXPDTA
-      as_record("FORMUL",{
-          as_field("compNum",{9,10}),
-          as_field("hetID",{13,15}),
-          as_field("continuation",{17,18}),
-          as_field("asterisk",{19,19}),
-          as_field("text",{20,70}),
-      }), // FORMUL
-      as_record("HEADER",{
-          as_field("classification",{11,50}),
-          as_field("depDate",{51,59}),
-          as_field("idCode",{63,66}),
-      }), // HEADER
-      as_record("HELIX",{
-          as_field("serNum",{8,10}),
-          as_field("helixID",{12,14}),
-          as_field("initResName",{16,18}),
-          as_field("initChainID",{20,20}),
-          as_field("initSeqNum",{22,25}),
-          as_field("initICode",{26,26}),
-          as_field("endResName",{28,30}),
-          as_field("endChainID",{32,32}),
-          as_field("endSeqNum",{34,37}),
-          as_field("endICode",{38,38}),
-          as_field("helixClass",{39,40}),
-          as_field("comment",{41,70}),
-          as_field("length",{72,76}),
-      }), // HELIX
-      as_record("HET",{
-          as_field("hetID",{8,10}),
-          as_field("ChainID",{13,13}),
-          as_field("seqNum",{14,17}),
-          as_field("iCode",{18,18}),
-          as_field("numHetAtoms",{21,25}),
-          as_field("text",{31,70}),
-      }), // HET
-      as_record("HETATM",{
-          as_field("serial",{7,11}),
-          as_field("name",{13,16}),
-          as_field("altLoc",{17,17}),
-          as_field("resName",{18,20}),
-          as_field("chainID",{22,22}),
-          as_field("resSeq",{23,26}),
-          as_field("iCode",{27,27}),
-          as_field("x",{31,38}),
-          as_field("y",{39,46}),
-          as_field("z",{47,54}),
-          as_field("occupancy",{55,60}),
-          as_field("tempFactor",{61,66}),
-          as_field("element",{77,78}),
-          as_field("charge",{79,80}),
-      }), // HETATM
-      as_record("HETNAM",{
-          as_field("continuation",{9,10}),
-          as_field("hetID",{12,14}),
-          as_field("text",{16,70}),
-      }), // HETNAM
-      as_record("HETSYN",{
-          as_field("continuation",{9,10}),
-          as_field("hetID",{12,14}),
-          as_field("hetSynonyms",{16,70}),
-      }), // HETSYN
-      as_record("JRNL",{
-          as_field("text",{13,79}),
-      }), // JRNL
-      as_record("KEYWDS",{
-          as_field("continuation",{9,10}),
-          as_field("keywds",{11,79}),
-      }), // KEYWDS
-      as_record("LINK",{
-          as_field("name1",{13,16}),
-          as_field("altLoc1",{17,17}),
-          as_field("resName1",{18,20}),
-          as_field("chainID1",{22,22}),
-          as_field("resSeq1",{23,26}),
-          as_field("iCode1",{27,27}),
-          as_field("name2",{43,46}),
-          as_field("altLoc2",{47,47}),
-          as_field("resName2",{48,50}),
-          as_field("chainID2",{52,52}),
-          as_field("resSeq2",{53,56}),
-          as_field("iCode2",{57,57}),
-          as_field("sym1",{60,65}),
-          as_field("sym2",{67,72}),
-          as_field("Length",{74,78}),
-      }), // LINK
-      as_record("MASTER",{
-          as_field("numRemark",{11,15}),
-          as_field("0",{16,20}),
-          as_field("numHet",{21,25}),
-          as_field("numHelix",{26,30}),
-          as_field("numSheet",{31,35}),
-          as_field("numTurn",{36,40}),
-          as_field("numSite",{41,45}),
-          as_field("numXform",{46,50}),
-          as_field("numCoord",{51,55}),
-          as_field("numTer",{56,60}),
-          as_field("numConect",{61,65}),
-          as_field("numSeq",{66,70}),
-      }), // MASTER
-      as_record("MDLTYP",{
-          as_field("continuation",{9,10}),
-          as_field("comment",{11,80}),
-      }), // MDLTYP
-      as_record("MODEL",{
-          as_field("serial",{11,14}),
-      }), // MODEL
-      as_record("MODRES",{
-          as_field("idCode",{8,11}),
-          as_field("resName",{13,15}),
-          as_field("chainID",{17,17}),
-          as_field("seqNum",{19,22}),
-          as_field("iCode",{23,23}),
-          as_field("stdRes",{25,27}),
-          as_field("comment",{30,70}),
-      }), // MODRES
-      as_record("MTRIX1",{
-          as_field("serial",{8,10}),
-          as_field("m[1][1]",{11,20}),
-          as_field("m[1][2]",{21,30}),
-          as_field("m[1][3]",{31,40}),
-          as_field("v[1]",{46,55}),
-          as_field("iGiven",{60,60}),
-      }), // MTRIX1
-      as_record("MTRIX2",{
-          as_field("serial",{8,10}),
-          as_field("m[2][1]",{11,20}),
-          as_field("m[2][2]",{21,30}),
-          as_field("m[2][3]",{31,40}),
-          as_field("v[2]",{46,55}),
-          as_field("iGiven",{60,60}),
-      }), // MTRIX2
-      as_record("MTRIX3",{
-          as_field("serial",{8,10}),
-          as_field("m[3][1]",{11,20}),
-          as_field("m[3][2]",{21,30}),
-          as_field("m[3][3]",{31,40}),
-          as_field("v[3]",{46,55}),
-          as_field("iGiven",{60,60}),
-      }), // MTRIX3
-      as_record("NUMMDL",{
-          as_field("modelNumber",{11,14}),
-      }), // NUMMDL
-      as_record("OBSLTE",{
-          as_field("continuation",{9,10}),
-          as_field("repDate",{12,20}),
-          as_field("idCode",{22,25}),
-          as_field("rIdCode",{32,35,37,40,42,45,47,50,52,55,57,60,62,65,67,70,72,75}),
-      }), // OBSLTE
-      as_record("ORIGX1",{
-          as_field("o[1][1]",{11,20}),
-          as_field("o[1][2]",{21,30}),
-          as_field("o[1][3]",{31,40}),
-          as_field("t[1]",{46,55}),
-      }), // ORIGX1
-      as_record("ORIGX2",{
-          as_field("o[2][1]",{11,20}),
-          as_field("o[2][2]",{21,30}),
-          as_field("o[2][3]",{31,40}),
-          as_field("t[2]",{46,55}),
-      }), // ORIGX2
-      as_record("ORIGX3",{
-          as_field("o[3][1]",{11,20}),
-          as_field("o[3][2]",{21,30}),
-          as_field("o[3][3]",{31,40}),
-          as_field("t[3]",{46,55}),
-      }), // ORIGX3
-      as_record("REMARK",{
-          as_field("remarkNum",{8,10}),
-          as_field("empty",{12,79}),
-      }), // REMARK
-      as_record("REVDAT",{
-          as_field("modNum",{8,10}),
-          as_field("continuation",{11,12}),
-          as_field("modDate",{14,22}),
-          as_field("modId",{24,27}),
-          as_field("modType",{32,32}),
-          as_field("record",{40,45,47,52,54,59,61,66}),
-      }), // REVDAT
-      as_record("SCALE1",{
-          as_field("s[1][1]",{11,20}),
-          as_field("s[1][2]",{21,30}),
-          as_field("s[1][3]",{31,40}),
-          as_field("u[1]",{46,55}),
-      }), // SCALE1
-      as_record("SCALE2",{
-          as_field("s[2][1]",{11,20}),
-          as_field("s[2][2]",{21,30}),
-          as_field("s[2][3]",{31,40}),
-          as_field("u[2]",{46,55}),
-      }), // SCALE2
-      as_record("SCALE3",{
-          as_field("s[3][1]",{11,20}),
-          as_field("s[3][2]",{21,30}),
-          as_field("s[3][3]",{31,40}),
-          as_field("u[3]",{46,55}),
-      }), // SCALE3
-      as_record("SEQADV",{
-          as_field("idCode",{8,11}),
-          as_field("resName",{13,15}),
-          as_field("chainID",{17,17}),
-          as_field("seqNum",{19,22}),
-          as_field("iCode",{23,23}),
-          as_field("database",{25,28}),
-          as_field("dbAccession",{30,38}),
-          as_field("dbRes",{40,42}),
-          as_field("dbSeq",{44,48}),
-          as_field("conflict",{50,70}),
-      }), // SEQADV
-      as_record("SEQRES",{
-          as_field("serNum",{8,10}),
-          as_field("chainID",{12,12}),
-          as_field("numRes",{14,17}),
-          as_field("resName",{20,22,24,26,28,30,32,34,36,38,40,42,44,46,48,50,52,54,56,58,60,62,64,66,68,70}),
-      }), // SEQRES
-      as_record("SHEET",{
-          as_field("strand",{8,10}),
-          as_field("sheetID",{12,14}),
-          as_field("numStrands",{15,16}),
-          as_field("initResName",{18,20}),
-          as_field("initChainID",{22,22}),
-          as_field("initSeqNum",{23,26}),
-          as_field("initICode",{27,27}),
-          as_field("endResName",{29,31}),
-          as_field("endChainID",{33,33}),
-          as_field("endSeqNum",{34,37}),
-          as_field("endICode",{38,38}),
-          as_field("sense",{39,40}),
-          as_field("curAtom",{42,45}),
-          as_field("curResName",{46,48}),
-          as_field("curChainId",{50,50}),
-          as_field("curResSeq",{51,54}),
-          as_field("curICode",{55,55}),
-          as_field("prevAtom",{57,60}),
-          as_field("prevResName",{61,63}),
-          as_field("prevChainId",{65,65}),
-          as_field("prevResSeq",{66,69}),
-          as_field("prevICode",{70,70}),
-      }), // SHEET
-      as_record("SIGATM",{
-          as_field("serial",{7,11}),
-          as_field("name",{13,16}),
-          as_field("altLoc",{17,17}),
-          as_field("resName",{18,20}),
-          as_field("chainID",{22,22}),
-          as_field("resSeq",{23,26}),
-          as_field("iCode",{27,27}),
-          as_field("sigX",{31,38}),
-          as_field("sigY",{39,46}),
-          as_field("sigZ",{47,54}),
-          as_field("sigOcc",{55,60}),
-          as_field("sigTemp",{61,66}),
-          as_field("element",{77,78}),
-          as_field("charge",{79,80}),
-      }), // SIGATM
-      as_record("SIGUIJ",{
-          as_field("serial",{7,11}),
-          as_field("name",{13,16}),
-          as_field("altLoc",{17,17}),
-          as_field("resName",{18,20}),
-          as_field("chainID",{22,22}),
-          as_field("resSeq",{23,26}),
-          as_field("iCode",{27,27}),
-          as_field("sig[0][0]",{29,35}),
-          as_field("sig[1][1]",{36,42}),
-          as_field("sig[2][2]",{43,49}),
-          as_field("sig[0][1]",{50,56}),
-          as_field("sig[0][2]",{57,63}),
-          as_field("sig[1][2]",{64,70}),
-          as_field("element",{77,78}),
-          as_field("charge",{79,80}),
-      }), // SIGUIJ
-      as_record("SITE",{
-          as_field("seqNum",{8,10}),
-          as_field("siteID",{12,14}),
-          as_field("numRes",{16,17}),
-          as_field("resName1",{19,21}),
-          as_field("chainID1",{23,23}),
-          as_field("seq1",{24,27}),
-          as_field("iCode1",{28,28}),
-          as_field("resName2",{30,32}),
-          as_field("chainID2",{34,34}),
-          as_field("seq2",{35,38}),
-          as_field("iCode2",{39,39}),
-          as_field("resName3",{41,43}),
-          as_field("chainID3",{45,45}),
-          as_field("seq3",{46,49}),
-          as_field("iCode3",{50,50}),
-          as_field("resName4",{52,54}),
-          as_field("chainID4",{56,56}),
-          as_field("seq4",{57,60}),
-          as_field("iCode4",{61,61}),
-      }), // SITE
-      as_record("SOURCE",{
-          as_field("continuation",{8,10}),
-          as_field("srcName",{11,79}),
-      }), // SOURCE
-      as_record("SPLIT",{
-          as_field("continuation",{9,10}),
-          as_field("idCode",{12,15,17,20,22,25,27,30,32,35,37,40,42,45,47,50,52,55,57,60,62,65,67,70,72,75,77,80}),
-      }), // SPLIT
-      as_record("SPRSDE",{
-          as_field("continuation",{9,10}),
-          as_field("sprsdeDate",{12,20}),
-          as_field("idCode",{22,25}),
-          as_field("sIdCode",{32,35,37,40,42,45,47,50,52,55,57,60,62,65,67,70,72,75}),
-      }), // SPRSDE
-      as_record("SSBOND",{
-          as_field("serNum",{8,10}),
-          as_field("CYS",{26,28}),
-          as_field("chainID1",{16,16}),
-          as_field("seqNum1",{18,21}),
-          as_field("icode1",{22,22}),
-          as_field("chainID2",{30,30}),
-          as_field("seqNum2",{32,35}),
-          as_field("icode2",{36,36}),
-          as_field("sym1",{60,65}),
-          as_field("sym2",{67,72}),
-          as_field("Length",{74,78}),
-      }), // SSBOND
-      as_record("TER",{
-          as_field("serial",{7,11}),
-          as_field("resName",{18,20}),
-          as_field("chainID",{22,22}),
-          as_field("resSeq",{23,26}),
-          as_field("iCode",{27,27}),
-      }), // TER
-      as_record("TITLE",{
-          as_field("continuation",{9,10}),
-          as_field("title",{11,80}),
-      }), // TITLE
-  };
-  return result;
+namespace {
+
+constexpr size_t max_row_colons = 28;
+constexpr size_t max_record_fields = 32;
+
+/// Field of record as written in table below, fields of record must be consecutive
+struct Row {
+  /// Record without fields
+  template <size_t N> constexpr Row(const char (&record)[N]) : record(record), has_field(false) {}
+
+  template <size_t N, size_t M>
+  constexpr Row(const char (&record)[N], const char (&field)[M], std::initializer_list<int> colons)
+      : record(record), field(field) {
+    if (colons.size() > max_row_colons) {
+      throw std::length_error("too many colons of field");
+    }
+    for (int colon : colons) {
+      this->colons[n_colons++] = colon;
+    }
+  }
+
+  RecordName record;
+  FieldName field; /// names longer than 8 characters are truncated
+  int colons[max_row_colons] = {};
+  size_t n_colons = 0;
+  bool has_field = true;
+};
+
+constexpr Row rows[] = {
+    {"ANISOU", "serial", {7, 11}},
+    {"ANISOU", "name", {13, 16}},
+    {"ANISOU", "altLoc", {17, 17}},
+    {"ANISOU", "resName", {18, 20}},
+    {"ANISOU", "chainID", {22, 22}},
+    {"ANISOU", "resSeq", {23, 26}},
+    {"ANISOU", "iCode", {27, 27}},
+    {"ANISOU", "u[0][0]", {29, 35}},
+    {"ANISOU", "u[1][1]", {36, 42}},
+    {"ANISOU", "u[2][2]", {43, 49}},
+    {"ANISOU", "u[0][1]", {50, 56}},
+    {"ANISOU", "u[0][2]", {57, 63}},
+    {"ANISOU", "u[1][2]", {64, 70}},
+    {"ANISOU", "element", {77, 78}},
+    {"ANISOU", "charge", {79, 80}},
+    {"ATOM", "serial", {7, 11}},
+    {"ATOM", "name", {13, 16}},
+    {"ATOM", "altLoc", {17, 17}},
+    {"ATOM", "resName", {18, 20}},
+    {"ATOM", "chainID", {22, 22}},
+    {"ATOM", "resSeq", {23, 26}},
+    {"ATOM", "iCode", {27, 27}},
+    {"ATOM", "x", {31, 38}},
+    {"ATOM", "y", {39, 46}},
+    {"ATOM", "z", {47, 54}},
+    {"ATOM", "occupancy", {55, 60}},
+    {"ATOM", "tempFactor", {61, 66}},
+    {"ATOM", "element", {77, 78}},
+    {"ATOM", "charge", {79, 80}},
+    {"AUTHOR", "continuation", {9, 10}},
+    {"AUTHOR", "authorList", {11, 79}},
+    {"CAVEAT", "continuation", {9, 10}},
+    {"CAVEAT", "idCode", {12, 15}},
+    {"CAVEAT", "comment", {20, 79}},
+    {"CISPEP", "serNum", {8, 10}},
+    {"CISPEP", "pep1", {12, 14}},
+    {"CISPEP", "chainID1", {16, 16}},
+    {"CISPEP", "seqNum1", {18, 21}},
+    {"CISPEP", "icode1", {22, 22}},
+    {"CISPEP", "pep2", {26, 28}},
+    {"CISPEP", "chainID2", {30, 30}},
+    {"CISPEP", "seqNum2", {32, 35}},
+    {"CISPEP", "icode2", {36, 36}},
+    {"CISPEP", "modNum", {44, 46}},
+    {"CISPEP", "measure", {54, 59}},
+    {"COMPND", "continuation", {8, 10}},
+    {"COMPND", "compound", {11, 80}},
+    {"CONECT", "serial", {7, 11, 12, 16, 17, 21, 22, 26, 27, 31}},
+    {"CRYST1", "a", {7, 15}},
+    {"CRYST1", "b", {16, 24}},
+    {"CRYST1", "c", {25, 33}},
+    {"CRYST1", "alpha", {34, 40}},
+    {"CRYST1", "beta", {41, 47}},
+    {"CRYST1", "gamma", {48, 54}},
+    {"CRYST1", "sGroup", {56, 66}},
+    {"CRYST1", "z", {67, 70}},
+    {"DBREF", "idCode", {8, 11}},
+    {"DBREF", "chainID", {13, 13}},
+    {"DBREF", "seqBegin", {15, 18}},
+    {"DBREF", "insertBegin", {19, 19}},
+    {"DBREF", "seqEnd", {21, 24}},
+    {"DBREF", "insertEnd", {25, 25}},
+    {"DBREF", "database", {27, 32}},
+    {"DBREF", "dbAccession", {34, 41}},
+    {"DBREF", "dbIdCode", {43, 54}},
+    {"DBREF", "dbseqBegin", {56, 60}},
+    {"DBREF", "idbnsBeg", {61, 61}},
+    {"DBREF", "dbseqEnd", {63, 67}},
+    {"DBREF", "dbinsEnd", {68, 68}},
+    {"DBREF1", "idCode", {8, 11}},
+    {"DBREF1", "chainID", {13, 13}},
+    {"DBREF1", "seqBegin", {15, 18}},
+    {"DBREF1", "insertBegin", {19, 19}},
+    {"DBREF1", "seqEnd", {21, 24}},
+    {"DBREF1", "insertEnd", {25, 25}},
+    {"DBREF1", "database", {27, 32}},
+    {"DBREF1", "dbIdCode", {48, 67}},
+    {"DBREF2", "idCode", {8, 11}},
+    {"DBREF2", "chainID", {13, 13}},
+    {"DBREF2", "dbAccession", {19, 40}},
+    {"DBREF2", "seqBegin", {46, 55}},
+    {"DBREF2", "seqEnd", {58, 67}},
+    {"END"},
+    {"ENDMDL"},
+    {"EXPDTA", "continuation", {9, 10}},
+    {"EXPDTA", "technique", {11, 79}},
+    {"FORMUL", "compNum", {9, 10}},
+    {"FORMUL", "hetID", {13, 15}},
+    {"FORMUL", "continuation", {17, 18}},
+    {"FORMUL", "asterisk", {19, 19}},
+    {"FORMUL", "text", {20, 70}},
+    {"HEADER", "classification", {11, 50}},
+    {"HEADER", "depDate", {51, 59}},
+    {"HEADER", "idCode", {63, 66}},
+    {"HELIX", "serNum", {8, 10}},
+    {"HELIX", "helixID", {12, 14}},
+    {"HELIX", "initResName", {16, 18}},
+    {"HELIX", "initChainID", {20, 20}},
+    {"HELIX", "initSeqNum", {22, 25}},
+    {"HELIX", "initICode", {26, 26}},
+    {"HELIX", "endResName", {28, 30}},
+    {"HELIX", "endChainID", {32, 32}},
+    {"HELIX", "endSeqNum", {34, 37}},
+    {"HELIX", "endICode", {38, 38}},
+    {"HELIX", "helixClass", {39, 40}},
+    {"HELIX", "comment", {41, 70}},
+    {"HELIX", "length", {72, 76}},
+    {"HET", "hetID", {8, 10}},
+    {"HET", "ChainID", {13, 13}},
+    {"HET", "seqNum", {14, 17}},
+    {"HET", "iCode", {18, 18}},
+    {"HET", "numHetAtoms", {21, 25}},
+    {"HET", "text", {31, 70}},
+    {"HETATM", "serial", {7, 11}},
+    {"HETATM", "name", {13, 16}},
+    {"HETATM", "altLoc", {17, 17}},
+    {"HETATM", "resName", {18, 20}},
+    {"HETATM", "chainID", {22, 22}},
+    {"HETATM", "resSeq", {23, 26}},
+    {"HETATM", "iCode", {27, 27}},
+    {"HETATM", "x", {31, 38}},
+    {"HETATM", "y", {39, 46}},
+    {"HETATM", "z", {47, 54}},
+    {"HETATM", "occupancy", {55, 60}},
+    {"HETATM", "tempFactor", {61, 66}},
+    {"HETATM", "element", {77, 78}},
+    {"HETATM", "charge", {79, 80}},
+    {"HETNAM", "continuation", {9, 10}},
+    {"HETNAM", "hetID", {12, 14}},
+    {"HETNAM", "text", {16, 70}},
+    {"HETSYN", "continuation", {9, 10}},
+    {"HETSYN", "hetID", {12, 14}},
+    {"HETSYN", "hetSynonyms", {16, 70}},
+    {"JRNL", "text", {13, 79}},
+    {"KEYWDS", "continuation", {9, 10}},
+    {"KEYWDS", "keywds", {11, 79}},
+    {"LINK", "name1", {13, 16}},
+    {"LINK", "altLoc1", {17, 17}},
+    {"LINK", "resName1", {18, 20}},
+    {"LINK", "chainID1", {22, 22}},
+    {"LINK", "resSeq1", {23, 26}},
+    {"LINK", "iCode1", {27, 27}},
+    {"LINK", "name2", {43, 46}},
+    {"LINK", "altLoc2", {47, 47}},
+    {"LINK", "resName2", {48, 50}},
+    {"LINK", "chainID2", {52, 52}},
+    {"LINK", "resSeq2", {53, 56}},
+    {"LINK", "iCode2", {57, 57}},
+    {"LINK", "sym1", {60, 65}},
+    {"LINK", "sym2", {67, 72}},
+    {"LINK", "Length", {74, 78}},
+    {"MASTER", "numRemark", {11, 15}},
+    {"MASTER", "0", {16, 20}},
+    {"MASTER", "numHet", {21, 25}},
+    {"MASTER", "numHelix", {26, 30}},
+    {"MASTER", "numSheet", {31, 35}},
+    {"MASTER", "numTurn", {36, 40}},
+    {"MASTER", "numSite", {41, 45}},
+    {"MASTER", "numXform", {46, 50}},
+    {"MASTER", "numCoord", {51, 55}},
+    {"MASTER", "numTer", {56, 60}},
+    {"MASTER", "numConect", {61, 65}},
+    {"MASTER", "numSeq", {66, 70}},
+    {"MDLTYP", "continuation", {9, 10}},
+    {"MDLTYP", "comment", {11, 80}},
+    {"MODEL", "serial", {11, 14}},
+    {"MODRES", "idCode", {8, 11}},
+    {"MODRES", "resName", {13, 15}},
+    {"MODRES", "chainID", {17, 17}},
+    {"MODRES", "seqNum", {19, 22}},
+    {"MODRES", "iCode", {23, 23}},
+    {"MODRES", "stdRes", {25, 27}},
+    {"MODRES", "comment", {30, 70}},
+    {"MTRIX1", "serial", {8, 10}},
+    {"MTRIX1", "m[1][1]", {11, 20}},
+    {"MTRIX1", "m[1][2]", {21, 30}},
+    {"MTRIX1", "m[1][3]", {31, 40}},
+    {"MTRIX1", "v[1]", {46, 55}},
+    {"MTRIX1", "iGiven", {60, 60}},
+    {"MTRIX2", "serial", {8, 10}},
+    {"MTRIX2", "m[2][1]", {11, 20}},
+    {"MTRIX2", "m[2][2]", {21, 30}},
+    {"MTRIX2", "m[2][3]", {31, 40}},
+    {"MTRIX2", "v[2]", {46, 55}},
+    {"MTRIX2", "iGiven", {60, 60}},
+    {"MTRIX3", "serial", {8, 10}},
+    {"MTRIX3", "m[3][1]", {11, 20}},
+    {"MTRIX3", "m[3][2]", {21, 30}},
+    {"MTRIX3", "m[3][3]", {31, 40}},
+    {"MTRIX3", "v[3]", {46, 55}},
+    {"MTRIX3", "iGiven", {60, 60}},
+    {"NUMMDL", "modelNumber", {11, 14}},
+    {"OBSLTE", "continuation", {9, 10}},
+    {"OBSLTE", "repDate", {12, 20}},
+    {"OBSLTE", "idCode", {22, 25}},
+    {"OBSLTE", "rIdCode", {32, 35, 37, 40, 42, 45, 47, 50, 52, 55, 57, 60, 62, 65, 67, 70, 72, 75}},
+    {"ORIGX1", "o[1][1]", {11, 20}},
+    {"ORIGX1", "o[1][2]", {21, 30}},
+    {"ORIGX1", "o[1][3]", {31, 40}},
+    {"ORIGX1", "t[1]", {46, 55}},
+    {"ORIGX2", "o[2][1]", {11, 20}},
+    {"ORIGX2", "o[2][2]", {21, 30}},
+    {"ORIGX2", "o[2][3]", {31, 40}},
+    {"ORIGX2", "t[2]", {46, 55}},
+    {"ORIGX3", "o[3][1]", {11, 20}},
+    {"ORIGX3", "o[3][2]", {21, 30}},
+    {"ORIGX3", "o[3][3]", {31, 40}},
+    {"ORIGX3", "t[3]", {46, 55}},
+    {"REMARK", "remarkNum", {8, 10}},
+    {"REMARK", "empty", {12, 79}},
+    {"REVDAT", "modNum", {8, 10}},
+    {"REVDAT", "continuation", {11, 12}},
+    {"REVDAT", "modDate", {14, 22}},
+    {"REVDAT", "modId", {24, 27}},
+    {"REVDAT", "modType", {32, 32}},
+    {"REVDAT", "record", {40, 45, 47, 52, 54, 59, 61, 66}},
+    {"SCALE1", "s[1][1]", {11, 20}},
+    {"SCALE1", "s[1][2]", {21, 30}},
+    {"SCALE1", "s[1][3]", {31, 40}},
+    {"SCALE1", "u[1]", {46, 55}},
+    {"SCALE2", "s[2][1]", {11, 20}},
+    {"SCALE2", "s[2][2]", {21, 30}},
+    {"SCALE2", "s[2][3]", {31, 40}},
+    {"SCALE2", "u[2]", {46, 55}},
+    {"SCALE3", "s[3][1]", {11, 20}},
+    {"SCALE3", "s[3][2]", {21, 30}},
+    {"SCALE3", "s[3][3]", {31, 40}},
+    {"SCALE3", "u[3]", {46, 55}},
+    {"SEQADV", "idCode", {8, 11}},
+    {"SEQADV", "resName", {13, 15}},
+    {"SEQADV", "chainID", {17, 17}},
+    {"SEQADV", "seqNum", {19, 22}},
+    {"SEQADV", "iCode", {23, 23}},
+    {"SEQADV", "database", {25, 28}},
+    {"SEQADV", "dbAccession", {30, 38}},
+    {"SEQADV", "dbRes", {40, 42}},
+    {"SEQADV", "dbSeq", {44, 48}},
+    {"SEQADV", "conflict", {50, 70}},
+    {"SEQRES", "serNum", {8, 10}},
+    {"SEQRES", "chainID", {12, 12}},
+    {"SEQRES", "numRes", {14, 17}},
+    {"SEQRES", "resName", {20, 22, 24, 26, 28, 30, 32, 34, 36, 38, 40, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62, 64, 66, 68, 70}},
+    {"SHEET", "strand", {8, 10}},
+    {"SHEET", "sheetID", {12, 14}},
+    {"SHEET", "numStrands", {15, 16}},
+    {"SHEET", "initResName", {18, 20}},
+    {"SHEET", "initChainID", {22, 22}},
+    {"SHEET", "initSeqNum", {23, 26}},
+    {"SHEET", "initICode", {27, 27}},
+    {"SHEET", "endResName", {29, 31}},
+    {"SHEET", "endChainID", {33, 33}},
+    {"SHEET", "endSeqNum", {34, 37}},
+    {"SHEET", "endICode", {38, 38}},
+    {"SHEET", "sense", {39, 40}},
+    {"SHEET", "curAtom", {42, 45}},
+    {"SHEET", "curResName", {46, 48}},
+    {"SHEET", "curChainId", {50, 50}},
+    {"SHEET", "curResSeq", {51, 54}},
+    {"SHEET", "curICode", {55, 55}},
+    {"SHEET", "prevAtom", {57, 60}},
+    {"SHEET", "prevResName", {61, 63}},
+    {"SHEET", "prevChainId", {65, 65}},
+    {"SHEET", "prevResSeq", {66, 69}},
+    {"SHEET", "prevICode", {70, 70}},
+    {"SIGATM", "serial", {7, 11}},
+    {"SIGATM", "name", {13, 16}},
+    {"SIGATM", "altLoc", {17, 17}},
+    {"SIGATM", "resName", {18, 20}},
+    {"SIGATM", "chainID", {22, 22}},
+    {"SIGATM", "resSeq", {23, 26}},
+    {"SIGATM", "iCode", {27, 27}},
+    {"SIGATM", "sigX", {31, 38}},
+    {"SIGATM", "sigY", {39, 46}},
+    {"SIGATM", "sigZ", {47, 54}},
+    {"SIGATM", "sigOcc", {55, 60}},
+    {"SIGATM", "sigTemp", {61, 66}},
+    {"SIGATM", "element", {77, 78}},
+    {"SIGATM", "charge", {79, 80}},
+    {"SIGUIJ", "serial", {7, 11}},
+    {"SIGUIJ", "name", {13, 16}},
+    {"SIGUIJ", "altLoc", {17, 17}},
+    {"SIGUIJ", "resName", {18, 20}},
+    {"SIGUIJ", "chainID", {22, 22}},
+    {"SIGUIJ", "resSeq", {23, 26}},
+    {"SIGUIJ", "iCode", {27, 27}},
+    {"SIGUIJ", "sig[0][0]", {29, 35}},
+    {"SIGUIJ", "sig[1][1]", {36, 42}},
+    {"SIGUIJ", "sig[2][2]", {43, 49}},
+    {"SIGUIJ", "sig[0][1]", {50, 56}},
+    {"SIGUIJ", "sig[0][2]", {57, 63}},
+    {"SIGUIJ", "sig[1][2]", {64, 70}},
+    {"SIGUIJ", "element", {77, 78}},
+    {"SIGUIJ", "charge", {79, 80}},
+    {"SITE", "seqNum", {8, 10}},
+    {"SITE", "siteID", {12, 14}},
+    {"SITE", "numRes", {16, 17}},
+    {"SITE", "resName1", {19, 21}},
+    {"SITE", "chainID1", {23, 23}},
+    {"SITE", "seq1", {24, 27}},
+    {"SITE", "iCode1", {28, 28}},
+    {"SITE", "resName2", {30, 32}},
+    {"SITE", "chainID2", {34, 34}},
+    {"SITE", "seq2", {35, 38}},
+    {"SITE", "iCode2", {39, 39}},
+    {"SITE", "resName3", {41, 43}},
+    {"SITE", "chainID3", {45, 45}},
+    {"SITE", "seq3", {46, 49}},
+    {"SITE", "iCode3", {50, 50}},
+    {"SITE", "resName4", {52, 54}},
+    {"SITE", "chainID4", {56, 56}},
+    {"SITE", "seq4", {57, 60}},
+    {"SITE", "iCode4", {61, 61}},
+    {"SOURCE", "continuation", {8, 10}},
+    {"SOURCE", "srcName", {11, 79}},
+    {"SPLIT", "continuation", {9, 10}},
+    {"SPLIT", "idCode", {12, 15, 17, 20, 22, 25, 27, 30, 32, 35, 37, 40, 42, 45, 47, 50, 52, 55, 57, 60, 62, 65, 67, 70, 72, 75, 77, 80}},
+    {"SPRSDE", "continuation", {9, 10}},
+    {"SPRSDE", "sprsdeDate", {12, 20}},
+    {"SPRSDE", "idCode", {22, 25}},
+    {"SPRSDE", "sIdCode", {32, 35, 37, 40, 42, 45, 47, 50, 52, 55, 57, 60, 62, 65, 67, 70, 72, 75}},
+    {"SSBOND", "serNum", {8, 10}},
+    {"SSBOND", "CYS", {26, 28}},
+    {"SSBOND", "chainID1", {16, 16}},
+    {"SSBOND", "seqNum1", {18, 21}},
+    {"SSBOND", "icode1", {22, 22}},
+    {"SSBOND", "chainID2", {30, 30}},
+    {"SSBOND", "seqNum2", {32, 35}},
+    {"SSBOND", "icode2", {36, 36}},
+    {"SSBOND", "sym1", {60, 65}},
+    {"SSBOND", "sym2", {67, 72}},
+    {"SSBOND", "Length", {74, 78}},
+    {"TER", "serial", {7, 11}},
+    {"TER", "resName", {18, 20}},
+    {"TER", "chainID", {22, 22}},
+    {"TER", "resSeq", {23, 26}},
+    {"TER", "iCode", {27, 27}},
+    {"TITLE", "continuation", {9, 10}},
+    {"TITLE", "title", {11, 80}},
+};
+
+constexpr size_t n_rows = std::size(rows);
+
+constexpr bool starts_record(size_t row) { return row == 0 || rows[row].record.value() != rows[row - 1].record.value(); }
+
+/// Index of row which follows rows of record started at @p first
+constexpr size_t end_of_record(size_t first) {
+  size_t last = first + 1;
+  while (last < n_rows && !starts_record(last)) {
+    ++last;
+  }
+  return last;
+}
+
+constexpr size_t count_fields(size_t first) { return rows[first].has_field ? end_of_record(first) - first : 0; }
+
+constexpr size_t count_records() {
+  size_t n = 0;
+  for (size_t i = 0; i < n_rows; ++i) {
+    n += starts_record(i);
+  }
+  return n;
+}
+
+constexpr size_t count_colons() {
+  size_t n = 0;
+  for (auto& row : rows) {
+    n += row.n_colons;
+  }
+  return n;
+}
+
+constexpr size_t count_field_slots() {
+  size_t n = 0;
+  for (size_t first = 0; first < n_rows; first = end_of_record(first)) {
+    n += size_t(1) << perfect_hash_bits(count_fields(first));
+  }
+  return n;
+}
+
+constexpr size_t n_records = count_records();
+constexpr size_t n_colons = count_colons();
+constexpr size_t n_field_slots = count_field_slots();
+constexpr int record_bits = perfect_hash_bits(n_records);
+
+/// Generated by tools/generate_pdb_record_seeds.py
+constexpr uint64_t record_seed = 148;
+constexpr uint64_t field_seeds[] = {
+    3, 1, 0, 0, 2, 1, 0, 0, 4, 1, 0, 0, 0, 0, 0, 0, 6, 0, 1, 0, 0, 0, 0, 13, 7, 0, 0, 1, 1, 0, 0, 0, 1, 0, 2, 1, 0,
+    1, 0, 1, 0, 2, 0, 1, 5, 14, 5, 0, 0, 0, 2, 0, 0
+};
+
+static_assert(std::size(field_seeds) == n_records, "Stale field_seeds, run tools/generate_pdb_record_seeds.py");
+
+struct PackedTable {
+  std::array<int, n_colons> colons{};
+  std::array<size_t, n_rows> row_colons{}; /// offset of row colons
+
+  std::array<uint64_t, n_records> record_names{};
+  std::array<size_t, n_records> first_row{};
+  std::array<size_t, n_records> n_fields{};
+  std::array<size_t, n_records> first_slot{};
+  std::array<uint64_t, n_records> seed{};
+  std::array<int, n_records> bits{};
+  std::array<uint8_t, n_field_slots> field_slots{};
+
+  std::array<uint8_t, size_t(1) << record_bits> record_slots{};
+
+  bool seeds_are_perfect = true; /// no two keys are mapped to same slot
+};
+
+constexpr PackedTable pack() {
+  PackedTable table;
+  for (size_t i = 0, offset = 0; i < n_rows; offset += rows[i].n_colons, ++i) {
+    table.row_colons[i] = offset;
+    for (size_t k = 0; k < rows[i].n_colons; ++k) {
+      table.colons[offset + k] = rows[i].colons[k];
+    }
+  }
+  size_t record = 0;
+  size_t slot = 0;
+  for (size_t first = 0; first < n_rows; first = end_of_record(first), ++record) {
+    const size_t n_fields = count_fields(first);
+    if (n_fields > max_record_fields) {
+      throw std::length_error("too many fields of record");
+    }
+    uint64_t keys[max_record_fields] = {};
+    for (size_t i = 0; i < n_fields; ++i) {
+      keys[i] = rows[first + i].field.value();
+    }
+    table.record_names[record] = rows[first].record.value();
+    table.first_row[record] = first;
+    table.n_fields[record] = n_fields;
+    table.first_slot[record] = slot;
+    table.bits[record] = perfect_hash_bits(n_fields);
+    table.seed[record] = field_seeds[record];
+    table.seeds_are_perfect &=
+        fill_perfect_hash_slots(keys, n_fields, table.field_slots.data() + slot, table.bits[record], table.seed[record]);
+    slot += size_t(1) << table.bits[record];
+  }
+  table.seeds_are_perfect &=
+      fill_perfect_hash_slots(table.record_names.data(), n_records, table.record_slots.data(), record_bits, record_seed);
+  return table;
+}
+
+constexpr PackedTable packed = pack();
+
+static_assert(packed.seeds_are_perfect, "Hash collision, run tools/generate_pdb_record_seeds.py");
+
+constexpr std::array<PdbRecordType::Field, n_rows> make_fields() {
+  std::array<PdbRecordType::Field, n_rows> fields{};
+  for (size_t i = 0; i < n_rows; ++i) {
+    fields[i] = {rows[i].field, PdbFieldColons(packed.colons.data() + packed.row_colons[i], rows[i].n_colons)};
+  }
+  return fields;
+}
+
+constexpr std::array<PdbRecordType::Field, n_rows> fields = make_fields();
+
+constexpr std::array<PdbRecordType, n_records> make_records() {
+  std::array<PdbRecordType, n_records> records{};
+  for (size_t r = 0; r < n_records; ++r) {
+    records[r] = PdbRecordType(
+        xmol::future::Span<const PdbRecordType::Field>(fields.data() + packed.first_row[r], packed.n_fields[r]),
+        xmol::future::Span<const uint8_t>(packed.field_slots.data() + packed.first_slot[r],
+                                          size_t(1) << packed.bits[r]),
+        packed.seed[r], packed.bits[r]);
+  }
+  return records;
+}
+
+constexpr std::array<PdbRecordType, n_records> records = make_records();
+
+} // namespace
+
+const PdbRecordType* detail::find_bundled_record(const RecordName& recordTypeName) noexcept {
+  const uint8_t index = packed.record_slots[perfect_hash_slot(recordTypeName.value(), record_seed, record_bits)];
+  if (index != perfect_hash_empty_slot && packed.record_names[index] == recordTypeName.value()) {
+    return &records[index];
+  }
+  return nullptr;
 }
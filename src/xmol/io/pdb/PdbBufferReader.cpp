@@ -0,0 +1,288 @@
+#include "xmol/io/pdb/PdbBufferReader.h"
+#include "xmol/io/pdb/exceptions.h"
+#include "xmol/utils/parallel.h"
+#include "xmol/utils/parsing.h"
+#include <algorithm>
+#include <optional>
+
+using namespace xmol;
+using namespace xmol::io::pdb;
+using xmol::utils::parse_fixed_point_field;
+using xmol::utils::parse_int_field;
+using xmol::utils::trim_field;
+
+namespace {
+
+/// Colons of record name of any record
+constexpr int record_name_colons[] = {1, 6};
+
+enum class Record { ATOM, HETATM, ATOM_DETAILS, TER, MODEL, ENDMDL, CRYST1, OTHER };
+
+/// Line which starts at given position without line terminator and position of next line
+struct Line {
+  std::string_view text;
+  size_t next;
+};
+
+Line line_at(std::string_view buffer, size_t pos) {
+  auto eol = std::min(buffer.find('\n', pos), buffer.size());
+  auto text = buffer.substr(pos, eol - pos);
+  if (!text.empty() && text.back() == '\r') {
+    text.remove_suffix(1);
+  }
+  return {text, std::min(eol + 1, buffer.size())};
+}
+
+Record record_of(std::string_view line) {
+  auto name = line.substr(0, 6);
+  auto last = name.find_last_not_of(' ');
+  name = name.substr(0, last == std::string_view::npos ? 0 : last + 1);
+  if (name == "ATOM") {
+    return Record::ATOM;
+  }
+  if (name == "HETATM") {
+    return Record::HETATM;
+  }
+  if (name == "ANISOU" || name == "SIGATM" || name == "SIGUIJ") {
+    return Record::ATOM_DETAILS;
+  }
+  if (name == "TER") {
+    return Record::TER;
+  }
+  if (name == "MODEL") {
+    return Record::MODEL;
+  }
+  if (name == "ENDMDL") {
+    return Record::ENDMDL;
+  }
+  if (name == "CRYST1") {
+    return Record::CRYST1;
+  }
+  return Record::OTHER;
+}
+
+bool is_atom(Record record) { return record == Record::ATOM || record == Record::HETATM; }
+
+} // namespace
+
+PdbBufferReader::PdbBufferReader(std::string_view buffer, const basic_PdbRecords& db)
+    : m_buffer(buffer), m_atom(db.get_record(RecordName("ATOM"))), m_hetatm(db.get_record(RecordName("HETATM"))),
+      m_cell(db.get_record(RecordName("CRYST1"))) {}
+
+std::vector<Frame> PdbBufferReader::read_frames(int n_threads) const {
+  auto models = find_models();
+  std::vector<Frame> frames(models.size());
+  utils::parallel_for(models.size(), n_threads,
+                      [&](size_t task, int) { frames[task] = read_model(models[task]); });
+  return frames;
+}
+
+std::vector<PdbBufferReader::Model> PdbBufferReader::find_models() const {
+  std::vector<Model> models;
+  auto cell = geom::UnitCell::unit_cubic_cell();
+  size_t pos = 0;
+  while (pos < m_buffer.size()) {
+    auto [line, next] = line_at(m_buffer, pos);
+    auto record = record_of(line);
+    if (record == Record::CRYST1) {
+      cell = read_cell(line);
+    } else if (record == Record::MODEL) {
+      // jump between line starts which look like ENDMDL, model lines themselves are not classified
+      size_t end = next;
+      while (end < m_buffer.size() && record_of(line_at(m_buffer, end).text) != Record::ENDMDL) {
+        end = std::min(m_buffer.find("\nENDMDL", end), m_buffer.size() - 1) + 1;
+      }
+      models.push_back({next, end, cell});
+      next = end < m_buffer.size() ? line_at(m_buffer, end).next : end;
+    } else if (is_atom(record)) {
+      // frame without MODEL record lasts until first unrelated record
+      size_t end = pos;
+      while (end < m_buffer.size()) {
+        auto [atom_line, atom_next] = line_at(m_buffer, end);
+        auto atom_record = record_of(atom_line);
+        if (!is_atom(atom_record) && atom_record != Record::ATOM_DETAILS && atom_record != Record::TER) {
+          break;
+        }
+        end = atom_next;
+      }
+      models.push_back({pos, end, cell});
+      next = end;
+    }
+    pos = next;
+  }
+  return models;
+}
+
+Frame PdbBufferReader::read_model(const Model& model) const {
+  // Count upper bounds of atoms, residues and chains to preallocate frame storage,
+  // residues are compared by raw text of fields here
+  size_t n_atoms = 0;
+  size_t n_residues = 0;
+  size_t n_molecules = 0;
+  {
+    bool chain_open = false;
+    char chain_id = 0;
+    std::string_view res_seq, i_code;
+    for (size_t pos = model.begin; pos < model.end;) {
+      auto [line, next] = line_at(m_buffer, pos);
+      pos = next;
+      auto record = record_of(line);
+      if (record == Record::TER) {
+        chain_open = false;
+      }
+      if (!is_atom(record)) {
+        continue;
+      }
+      auto& layout = record == Record::ATOM ? m_atom : m_hetatm;
+      if (line.size() < layout.min_length) {
+        continue;
+      }
+      ++n_atoms;
+      if (!chain_open || layout.chainID.of(line)[0] != chain_id) {
+        chain_open = true;
+        chain_id = layout.chainID.of(line)[0];
+        ++n_molecules;
+        res_seq = {};
+      }
+      if (layout.resSeq.of(line) != res_seq || layout.iCode.of(line) != i_code) {
+        res_seq = layout.resSeq.of(line);
+        i_code = layout.iCode.of(line);
+        ++n_residues;
+      }
+    }
+  }
+
+  Frame frame;
+  frame.reserve_molecules(n_molecules);
+  frame.reserve_residues(n_residues);
+  frame.reserve_atoms(n_atoms);
+  frame.cell = model.cell;
+
+  std::optional<proxy::MoleculeRef> molecule;
+  std::optional<proxy::ResidueRef> residue;
+  char chain_id = 0;
+  ResidueId residue_id;
+  for (size_t pos = model.begin; pos < model.end;) {
+    const std::string_view line = line_at(m_buffer, pos).text;
+    pos = line_at(m_buffer, pos).next;
+    auto record = record_of(line);
+    if (record == Record::TER) {
+      molecule = {};
+    }
+    if (!is_atom(record)) {
+      continue;
+    }
+    auto& layout = record == Record::ATOM ? m_atom : m_hetatm;
+
+    char atom_chain_id = field(line, layout.chainID)[0];
+    auto i_code = name_field(line, layout.iCode, ResidueInsertionCode::max_length);
+    ResidueId atom_residue_id(int_field(line, layout.resSeq), ResidueInsertionCode(i_code.data(), i_code.size()));
+    if (!molecule || atom_chain_id != chain_id) {
+      chain_id = atom_chain_id;
+      molecule = frame.add_molecule().name(MoleculeName(&chain_id, 1));
+      residue = {};
+    }
+    if (!residue || atom_residue_id != residue_id) {
+      residue_id = atom_residue_id;
+      auto residue_name = name_field(line, layout.resName, ResidueName::max_length);
+      residue = molecule->add_residue()
+                    .name(ResidueName(residue_name.data(), residue_name.size()))
+                    .id(residue_id);
+    }
+    auto atom_name = name_field(line, layout.name, AtomName::max_length);
+    residue->add_atom()
+        .name(AtomName(atom_name.data(), atom_name.size()))
+        .id(int_field(line, layout.serial))
+        .r(XYZ(double_field(line, layout.x), double_field(line, layout.y), double_field(line, layout.z)));
+  }
+  return frame;
+}
+
+size_t PdbBufferReader::count_atoms(const Model& model) const {
+  size_t n_atoms = 0;
+  for (size_t pos = model.begin; pos < model.end;) {
+    auto [line, next] = line_at(m_buffer, pos);
+    n_atoms += is_atom(record_of(line));
+    pos = next;
+  }
+  return n_atoms;
+}
+
+void PdbBufferReader::read_model_coords(const Model& model, Frame& frame) const {
+  auto atoms = frame.atoms();
+  auto coords = frame.coords();
+  size_t i = 0;
+  for (size_t pos = model.begin; pos < model.end;) {
+    auto [line, next] = line_at(m_buffer, pos);
+    pos = next;
+    auto record = record_of(line);
+    if (!is_atom(record)) {
+      continue;
+    }
+    auto& layout = record == Record::ATOM ? m_atom : m_hetatm;
+    if (i == atoms.size()) {
+      throw_field_error(line, "PDB line: model has more atoms than frame (" + std::to_string(atoms.size()) + ")",
+                        PdbColumns(PdbFieldColons(record_name_colons, 2)));
+    }
+    auto atom_name = name_field(line, layout.name, AtomName::max_length);
+    if (AtomName(atom_name.data(), atom_name.size()) != atoms[i].name()) {
+      throw_field_error(line, "PDB line: atom name doesn't match frame atom `" + atoms[i].name().str() + "`",
+                        layout.name);
+    }
+    coords[i].set(XYZ(double_field(line, layout.x), double_field(line, layout.y), double_field(line, layout.z)));
+    ++i;
+  }
+  if (i != atoms.size()) {
+    throw PdbException("PDB model has " + std::to_string(i) + " atoms, expected " + std::to_string(atoms.size()));
+  }
+  frame.cell = model.cell;
+}
+
+geom::UnitCell PdbBufferReader::read_cell(std::string_view line) const {
+  return geom::UnitCell(double_field(line, m_cell.a), double_field(line, m_cell.b), double_field(line, m_cell.c),
+                        geom::Degrees(double_field(line, m_cell.alpha)), geom::Degrees(double_field(line, m_cell.beta)),
+                        geom::Degrees(double_field(line, m_cell.gamma)));
+}
+
+std::string_view PdbBufferReader::field(std::string_view line, const PdbColumns& columns) const {
+  if (GSL_UNLIKELY(line.size() < columns.end())) {
+    throw_field_error(line, "PDB line is too short", columns);
+  }
+  return columns.of(line);
+}
+
+std::string_view PdbBufferReader::name_field(std::string_view line, const PdbColumns& columns,
+                                             size_t max_length) const {
+  auto value = trim_field(field(line, columns));
+  if (GSL_UNLIKELY(value.size() > max_length)) {
+    throw_field_error(line, "PDB line: name is too long", columns);
+  }
+  return value;
+}
+
+int PdbBufferReader::int_field(std::string_view line, const PdbColumns& columns) const {
+  auto [success, value] = parse_int_field(field(line, columns));
+  if (GSL_UNLIKELY(!success)) {
+    throw_field_error(line, "PDB line: can't read int", columns);
+  }
+  return value;
+}
+
+double PdbBufferReader::double_field(std::string_view line, const PdbColumns& columns) const {
+  auto [success, value] = parse_fixed_point_field(field(line, columns));
+  if (GSL_UNLIKELY(!success)) {
+    throw_field_error(line, "PDB line: can't read double", columns);
+  }
+  return value;
+}
+
+void PdbBufferReader::throw_field_error(std::string_view line, const std::string& what,
+                                        const PdbColumns& columns) const {
+  const size_t line_number = 1 + std::count(m_buffer.data(), line.data(), '\n');
+  const int colon_l = columns.first;
+  const int colon_r = columns.first + columns.n - 1;
+  std::string filler(std::min(std::max(colon_l, 0), 80), '~');
+  std::string underline(std::min(colon_r - colon_l + 1, 80), '^');
+  throw PdbException(what + "\n" + "at line " + std::to_string(line_number) + ":" + std::to_string(colon_l) + "-" +
+                     std::to_string(colon_r) + "\n" + std::string(line) + "\n" + filler + underline);
+}
@@ -0,0 +1,21 @@
+#include "xmol/io/pdb/PdbLayout.h"
+#include <algorithm>
+
+using namespace xmol::io::pdb;
+
+PdbAtomRecordLayout::PdbAtomRecordLayout(const PdbRecordType& record)
+    : serial(record.getFieldColons(FieldName("serial"))), name(record.getFieldColons(FieldName("name"))),
+      resName(record.getFieldColons(FieldName("resName"))), chainID(record.getFieldColons(FieldName("chainID"))),
+      resSeq(record.getFieldColons(FieldName("resSeq"))), iCode(record.getFieldColons(FieldName("iCode"))),
+      x(record.getFieldColons(FieldName("x"))), y(record.getFieldColons(FieldName("y"))),
+      z(record.getFieldColons(FieldName("z"))) {
+  min_length = 0;
+  for (auto& columns : {serial, name, resName, chainID, resSeq, iCode, x, y, z}) {
+    min_length = std::max(min_length, columns.end());
+  }
+}
+
+PdbCellRecordLayout::PdbCellRecordLayout(const PdbRecordType& record)
+    : a(record.getFieldColons(FieldName("a"))), b(record.getFieldColons(FieldName("b"))),
+      c(record.getFieldColons(FieldName("c"))), alpha(record.getFieldColons(FieldName("alpha"))),
+      beta(record.getFieldColons(FieldName("beta"))), gamma(record.getFieldColons(FieldName("gamma"))) {}
@@ -16,7 +16,7 @@ PdbLine::PdbLine(const std::string& pdb_line, const basic_PdbRecords& db)
     : recordName(rtrim(pdb_line.substr(0, 6))), line(&pdb_line),
       pdbRecordType(&db.get_record(this->recordName)) {}
 double PdbLine::getDouble(const FieldName& fieldName, size_t idx) const {
-  auto& v = pdbRecordType->getFieldColons(fieldName);
+  auto v = pdbRecordType->getFieldColons(fieldName);
   auto first = v[idx * 2] - 1;
   auto last = v[idx * 2 + 1] - 1;
   auto n = last + 1 - first;
@@ -29,7 +29,7 @@ double PdbLine::getDouble(const FieldName& fieldName, size_t idx) const {
 }
 
 int PdbLine::getInt(const FieldName& fieldName, size_t idx) const {
-  auto& v = pdbRecordType->getFieldColons(fieldName);
+  auto v = pdbRecordType->getFieldColons(fieldName);
   auto first = v[idx * 2] - 1;
   auto last = v[idx * 2 + 1] - 1;
   auto n = last + 1 - first;
@@ -43,7 +43,7 @@ int PdbLine::getInt(const FieldName& fieldName, size_t idx) const {
 
 std::string PdbLine::getString(const FieldName& fieldName,
                                size_t idx) const {
-  auto& v = pdbRecordType->getFieldColons(fieldName);
+  auto v = pdbRecordType->getFieldColons(fieldName);
   if (line->length() < v[idx * 2 + 1]) {
     throw PdbFieldReadError("PDB line is too short",v[idx * 2] - 1, v[idx * 2 + 1]-1);
   }
@@ -52,7 +52,7 @@ std::string PdbLine::getString(const FieldName& fieldName,
 
 PdbLine::StrPtr PdbLine::getStrPtr(const FieldName& fieldName,
                                    size_t idx) const {
-  auto& v = pdbRecordType->getFieldColons(fieldName);
+  auto v = pdbRecordType->getFieldColons(fieldName);
   if (line->length() < v[idx * 2 + 1]) {
     throw PdbFieldReadError("PDB line is too short",v[idx * 2] - 1, v[idx * 2 + 1]-1);
   }
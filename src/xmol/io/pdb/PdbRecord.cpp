@@ -1,34 +1,61 @@
 #include "xmol/io/pdb/PdbRecord.h"
 #include "xmol/io/pdb/exceptions.h"
-
-#include <fstream>
+#include "xmol/utils/perfect_hash.h"
 
 using namespace xmol::io;
 using namespace xmol::io::pdb;
+using xmol::utils::perfect_hash_empty_slot;
+using xmol::utils::perfect_hash_slot;
 
-const std::vector<int>&
-PdbRecordType::getFieldColons(const FieldName& fieldName) const {
-  auto col = fieldColons.find(fieldName);
-  if (col != fieldColons.end()) {
-    return col->second;
+PdbFieldColons PdbRecordType::getFieldColons(const FieldName& fieldName) const {
+  if (!m_slots.empty()) {
+    const uint8_t index = m_slots[perfect_hash_slot(fieldName.value(), m_seed, m_bits)];
+    if (index != perfect_hash_empty_slot && m_fields[index].name == fieldName) {
+      return m_fields[index].colons;
+    }
   }
-  throw PdbUknownRecordField("Unknown field" +fieldName.str() + "`");
+  throw PdbUknownRecordField("Unknown field `" + fieldName.str() + "`");
 }
 
-void PdbRecordType::set_field(const FieldName& fieldName,
-                              const std::vector<int>& colons) {
-  fieldColons[fieldName] = colons;
+AlteredPdbRecords::OwnedRecord::OwnedRecord(const PdbRecordType& record) {
+  for (auto& field : record.fields()) {
+    colons.emplace(field.name, std::vector<int>(field.colons.begin(), field.colons.end()));
+  }
+  update();
 }
 
-StandardPdbRecords::StandardPdbRecords() {
-  this->recordTypes = detail::get_bundled_records();
+AlteredPdbRecords::OwnedRecord::OwnedRecord(const OwnedRecord& other) : colons(other.colons) { update(); }
+
+AlteredPdbRecords::OwnedRecord& AlteredPdbRecords::OwnedRecord::operator=(const OwnedRecord& other) {
+  colons = other.colons;
+  update();
+  return *this;
+}
+
+void AlteredPdbRecords::OwnedRecord::set_field(const FieldName& fieldName, std::vector<int> field_colons) {
+  colons[fieldName] = std::move(field_colons);
+  update();
+}
+
+void AlteredPdbRecords::OwnedRecord::update() {
+  fields.clear();
+  std::vector<uint64_t> keys;
+  for (auto& [name, field_colons] : colons) {
+    fields.push_back({name, PdbFieldColons(field_colons.data(), field_colons.size())});
+    keys.push_back(name.value());
+  }
+  const int bits = utils::perfect_hash_bits(keys.size());
+  slots.resize(size_t(1) << bits);
+  const uint64_t seed = utils::find_perfect_hash_seed(keys.data(), keys.size(), slots.data(), bits);
+  record = PdbRecordType(future::Span<const PdbRecordType::Field>(fields.data(), fields.size()),
+                         future::Span<const uint8_t>(slots.data(), slots.size()), seed, bits);
 }
 
 const PdbRecordType& AlteredPdbRecords::get_record(
     const RecordName& recordTypeName) const {
   auto it = recordTypes.find(recordTypeName);
   if (it != recordTypes.end()) {
-    return it->second;
+    return it->second.record;
   }
   return basic->get_record(recordTypeName);
 }
@@ -37,24 +64,20 @@ void AlteredPdbRecords::alter_record(RecordName recordTypeName,
                                      FieldName fieldName,
                                      std::vector<int> colons) {
   auto it = recordTypes.find(recordTypeName);
-  if (it != recordTypes.end()) { // alter owned record
-    it->second.set_field(fieldName, colons);
-  } else {
-    try { // copy record from backup and alter field
-      auto record = recordTypes.emplace(recordTypeName,
-                                        basic->get_record(recordTypeName));
-      record.first->second.set_field(fieldName, colons);
-    } catch (std::out_of_range&) { // create new record with single field
-      recordTypes.emplace(recordTypeName, PdbRecordType({{fieldName, colons}}));
+  if (it == recordTypes.end()) {
+    try { // copy record from underlying layer
+      it = recordTypes.emplace(recordTypeName, OwnedRecord(basic->get_record(recordTypeName))).first;
+    } catch (PdbUknownRecord&) { // create new record
+      it = recordTypes.emplace(recordTypeName, OwnedRecord(PdbRecordType())).first;
     }
   }
+  it->second.set_field(fieldName, std::move(colons));
 }
 
 const PdbRecordType&
 StandardPdbRecords::get_record(const RecordName& recordTypeName) const {
-  auto col = recordTypes.find(recordTypeName);
-  if (col != recordTypes.end()) {
-    return col->second;
+  if (auto record = detail::find_bundled_record(recordTypeName)) {
+    return *record;
   }
   throw PdbUknownRecord("Unknown record `" + recordTypeName.str() + "`");
 }
@@ -0,0 +1,88 @@
+#include "xmol/io/pdb/PdbTrajectoryWriter.h"
+#include "xmol/Frame.h"
+#include "xmol/io/pdb/exceptions.h"
+#include "xmol/proxy/spans.h"
+#include "xmol/utils/formatting.h"
+#include <sstream>
+
+using namespace xmol;
+using namespace xmol::io;
+using namespace xmol::io::pdb;
+using xmol::utils::format_fixed_point_field;
+using xmol::utils::format_wrapped_int_field;
+
+PdbTrajectoryWriter::PdbTrajectoryWriter(const std::string& filename, bool write_cell, const basic_PdbRecords& db)
+    : m_out(filename, std::ios::binary), m_db(&db), m_write_cell(write_cell), m_layout(db.get_record(RecordName("ATOM"))),
+      m_model_serial(db.get_record(RecordName("MODEL")).getFieldColons(FieldName("serial"))), m_writer(m_out) {
+  if (m_out.fail()) {
+    throw PdbWriteError("Can't open file `" + filename + "` for writing");
+  }
+}
+
+PdbTrajectoryWriter::~PdbTrajectoryWriter() {
+  try {
+    close();
+  } catch (PdbWriteError&) {
+  }
+}
+
+void PdbTrajectoryWriter::close() {
+  if (!m_out.is_open()) {
+    return;
+  }
+  m_out.write("END\n", 4);
+  m_out.close();
+  if (m_out.fail()) {
+    throw PdbWriteError("Can't close file after model " + std::to_string(m_n_models));
+  }
+}
+
+void PdbTrajectoryWriter::write(Frame& frame) {
+  if (!m_out.is_open()) {
+    throw PdbWriteError("PDB writer: file is closed");
+  }
+  if (m_atom_lines.size() != frame.n_atoms()) {
+    cache_atom_lines(frame);
+  }
+
+  auto coords = frame.coords();
+  for (size_t i = 0; i < m_atom_lines.size(); ++i) {
+    char* line = m_lines.data() + m_atom_lines[i];
+    const XYZ& r = coords[i];
+    if (!format_fixed_point_field(line + m_layout.x.first, m_layout.x.n, 3, r.x()) ||
+        !format_fixed_point_field(line + m_layout.y.first, m_layout.y.n, 3, r.y()) ||
+        !format_fixed_point_field(line + m_layout.z.first, m_layout.z.n, 3, r.z())) {
+      throw PdbWriteError("PDB writer: coordinates of atom " + to_string(frame.atoms()[i]) +
+                         " do not fit into ATOM record");
+    }
+  }
+
+  if (m_write_cell && frame.cell.volume() != 1.0) {
+    m_writer.write(frame.cell, *m_db);
+  }
+  ++m_n_models;
+  std::string model(std::max<size_t>(m_model_serial.end(), 6), ' ');
+  model.replace(0, 5, "MODEL");
+  format_wrapped_int_field(model.data() + m_model_serial.first, m_model_serial.n, m_n_models);
+  model += '\n';
+  m_out.write(model.data(), model.size());
+  m_out.write(m_lines.data(), m_lines.size());
+  m_out.write("ENDMDL\n", 7);
+  if (m_out.fail()) {
+    throw PdbWriteError("Can't write model " + std::to_string(m_n_models));
+  }
+}
+
+void PdbTrajectoryWriter::cache_atom_lines(Frame& frame) {
+  std::ostringstream out;
+  auto molecules = frame.molecules();
+  PdbWriter(out).write(molecules, *m_db);
+  m_lines = out.str();
+  m_atom_lines.clear();
+  m_atom_lines.reserve(frame.n_atoms());
+  for (size_t pos = 0; pos < m_lines.size(); pos = m_lines.find('\n', pos) + 1) {
+    if (m_lines.compare(pos, 4, "ATOM") == 0) {
+      m_atom_lines.push_back(pos);
+    }
+  }
+}
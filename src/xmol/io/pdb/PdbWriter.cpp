@@ -1,143 +1,269 @@
 #include "xmol/io/pdb/PdbWriter.h"
 #include "xmol/Frame.h"
-#include "xmol/io/pdb/PdbRecord.h"
+#include "xmol/io/pdb/PdbLayout.h"
+#include "xmol/io/pdb/exceptions.h"
 #include "xmol/proxy/selections.h"
+#include "xmol/utils/formatting.h"
+#include <algorithm>
+#include <optional>
 
 using namespace xmol::io::pdb;
 using namespace xmol::io;
 using namespace xmol;
 using namespace xmol::proxy;
+using xmol::utils::format_fixed_point_field;
+using xmol::utils::format_wrapped_int_field;
 
-void PdbWriter::write(AtomRef& atom) { this->write(atom, StandardPdbRecords::instance()); }
+namespace {
 
-void PdbWriter::write(ResidueRef& residue) { this->write(residue, StandardPdbRecords::instance()); }
+const int pdb_line_width = 80;
 
-void PdbWriter::write(MoleculeRef& chain) { this->write(chain, StandardPdbRecords::instance()); }
+/// Buffer is passed to stream in blocks of about that size
+const size_t flush_threshold = 1 << 20;
 
-void PdbWriter::write(Frame& frame) { this->write(frame, StandardPdbRecords::instance()); }
-namespace {
-  const int pdb_line_width = 80;
-
-  struct write_field_t{
-    write_field_t(const PdbRecordType& record,std::string& line):record(record),line(line){};
-    template<typename T>
-    void operator()(const char* const fmt, const T& value, const FieldName& field){
-      const std::vector<int>& colons = record.getFieldColons(field);
-      const int first = colons[0]-1;
-      const int last = colons[1]-1;
-      assert(first<=last);
-      assert(last<pdb_line_width);
-      int bytes_to_write = last+1-first;
-      char buff[bytes_to_write+2];
-      int w = std::snprintf(buff,bytes_to_write+1,fmt, value);
-      line.replace(last-w+1,w, buff);
-    };
-    const PdbRecordType& record;
-    std::string& line;
-  };
+/// Right-aligned text, returns false if text doesn't fit into columns
+bool write_text(char* line, const PdbColumns& columns, const char* text, int length) {
+  if (length > columns.n) {
+    return false;
+  }
+  std::fill(line + columns.first, line + columns.end() - length, ' ');
+  std::copy(text, text + length, line + columns.end() - length);
+  return true;
+}
+
+template <typename Name> bool write_name(char* line, const PdbColumns& columns, const Name& name) {
+  char text[Name::max_length];
+  int length = 0;
+  while (length < Name::max_length && name[length] != '\0') {
+    text[length] = name[length];
+    ++length;
+  }
+  return write_text(line, columns, text, length);
 }
-void PdbWriter::write(AtomRef& atom, const basic_PdbRecords& db) {
 
-  std::string line(pdb_line_width, ' ');
+void write_int(char* line, const PdbColumns& columns, long long value) {
+  format_wrapped_int_field(line + columns.first, columns.n, value);
+}
 
-  auto& atom_record = db.get_record(RecordName("ATOM"));
+/// Blank line of given width with record name
+std::string record_template(const char* record_name, size_t width) {
+  std::string line(std::max<size_t>(pdb_line_width, width), ' ');
+  line.replace(0, std::strlen(record_name), record_name);
+  return line;
+}
 
-  auto write_field = write_field_t(atom_record, line);
+/// Formats ATOM records into buffer, fields of residue are formatted once per residue
+class AtomLines {
+public:
+  AtomLines(const basic_PdbRecords& db, std::string& buffer, std::ostream& out)
+      : m_layout(db.get_record(RecordName("ATOM"))), m_buffer(buffer), m_out(out),
+        m_template(record_template("ATOM", m_layout.min_length)) {}
 
-  auto format_atom_name = [](const AtomName& aname) {
-    auto s = aname.str();
-    if (s.size() < 4) {
-      return " "+s;
+  void append(AtomRef& atom) {
+    auto residue = atom.residue();
+    if (!m_residue || !(*m_residue == residue)) {
+      set_residue(residue);
     }
-    return s;
-  };
+    const size_t offset = m_buffer.size();
+    m_buffer += m_template;
+    m_buffer += '\n';
+    char* line = m_buffer.data() + offset;
+    write_int(line, m_layout.serial, atom.id());
+    write_atom_name(line, atom.name());
+    const XYZ& r = atom.r();
+    if (!write_coord(line, m_layout.x, r.x()) || !write_coord(line, m_layout.y, r.y()) ||
+        !write_coord(line, m_layout.z, r.z())) {
+      m_buffer.resize(offset);
+      flush();
+      throw PdbWriteError("PDB writer: coordinates of atom " + to_string(atom) + " do not fit into ATOM record");
+    }
+    if (m_buffer.size() >= flush_threshold) {
+      flush();
+    }
+  }
 
-  line.replace(0,6,"ATOM");
-  write_field("%d", atom.id(), FieldName("serial"));
-  write_field("%-4s", format_atom_name(atom.name()).c_str(), FieldName("name"));
-//  write_field("%s", , FieldName("altLoc"));
-  write_field("%-s", atom.residue().name().str().c_str(), FieldName("resName"));
-  write_field("%-s", atom.residue().molecule().name().str().c_str(), FieldName("chainID"));
-  write_field("%-d", atom.residue().id().serial, FieldName("resSeq"));
-  write_field("%s", atom.residue().id().iCode.str().c_str(), FieldName("iCode"));
-  write_field("%8.3f", atom.r().x(), FieldName("x"));
-  write_field("%8.3f", atom.r().y(), FieldName("y"));
-  write_field("%8.3f", atom.r().z(), FieldName("z"));
-//  write_field("%s", , FieldName("occupancy"));
-//  write_field("%s", , FieldName("tempFactor"));
-//  write_field("%s", , FieldName("element"));
+  void append_ter() { m_buffer += "TER\n"; }
 
+  void flush() {
+    m_out.write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+  }
 
-  (*m_ostream) << line <<"\n";
-}
+private:
+  void set_residue(ResidueRef& residue) {
+    m_residue.reset();
+    char* line = m_template.data();
+    if (!write_name(line, m_layout.resName, residue.name())) {
+      name_doesnt_fit("residue name", residue.name().str(), m_layout.resName);
+    }
+    if (!write_name(line, m_layout.chainID, residue.molecule().name())) {
+      name_doesnt_fit("chain name", residue.molecule().name().str(), m_layout.chainID);
+    }
+    write_int(line, m_layout.resSeq, residue.id().serial);
+    if (!write_name(line, m_layout.iCode, residue.id().iCode)) {
+      name_doesnt_fit("insertion code", residue.id().iCode.str(), m_layout.iCode);
+    }
+    m_residue = residue;
+  }
 
-void PdbWriter::write(ResidueRef& residue, const basic_PdbRecords& db) {
+  /// Names are never truncated, columns can be widened by @ref AlteredPdbRecords (e.g. resName to 18-21)
+  [[noreturn]] void name_doesnt_fit(const char* what, const std::string& name, const PdbColumns& columns) {
+    flush();
+    throw PdbWriteError("PDB writer: " + std::string(what) + " `" + name + "` doesn't fit into " +
+                        std::to_string(columns.n) + " column(s) of ATOM record");
+  }
+
+  /// Atom names shorter than 4 characters start at second column
+  void write_atom_name(char* line, const AtomName& name) {
+    char text[AtomName::max_length] = {' ', ' ', ' ', ' '};
+    const int shift = name[AtomName::max_length - 1] == '\0' ? 1 : 0;
+    for (int i = 0; i + shift < AtomName::max_length && name[i] != '\0'; ++i) {
+      text[i + shift] = name[i];
+    }
+    if (!write_text(line, m_layout.name, text, AtomName::max_length)) {
+      name_doesnt_fit("atom name", name.str(), m_layout.name);
+    }
+  }
+
+  static bool write_coord(char* line, const PdbColumns& columns, double value) {
+    return format_fixed_point_field(line + columns.first, columns.n, 3, value);
+  }
+
+  PdbAtomRecordLayout m_layout;
+  std::string& m_buffer;
+  std::ostream& m_out;
+  std::string m_template;
+  std::optional<ResidueRef> m_residue;
+};
+
+void append_residue(ResidueRef& residue, AtomLines& lines) {
   for (auto& a : residue.atoms()) {
-    this->write(a, db);
+    lines.append(a);
   }
 }
-void PdbWriter::write(MoleculeRef& chain, const basic_PdbRecords& db) {
+
+void append_molecule(MoleculeRef& chain, AtomLines& lines) {
   for (auto& r : chain.residues()) {
-    this->write(r, db);
+    append_residue(r, lines);
   }
-  (*m_ostream) << ("TER\n");
+  lines.append_ter();
 }
 
-void PdbWriter::write(Frame& frame, const basic_PdbRecords& db) {
-  if (frame.cell.volume() != 1.0) {
-    std::string line(pdb_line_width, ' ');
-    line.replace(0, 6, "CRYST1");
+} // namespace
+
+void PdbWriter::write(AtomRef& atom) { this->write(atom, StandardPdbRecords::instance()); }
+
+void PdbWriter::write(ResidueRef& residue) { this->write(residue, StandardPdbRecords::instance()); }
+
+void PdbWriter::write(MoleculeRef& chain) { this->write(chain, StandardPdbRecords::instance()); }
+
+void PdbWriter::write(Frame& frame) { this->write(frame, StandardPdbRecords::instance()); }
+
+void PdbWriter::write(AtomRef& atom, const basic_PdbRecords& db) {
+  AtomLines lines(db, m_buffer, *m_ostream);
+  lines.append(atom);
+  flush();
+}
 
-    auto& cryst_record = db.get_record(RecordName("CRYST1"));
-    auto write_field = write_field_t(cryst_record, line);
+void PdbWriter::write(ResidueRef& residue, const basic_PdbRecords& db) {
+  AtomLines lines(db, m_buffer, *m_ostream);
+  append_residue(residue, lines);
+  flush();
+}
 
-    write_field("%9.3f", frame.cell.a(), FieldName("a"));
-    write_field("%9.3f", frame.cell.b(), FieldName("b"));
-    write_field("%9.3f", frame.cell.c(), FieldName("c"));
-    write_field("%7.2f", frame.cell.alpha().degrees(), FieldName("alpha"));
-    write_field("%7.2f", frame.cell.beta().degrees(), FieldName("beta"));
-    write_field("%7.2f", frame.cell.gamma().degrees(), FieldName("gamma"));
+void PdbWriter::write(MoleculeRef& chain, const basic_PdbRecords& db) {
+  AtomLines lines(db, m_buffer, *m_ostream);
+  append_molecule(chain, lines);
+  flush();
+}
 
-    (*m_ostream) << line << "\n";
+void PdbWriter::write(Frame& frame, const basic_PdbRecords& db) {
+  if (frame.cell.volume() != 1.0) {
+    append_cell(frame.cell, db);
   }
+  AtomLines lines(db, m_buffer, *m_ostream);
   for (auto& c : frame.molecules()) {
-    this->write(c, db);
+    append_molecule(c, lines);
   }
+  flush();
 }
 
 void PdbWriter::write(AtomSelection& atomSelection, const basic_PdbRecords& db) {
+  AtomLines lines(db, m_buffer, *m_ostream);
   for (auto& a : atomSelection) {
-    this->write(a, db);
+    lines.append(a);
   }
+  flush();
 }
+
 void PdbWriter::write(ResidueSelection& residueSelection, const basic_PdbRecords& db) {
+  AtomLines lines(db, m_buffer, *m_ostream);
   for (auto& r : residueSelection) {
-    this->write(r, db);
+    append_residue(r, lines);
   }
-  (*m_ostream) << ("TER\n");
+  lines.append_ter();
+  flush();
 }
 
 void PdbWriter::write(MoleculeSelection& chainSelection, const basic_PdbRecords& db) {
+  AtomLines lines(db, m_buffer, *m_ostream);
   for (auto& c : chainSelection) {
-    this->write(c, db);
+    append_molecule(c, lines);
   }
+  flush();
 }
 
 void PdbWriter::write(AtomSpan& atomSpan, const basic_PdbRecords& db) {
+  AtomLines lines(db, m_buffer, *m_ostream);
   for (auto& a : atomSpan) {
-    this->write(a, db);
+    lines.append(a);
   }
+  flush();
 }
+
 void PdbWriter::write(ResidueSpan& residueSpan, const basic_PdbRecords& db) {
+  AtomLines lines(db, m_buffer, *m_ostream);
   for (auto& r : residueSpan) {
-    this->write(r, db);
+    append_residue(r, lines);
   }
-  (*m_ostream) << ("TER\n");
+  lines.append_ter();
+  flush();
 }
 
 void PdbWriter::write(MoleculeSpan& chainSpan, const basic_PdbRecords& db) {
+  AtomLines lines(db, m_buffer, *m_ostream);
   for (auto& c : chainSpan) {
-    this->write(c, db);
+    append_molecule(c, lines);
   }
+  flush();
+}
+
+void PdbWriter::write(const geom::UnitCell& cell, const basic_PdbRecords& db) {
+  append_cell(cell, db);
+  flush();
+}
+
+void PdbWriter::append_cell(const geom::UnitCell& cell, const basic_PdbRecords& db) {
+  PdbCellRecordLayout layout(db.get_record(RecordName("CRYST1")));
+  std::string line = record_template("CRYST1", 0);
+  auto write_field = [&](const PdbColumns& columns, int precision, double value) {
+    if (columns.end() > line.size() ||
+        !format_fixed_point_field(line.data() + columns.first, columns.n, precision, value)) {
+      throw PdbWriteError("PDB writer: unit cell parameter " + std::to_string(value) +
+                         " doesn't fit into CRYST1 record");
+    }
+  };
+  write_field(layout.a, 3, cell.a());
+  write_field(layout.b, 3, cell.b());
+  write_field(layout.c, 3, cell.c());
+  write_field(layout.alpha, 2, cell.alpha().degrees());
+  write_field(layout.beta, 2, cell.beta().degrees());
+  write_field(layout.gamma, 2, cell.gamma().degrees());
+  m_buffer += line;
+  m_buffer += '\n';
 }
 
+void PdbWriter::flush() {
+  m_ostream->write(m_buffer.data(), m_buffer.size());
+  m_buffer.clear();
+}
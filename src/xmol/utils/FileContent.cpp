@@ -0,0 +1,358 @@
+#include "xmol/utils/FileContent.h"
+#include "xmol/utils/parallel.h"
+
+#include <stdexcept>
+#include <vector>
+#include <zlib.h>
+#ifdef XMOL_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace xmol::utils;
+
+namespace {
+
+/// zlib counts input and output in 32-bit integers, larger buffers are fed in chunks
+constexpr size_t max_zlib_chunk = 1u << 30;
+
+/// Size of chunks passed to FileContent::stream() consumer
+constexpr size_t stream_chunk_size = 1u << 16;
+
+using Consumer = std::function<bool(std::string_view)>;
+
+uint32_t read_le16(const unsigned char* p) { return p[0] | (p[1] << 8); }
+uint32_t read_le32(const unsigned char* p) {
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+const unsigned char* bytes(std::string_view data) { return reinterpret_cast<const unsigned char*>(data.data()); }
+
+bool is_gzip(std::string_view data) { return data.size() >= 2 && bytes(data)[0] == 0x1f && bytes(data)[1] == 0x8b; }
+
+bool is_zstd(std::string_view data) {
+  if (data.size() < 4) {
+    return false;
+  }
+  const uint32_t magic = read_le32(bytes(data));
+  // zstd frame or skippable frame (`pzstd` starts file with one)
+  return magic == 0xFD2FB528 || (magic & 0xFFFFFFF0) == 0x184D2A50;
+}
+
+/// Independently compressed part of input
+struct Block {
+  size_t in_begin;
+  size_t in_size;
+  size_t out_begin;
+  size_t out_size;
+};
+
+class Inflater {
+public:
+  Inflater() {
+    if (inflateInit2(&m_stream, 16 + MAX_WBITS) != Z_OK) { // gzip wrapper only
+      throw std::runtime_error("Can't initialize zlib");
+    }
+  }
+  Inflater(const Inflater&) = delete;
+  Inflater& operator=(const Inflater&) = delete;
+  ~Inflater() { inflateEnd(&m_stream); }
+  z_stream* operator->() { return &m_stream; }
+  z_stream* get() { return &m_stream; }
+
+private:
+  z_stream m_stream{};
+};
+
+/** Offsets of BGZF blocks, empty if @p data is not a BGZF file
+ *
+ * BGZF block is gzip member with `BC` extra subfield which holds block size,
+ * decompressed size is stored in member trailer */
+std::vector<Block> bgzf_blocks(std::string_view data) {
+  std::vector<Block> blocks;
+  size_t in = 0;
+  size_t out = 0;
+  while (in < data.size()) {
+    const unsigned char* p = bytes(data) + in;
+    const size_t left = data.size() - in;
+    if (left < 26 || p[0] != 0x1f || p[1] != 0x8b || p[2] != 8 || !(p[3] & 4) || read_le16(p + 10) != 6 ||
+        p[12] != 'B' || p[13] != 'C' || read_le16(p + 14) != 2) {
+      return {};
+    }
+    const size_t size = read_le16(p + 16) + 1;
+    if (size < 26 || size > left) {
+      return {};
+    }
+    const size_t out_size = read_le32(p + size - 4);
+    blocks.push_back({in, size, out, out_size});
+    in += size;
+    out += out_size;
+  }
+  return blocks;
+}
+
+void inflate_block(std::string_view in, char* out, size_t out_size) {
+  Inflater inflater;
+  inflater->next_in = const_cast<Bytef*>(bytes(in));
+  inflater->avail_in = in.size();
+  inflater->next_out = reinterpret_cast<Bytef*>(out);
+  inflater->avail_out = out_size;
+  if (inflate(inflater.get(), Z_FINISH) != Z_STREAM_END || inflater->avail_out != 0) {
+    throw std::runtime_error("corrupted BGZF block");
+  }
+}
+
+/// Inflate (multi-member) gzip stream
+std::string inflate_gzip(std::string_view data) {
+  std::string out;
+  // trailer of last member holds its size modulo 2^32, good guess for single-member files
+  const size_t last_member_size = data.size() >= 4 ? read_le32(bytes(data) + data.size() - 4) : 0;
+  out.resize(std::max<size_t>({last_member_size, data.size() * 4, 1 << 16}));
+
+  Inflater inflater;
+  size_t in_pos = 0;
+  size_t out_pos = 0;
+  while (true) {
+    if (out_pos == out.size()) {
+      out.resize(out.size() * 2);
+    }
+    const size_t avail_in = std::min(data.size() - in_pos, max_zlib_chunk);
+    const size_t avail_out = std::min(out.size() - out_pos, max_zlib_chunk);
+    inflater->next_in = const_cast<Bytef*>(bytes(data) + in_pos);
+    inflater->avail_in = avail_in;
+    inflater->next_out = reinterpret_cast<Bytef*>(out.data() + out_pos);
+    inflater->avail_out = avail_out;
+    const int status = inflate(inflater.get(), Z_NO_FLUSH);
+    in_pos += avail_in - inflater->avail_in;
+    out_pos += avail_out - inflater->avail_out;
+    if (status == Z_STREAM_END) {
+      // concatenated members make single stream, trailing garbage is ignored like by `gzip`
+      if (!is_gzip(data.substr(in_pos))) {
+        break;
+      }
+      inflateReset(inflater.get());
+    } else if (status == Z_BUF_ERROR) {
+      throw std::runtime_error("unexpected end of gzip stream");
+    } else if (status != Z_OK) {
+      throw std::runtime_error(std::string("corrupted gzip stream: ") + (inflater->msg ? inflater->msg : ""));
+    }
+  }
+  out.resize(out_pos);
+  return out;
+}
+
+/** Pass inflated (multi-member) gzip stream to consumer chunk by chunk
+ *  @param known_size decompressed size if it is known without decompression (BGZF) */
+size_t stream_gzip(std::string_view data, const Consumer& consumer, std::optional<size_t> known_size) {
+  std::string chunk(stream_chunk_size, '\0');
+  Inflater inflater;
+  size_t in_pos = 0;
+  size_t out_size = 0;
+  bool wanted = true;
+  while (true) {
+    const size_t avail_in = std::min(data.size() - in_pos, max_zlib_chunk);
+    inflater->next_in = const_cast<Bytef*>(bytes(data) + in_pos);
+    inflater->avail_in = avail_in;
+    inflater->next_out = reinterpret_cast<Bytef*>(chunk.data());
+    inflater->avail_out = chunk.size();
+    const int status = inflate(inflater.get(), Z_NO_FLUSH);
+    in_pos += avail_in - inflater->avail_in;
+    const size_t produced = chunk.size() - inflater->avail_out;
+    out_size += produced;
+    if (wanted && produced) {
+      wanted = consumer(std::string_view(chunk.data(), produced));
+    }
+    if (!wanted && known_size) {
+      return *known_size;
+    }
+    if (status == Z_STREAM_END) {
+      if (!is_gzip(data.substr(in_pos))) {
+        break;
+      }
+      inflateReset(inflater.get());
+    } else if (status == Z_BUF_ERROR) {
+      throw std::runtime_error("unexpected end of gzip stream");
+    } else if (status != Z_OK) {
+      throw std::runtime_error(std::string("corrupted gzip stream: ") + (inflater->msg ? inflater->msg : ""));
+    }
+  }
+  return out_size;
+}
+
+std::string decompress_gzip(std::string_view data, int n_threads) {
+  const std::vector<Block> blocks = bgzf_blocks(data);
+  if (blocks.empty()) {
+    return inflate_gzip(data);
+  }
+  std::string out(blocks.back().out_begin + blocks.back().out_size, '\0');
+  parallel_for(blocks.size(), n_threads, [&](size_t i, int) {
+    const Block& block = blocks[i];
+    inflate_block(data.substr(block.in_begin, block.in_size), out.data() + block.out_begin, block.out_size);
+  });
+  return out;
+}
+
+#ifdef XMOL_WITH_ZSTD
+/// Sequential decompression, used when size of some frame is not stored in its header
+std::string decompress_zstd_stream(std::string_view data) {
+  std::unique_ptr<ZSTD_DStream, size_t (*)(ZSTD_DStream*)> stream(ZSTD_createDStream(), ZSTD_freeDStream);
+  if (!stream) {
+    throw std::runtime_error("Can't initialize zstd");
+  }
+  std::string out(std::max(data.size() * 4, ZSTD_DStreamOutSize()), '\0');
+  ZSTD_inBuffer input{data.data(), data.size(), 0};
+  ZSTD_outBuffer output{out.data(), out.size(), 0};
+  size_t hint = 1;
+  // full output buffer may leave decompressed data inside of stream, flush it even if input is consumed
+  while (input.pos < input.size || output.pos == output.size) {
+    if (output.pos == output.size) {
+      out.resize(out.size() * 2);
+      output.dst = out.data();
+      output.size = out.size();
+    }
+    hint = ZSTD_decompressStream(stream.get(), &output, &input);
+    if (ZSTD_isError(hint)) {
+      throw std::runtime_error(std::string("corrupted zstd stream: ") + ZSTD_getErrorName(hint));
+    }
+  }
+  if (hint != 0) {
+    throw std::runtime_error("unexpected end of zstd stream");
+  }
+  out.resize(output.pos);
+  return out;
+}
+
+std::string decompress_zstd(std::string_view data, int n_threads) {
+  std::vector<Block> frames;
+  size_t in = 0;
+  size_t out = 0;
+  while (in < data.size()) {
+    const size_t size = ZSTD_findFrameCompressedSize(data.data() + in, data.size() - in);
+    if (ZSTD_isError(size)) {
+      throw std::runtime_error(std::string("corrupted zstd stream: ") + ZSTD_getErrorName(size));
+    }
+    const unsigned long long out_size = ZSTD_getFrameContentSize(data.data() + in, size); // 0 for skippable frame
+    if (out_size == ZSTD_CONTENTSIZE_UNKNOWN || out_size == ZSTD_CONTENTSIZE_ERROR) {
+      return decompress_zstd_stream(data);
+    }
+    frames.push_back({in, size, out, size_t(out_size)});
+    in += size;
+    out += out_size;
+  }
+  std::string result(out, '\0');
+  parallel_for(frames.size(), n_threads, [&](size_t i, int) {
+    const Block& frame = frames[i];
+    const size_t written = ZSTD_decompress(result.data() + frame.out_begin, frame.out_size,
+                                           data.data() + frame.in_begin, frame.in_size);
+    if (ZSTD_isError(written) || written != frame.out_size) {
+      throw std::runtime_error("corrupted zstd frame");
+    }
+  });
+  return result;
+}
+
+/// Pass decompressed zstd stream to consumer chunk by chunk
+size_t stream_zstd(std::string_view data, const Consumer& consumer) {
+  std::optional<size_t> known_size = 0;
+  for (size_t in = 0; in < data.size();) {
+    const size_t size = ZSTD_findFrameCompressedSize(data.data() + in, data.size() - in);
+    if (ZSTD_isError(size)) {
+      throw std::runtime_error(std::string("corrupted zstd stream: ") + ZSTD_getErrorName(size));
+    }
+    const unsigned long long out_size = ZSTD_getFrameContentSize(data.data() + in, size);
+    if (out_size == ZSTD_CONTENTSIZE_UNKNOWN || out_size == ZSTD_CONTENTSIZE_ERROR) {
+      known_size.reset();
+      break;
+    }
+    *known_size += out_size;
+    in += size;
+  }
+
+  std::unique_ptr<ZSTD_DStream, size_t (*)(ZSTD_DStream*)> stream(ZSTD_createDStream(), ZSTD_freeDStream);
+  if (!stream) {
+    throw std::runtime_error("Can't initialize zstd");
+  }
+  std::string chunk(ZSTD_DStreamOutSize(), '\0');
+  ZSTD_inBuffer input{data.data(), data.size(), 0};
+  ZSTD_outBuffer output{chunk.data(), chunk.size(), 0};
+  size_t out_size = 0;
+  size_t hint = 1;
+  bool wanted = true;
+  while (input.pos < input.size || output.pos == output.size) {
+    output.pos = 0;
+    hint = ZSTD_decompressStream(stream.get(), &output, &input);
+    if (ZSTD_isError(hint)) {
+      throw std::runtime_error(std::string("corrupted zstd stream: ") + ZSTD_getErrorName(hint));
+    }
+    out_size += output.pos;
+    if (wanted && output.pos) {
+      wanted = consumer(std::string_view(chunk.data(), output.pos));
+    }
+    if (!wanted && known_size) {
+      return *known_size;
+    }
+  }
+  if (hint != 0) {
+    throw std::runtime_error("unexpected end of zstd stream");
+  }
+  return out_size;
+}
+#endif
+
+} // namespace
+
+FileContent::FileContent(const std::string& filename, int n_threads) : m_mapped(std::in_place, filename) {
+  const std::string_view data = m_mapped->view();
+  try {
+    if (is_gzip(data)) {
+      m_decompressed = decompress_gzip(data, n_threads);
+    } else if (is_zstd(data)) {
+#ifdef XMOL_WITH_ZSTD
+      m_decompressed = decompress_zstd(data, n_threads);
+#else
+      throw std::runtime_error("zstd-compressed files are not supported by this build");
+#endif
+    } else {
+      return;
+    }
+  } catch (std::runtime_error& e) {
+    throw std::runtime_error("Can't decompress `" + filename + "`: " + e.what());
+  }
+  m_mapped.reset();
+}
+
+size_t FileContent::stream(const std::string& filename, const std::function<bool(std::string_view)>& consumer) {
+  const MappedFile mapped(filename);
+  const std::string_view data = mapped.view();
+  // exceptions of consumer are propagated as is, only decompression errors are annotated with filename
+  bool consuming = false;
+  const Consumer guarded = [&](std::string_view chunk) {
+    consuming = true;
+    const bool wanted = consumer(chunk);
+    consuming = false;
+    return wanted;
+  };
+  try {
+    if (is_gzip(data)) {
+      const std::vector<Block> blocks = bgzf_blocks(data);
+      std::optional<size_t> known_size;
+      if (!blocks.empty()) {
+        known_size = blocks.back().out_begin + blocks.back().out_size;
+      }
+      return stream_gzip(data, guarded, known_size);
+    } else if (is_zstd(data)) {
+#ifdef XMOL_WITH_ZSTD
+      return stream_zstd(data, guarded);
+#else
+      throw std::runtime_error("zstd-compressed files are not supported by this build");
+#endif
+    }
+  } catch (std::runtime_error& e) {
+    if (consuming) {
+      throw;
+    }
+    throw std::runtime_error("Can't decompress `" + filename + "`: " + e.what());
+  }
+  for (size_t pos = 0; pos < data.size() && guarded(data.substr(pos, stream_chunk_size)); pos += stream_chunk_size) {
+  }
+  return data.size();
+}
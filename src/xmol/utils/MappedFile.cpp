@@ -0,0 +1,47 @@
+#include "xmol/utils/MappedFile.h"
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+using namespace xmol::utils;
+
+MappedFile::MappedFile(const std::string& filename) {
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Can't open `" + filename + "`");
+  }
+  struct stat status {};
+  if (::fstat(fd, &status) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Can't stat `" + filename + "`");
+  }
+  m_size = status.st_size;
+  if (m_size > 0) { // zero-length mappings are not allowed
+    void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Can't map `" + filename + "`");
+    }
+    ::madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(data);
+  }
+  ::close(fd); // mapping keeps file open
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  std::swap(m_data, other.m_data); // previous mapping is released by `other`
+  std::swap(m_size, other.m_size);
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  if (m_data) {
+    ::munmap(const_cast<char*>(m_data), m_size);
+  }
+}
@@ -127,3 +127,72 @@ def test_calc_inertia_tensor_off_diagonal():
     I = calc_inertia_tensor(a)
 
     assert np.allclose([I[0, 1], I[0, 2], I[1, 0], I[1, 2], I[2, 0], I[2, 1]], 0)
+
+
+def test_calc_fitted_rmsd():
+    from pyxmolpp2 import calc_alignment, calc_fitted_rmsd, calc_rmsd, XYZ, Rotation, Translation, Degrees
+
+    np.random.seed(3)
+    a = np.random.random((20, 3)) * 10
+    G = Rotation(XYZ(7, 6, 5), Degrees(42)) * Translation(XYZ(8, -9, 1))
+    b = np.array([G.transform(XYZ(*x)).values for x in a]) + np.random.random((20, 3)) * 0.1
+
+    T = calc_alignment(a, b)
+    b_aligned = np.array([T.transform(XYZ(*x)).values for x in b])
+
+    assert calc_fitted_rmsd(a, b) == pytest.approx(calc_rmsd(a, b_aligned))
+    assert calc_fitted_rmsd(a, b, weights=np.ones(20)) == pytest.approx(calc_rmsd(a, b_aligned))
+    assert calc_fitted_rmsd(a, a) == pytest.approx(0, abs=1e-6)
+
+
+def test_calc_pairwise_fitted_rmsd():
+    from pyxmolpp2 import calc_fitted_rmsd, calc_pairwise_fitted_rmsd
+
+    np.random.seed(4)
+    n_frames, n_atoms = 12, 30
+    frames = np.random.random((n_frames, n_atoms, 3)) * 10
+    expected = [calc_fitted_rmsd(frames[i], frames[j]) for i in range(n_frames) for j in range(i + 1, n_frames)]
+
+    assert np.allclose(calc_pairwise_fitted_rmsd(frames), expected)
+    assert np.allclose(calc_pairwise_fitted_rmsd(frames, n_threads=1), expected)
+
+    single = calc_pairwise_fitted_rmsd(frames, single_precision=True)
+    assert single.dtype == np.float32
+    assert np.allclose(single, expected, atol=1e-4)
+
+
+def test_calc_pairwise_fitted_rmsd_of_trajectory_slice():
+    from pyxmolpp2 import calc_fitted_rmsd, calc_pairwise_fitted_rmsd, Trajectory, TrajectoryInputFile
+    from make_polygly import make_polyglycine
+
+    class InMemoryTrajectory(TrajectoryInputFile):
+        def __init__(self, coords):
+            super().__init__()
+            self._coords = coords
+
+        def n_frames(self):
+            return len(self._coords)
+
+        def n_atoms(self):
+            return self._coords.shape[1]
+
+        def read_frame(self, index, frame):
+            frame.coords.values[:] = self._coords[index]
+
+        def advance(self, shift):
+            pass
+
+    np.random.seed(5)
+    ref = make_polyglycine([("A", 3)])
+    coords = np.random.uniform(-5, 5, (8, ref.atoms.size, 3))
+    traj = Trajectory(ref)
+    traj.extend(InMemoryTrajectory(coords))
+    indices = [0, 3, 7, 12, 20]
+
+    selected = coords[:, indices]
+    expected = [calc_fitted_rmsd(selected[i], selected[j]) for i in range(8) for j in range(i + 1, 8)]
+    assert np.allclose(calc_pairwise_fitted_rmsd(traj[:], indices), expected)
+
+    single = calc_pairwise_fitted_rmsd(traj[:], indices, single_precision=True)
+    assert single.dtype == np.float32
+    assert np.allclose(single, expected, atol=1e-4)
@@ -95,3 +95,37 @@ def test_autocorr():
     print("Time(py)  = %f" % py_time)
     print("Speedup   = %g%%" % (py_time / cpp_time * 100))
     # assert py_time < cpp_time, "Python occasionally faster"
+
+
+@pytest.mark.parametrize("name", ["calc_autocorr_order_2", "calc_autocorr_order_2_PRE"])
+def test_autocorr_batch(name):
+    import pyxmolpp2
+
+    calc = getattr(pyxmolpp2, name)
+    v = np.random.random((5, 200, 3))
+    batch = calc(v, limit=150, n_threads=2)
+    assert batch.shape == (5, 150)
+    for i in range(5):
+        assert np.allclose(batch[i], calc(v[i], limit=150), atol=1e-12)
+
+
+def test_multi_tau_correlator():
+    from pyxmolpp2 import MultiTauCorrelator, AutoCorrelationMode, calc_autocorr_order_2_PRE
+
+    v = np.random.random((40, 3, 3))
+    correlator = MultiTauCorrelator(3, mode=AutoCorrelationMode.NORMALIZE_AND_DIVIDE_BY_CUBE, points_per_level=64)
+    for frame in v:
+        correlator.update(frame)
+    assert correlator.n_frames == 40
+    assert np.all(correlator.lags == np.arange(40))
+    expected = calc_autocorr_order_2_PRE(np.transpose(v, (1, 0, 2)))
+    assert np.allclose(correlator.correlation(), expected, atol=1e-9)
+
+
+def test_multi_tau_correlator_zero_vector():
+    from pyxmolpp2 import MultiTauCorrelator, GeomError
+
+    correlator = MultiTauCorrelator(2)
+    with pytest.raises(GeomError):
+        correlator.update(np.array([[1.0, 0, 0], [0, 0, 0]]))
+    assert correlator.n_frames == 0
@@ -0,0 +1,55 @@
+import numpy as np
+from make_polygly import make_polyglycine
+from pyxmolpp2 import TrajectoryInputFile, Frame
+
+
+class RandomTrajectory(TrajectoryInputFile):
+    def __init__(self, coords):
+        super().__init__()
+        self._coords = coords
+
+    def n_frames(self):
+        return len(self._coords)
+
+    def n_atoms(self):
+        return self._coords.shape[1]
+
+    def read_frame(self, index: int, frame: Frame):
+        frame.coords.values[:] = self._coords[index]
+
+    def advance(self, shift: int):
+        pass
+
+
+def make_trajectory(n_frames=7):
+    from pyxmolpp2 import Trajectory
+
+    ref = make_polyglycine([("A", 10)])
+    coords = np.random.uniform(-5, 5, (n_frames, ref.atoms.size, 3))
+    traj = Trajectory(ref)
+    traj.extend(RandomTrajectory(coords))
+    return ref, traj, coords
+
+
+def test_extract_bond_vectors_by_indices():
+    from pyxmolpp2 import extract_bond_vectors
+
+    ref, traj, coords = make_trajectory()
+    pairs = [(0, 1), (9, 8)]
+    vectors = extract_bond_vectors(traj[:], pairs)
+    assert vectors.shape == (2, len(coords), 3)
+    for k, (i, j) in enumerate(pairs):
+        assert np.allclose(vectors[k], coords[:, j] - coords[:, i])
+
+
+def test_extract_bond_vectors_by_selections():
+    from pyxmolpp2 import extract_bond_vectors, aName, calc_autocorr_order_2
+
+    ref, traj, coords = make_trajectory()
+    ref.coords.values[:] = coords[0]
+    n = ref.atoms.filter(aName == "N")
+    h = ref.atoms.filter(aName == "H")
+    vectors = extract_bond_vectors(traj[:], n, h, reference=ref.atoms)
+    assert vectors.shape == (10, len(coords), 3)
+    assert np.allclose(vectors[:, 0], h.coords.values - n.coords.values)
+    assert calc_autocorr_order_2(vectors).shape == (10, len(coords))
@@ -0,0 +1,56 @@
+import numpy as np
+import pytest
+
+
+def make_frames(n_structures=3, n_frames=30, n_atoms=15, seed=1):
+    rng = np.random.RandomState(seed)
+    structures = rng.uniform(-5, 5, (n_structures, n_atoms, 3))
+    frames = np.array([structures[i % n_structures] for i in range(n_frames)])
+    return frames + rng.normal(0, 0.05, (n_frames, n_atoms, 3))
+
+
+def check_recovered(clustering, n_structures):
+    labels = clustering.labels
+    assert len(clustering.medoids) == n_structures
+    assert len(set(labels)) == n_structures
+    assert all(labels[i] == labels[i % n_structures] for i in range(len(labels)))
+    assert all(labels[m] == k for k, m in enumerate(clustering.medoids))
+
+
+@pytest.mark.parametrize("cached", [False, True])
+def test_gromos_clustering(cached):
+    from pyxmolpp2 import calc_pairwise_fitted_rmsd, gromos_clustering, CachedRmsdMatrix
+
+    frames = make_frames()
+    distances = CachedRmsdMatrix(frames, cache_rows=4) if cached else calc_pairwise_fitted_rmsd(frames)
+    check_recovered(gromos_clustering(distances, cutoff=0.5), 3)
+
+
+def test_k_medoids_clustering():
+    from pyxmolpp2 import k_medoids_clustering, CachedRmsdMatrix
+
+    frames = make_frames(seed=2)
+    distances = CachedRmsdMatrix(frames)
+    check_recovered(k_medoids_clustering(distances, n_clusters=3, seed=1), 3)
+    assert distances.row(0)[3] == pytest.approx(distances.distance(0, 3))
+
+
+@pytest.mark.parametrize("method", ["SINGLE", "COMPLETE", "AVERAGE"])
+def test_hierarchical_clustering(method):
+    from pyxmolpp2 import calc_pairwise_fitted_rmsd, calc_linkage, hierarchical_clustering, Linkage
+
+    frames = make_frames(seed=3)
+    distances = calc_pairwise_fitted_rmsd(frames)
+    linkage = calc_linkage(distances, getattr(Linkage, method))
+    assert linkage.shape == (len(frames) - 1, 4)
+    assert linkage[-1, 3] == len(frames)
+    check_recovered(hierarchical_clustering(distances, linkage, n_clusters=3), 3)
+    check_recovered(hierarchical_clustering(distances, linkage, threshold=0.5), 3)
+    with pytest.raises(ValueError):
+        hierarchical_clustering(distances, linkage)
+
+    for row, column, value in [(0, 0, -1), (0, 1, 0.5), (0, 0, 2 * len(frames)), (1, 3, 5)]:
+        malformed = linkage.copy()
+        malformed[row, column] = value
+        with pytest.raises(ValueError):
+            hierarchical_clustering(distances, malformed, n_clusters=3)
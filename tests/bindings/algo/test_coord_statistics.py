@@ -0,0 +1,66 @@
+import numpy as np
+
+
+def test_coord_statistics():
+    from pyxmolpp2 import CoordStatistics
+
+    frames = np.random.normal(0, 1, (60, 4, 3)) + 100
+    a = CoordStatistics(4, covariance=True)
+    b = CoordStatistics(4, covariance=True)
+    for frame in frames[:25]:
+        a.update(frame)
+    for frame in frames[25:]:
+        b.update(frame)
+    a.merge(b)
+
+    assert a.n_frames == 60
+    assert np.allclose(a.mean, frames.mean(axis=0))
+    assert np.allclose(a.rmsf, np.sqrt(((frames - frames.mean(axis=0)) ** 2).sum(axis=2).mean(axis=0)))
+    assert np.allclose(a.covariance(), np.cov(frames.reshape(60, 12).T, bias=True))
+
+
+def test_coord_statistics_of_frame_coords():
+    from pyxmolpp2 import CoordStatistics
+    from make_polygly import make_polyglycine
+
+    frame = make_polyglycine([("A", 2)])
+    statistics = CoordStatistics(frame.atoms.size)
+    statistics.update(frame.coords)
+    statistics.update(frame.atoms.coords)
+    assert np.allclose(statistics.mean, frame.coords.values)
+    assert np.allclose(statistics.rmsf, 0)
+
+
+def test_principal_components():
+    from pyxmolpp2 import CoordStatistics, PrincipalComponents, Trajectory
+    from make_polygly import make_polyglycine
+    from algo.test_bond_vectors import RandomTrajectory
+
+    ref = make_polyglycine([("A", 3)])
+    n_atoms = ref.atoms.size
+    mode = np.random.normal(0, 1, (n_atoms, 3))
+    frames = np.random.normal(0, 0.01, (100, n_atoms, 3)) + np.random.normal(0, 1, 100)[:, None, None] * mode
+
+    statistics = CoordStatistics(n_atoms, covariance=True)
+    for frame in frames:
+        statistics.update(frame)
+    pca = PrincipalComponents(statistics, 2)
+    assert pca.modes.shape == (3 * n_atoms, 2)
+    assert pca.eigenvalues[0] > 0.99 * pca.total_variance
+    assert abs(np.dot(pca.modes[:, 0], mode.flatten() / np.linalg.norm(mode))) > 0.999
+
+    projections = pca.project(frames, n_threads=2)
+    assert projections.shape == (100, 2)
+    assert np.allclose(projections, (frames - frames.mean(axis=0)).reshape(100, -1) @ pca.modes)
+
+    traj = Trajectory(ref)
+    traj.extend(RandomTrajectory(frames))
+    indices = list(range(n_atoms))
+    assert np.allclose(pca.project(traj[:], indices, align=False), projections)
+
+    # rigid body motion doesn't affect projections of aligned frames
+    angle = 0.7
+    rotation = np.array([[np.cos(angle), -np.sin(angle), 0], [np.sin(angle), np.cos(angle), 0], [0, 0, 1]])
+    moved = Trajectory(ref)
+    moved.extend(RandomTrajectory(frames @ rotation.T + np.array([5, -3, 1])))
+    assert np.allclose(pca.project(moved[:], indices), pca.project(traj[:], indices), atol=1e-9)
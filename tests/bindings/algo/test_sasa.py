@@ -24,3 +24,68 @@ def test_calc_sasa():
         T1, T3 = t2 - t1, t4 - t3
         assert T3 > T1
 
+
+
+def test_calc_sasa_n_threads():
+    from pyxmolpp2 import calc_sasa
+    import numpy as np
+
+    rng = np.random.RandomState(1)
+    coords = rng.uniform(0, 20, (500, 3))
+    radii = rng.uniform(1.0, 2.0, 500)
+
+    serial = calc_sasa(coords, radii, 1.4, n_threads=1)
+    assert np.array_equal(serial, calc_sasa(coords, radii, 1.4, n_threads=4))
+    assert np.array_equal(serial, calc_sasa(coords, radii, 1.4))
+
+
+def test_calc_sasa_shrake_rupley():
+    from pyxmolpp2 import calc_sasa, SasaMethod
+    import numpy as np
+
+    rng = np.random.RandomState(2)
+    coords = rng.uniform(0, 20, (500, 3))
+    radii = np.round(rng.uniform(1.0, 2.0, 500) * 4) / 4
+
+    lee_richards = calc_sasa(coords, radii, 1.4, n_samples=100)
+    shrake_rupley = calc_sasa(coords, radii, 1.4, n_samples=1000, method=SasaMethod.SHRAKE_RUPLEY)
+    assert shrake_rupley.sum() == pytest.approx(lee_richards.sum(), rel=2e-3)
+    assert calc_sasa(coords, radii, 1.4, np.array([3, 7], dtype=np.intc),
+                     method=SasaMethod.SHRAKE_RUPLEY).size == 2
+
+
+def test_calc_sasa_of_atoms():
+    from pyxmolpp2 import calc_sasa, SasaMethod, XYZ
+    from make_polygly import make_polyglycine
+    import numpy as np
+
+    frame = make_polyglycine([("A", 10)])
+    for i, a in enumerate(frame.atoms):
+        a.r = XYZ(i * 0.7, (i % 7) * 1.1, 0)
+        a.vdw_radius = 1.5
+    atoms = frame.atoms
+    per_atom = calc_sasa(atoms, 1.4, method=SasaMethod.SHRAKE_RUPLEY)
+    per_residue = calc_sasa(atoms, 1.4, method=SasaMethod.SHRAKE_RUPLEY, per_residue=True)
+    assert per_atom.size == atoms.size
+    assert per_residue.size == frame.residues.size
+    assert per_residue.sum() == pytest.approx(per_atom.sum())
+    assert np.allclose(per_atom, calc_sasa(atoms.coords.values, np.full(atoms.size, 1.5), 1.4,
+                                           method=SasaMethod.SHRAKE_RUPLEY))
+
+
+def test_sasa_calculator():
+    from pyxmolpp2 import calc_sasa, SasaCalculator
+    import numpy as np
+
+    rng = np.random.RandomState(3)
+    coords = rng.uniform(0, 30, (500, 3))
+    radii = np.full(500, 1.5)
+
+    calculator = SasaCalculator(1.4)
+    assert np.array_equal(calculator.update(coords, radii), calc_sasa(coords, radii, 1.4))
+    assert calculator.n_updated_atoms == 500
+
+    coords[0] += 0.1
+    assert np.array_equal(calculator.update(coords, radii), calc_sasa(coords, radii, 1.4))
+    assert 0 < calculator.n_updated_atoms < 500
+    assert np.array_equal(calculator.sasa, calc_sasa(coords, radii, 1.4))
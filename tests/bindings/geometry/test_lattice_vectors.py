@@ -59,3 +59,46 @@ def test_to_tuple():
     assert v1.distance(XYZ(1, 4, 1)) == pytest.approx(0)
     assert v2.distance(XYZ(5, 1, 1)) == pytest.approx(0)
     assert v3.distance(XYZ(7, 1, 4)) == pytest.approx(0)
+
+
+def test_minimum_image():
+    from pyxmolpp2 import UnitCell, XYZ, Degrees
+    import numpy as np
+
+    cell = UnitCell(10, 12, 14, Degrees(80), Degrees(95), Degrees(110))
+    np.random.seed(1)
+    deltas = (np.random.random((100, 3)) - 0.5) * 60
+    reduced = cell.minimum_image(deltas)
+    assert reduced.shape == deltas.shape
+    for d, r in zip(deltas, reduced):
+        closest = cell.closest_image_to(XYZ(0, 0, 0), XYZ(*d))
+        assert np.linalg.norm(r) == pytest.approx(closest.distance)
+
+
+def test_wrap_unwrap():
+    from pyxmolpp2 import UnitCell, Degrees
+    from make_polygly import make_polyglycine
+    import numpy as np
+
+    frame = make_polyglycine([("A", 10)])
+    n = frame.coords.size
+    frame.coords.values[:] = np.arange(n)[:, None] * np.array([0.5, 0.3, -0.2])
+    original = frame.coords.values.copy()
+    cell = UnitCell(10, 12, 14, Degrees(80), Degrees(95), Degrees(110))
+
+    def assert_whole():
+        shift = original[0] - frame.coords.values[0]
+        assert np.allclose(frame.coords.values + shift, original)
+
+    cell.wrap(frame.coords)
+    assert not np.allclose(frame.coords.values, original)
+    cell.unwrap(frame.coords)
+    assert_whole()
+
+    cell.wrap(frame.coords)
+    cell.make_molecules_whole(frame.molecules)
+    assert_whole()
+
+    cell.wrap(frame.coords)
+    cell.unwrap(frame.atoms.coords, bonds=[(i, i + 1) for i in range(n - 1)])
+    assert_whole()
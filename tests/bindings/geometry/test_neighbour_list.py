@@ -0,0 +1,44 @@
+import pytest
+
+
+def test_neighbour_list():
+    from pyxmolpp2 import NeighbourList
+    import numpy as np
+
+    np.random.seed(1)
+    coords = np.random.random((300, 3)) * 15
+    cutoff = 3.0
+
+    def brute_force(coords):
+        d = np.linalg.norm(coords[:, None, :] - coords[None, :, :], axis=-1)
+        i, j = np.where(np.triu(d < cutoff, k=1))
+        return set(zip(i, j))
+
+    nl = NeighbourList(cutoff=cutoff, skin=1.0)
+    assert nl.update(coords)
+    assert set(map(tuple, nl.pairs(coords))) == brute_force(coords)
+
+    # every second point moves by 0.2 per step, so displacement exceeds skin / 2 = 0.5 on every third step
+    for step in range(10):
+        coords[::2, 0] += 0.2
+        assert nl.update(coords) == (step % 3 == 2)
+        assert set(map(tuple, nl.pairs(coords))) == brute_force(coords)
+
+    assert nl.n_rebuilds == 4
+    assert len(nl) == coords.shape[0]
+
+    half = NeighbourList(cutoff=cutoff, skin=1.0)
+    full = NeighbourList(cutoff=cutoff, skin=1.0, mode=NeighbourList.FULL)
+    half.update(coords)
+    full.update(coords)
+    assert full.n_pairs == 2 * half.n_pairs
+    for i in range(len(full)):
+        assert i not in full.neighbours(i)
+
+
+def test_neighbour_list_not_built():
+    from pyxmolpp2 import NeighbourList, GeomError
+
+    nl = NeighbourList(cutoff=3.0, skin=1.0)
+    with pytest.raises(GeomError):
+        nl.neighbours(0)
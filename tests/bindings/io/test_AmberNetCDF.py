@@ -14,3 +14,49 @@ def test_read_netcdf():
     assert datfile.n_atoms() == frame.atoms.size
 
     datfile.read_frame(0, frame)
+
+
+@pytest.mark.parametrize("options", [
+    dict(format=None),
+    dict(format="CLASSIC_64BIT"),
+    dict(frames_per_chunk=4, atoms_per_chunk=10, buffer_frames=3),
+    dict(deflate_level=4),
+])
+def test_write_read_netcdf(tmp_path, options):
+    from pyxmolpp2 import PdbFile, AmberNetCDF, AmberNetCDFWriter, Trajectory, Translation, XYZ
+    import numpy as np
+
+    options = dict(options)
+    if options.get("format"):
+        options["format"] = getattr(AmberNetCDFWriter.Format, options["format"])
+    else:
+        options.pop("format", None)
+
+    frame = PdbFile(os.environ["TEST_DATA_PATH"] + "/amber/GB1_F30C_MTSL/box.pdb").frames()[0]
+    filename = str(tmp_path / "output.nc")
+
+    writer = AmberNetCDFWriter(filename, **options)
+    expected = []
+    for i in range(10):
+        frame.time = i * 2.0
+        frame.coords.apply(Translation(XYZ(1, 0, 0)))
+        expected.append(frame.coords.values.copy())
+        writer.write(frame)
+    assert writer.n_frames() == 10
+    writer.close()
+
+    traj = Trajectory(frame)
+    traj.extend(AmberNetCDF(filename))
+    assert traj.n_frames == 10
+    for i, f in enumerate(traj):
+        assert f.time == pytest.approx(i * 2.0)
+        assert np.allclose(f.coords.values, expected[i], atol=1e-3)
+
+
+def test_write_errors(tmp_path):
+    from pyxmolpp2 import AmberNetCDFWriter, AmberNetCDFWriteError
+
+    with pytest.raises(AmberNetCDFWriteError):
+        AmberNetCDFWriter(str(tmp_path / "output.nc"), deflate_level=10)
+    with pytest.raises(AmberNetCDFWriteError):
+        AmberNetCDFWriter(str(tmp_path / "output.nc"), format=AmberNetCDFWriter.Format.CLASSIC_64BIT, deflate_level=1)
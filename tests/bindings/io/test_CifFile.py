@@ -0,0 +1,66 @@
+import pytest
+
+
+def write_ensemble(filename, n_models, n_atoms):
+    with open(filename, "w") as f:
+        f.write("data_TEST\n_cell.length_a 30.0\n_cell.length_b 40.0\n_cell.length_c 50.0\n#\nloop_\n")
+        for tag in ["group_PDB", "id", "label_atom_id", "label_comp_id", "label_asym_id", "label_seq_id",
+                    "Cartn_x", "Cartn_y", "Cartn_z", "auth_seq_id", "auth_asym_id", "pdbx_PDB_model_num"]:
+            f.write("_atom_site.%s\n" % tag)
+        for model in range(n_models):
+            for i in range(n_atoms):
+                f.write("ATOM %d CA GLY A %d %.3f %.3f %.3f %d AAAB %d\n"
+                        % (i + 1, i + 1, model, i * 0.5, -i * 0.25, i + 10, model + 1))
+
+
+def test_read_frames(tmp_path):
+    from pyxmolpp2 import CifFile
+
+    filename = str(tmp_path / "ensemble.cif")
+    write_ensemble(filename, 3, 20)
+
+    frames = CifFile(filename).frames()
+    assert len(frames) == 3
+    frame = frames[0]
+    assert frame.atoms.size == 20
+    assert frame.residues.size == 20
+    assert frame.molecules.size == 1
+    assert frame.molecules[0].name == "AAAB"
+    assert frame.residues[0].id.serial == 10
+    assert frame.cell.a == pytest.approx(30)
+    assert frames[2].atoms[0].r.x == pytest.approx(2)
+
+
+def test_streaming_mode(tmp_path):
+    from pyxmolpp2 import CifFile, Trajectory
+    import numpy as np
+
+    filename = str(tmp_path / "ensemble.cif")
+    write_ensemble(filename, 10, 30)
+
+    frames = CifFile(filename).frames()
+    streaming = CifFile(filename, read_now=False)
+    assert streaming.n_frames() == 10
+    assert streaming.n_atoms() == 30
+    assert len(streaming.frames()) == 0
+
+    traj = Trajectory(frames[0])
+    traj.extend(streaming)
+    n = 0
+    for expected, frame in zip(frames, traj):
+        assert np.allclose(expected.coords.values, frame.coords.values)
+        n += 1
+    assert n == 10
+
+
+def test_read_errors(tmp_path):
+    from pyxmolpp2 import CifFile, CifReadError
+
+    with pytest.raises(CifReadError):
+        CifFile("does_not_exists.cif")
+
+    filename = str(tmp_path / "broken.cif")
+    with open(filename, "w") as f:
+        f.write("data_X\nloop_\n_atom_site.id\n_atom_site.label_atom_id\n1 N\n")
+    with pytest.raises(CifReadError):
+        CifFile(filename)
@@ -0,0 +1,95 @@
+import pytest
+
+
+def write_trajectory(filename, n_frames, n_atoms):
+    with open(filename, "w") as f:
+        for frame in range(n_frames):
+            f.write("Generated t= %.5f\n%d\n" % (frame * 2.0, n_atoms))
+            for i in range(n_atoms):
+                f.write("%5d%-5s%5s%5d%8.3f%8.3f%8.3f\n" % (i // 3 + 1, "POPC", "C%d" % (i % 3), i + 1,
+                                                          frame * 0.1, i * 0.05, -i * 0.025))
+            f.write("%10.5f%10.5f%10.5f\n" % (3.0, 4.0, 5.0))
+
+
+def test_read_frames(tmp_path):
+    from pyxmolpp2 import GromacsGroFile
+
+    filename = str(tmp_path / "traj.gro")
+    write_trajectory(filename, 3, 20)
+
+    frames = GromacsGroFile(filename).frames()
+    assert len(frames) == 3
+    frame = frames[0]
+    assert frame.atoms.size == 20
+    assert frame.residues.size == 7
+    assert frame.molecules.size == 1
+    assert frame.residues[0].name == "POPC"
+    assert frame.atoms[1].name == "C1"
+    assert frame.cell.a == pytest.approx(30)
+    assert frame.cell.c == pytest.approx(50)
+    assert frames[2].time == pytest.approx(4)
+    assert frames[2].atoms[0].r.x == pytest.approx(2)
+    assert frames[0].atoms[4].r.y == pytest.approx(2)
+
+
+def test_streaming_mode(tmp_path):
+    from pyxmolpp2 import GromacsGroFile, Trajectory
+    import numpy as np
+
+    filename = str(tmp_path / "traj.gro")
+    write_trajectory(filename, 10, 30)
+
+    frames = GromacsGroFile(filename).frames()
+    streaming = GromacsGroFile(filename, read_now=False)
+    assert streaming.n_frames() == 10
+    assert streaming.n_atoms() == 30
+    assert len(streaming.frames()) == 0
+
+    traj = Trajectory(frames[0])
+    traj.extend(streaming)
+    n = 0
+    for expected, frame in zip(frames, traj):
+        assert np.allclose(expected.coords.values, frame.coords.values)
+        n += 1
+    assert n == 10
+
+
+def test_write_read(tmp_path):
+    from pyxmolpp2 import GromacsGroFile, GroWriter
+    import numpy as np
+
+    filename = str(tmp_path / "traj.gro")
+    write_trajectory(filename, 2, 10)
+    frames = GromacsGroFile(filename).frames()
+
+    output = str(tmp_path / "output.gro")
+    writer = GroWriter(output)
+    for frame in frames:
+        writer.write(frame, title="Test")
+    del writer
+
+    with open(output) as f:
+        assert f.readline() == "Test t= 0.00000\n"
+
+    written = GromacsGroFile(output).frames()
+    assert len(written) == 2
+    for expected, frame in zip(frames, written):
+        assert np.allclose(expected.coords.values, frame.coords.values)
+        assert [a.name for a in expected.atoms] == [a.name for a in frame.atoms]
+        assert frame.cell.b == pytest.approx(40)
+
+
+def test_errors(tmp_path):
+    from pyxmolpp2 import GromacsGroFile, GroReadError, GroWriter, GroWriteError
+
+    with pytest.raises(GroReadError):
+        GromacsGroFile("does_not_exists.gro")
+
+    filename = str(tmp_path / "broken.gro")
+    with open(filename, "w") as f:
+        f.write("title\n2\n    1ALA      N    1   0.100   0.200   0.300\n")
+    with pytest.raises(GroReadError):
+        GromacsGroFile(filename)
+
+    with pytest.raises(GroWriteError):
+        GroWriter(str(tmp_path / "does_not_exist" / "output.gro"))
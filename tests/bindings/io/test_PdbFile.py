@@ -42,3 +42,105 @@ def test_read_empty_file():
     import os
 
     assert len(PdbFile(os.devnull).frames()) == 0
+
+
+def test_read_models_in_parallel(tmp_path):
+    from pyxmolpp2 import PdbFile
+    import numpy as np
+
+    filename = str(tmp_path / "ensemble.pdb")
+    with open(filename, "w") as f:
+        for model in range(20):
+            f.write("MODEL     %4d\n" % (model + 1))
+            for i in range(30):
+                f.write("ATOM  %5d  CA  GLY A%4d    %8.3f%8.3f%8.3f  1.00  0.00           C\n"
+                        % (i + 1, i + 1, model, i * 0.5, -i * 0.25))
+            f.write("ENDMDL\n")
+
+    serial = PdbFile(filename, n_threads=1).frames()
+    parallel = PdbFile(filename, n_threads=4).frames()
+    assert len(serial) == len(parallel) == 20
+    for model, (a, b) in enumerate(zip(serial, parallel)):
+        assert np.allclose(a.coords.values, b.coords.values)
+        assert np.allclose(b.coords.values[:, 0], model)
+
+
+def test_streaming_mode(tmp_path):
+    from pyxmolpp2 import PdbFile, Trajectory
+    import numpy as np
+
+    filename = str(tmp_path / "ensemble.pdb")
+    with open(filename, "w") as f:
+        for model in range(10):
+            f.write("MODEL     %4d\n" % (model + 1))
+            for i in range(30):
+                f.write("ATOM  %5d  CA  GLY A%4d    %8.3f%8.3f%8.3f  1.00  0.00           C\n"
+                        % (i + 1, i + 1, model, i * 0.5, -i * 0.25))
+            f.write("ENDMDL\n")
+
+    frames = PdbFile(filename).frames()
+    streaming = PdbFile(filename, read_now=False)
+    assert streaming.n_frames() == 10
+    assert streaming.n_atoms() == 30
+    assert len(streaming.frames()) == 0
+
+    traj = Trajectory(frames[0])
+    traj.extend(streaming)
+    for _ in range(2):
+        n = 0
+        for expected, frame in zip(frames, traj):
+            assert np.allclose(expected.coords.values, frame.coords.values)
+            n += 1
+        assert n == 10
+
+
+def test_trajectory_writer(tmp_path):
+    from pyxmolpp2 import PdbFile, PdbTrajectoryWriter, PdbWriteError, Translation, XYZ
+    import numpy as np
+
+    filename = str(tmp_path / "single.pdb")
+    with open(filename, "w") as f:
+        f.write("CRYST1   30.000   40.000   50.000  90.00  90.00  90.00 P 1           1\n")
+        for i in range(30):
+            f.write("ATOM  %5d  CA  GLY A%4d    %8.3f%8.3f%8.3f  1.00  0.00           C\n"
+                    % (i + 1, i + 1, i, i * 0.5, -i * 0.25))
+    frame = PdbFile(filename).frames()[0]
+
+    output = str(tmp_path / "trajectory.pdb")
+    expected = []
+    with PdbTrajectoryWriter(output) as writer:
+        for _ in range(5):
+            frame.coords.apply(Translation(XYZ(1, -0.5, 0.25)))
+            writer.write(frame)
+            expected.append(frame.coords.values.copy())
+        assert writer.n_models() == 5
+    with pytest.raises(PdbWriteError):
+        writer.write(frame)
+    writer.close()
+
+    frames = PdbFile(output).frames()
+    assert len(frames) == 5
+    for model, values in zip(frames, expected):
+        assert np.allclose(model.coords.values, values)
+        assert np.isclose(model.cell.a, 30)
+
+    with pytest.raises(PdbWriteError):
+        PdbTrajectoryWriter(str(tmp_path / "missing" / "trajectory.pdb"))
+
+
+def test_read_compressed(tmp_path):
+    from pyxmolpp2 import PdbFile
+    import gzip
+    import numpy as np
+
+    filename = os.environ["TEST_DATA_PATH"] + "/pdb/rcsb/1PGB.pdb"
+    with open(filename, "rb") as f:
+        content = f.read()
+    compressed = str(tmp_path / "1PGB.pdb.gz")
+    with gzip.open(compressed, "wb") as f:
+        f.write(content)
+
+    expected = PdbFile(filename).frames()
+    frames = PdbFile(compressed).frames()
+    assert len(frames) == len(expected)
+    assert np.allclose(frames[0].coords.values, expected[0].coords.values)
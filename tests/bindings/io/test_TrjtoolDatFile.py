@@ -28,3 +28,25 @@ def test_raise_file_is_empty():
     import os
     with pytest.raises(RuntimeError):
         TrjtoolDatFile(os.devnull)
+
+
+def test_read_compressed(tmp_path):
+    from pyxmolpp2 import PdbFile, TrjtoolDatFile, Trajectory
+    import gzip
+    import numpy as np
+
+    path = os.environ["TEST_DATA_PATH"] + "/trjtool/GB1/run00001"
+    with open(path + ".dat", "rb") as f:
+        content = f.read()
+    compressed = str(tmp_path / "run00001.dat.gz")
+    with gzip.open(compressed, "wb") as f:
+        f.write(content)
+
+    frame = PdbFile(path + ".pdb").frames()[0]
+    traj = Trajectory(frame)
+    traj.extend(TrjtoolDatFile(path + ".dat"))
+    traj_gz = Trajectory(frame)
+    traj_gz.extend(TrjtoolDatFile(compressed))
+    assert traj_gz.n_frames == traj.n_frames
+    for a, b in zip(traj[::100], traj_gz[::100]):
+        assert np.allclose(a.coords.values, b.coords.values)
@@ -482,6 +482,20 @@ def test_frame_buf_output():
     assert output.getvalue().splitlines()[-1].strip() == "TER"
 
 
+def test_long_names_pdb_output():
+    from io import StringIO
+    from pyxmolpp2 import PdbWriteError
+    frame = make_polyglycine([("A", 2)])
+    frame.residues[0].name = "DPPC"
+    with pytest.raises(PdbWriteError):
+        frame.to_pdb(StringIO())
+
+    frame.residues[0].name = "GLY"
+    frame.molecules[0].name = "AB"
+    with pytest.raises(PdbWriteError):
+        frame.to_pdb(StringIO())
+
+
 def test_frame_file_output():
     frame = make_polyglycine([("A", 20)])
 
@@ -27,3 +27,58 @@ def test_torsional_angly_factory():
         assert TorsionAngleFactory.chi3(res) is None
         assert TorsionAngleFactory.chi4(res) is None
         assert TorsionAngleFactory.chi5(res) is None
+
+
+def test_torsion_table():
+    import numpy as np
+    from pyxmolpp2 import TorsionTable, TorsionAngleFactory, Trajectory
+    from algo.test_bond_vectors import RandomTrajectory
+
+    frame = make_polyglycine([('A', 10)])
+    coords = np.random.uniform(-5, 5, (6, frame.atoms.size, 3))
+    frame.coords.values[:] = coords[0]
+
+    table = TorsionTable(frame.residues)
+    assert len(table) == 9 * 3
+    assert table.atom_indices.shape == (27, 4)
+    values = table.calc(frame.coords.values)
+    for value, name, residue_index in zip(values, table.names, table.residue_indices):
+        angle = TorsionAngleFactory.get(frame.residues[int(residue_index)], name)
+        assert np.isclose(value, angle.value().radians)
+
+    traj = Trajectory(frame)
+    traj.extend(RandomTrajectory(coords))
+    series = table.calc(traj[:])
+    assert series.shape == (6, 27)
+    assert np.allclose(series[0], values)
+    assert len(TorsionTable(frame.residues, names=["phi"])) == 9
+
+
+def test_conformation_setter():
+    import numpy as np
+    from pyxmolpp2 import ConformationSetter, TorsionAngleFactory, Degrees
+
+    def chain_angles(frame):
+        result = []
+        for r in frame.residues:
+            for factory in [TorsionAngleFactory.omega, TorsionAngleFactory.phi, TorsionAngleFactory.psi]:
+                angle = factory(r)
+                if angle is not None:
+                    result.append(angle)
+        return result
+
+    frame = make_polyglycine([('A', 10)])
+    reference = make_polyglycine([('A', 10)])
+    coords = np.random.uniform(-3, 3, (frame.atoms.size, 3))
+    frame.coords.values[:] = coords
+    reference.coords.values[:] = coords
+
+    angles = chain_angles(frame)
+    setter = ConformationSetter(angles)
+    assert len(setter) == 9 * 3
+    values = [Degrees(v) for v in np.random.uniform(-180, 180, len(setter))]
+    setter.set(values)
+    for angle, value in zip(chain_angles(reference), values):
+        angle.rotate_to(value)
+    assert np.allclose(frame.coords.values, reference.coords.values)
+    assert np.allclose([(a - b).to_standard_range().degrees for a, b in zip(setter.values(), values)], 0, atol=1e-6)
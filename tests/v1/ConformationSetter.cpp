@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include "xmol/ConformationSetter.h"
+#include "xmol/Frame.h"
+#include "xmol/ProteinTorsionAngleFactory.h"
+#include "xmol/proxy/selections.h"
+#include <random>
+
+using ::testing::Test;
+using namespace xmol::proxy;
+using namespace xmol::geom;
+using namespace xmol;
+
+class ConformationSetterTests : public Test {
+public:
+  /// Chain of GLY and SER residues with random coordinates
+  static Frame make_chain(int n_residues) {
+    Frame frame;
+    MoleculeRef mol = frame.add_molecule().name("A");
+    for (int i = 0; i < n_residues; ++i) {
+      ResidueRef r = mol.add_residue().name(i % 3 ? "GLY" : "SER").id(i + 1);
+      for (auto name : {"N", "H", "CA", "HA2", "HA3", "C", "O"}) {
+        r.add_atom().name(name);
+      }
+      if (i % 3 == 0) {
+        for (auto name : {"CB", "HB2", "HB3", "OG", "HG"}) {
+          r.add_atom().name(name);
+        }
+      }
+    }
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(-3, 3);
+    for (auto& r : frame.coords()) {
+      r.set(XYZ(dist(gen), dist(gen), dist(gen)));
+    }
+    return frame;
+  }
+
+  static std::vector<TorsionAngle> chain_angles(Frame& frame) {
+    std::vector<TorsionAngle> result;
+    for (auto residue : frame.residues()) {
+      for (auto name : {"omega", "phi", "psi", "chi1"}) {
+        auto angle = TorsionAngleFactory::get(residue, TorsionAngleName(name));
+        if (angle) {
+          result.push_back(*angle);
+        }
+      }
+    }
+    return result;
+  }
+};
+
+TEST_F(ConformationSetterTests, matches_consecutive_set) {
+  auto frame = make_chain(12);
+  auto reference = make_chain(12);
+  auto angles = chain_angles(frame);
+  auto reference_angles = chain_angles(reference);
+  ConformationSetter setter(angles);
+  ASSERT_EQ(setter.size(), angles.size());
+
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<double> dist(-180, 180);
+  for (int trial = 0; trial < 3; ++trial) {
+    std::vector<AngleValue> values;
+    for (size_t k = 0; k < angles.size(); ++k) {
+      values.emplace_back(Degrees(dist(gen)));
+    }
+    setter.set(values);
+    for (size_t k = 0; k < angles.size(); ++k) {
+      reference_angles[k].set(values[k]);
+    }
+    auto current = setter.values();
+    for (size_t k = 0; k < angles.size(); ++k) {
+      EXPECT_NEAR((current[k] - values[k]).to_standard_range().degrees(), 0, 1e-6) << k;
+    }
+    auto atoms = frame.atoms();
+    auto reference_atoms = reference.atoms();
+    for (size_t i = 0; i < atoms.size(); ++i) {
+      EXPECT_NEAR(atoms[i].r().distance(reference_atoms[i].r()), 0, 1e-9) << i;
+    }
+  }
+}
+
+TEST_F(ConformationSetterTests, wrong_order) {
+  auto frame = make_chain(4);
+  auto angles = chain_angles(frame);
+  std::reverse(angles.begin(), angles.end());
+  EXPECT_THROW(ConformationSetter{angles}, GeomError);
+}
@@ -3,6 +3,7 @@
 #include "xmol/Frame.h"
 #include "xmol/algo/alignment-impl.h"
 #include "xmol/geom/UnitCell.h"
+#include <random>
 
 using ::testing::Test;
 using namespace xmol;
@@ -130,4 +131,42 @@ TEST_F(GeomTests, best_shift3){
   EXPECT_DOUBLE_EQ(-1.5, image.shift.x());
   EXPECT_DOUBLE_EQ(-3.0, image.shift.y());
   EXPECT_DOUBLE_EQ(-4.5, image.shift.z());
-}
\ No newline at end of file
+}
+TEST_F(GeomTests, fitted_rmsd_qcp) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dist(-10, 10);
+  CoordEigenMatrix X(50, 3);
+  for (int i = 0; i < X.rows(); ++i) {
+    X.row(i) << dist(gen), dist(gen), dist(gen);
+  }
+  Transformation3d G = Translation3d(XYZ(-1, 1, 2)) * Rotation3d(XYZ(1, 2, 3), Degrees(70));
+  CoordEigenMatrix Y = (G.get_underlying_matrix() * X.transpose()).transpose().rowwise() + G.get_translation()._eigen();
+  for (int i = 0; i < Y.rows(); ++i) {
+    Y.row(i) += CoordEigenVector(dist(gen), dist(gen), dist(gen)) * 0.05;
+  }
+
+  auto svd_alignment = calc_alignment_impl(X, Y);
+  CoordEigenMatrix Y_svd = (svd_alignment.get_underlying_matrix() * Y.transpose()).transpose().rowwise() +
+                           svd_alignment.get_translation()._eigen();
+  const double svd_rmsd = calc_rmsd_impl(X, Y_svd);
+
+  Rotation3d R;
+  EXPECT_NEAR(calc_fitted_rmsd_impl(X, Y), svd_rmsd, 1e-9);
+  EXPECT_NEAR(calc_fitted_rmsd_impl(X, Y, &R), svd_rmsd, 1e-9);
+  EXPECT_LT((R.get_underlying_matrix() - svd_alignment.get_underlying_matrix()).array().abs().maxCoeff(), 1e-9);
+
+  Eigen::VectorXd w = Eigen::VectorXd::Ones(X.rows());
+  EXPECT_NEAR(calc_fitted_rmsd_weighted_impl(X, Y, w), svd_rmsd, 1e-9);
+
+  for (int i = 0; i < w.size(); ++i) {
+    w[i] = 1 + i % 3;
+  }
+  const double weighted_rmsd = calc_fitted_rmsd_weighted_impl(X, Y, w, &R);
+  CoordEigenVector xc = (X.array().colwise() * w.array()).colwise().sum() / w.sum();
+  CoordEigenVector yc = (Y.array().colwise() * w.array()).colwise().sum() / w.sum();
+  CoordEigenMatrix Y_w = (R.get_underlying_matrix() * (Y.rowwise() - yc).transpose()).transpose().rowwise() + xc;
+  EXPECT_NEAR(std::sqrt(((X - Y_w).rowwise().squaredNorm().array() * w.array()).sum() / w.sum()), weighted_rmsd,
+              1e-9);
+
+  EXPECT_NEAR(calc_fitted_rmsd_impl(X, X), 0, 1e-6);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "xmol/Frame.h"
+#include "xmol/TorsionTable.h"
+#include "xmol/proxy/selections.h"
+#include <random>
+
+using ::testing::Test;
+using namespace xmol::proxy;
+using namespace xmol::geom;
+using namespace xmol;
+
+class TorsionTableTests : public Test {
+public:
+  /// Chain of GLY-SER-GLY-SER with random coordinates
+  TorsionTableTests() {
+    MoleculeRef mol = frame.add_molecule().name("A");
+    for (int i = 0; i < 4; ++i) {
+      ResidueRef r = mol.add_residue().name(i % 2 ? "SER" : "GLY").id(i + 1);
+      for (auto name : {"N", "H", "CA", "C", "O"}) {
+        r.add_atom().name(name);
+      }
+      if (i % 2) {
+        r.add_atom().name("CB");
+        r.add_atom().name("OG");
+      }
+    }
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(-3, 3);
+    for (auto& r : frame.coords()) {
+      r.set(XYZ(dist(gen), dist(gen), dist(gen)));
+    }
+  }
+  Frame frame;
+};
+
+TEST_F(TorsionTableTests, matches_factory) {
+  TorsionTable table(frame.residues());
+  // phi: 3, psi: 3, omega: 3, chi1: 2
+  ASSERT_EQ(table.size(), 11);
+  std::vector<XYZ> coords;
+  for (auto& r : frame.coords()) {
+    coords.emplace_back(r.x(), r.y(), r.z());
+  }
+  std::vector<double> values(table.size());
+  table.calc(future::Span(coords), future::Span(values));
+
+  size_t k = 0;
+  for (auto residue : frame.residues()) {
+    for (auto& name : TorsionTable::protein_angles()) {
+      auto angle = TorsionAngleFactory::get(residue, name);
+      if (!angle) {
+        continue;
+      }
+      ASSERT_LT(k, table.size());
+      EXPECT_EQ(table.names()[k], name);
+      EXPECT_EQ(table.residue_indices()[k], residue.index());
+      EXPECT_NEAR(values[k], angle->value().radians(), 1e-12);
+      ++k;
+    }
+  }
+  EXPECT_EQ(k, table.size());
+}
+
+TEST_F(TorsionTableTests, selected_angles) {
+  TorsionTable table(frame.residues(), {TorsionAngleName("chi1")});
+  ASSERT_EQ(table.size(), 2);
+  EXPECT_EQ(table.residue_indices(), (std::vector<ResidueIndex>{1, 3}));
+  std::vector<XYZ> too_short(3);
+  std::vector<double> values(table.size());
+  EXPECT_THROW(table.calc(future::Span(too_short), future::Span(values)), GeomError);
+}
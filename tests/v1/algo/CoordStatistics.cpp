@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include "xmol/algo/CoordStatistics.h"
+#include "xmol/utils/parallel.h"
+#include <random>
+
+using ::testing::Test;
+using namespace xmol;
+using namespace xmol::algo;
+using namespace xmol::geom;
+
+class CoordStatisticsTests : public Test {
+public:
+  /// Frames with large common offset to check numerical stability
+  static std::vector<std::vector<XYZ>> random_frames(int n_frames, int n_atoms, int seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> dist(0, 1);
+    std::vector<std::vector<XYZ>> result(n_frames);
+    for (auto& frame : result) {
+      for (int i = 0; i < n_atoms; ++i) {
+        const double y = dist(gen);
+        frame.emplace_back(1e6 + dist(gen) * (i + 1), y, dist(gen) + 0.5 * y);
+      }
+    }
+    return result;
+  }
+
+  /// Two-pass reference covariance
+  static Eigen::MatrixXd two_pass_covariance(const std::vector<std::vector<XYZ>>& frames) {
+    const size_t n = 3 * frames.front().size();
+    Eigen::MatrixXd X(n, frames.size());
+    for (size_t f = 0; f < frames.size(); ++f) {
+      for (size_t i = 0; i < frames[f].size(); ++i) {
+        X.col(f).segment<3>(3 * i) = frames[f][i]._eigen();
+      }
+    }
+    Eigen::MatrixXd centered = X.colwise() - X.rowwise().mean();
+    return centered * centered.transpose() / frames.size();
+  }
+};
+
+TEST_F(CoordStatisticsTests, mean_rmsf_covariance) {
+  const int n_atoms = 7;
+  auto frames = random_frames(101, n_atoms, 1);
+  CoordStatistics statistics(n_atoms, true);
+  for (auto& frame : frames) {
+    statistics.update(future::Span(frame));
+  }
+  EXPECT_EQ(statistics.n_frames(), frames.size());
+  auto expected = two_pass_covariance(frames);
+  EXPECT_LT((statistics.covariance() - expected).cwiseAbs().maxCoeff(), 1e-9);
+  // pending block is folded into result only, accumulator is not modified
+  EXPECT_EQ(statistics.covariance(), statistics.covariance());
+
+  auto mean = statistics.mean();
+  auto rmsf = statistics.rmsf();
+  for (int i = 0; i < n_atoms; ++i) {
+    XYZ expected_mean;
+    for (auto& frame : frames) {
+      expected_mean += frame[i];
+    }
+    expected_mean /= frames.size();
+    EXPECT_NEAR(mean[i].distance(expected_mean), 0, 1e-7);
+    EXPECT_NEAR(rmsf[i], std::sqrt(expected.block<3, 3>(3 * i, 3 * i).trace()), 1e-9);
+  }
+}
+
+TEST_F(CoordStatisticsTests, parallel_merge) {
+  const int n_atoms = 5;
+  auto frames = random_frames(250, n_atoms, 2);
+  CoordStatistics serial(n_atoms, true);
+  for (auto& frame : frames) {
+    serial.update(future::Span(frame));
+  }
+
+  const size_t n_parts = 7;
+  std::vector<CoordStatistics> parts(n_parts, CoordStatistics(n_atoms, true));
+  utils::parallel_for(n_parts, 3, [&](size_t part, int) {
+    for (size_t f = part; f < frames.size(); f += n_parts) {
+      parts[part].update(future::Span(frames[f]));
+    }
+  });
+  CoordStatistics merged(n_atoms, true);
+  for (auto& part : parts) {
+    merged.merge(part);
+  }
+  EXPECT_EQ(merged.n_frames(), serial.n_frames());
+  EXPECT_LT((merged.covariance() - serial.covariance()).cwiseAbs().maxCoeff(), 1e-9);
+  for (int i = 0; i < n_atoms; ++i) {
+    EXPECT_NEAR(merged.mean()[i].distance(serial.mean()[i]), 0, 1e-7);
+    EXPECT_NEAR(merged.rmsf()[i], serial.rmsf()[i], 1e-9);
+  }
+}
+
+TEST_F(CoordStatisticsTests, invalid_arguments) {
+  CoordStatistics statistics(3);
+  std::vector<XYZ> coords(4);
+  EXPECT_THROW(statistics.update(future::Span(coords)), GeomError);
+  EXPECT_THROW(statistics.covariance(), GeomError);
+  EXPECT_THROW(statistics.merge(CoordStatistics(3, true)), GeomError);
+}
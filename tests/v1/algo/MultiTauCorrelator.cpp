@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include "xmol/algo/MultiTauCorrelator.h"
+#include <random>
+
+using ::testing::Test;
+using namespace xmol::algo;
+using namespace xmol::geom;
+using namespace xmol::future;
+
+class MultiTauCorrelatorTests : public Test {
+public:
+  /// Vectors with slowly diffusing directions, frame after frame
+  static std::vector<XYZ> random_walk(size_t n_frames, size_t n_vectors, int seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> dist(0, 0.05);
+    std::vector<XYZ> current(n_vectors, XYZ(0, 0, 1));
+    std::vector<XYZ> result;
+    for (size_t frame = 0; frame < n_frames; ++frame) {
+      for (auto& v : current) {
+        v += XYZ(dist(gen), dist(gen), dist(gen));
+        v = v / v.len() * (1 + dist(gen));
+        result.push_back(v);
+      }
+    }
+    return result;
+  }
+
+  /// Series of i-th vector
+  static std::vector<XYZ> series(const std::vector<XYZ>& frames, size_t n_vectors, size_t i) {
+    std::vector<XYZ> result;
+    for (size_t k = i; k < frames.size(); k += n_vectors) {
+      result.push_back(frames[k]);
+    }
+    return result;
+  }
+};
+
+TEST_F(MultiTauCorrelatorTests, exact_within_first_level) {
+  const size_t n_vectors = 3;
+  const size_t n_frames = 50;
+  auto frames = random_walk(n_frames, n_vectors, 1);
+  for (auto mode : {AutoCorrelationMode::NORMALIZE_VECTORS, AutoCorrelationMode::NORMALIZE_AND_DIVIDE_BY_CUBE}) {
+    MultiTauCorrelator correlator(n_vectors, mode, 64, 2);
+    for (size_t frame = 0; frame < n_frames; ++frame) {
+      correlator.update(Span<XYZ>(frames.data() + frame * n_vectors, n_vectors));
+    }
+    auto lags = correlator.lags();
+    ASSERT_EQ(lags.size(), n_frames);
+    auto correlation = correlator.correlation();
+    for (size_t i = 0; i < n_vectors; ++i) {
+      auto v = series(frames, n_vectors, i);
+      std::vector<double> expected(n_frames);
+      calc_autocorr_order_2(Span(v), Span(expected), mode);
+      for (size_t k = 0; k < n_frames; ++k) {
+        EXPECT_EQ(lags[k], k);
+        EXPECT_NEAR(correlation[i * n_frames + k], expected[k], 1e-9);
+      }
+    }
+  }
+}
+
+TEST_F(MultiTauCorrelatorTests, approximates_long_lags) {
+  const size_t n_frames = 4000;
+  auto frames = random_walk(n_frames, 1, 2);
+  MultiTauCorrelator correlator(1, AutoCorrelationMode::NORMALIZE_VECTORS, 16, 2);
+  for (size_t frame = 0; frame < n_frames; ++frame) {
+    correlator.update(Span<XYZ>(frames.data() + frame, 1));
+  }
+  std::vector<double> expected(n_frames);
+  calc_autocorr_order_2(Span(frames), Span(expected));
+
+  auto lags = correlator.lags();
+  auto correlation = correlator.correlation();
+  ASSERT_EQ(lags.size(), correlation.size());
+  EXPECT_LT(lags.size(), 16 + 8 * 12);
+  for (size_t k = 0; k < lags.size(); ++k) {
+    if (k > 0) {
+      EXPECT_GT(lags[k], lags[k - 1]);
+    }
+    if (lags[k] < n_frames / 4) {
+      EXPECT_NEAR(correlation[k], expected[lags[k]], 0.05) << lags[k];
+    }
+  }
+}
+
+TEST_F(MultiTauCorrelatorTests, invalid_arguments) {
+  EXPECT_THROW(MultiTauCorrelator(1, AutoCorrelationMode::NORMALIZE_VECTORS, 16, 1), GeomError);
+  EXPECT_THROW(MultiTauCorrelator(1, AutoCorrelationMode::NORMALIZE_VECTORS, 15, 2), GeomError);
+  EXPECT_THROW(MultiTauCorrelator(0), GeomError);
+  MultiTauCorrelator correlator(2);
+  std::vector<XYZ> v(3, XYZ(1, 0, 0));
+  EXPECT_THROW(correlator.update(Span(v)), GeomError);
+
+  std::vector<XYZ> zero = {XYZ(1, 0, 0), XYZ(0, 0, 0)};
+  EXPECT_THROW(correlator.update(Span(zero)), GeomError);
+  EXPECT_EQ(correlator.n_frames(), 0);
+  EXPECT_TRUE(correlator.lags().empty());
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include "xmol/Frame.h"
+#include "xmol/algo/PrincipalComponents.h"
+#include "xmol/geom/affine/Transformation3d.h"
+#include "test_common.h"
+#include <numeric>
+#include <random>
+
+using ::testing::Test;
+using namespace xmol;
+using namespace xmol::algo;
+using namespace xmol::geom;
+
+class PrincipalComponentsTests : public Test {
+public:
+  /// Frames fluctuating mostly along two fixed collective directions
+  static std::vector<XYZ> random_frames(int n_frames, int n_atoms, int seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> dist(0, 1);
+    std::vector<XYZ> first_mode, second_mode, mean;
+    for (int i = 0; i < n_atoms; ++i) {
+      first_mode.emplace_back(dist(gen), dist(gen), dist(gen));
+      second_mode.emplace_back(dist(gen), dist(gen), dist(gen));
+      mean.emplace_back(10 * dist(gen), 10 * dist(gen), 10 * dist(gen));
+    }
+    std::vector<XYZ> result;
+    for (int f = 0; f < n_frames; ++f) {
+      double a = 3 * dist(gen);
+      double b = dist(gen);
+      for (int i = 0; i < n_atoms; ++i) {
+        result.push_back(mean[i] + first_mode[i] * a + second_mode[i] * b +
+                         XYZ(dist(gen), dist(gen), dist(gen)) * 0.01);
+      }
+    }
+    return result;
+  }
+};
+
+TEST_F(PrincipalComponentsTests, modes_and_projections) {
+  const int n_frames = 150;
+  const int n_atoms = 20;
+  auto frames = random_frames(n_frames, n_atoms, 1);
+  CoordStatistics statistics(n_atoms, true);
+  for (int f = 0; f < n_frames; ++f) {
+    statistics.update(future::Span<XYZ>(frames.data() + f * n_atoms, n_atoms));
+  }
+  PrincipalComponents pca(statistics, 3);
+  ASSERT_EQ(pca.n_components(), 3);
+  EXPECT_GT(pca.eigenvalues()[0], pca.eigenvalues()[1]);
+  EXPECT_GT(pca.eigenvalues()[1], 100 * pca.eigenvalues()[2]);
+  EXPECT_NEAR(pca.total_variance(), statistics.covariance().trace(), 1e-9);
+  EXPECT_NEAR((pca.modes().transpose() * pca.modes() - Eigen::MatrixXd::Identity(3, 3)).norm(), 0, 1e-9);
+
+  for (int n_threads : {1, 3}) {
+    std::vector<double> result(n_frames * 3);
+    pca.project(future::Span(frames), future::Span(result), n_threads);
+    Eigen::VectorXd mean_projection = Eigen::VectorXd::Zero(3);
+    Eigen::VectorXd variance = Eigen::VectorXd::Zero(3);
+    for (int f = 0; f < n_frames; ++f) {
+      for (int k = 0; k < 3; ++k) {
+        mean_projection[k] += result[f * 3 + k] / n_frames;
+        variance[k] += result[f * 3 + k] * result[f * 3 + k] / n_frames;
+      }
+    }
+    EXPECT_NEAR(mean_projection.norm(), 0, 1e-9);
+    for (int k = 0; k < 3; ++k) {
+      EXPECT_NEAR(variance[k], pca.eigenvalues()[k], 1e-9 * pca.eigenvalues()[0]);
+    }
+  }
+}
+
+TEST_F(PrincipalComponentsTests, trajectory_alignment) {
+  const int n_frames = 40;
+  Frame frame;
+  test::add_polyglycines({{"A", 2}}, frame);
+  const int n_atoms = frame.n_atoms();
+  auto frames = random_frames(n_frames, n_atoms, 3);
+  CoordStatistics statistics(n_atoms, true);
+  std::vector<std::vector<XYZ>> still, moving;
+  for (int f = 0; f < n_frames; ++f) {
+    still.emplace_back(frames.begin() + f * n_atoms, frames.begin() + (f + 1) * n_atoms);
+    statistics.update(future::Span(still.back()));
+    affine::Transformation3d motion(affine::Rotation3d(XYZ(1, f, 2) / XYZ(1, f, 2).len(), Degrees(20.0 * f)),
+                                    affine::Translation3d(XYZ(f, -f, 2 * f)));
+    moving.push_back(still.back());
+    for (auto& r : moving.back()) {
+      r = motion.transform(r);
+    }
+  }
+  PrincipalComponents pca(statistics, 2);
+  std::vector<AtomIndex> indices(n_atoms);
+  std::iota(indices.begin(), indices.end(), 0);
+
+  auto project = [&](const std::vector<std::vector<XYZ>>& coords, bool align) {
+    trajectory::Trajectory traj(frame);
+    traj.extend(test::InMemoryTrajectoryFile(coords));
+    auto slice = traj.slice();
+    std::vector<double> result(n_frames * 2);
+    pca.project(slice, indices, future::Span(result), 2, align);
+    return Eigen::Map<Eigen::VectorXd>(result.data(), result.size()).eval();
+  };
+  std::vector<double> raw(n_frames * 2);
+  pca.project(future::Span(frames), future::Span(raw), 2);
+  const Eigen::Map<Eigen::VectorXd> expected(raw.data(), raw.size());
+
+  EXPECT_NEAR((project(still, false) - expected).norm(), 0, 1e-9);
+  // rigid body motion is removed completely by fit onto mean structure
+  EXPECT_NEAR((project(moving, true) - project(still, true)).norm(), 0, 1e-9);
+  EXPECT_GT((project(moving, false) - expected).norm(), expected.norm());
+}
+
+TEST_F(PrincipalComponentsTests, mass_weighted) {
+  const int n_frames = 50;
+  const int n_atoms = 4;
+  auto frames = random_frames(n_frames, n_atoms, 2);
+  CoordStatistics statistics(n_atoms, true);
+  for (int f = 0; f < n_frames; ++f) {
+    statistics.update(future::Span<XYZ>(frames.data() + f * n_atoms, n_atoms));
+  }
+  std::vector<double> masses{1, 4, 9, 16};
+  PrincipalComponents pca(statistics, 12, future::Span<const double>(masses.data(), masses.size()));
+  Eigen::VectorXd w(12);
+  for (int i = 0; i < n_atoms; ++i) {
+    w.segment<3>(3 * i).setConstant(std::sqrt(masses[i]));
+  }
+  Eigen::MatrixXd expected = w.asDiagonal() * statistics.covariance() * w.asDiagonal();
+  Eigen::MatrixXd reconstructed = pca.modes() * pca.eigenvalues().asDiagonal() * pca.modes().transpose();
+  EXPECT_LT((reconstructed - expected).cwiseAbs().maxCoeff(), 1e-9);
+}
+
+TEST_F(PrincipalComponentsTests, invalid_arguments) {
+  CoordStatistics statistics(2, true);
+  std::vector<XYZ> coords{XYZ(0, 0, 0), XYZ(1, 1, 1)};
+  statistics.update(future::Span(coords));
+  EXPECT_THROW(PrincipalComponents(statistics, 1), GeomError);
+  statistics.update(future::Span(coords));
+  EXPECT_THROW(PrincipalComponents(statistics, 7), GeomError);
+  CoordStatistics no_covariance(2);
+  no_covariance.update(future::Span(coords));
+  no_covariance.update(future::Span(coords));
+  EXPECT_THROW(PrincipalComponents(no_covariance, 1), GeomError);
+}
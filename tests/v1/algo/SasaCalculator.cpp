@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "xmol/Frame.h"
+#include "xmol/algo/SasaCalculator.h"
+#include "xmol/proxy/spans.h"
+#include "test_common.h"
+#include <random>
+
+using ::testing::Test;
+using namespace xmol;
+using namespace xmol::algo;
+using namespace xmol::future;
+using namespace xmol::geom;
+
+class SasaCalculatorTests : public Test {
+public:
+  static std::vector<XYZ> random_coords(int n, double box, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dist(0, box);
+    std::vector<XYZ> result;
+    for (int i = 0; i < n; ++i) {
+      result.emplace_back(dist(gen), dist(gen), dist(gen));
+    }
+    return result;
+  }
+};
+
+TEST_F(SasaCalculatorTests, zero_tolerance_matches_calc_sasa) {
+  std::mt19937 gen(1);
+  auto coords = random_coords(800, 30, gen);
+  std::vector<double> radii(coords.size());
+  std::uniform_real_distribution<double> radius(1.0, 2.0);
+  for (auto& r : radii) {
+    r = std::round(radius(gen) * 4) / 4;
+  }
+  std::uniform_real_distribution<double> step(-0.05, 0.05);
+  for (auto method : {SasaMethod::LEE_RICHARDS, SasaMethod::SHRAKE_RUPLEY}) {
+    SasaCalculator calculator(1.4, 1.0, 0.0, method, 30, 2);
+    auto frame_coords = coords;
+    for (int frame = 0; frame < 10; ++frame) {
+      for (int i = 0; i < 3; ++i) { // move a few atoms only
+        frame_coords[(i * 13 + frame) % frame_coords.size()] += XYZ(step(gen), step(gen), step(gen));
+      }
+      auto sasa = calculator.update(Span(frame_coords), Span(radii));
+      std::vector<double> expected(coords.size());
+      if (method == SasaMethod::LEE_RICHARDS) {
+        calc_sasa(Span(frame_coords), Span(radii), 1.4, Span(expected), 30);
+      } else {
+        calc_sasa_shrake_rupley(Span(frame_coords), Span(radii), 1.4, Span(expected), 30);
+      }
+      EXPECT_EQ(std::vector<double>(sasa.begin(), sasa.end()), expected);
+      if (frame > 0) {
+        EXPECT_LT(calculator.n_updated_atoms(), coords.size());
+      }
+    }
+  }
+}
+
+TEST_F(SasaCalculatorTests, tolerance_skips_small_moves) {
+  std::mt19937 gen(2);
+  auto coords = random_coords(300, 15, gen);
+  std::vector<double> radii(coords.size(), 1.5);
+  SasaCalculator calculator(1.4, 1.0, 0.1);
+  calculator.update(Span(coords), Span(radii));
+  EXPECT_EQ(calculator.n_updated_atoms(), coords.size());
+
+  std::uniform_real_distribution<double> step(-0.01, 0.01);
+  for (auto& r : coords) {
+    r += XYZ(step(gen), step(gen), step(gen));
+  }
+  calculator.update(Span(coords), Span(radii));
+  EXPECT_EQ(calculator.n_updated_atoms(), 0);
+
+  coords[0] += XYZ(0.5, 0, 0);
+  auto sasa = calculator.update(Span(coords), Span(radii));
+  EXPECT_GT(calculator.n_updated_atoms(), 0);
+  std::vector<double> expected(coords.size());
+  calc_sasa(Span(coords), Span(radii), 1.4, Span(expected));
+  for (int i = 0; i < coords.size(); ++i) {
+    EXPECT_NEAR(sasa[i], expected[i], 1.0);
+  }
+  EXPECT_DOUBLE_EQ(sasa[0], expected[0]);
+}
+
+TEST_F(SasaCalculatorTests, frame_radii) {
+  Frame frame;
+  test::add_polyglycines({{"A", 5}}, frame);
+  std::mt19937 gen(3);
+  auto coords = random_coords(frame.n_atoms(), 10, gen);
+  int i = 0;
+  for (auto atom : frame.atoms()) {
+    atom.r(coords[i]);
+    atom.vdw_radius(1.0f + 0.1f * (i++ % 5));
+  }
+  SasaCalculator calculator(1.4);
+  auto sasa = calculator.update(frame);
+  std::vector<double> radii;
+  for (auto atom : frame.atoms()) {
+    radii.push_back(atom.vdw_radius());
+  }
+  std::vector<double> expected(frame.n_atoms());
+  calc_sasa(Span(coords), Span(radii), 1.4, Span(expected));
+  EXPECT_EQ(std::vector<double>(sasa.begin(), sasa.end()), expected);
+
+  frame.atoms()[0].vdw_radius(2.0f); // radius change invalidates all areas
+  calculator.update(frame);
+  EXPECT_EQ(calculator.n_updated_atoms(), frame.n_atoms());
+}
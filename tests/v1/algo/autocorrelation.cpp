@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "xmol/algo/vector-correlation.h"
+#include <random>
+
+using ::testing::Test;
+using namespace xmol::algo;
+using namespace xmol::geom;
+using namespace xmol::future;
+
+class AutoCorrelationTests : public Test {
+public:
+  static std::vector<XYZ> random_vectors(int n, int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    std::vector<XYZ> result;
+    for (int i = 0; i < n; ++i) {
+      result.emplace_back(dist(gen), dist(gen), dist(gen) + 0.1);
+    }
+    return result;
+  }
+
+  /// Direct sum of second Legendre polynomial of angle between vectors
+  static std::vector<double> brute_force(const std::vector<XYZ>& v, int limit) {
+    std::vector<double> result(limit);
+    for (int k = 0; k < limit; ++k) {
+      for (int i = 0; i + k < v.size(); ++i) {
+        double c = v[i].dot(v[i + k]) / v[i].len() / v[i + k].len();
+        result[k] += 1.5 * c * c - 0.5;
+      }
+      result[k] /= v.size() - k;
+    }
+    return result;
+  }
+};
+
+TEST_F(AutoCorrelationTests, matches_direct_sum) {
+  auto v = random_vectors(100, 1);
+  std::vector<double> result(100);
+  calc_autocorr_order_2(Span(v), Span(result));
+  auto expected = brute_force(v, 100);
+  for (int i = 0; i < result.size(); ++i) {
+    EXPECT_NEAR(result[i], expected[i], 1e-9) << i;
+  }
+}
+
+TEST_F(AutoCorrelationTests, batch_matches_single) {
+  const size_t n_vectors = 7;
+  const size_t n_frames = 53;
+  const size_t limit = 40;
+  auto v = random_vectors(n_vectors * n_frames, 2);
+  for (auto mode : {AutoCorrelationMode::NORMALIZE_VECTORS, AutoCorrelationMode::NORMALIZE_AND_DIVIDE_BY_CUBE}) {
+    std::vector<double> batch(n_vectors * limit);
+    calc_autocorr_order_2(Span(v), n_vectors, Span(batch), mode, 3);
+    for (size_t i = 0; i < n_vectors; ++i) {
+      std::vector<double> single(limit);
+      calc_autocorr_order_2(Span<XYZ>(v.data() + i * n_frames, n_frames), Span(single), mode);
+      for (size_t k = 0; k < limit; ++k) {
+        EXPECT_DOUBLE_EQ(batch[i * limit + k], single[k]);
+      }
+    }
+  }
+}
+
+TEST_F(AutoCorrelationTests, batch_invalid_sizes) {
+  auto v = random_vectors(10, 3);
+  std::vector<double> result(8);
+  EXPECT_THROW(calc_autocorr_order_2(Span(v), 3, Span(result)), GeomError);
+  std::vector<double> too_long(12);
+  EXPECT_THROW(calc_autocorr_order_2(Span(v), 2, Span(too_long)), GeomError);
+}
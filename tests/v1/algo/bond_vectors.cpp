@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "xmol/Frame.h"
+#include "xmol/algo/bond-vectors.h"
+#include "xmol/geom/affine/Transformation3d.h"
+#include "test_common.h"
+#include <random>
+
+using ::testing::Test;
+using namespace xmol;
+using namespace xmol::algo;
+using namespace xmol::geom;
+using xmol::test::InMemoryTrajectoryFile;
+
+class BondVectorsTests : public Test {
+public:
+  BondVectorsTests() {
+    test::add_polyglycines({{"A", 5}}, frame);
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(-5, 5);
+    for (size_t i = 0; i < frame.n_atoms(); ++i) {
+      reference.emplace_back(dist(gen), dist(gen), dist(gen));
+    }
+  }
+
+  Frame frame;
+  std::vector<XYZ> reference;
+};
+
+TEST_F(BondVectorsTests, differences_of_coordinates) {
+  std::vector<std::vector<XYZ>> frames;
+  for (int f = 0; f < 4; ++f) {
+    auto coords = reference;
+    for (auto& r : coords) {
+      r *= (f + 1);
+    }
+    frames.push_back(coords);
+  }
+  trajectory::Trajectory traj(frame);
+  traj.extend(InMemoryTrajectoryFile(frames));
+  auto slice = traj.slice();
+  std::vector<std::pair<AtomIndex, AtomIndex>> pairs{{0, 1}, {3, 2}, {7, 10}};
+  std::vector<XYZ> result(pairs.size() * slice.size());
+  extract_bond_vectors(slice, pairs, future::Span(result));
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    for (size_t f = 0; f < frames.size(); ++f) {
+      auto expected = frames[f][pairs[i].second] - frames[f][pairs[i].first];
+      EXPECT_NEAR(result[i * frames.size() + f].distance(expected), 0, 1e-12);
+    }
+  }
+}
+
+TEST_F(BondVectorsTests, aligned_to_reference) {
+  std::vector<std::vector<XYZ>> frames;
+  for (int f = 0; f < 5; ++f) {
+    affine::Transformation3d transformation(affine::Rotation3d(XYZ(1, f, 2) / XYZ(1, f, 2).len(), Degrees(30.0 * f)),
+                                            affine::Translation3d(XYZ(f, -f, 2 * f)));
+    auto coords = reference;
+    for (auto& r : coords) {
+      r = transformation.transform(r);
+    }
+    frames.push_back(coords);
+  }
+  trajectory::Trajectory traj(frame);
+  traj.extend(InMemoryTrajectoryFile(frames));
+  auto slice = traj.slice();
+
+  std::vector<AtomIndex> alignment_indices{0, 2, 4, 6, 8, 10};
+  std::vector<XYZ> alignment_reference;
+  for (auto i : alignment_indices) {
+    alignment_reference.push_back(reference[i]);
+  }
+  std::vector<std::pair<AtomIndex, AtomIndex>> pairs{{1, 5}, {9, 3}};
+  std::vector<XYZ> result(pairs.size() * slice.size());
+  extract_bond_vectors(slice, pairs, future::Span(result), future::Span(alignment_reference), alignment_indices);
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    auto expected = reference[pairs[i].second] - reference[pairs[i].first];
+    for (size_t f = 0; f < frames.size(); ++f) {
+      EXPECT_NEAR(result[i * frames.size() + f].distance(expected), 0, 1e-9);
+    }
+  }
+}
+
+TEST_F(BondVectorsTests, invalid_arguments) {
+  trajectory::Trajectory traj(frame);
+  traj.extend(InMemoryTrajectoryFile({reference, reference}));
+  auto slice = traj.slice();
+  std::vector<XYZ> result(2);
+  std::vector<XYZ> wrong_size(3);
+  EXPECT_THROW(extract_bond_vectors(slice, {{0, 1}}, future::Span(wrong_size)), GeomError);
+  EXPECT_THROW(extract_bond_vectors(slice, {{0, 1000}}, future::Span(result)), GeomError);
+  EXPECT_THROW(extract_bond_vectors(slice, {{0, 1}}, future::Span(result), future::Span(result), {0}), GeomError);
+}
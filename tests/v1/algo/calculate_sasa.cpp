@@ -4,6 +4,7 @@
 #include "xmol/io/PdbInputFile.h"
 #include <chrono>
 #include <numeric>
+#include <random>
 
 using ::testing::Test;
 using namespace xmol::geom;
@@ -44,3 +45,69 @@ TEST_F(calculate_sasa_Tests, calc_sasa_on_pdb) {
               << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << " ms)" << std::endl;
   }
 }
+
+TEST_F(calculate_sasa_Tests, result_does_not_depend_on_number_of_threads) {
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> box(0, 30);
+  std::uniform_real_distribution<double> radius(1.0, 2.0);
+  std::vector<XYZ> coords;
+  std::vector<double> radii;
+  for (int i = 0; i < 2000; ++i) {
+    coords.emplace_back(box(gen), box(gen), box(gen));
+    radii.push_back(radius(gen));
+  }
+  std::vector<double> serial(coords.size());
+  std::vector<double> parallel(coords.size());
+  calc_sasa(coords, Span(radii), 1.4, Span(serial), 20, {}, 1);
+  calc_sasa(coords, Span(radii), 1.4, Span(parallel), 20, {}, 4);
+  EXPECT_EQ(serial, parallel);
+
+  std::vector<int> indices = {5, 1000, 3};
+  std::vector<double> subset(indices.size());
+  calc_sasa(coords, Span(radii), 1.4, Span(subset), 20, Span(indices), 2);
+  for (int i = 0; i < indices.size(); ++i) {
+    EXPECT_EQ(subset[i], serial[indices[i]]);
+  }
+  indices[0] = -1;
+  EXPECT_THROW(calc_sasa(coords, Span(radii), 1.4, Span(subset), 20, Span(indices)), GeomError);
+}
+
+TEST_F(calculate_sasa_Tests, shrake_rupley_vs_analytical) {
+  const double R1 = 1.5;
+  const double R2 = 2.0;
+  const double d = 2.5;
+  std::vector<XYZ> coords = {XYZ(0, 0, 0), XYZ(0.3, -0.4, 1.2) * (d / XYZ(0.3, -0.4, 1.2).len()), XYZ(100, 0, 0)};
+  std::vector<double> radii = {R1, R2, R1};
+  std::vector<double> result(3);
+  calc_sasa_shrake_rupley(coords, Span(radii), 0.0, Span(result), 5000);
+
+  auto exposed_area = [&](double Ra, double Rb) {
+    const double h = Ra - (d * d + Ra * Ra - Rb * Rb) / (2 * d);
+    return 4 * M_PI * Ra * Ra - 2 * M_PI * Ra * h;
+  };
+  EXPECT_NEAR(result[0] / exposed_area(R1, R2), 1.0, 2e-3);
+  EXPECT_NEAR(result[1] / exposed_area(R2, R1), 1.0, 2e-3);
+  EXPECT_DOUBLE_EQ(result[2], 4 * M_PI * R1 * R1);
+}
+
+TEST_F(calculate_sasa_Tests, shrake_rupley_vs_lee_richards) {
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<double> box(0, 25);
+  std::uniform_real_distribution<double> radius(1.0, 2.0);
+  std::vector<XYZ> coords;
+  std::vector<double> radii;
+  for (int i = 0; i < 1000; ++i) {
+    coords.emplace_back(box(gen), box(gen), box(gen));
+    radii.push_back(std::round(radius(gen) * 4) / 4); // few radius classes
+  }
+  std::vector<double> lee_richards(coords.size());
+  std::vector<double> shrake_rupley(coords.size());
+  std::vector<double> shrake_rupley_parallel(coords.size());
+  calc_sasa(coords, Span(radii), 1.4, Span(lee_richards), 100);
+  calc_sasa_shrake_rupley(coords, Span(radii), 1.4, Span(shrake_rupley), 1000, {}, 1);
+  calc_sasa_shrake_rupley(coords, Span(radii), 1.4, Span(shrake_rupley_parallel), 1000, {}, 3);
+  EXPECT_EQ(shrake_rupley, shrake_rupley_parallel);
+  double total_lr = std::accumulate(lee_richards.begin(), lee_richards.end(), 0.0);
+  double total_sr = std::accumulate(shrake_rupley.begin(), shrake_rupley.end(), 0.0);
+  EXPECT_NEAR(total_sr / total_lr, 1.0, 2e-3);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "xmol/algo/clustering.h"
+#include "xmol/algo/pairwise-rmsd.h"
+#include <random>
+#include <set>
+
+using ::testing::Test;
+using namespace xmol;
+using namespace xmol::algo;
+using namespace xmol::geom;
+
+class ClusteringTests : public Test {
+public:
+  /// Noisy copies of few random structures, frame i is a copy of structure i % n_structures
+  static std::vector<XYZ> noisy_frames(int n_structures, int n_frames, int n_atoms, int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-5, 5);
+    std::normal_distribution<double> noise(0, 0.05);
+    std::vector<XYZ> structures;
+    for (int i = 0; i < n_structures * n_atoms; ++i) {
+      structures.emplace_back(dist(gen), dist(gen), dist(gen));
+    }
+    std::vector<XYZ> result;
+    for (int i = 0; i < n_frames; ++i) {
+      for (int k = 0; k < n_atoms; ++k) {
+        result.push_back(structures[(i % n_structures) * n_atoms + k] + XYZ(noise(gen), noise(gen), noise(gen)));
+      }
+    }
+    return result;
+  }
+
+  static void check_recovered(const Clustering& clustering, int n_structures) {
+    ASSERT_EQ(clustering.medoids.size(), n_structures);
+    for (int i = 0; i < clustering.labels.size(); ++i) {
+      EXPECT_EQ(clustering.labels[i], clustering.labels[i % n_structures]);
+    }
+    std::set<int> labels(clustering.labels.begin(), clustering.labels.end());
+    EXPECT_EQ(labels.size(), n_structures);
+    for (int k = 0; k < n_structures; ++k) {
+      EXPECT_EQ(clustering.labels[clustering.medoids[k]], k);
+    }
+  }
+
+  const int n_structures = 4;
+  const int n_frames = 60;
+  const size_t n_atoms = 20;
+};
+
+TEST_F(ClusteringTests, gromos) {
+  auto frames = noisy_frames(n_structures, n_frames, n_atoms, 1);
+  std::vector<double> rmsd(condensed_size(n_frames));
+  calc_pairwise_fitted_rmsd(future::Span(frames), n_atoms, future::Span(rmsd));
+  CondensedDistanceMatrix matrix(future::Span<const double>(rmsd.data(), rmsd.size()));
+  check_recovered(gromos_clustering(matrix, 0.5), n_structures);
+
+  CachedRmsdMatrix cached{future::Span(frames), n_atoms, 4};
+  auto clustering = gromos_clustering(cached, 0.5);
+  check_recovered(clustering, n_structures);
+  EXPECT_EQ(clustering.labels, gromos_clustering(matrix, 0.5).labels);
+}
+
+TEST_F(ClusteringTests, k_medoids) {
+  auto frames = noisy_frames(n_structures, n_frames, n_atoms, 2);
+  CachedRmsdMatrix cached{future::Span(frames), n_atoms, 8};
+  check_recovered(k_medoids_clustering(cached, n_structures, 100, 3), n_structures);
+  EXPECT_EQ(k_medoids_clustering(cached, 1).medoids.size(), 1);
+  EXPECT_THROW(k_medoids_clustering(cached, n_frames + 1), std::runtime_error);
+}
+
+TEST_F(ClusteringTests, hierarchical) {
+  auto frames = noisy_frames(n_structures, n_frames, n_atoms, 3);
+  std::vector<double> rmsd(condensed_size(n_frames));
+  calc_pairwise_fitted_rmsd(future::Span(frames), n_atoms, future::Span(rmsd));
+  CondensedDistanceMatrix matrix(future::Span<const double>(rmsd.data(), rmsd.size()));
+  for (auto method : {Linkage::SINGLE, Linkage::COMPLETE, Linkage::AVERAGE}) {
+    auto linkage = calc_linkage(matrix, method);
+    ASSERT_EQ(linkage.size(), n_frames - 1);
+    for (int i = 1; i < linkage.size(); ++i) {
+      EXPECT_LE(linkage[i - 1].distance, linkage[i].distance);
+    }
+    EXPECT_EQ(linkage.back().size, n_frames);
+    EXPECT_EQ(linkage.back().second, 2 * n_frames - 3);
+    check_recovered(hierarchical_clustering(matrix, linkage, n_structures), n_structures);
+    check_recovered(hierarchical_clustering_by_distance(matrix, linkage, 0.5), n_structures);
+    EXPECT_EQ(hierarchical_clustering(matrix, linkage, n_frames).medoids.size(), n_frames);
+  }
+}
+
+TEST_F(ClusteringTests, single_linkage_heights_below_complete) {
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> dist(0, 1);
+  const int n = 30;
+  std::vector<double> distances(condensed_size(n));
+  for (auto& d : distances) {
+    d = dist(gen);
+  }
+  CondensedDistanceMatrix matrix(future::Span<const double>(distances.data(), distances.size()));
+  auto single = calc_linkage(matrix, Linkage::SINGLE);
+  // complete linkage merge heights are never below single linkage ones
+  auto complete = calc_linkage(matrix, Linkage::COMPLETE);
+  for (int i = 0; i < n - 1; ++i) {
+    EXPECT_LE(single[i].distance, complete[i].distance);
+  }
+  // first merge is the closest pair for any linkage
+  auto closest = std::min_element(distances.begin(), distances.end()) - distances.begin();
+  EXPECT_DOUBLE_EQ(single[0].distance, distances[closest]);
+  EXPECT_DOUBLE_EQ(complete[0].distance, distances[closest]);
+}
+
+TEST_F(ClusteringTests, malformed_linkage) {
+  std::vector<double> distances(condensed_size(4), 1.0);
+  CondensedDistanceMatrix matrix(future::Span<const double>(distances.data(), distances.size()));
+  std::vector<LinkageStep> linkage{{0, 1, 1.0, 2}, {2, 4, 1.0, 3}, {3, 5, 1.0, 4}};
+  EXPECT_EQ(hierarchical_clustering(matrix, linkage, 1).medoids.size(), 1);
+  linkage[1].second = 1000;
+  EXPECT_THROW(hierarchical_clustering(matrix, linkage, 2), std::runtime_error);
+}
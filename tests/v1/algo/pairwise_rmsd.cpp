@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "xmol/algo/alignment-impl.h"
+#include "xmol/Frame.h"
+#include "xmol/algo/pairwise-rmsd.h"
+#include "test_common.h"
+#include <random>
+
+using ::testing::Test;
+using namespace xmol;
+using namespace xmol::algo;
+using namespace xmol::geom;
+
+class PairwiseRmsdTests : public Test {
+public:
+  static std::vector<XYZ> random_frames(int n_frames, int n_atoms, int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-5, 5);
+    std::vector<XYZ> result;
+    for (int i = 0; i < n_frames * n_atoms; ++i) {
+      result.emplace_back(dist(gen), dist(gen), dist(gen));
+    }
+    return result;
+  }
+};
+
+TEST_F(PairwiseRmsdTests, matches_fitted_rmsd) {
+  const int n_frames = 37;
+  const int n_atoms = 50;
+  auto frames = random_frames(n_frames, n_atoms, 1);
+  for (int n_threads : {1, 3}) {
+    std::vector<double> result(condensed_size(n_frames), -1);
+    calc_pairwise_fitted_rmsd(future::Span(frames), n_atoms, future::Span(result), n_threads);
+    for (int i = 0; i < n_frames; ++i) {
+      for (int j = i + 1; j < n_frames; ++j) {
+        Eigen::Map<const CoordEigenMatrix> X(frames[i * n_atoms]._eigen().data(), n_atoms, 3);
+        Eigen::Map<const CoordEigenMatrix> Y(frames[j * n_atoms]._eigen().data(), n_atoms, 3);
+        EXPECT_NEAR(result[condensed_index(n_frames, i, j)], calc_fitted_rmsd_impl(X, Y), 1e-8);
+      }
+    }
+  }
+}
+
+TEST_F(PairwiseRmsdTests, one_frame_tiles) {
+  // frames too large for cache tile, every pair of frames is a separate task
+  const int n_frames = 23;
+  const int n_atoms = 6000;
+  auto frames = random_frames(n_frames, n_atoms, 4);
+  std::vector<double> result(condensed_size(n_frames), -1);
+  calc_pairwise_fitted_rmsd(future::Span(frames), n_atoms, future::Span(result), 4);
+  for (int i = 0; i < n_frames; ++i) {
+    for (int j = i + 1; j < n_frames; ++j) {
+      Eigen::Map<const CoordEigenMatrix> X(frames[i * n_atoms]._eigen().data(), n_atoms, 3);
+      Eigen::Map<const CoordEigenMatrix> Y(frames[j * n_atoms]._eigen().data(), n_atoms, 3);
+      EXPECT_NEAR(result[condensed_index(n_frames, i, j)], calc_fitted_rmsd_impl(X, Y), 1e-8);
+    }
+  }
+}
+
+TEST_F(PairwiseRmsdTests, float_result_and_size_check) {
+  const int n_frames = 5;
+  const int n_atoms = 4;
+  auto frames = random_frames(n_frames, n_atoms, 2);
+  std::vector<float> result(condensed_size(n_frames));
+  calc_pairwise_fitted_rmsd(future::Span(frames), n_atoms, future::Span(result));
+  std::vector<double> reference(condensed_size(n_frames));
+  calc_pairwise_fitted_rmsd(future::Span(frames), n_atoms, future::Span(reference));
+  for (int i = 0; i < result.size(); ++i) {
+    EXPECT_NEAR(result[i], reference[i], 1e-5);
+  }
+  std::vector<double> wrong_size(3);
+  EXPECT_THROW(calc_pairwise_fitted_rmsd(future::Span(frames), n_atoms, future::Span(wrong_size)), GeomError);
+  EXPECT_THROW(calc_pairwise_fitted_rmsd(future::Span(frames), 3, future::Span(reference)), GeomError);
+}
+
+TEST_F(PairwiseRmsdTests, trajectory_slice) {
+  Frame frame;
+  test::add_polyglycines({{"A", 3}}, frame);
+  const size_t n_atoms = frame.n_atoms();
+  const int n_frames = 9;
+  auto coords = random_frames(n_frames, n_atoms, 3);
+  std::vector<std::vector<XYZ>> frames;
+  for (int i = 0; i < n_frames; ++i) {
+    frames.emplace_back(coords.begin() + i * n_atoms, coords.begin() + (i + 1) * n_atoms);
+  }
+  trajectory::Trajectory traj(frame);
+  traj.extend(test::InMemoryTrajectoryFile(frames));
+
+  const std::vector<AtomIndex> indices{0, 2, 5, 7, 9, 20};
+  std::vector<XYZ> selected;
+  for (auto& f : frames) {
+    for (auto index : indices) {
+      selected.push_back(f[index]);
+    }
+  }
+  std::vector<double> expected(condensed_size(n_frames));
+  calc_pairwise_fitted_rmsd(future::Span(selected), indices.size(), future::Span(expected));
+
+  auto slice = traj.slice();
+  std::vector<double> result(condensed_size(n_frames));
+  calc_pairwise_fitted_rmsd(slice, indices, future::Span(result), 2);
+  for (int i = 0; i < result.size(); ++i) {
+    EXPECT_NEAR(result[i], expected[i], 1e-10);
+  }
+
+  auto every_other = traj.slice(1, n_frames, 2);
+  std::vector<float> subset(condensed_size(every_other.size()));
+  calc_pairwise_fitted_rmsd(every_other, indices, future::Span(subset));
+  EXPECT_NEAR(subset[condensed_index(every_other.size(), 0, 1)], expected[condensed_index(n_frames, 1, 3)], 1e-5);
+
+  EXPECT_THROW(calc_pairwise_fitted_rmsd(slice, {0, AtomIndex(n_atoms)}, future::Span(result)), GeomError);
+  EXPECT_THROW(calc_pairwise_fitted_rmsd(slice, {}, future::Span(result)), GeomError);
+}
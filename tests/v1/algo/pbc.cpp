@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include "xmol/Frame.h"
+#include "xmol/algo/pbc.h"
+#include "xmol/proxy/selections.h"
+#include "xmol/proxy/spans.h"
+#include "test_common.h"
+#include <array>
+#include <cmath>
+#include <random>
+
+using ::testing::Test;
+using namespace xmol;
+using namespace xmol::algo;
+using namespace xmol::geom;
+
+class PbcTests : public Test {
+public:
+  static UnitCell triclinic_cell() { return UnitCell(10, 12, 14, Degrees(80), Degrees(95), Degrees(110)); }
+};
+
+TEST_F(PbcTests, minimum_image_matches_closest_image) {
+  auto cell = triclinic_cell();
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(-30, 30);
+  std::vector<XYZ> deltas;
+  for (int i = 0; i < 100; ++i) {
+    deltas.emplace_back(dist(gen), dist(gen), dist(gen));
+  }
+  auto reduced = deltas;
+  calc_minimum_image(cell, future::Span(reduced));
+  for (int i = 0; i < deltas.size(); ++i) {
+    auto closest = cell.closest_image_to(XYZ(0, 0, 0), deltas[i]);
+    EXPECT_NEAR(reduced[i].len(), closest.distance, 1e-9);
+  }
+}
+
+TEST_F(PbcTests, wrap_and_unwrap) {
+  Frame frame;
+  test::add_polyglycines({{"A", 10}}, frame);
+  auto coords = frame.coords();
+  int i = 0;
+  for (auto& r : coords) {
+    r.set(XYZ(0.5 * i, 0.3 * i, -0.2 * i));
+    ++i;
+  }
+  std::vector<XYZ> original(coords.begin(), coords.end());
+
+  auto cell = triclinic_cell();
+  const double volume = cell[0].dot(cell[1].cross(cell[2]));
+  auto fractional = [&](const XYZ& r) {
+    return std::array<double, 3>{r.dot(cell[1].cross(cell[2])) / volume, r.dot(cell[2].cross(cell[0])) / volume,
+                                 r.dot(cell[0].cross(cell[1])) / volume};
+  };
+  wrap(cell, coords);
+  for (int k = 0; k < original.size(); ++k) {
+    const auto wrapped = fractional(coords[k]);
+    const auto unwrapped = fractional(original[k]);
+    for (int d = 0; d < 3; ++d) {
+      EXPECT_GE(wrapped[d], 0);
+      EXPECT_LT(wrapped[d], 1);
+      const double shift = wrapped[d] - unwrapped[d];
+      EXPECT_NEAR(shift, std::round(shift), 1e-9);
+    }
+  }
+
+  unwrap_sequential(cell, coords);
+  auto shift = original[0] - XYZ(coords[0]);
+  for (int k = 0; k < original.size(); ++k) {
+    EXPECT_NEAR((XYZ(coords[k]) + shift).distance(original[k]), 0, 1e-9);
+  }
+
+  wrap(cell, coords);
+  auto molecules = frame.molecules();
+  make_molecules_whole(cell, molecules);
+  shift = original[0] - XYZ(coords[0]);
+  for (int k = 0; k < original.size(); ++k) {
+    EXPECT_NEAR((XYZ(coords[k]) + shift).distance(original[k]), 0, 1e-9);
+  }
+
+  wrap(cell, coords);
+  std::vector<std::pair<int, int>> bonds;
+  for (int k = 1; k < original.size(); ++k) {
+    bonds.emplace_back(k, k - 1);
+  }
+  proxy::CoordSelection selection(coords);
+  unwrap_bonded(cell, selection, bonds);
+  shift = original[0] - XYZ(coords[0]);
+  for (int k = 0; k < original.size(); ++k) {
+    EXPECT_NEAR((XYZ(coords[k]) + shift).distance(original[k]), 0, 1e-9);
+  }
+}
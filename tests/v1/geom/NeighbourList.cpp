@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "xmol/geom/NeighbourList.h"
+#include <random>
+#include <set>
+
+using ::testing::Test;
+using namespace xmol::geom;
+using namespace xmol::future;
+
+class NeighbourListTests : public Test {
+public:
+  static std::vector<XYZ> random_coords(int n, double box, int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(0, box);
+    std::vector<XYZ> result;
+    for (int i = 0; i < n; ++i) {
+      result.emplace_back(dist(gen), dist(gen), dist(gen));
+    }
+    return result;
+  }
+
+  static std::set<NeighbourList::pair_t> brute_force(const std::vector<XYZ>& coords, double cutoff) {
+    std::set<NeighbourList::pair_t> result;
+    for (int i = 0; i < coords.size(); ++i) {
+      for (int j = i + 1; j < coords.size(); ++j) {
+        if (coords[i].distance2(coords[j]) < cutoff * cutoff) {
+          result.emplace(i, j);
+        }
+      }
+    }
+    return result;
+  }
+};
+
+TEST_F(NeighbourListTests, half_list_matches_brute_force) {
+  auto coords = random_coords(500, 20.0, 1);
+  NeighbourList list(3.0, 1.0);
+  EXPECT_TRUE(list.update(Span(coords)));
+  auto pairs = list.pairs_within_cutoff(Span(coords));
+  EXPECT_EQ(std::set<NeighbourList::pair_t>(pairs.begin(), pairs.end()), brute_force(coords, 3.0));
+  EXPECT_EQ(pairs.size(), brute_force(coords, 3.0).size());
+}
+
+TEST_F(NeighbourListTests, full_list_is_symmetric) {
+  auto coords = random_coords(200, 10.0, 2);
+  NeighbourList half(2.5, 0.5, NeighbourList::Mode::HALF);
+  NeighbourList full(2.5, 0.5, NeighbourList::Mode::FULL);
+  half.update(Span(coords));
+  full.update(Span(coords));
+  EXPECT_EQ(full.n_pairs(), 2 * half.n_pairs());
+  for (int i = 0; i < coords.size(); ++i) {
+    for (int j : full.neighbours(i)) {
+      EXPECT_NE(i, j);
+      auto nj = full.neighbours(j);
+      EXPECT_NE(std::find(nj.begin(), nj.end(), i), nj.end());
+    }
+  }
+}
+
+TEST_F(NeighbourListTests, skin_reuse) {
+  auto coords = random_coords(300, 15.0, 3);
+  NeighbourList list(3.0, 1.0);
+  EXPECT_TRUE(list.update(Span(coords)));
+  // every second point moves by 0.2 per step, so displacement exceeds skin / 2 = 0.5 on every third step
+  for (int step = 0; step < 10; ++step) {
+    for (size_t i = 0; i < coords.size(); i += 2) {
+      coords[i] += XYZ(0.2, 0, 0);
+    }
+    EXPECT_EQ(list.update(Span(coords)), step % 3 == 2) << "step " << step;
+    auto pairs = list.pairs_within_cutoff(Span(coords));
+    EXPECT_EQ(std::set<NeighbourList::pair_t>(pairs.begin(), pairs.end()), brute_force(coords, 3.0));
+  }
+  EXPECT_EQ(list.n_rebuilds(), 4);
+}
+
+TEST_F(NeighbourListTests, neighbours_before_update) {
+  NeighbourList list(3.0, 1.0);
+  EXPECT_EQ(list.size(), 0);
+  EXPECT_THROW((void)list.neighbours(0), GeomError);
+  auto coords = random_coords(10, 5.0, 5);
+  list.update(Span(coords));
+  EXPECT_NO_THROW((void)list.neighbours(9));
+  EXPECT_THROW((void)list.neighbours(10), GeomError);
+  EXPECT_THROW((void)list.neighbours(-1), GeomError);
+}
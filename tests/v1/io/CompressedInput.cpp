@@ -0,0 +1,293 @@
+#include <gtest/gtest.h>
+
+#include "xmol/Frame.h"
+#include "xmol/io/GromacsGroFile.h"
+#include "xmol/io/PdbInputFile.h"
+#include "xmol/io/TrjtoolDatFile.h"
+#include "xmol/proxy/spans.h"
+#include "xmol/trajectory/Trajectory.h"
+#include "xmol/utils/FileContent.h"
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <zlib.h>
+#ifdef XMOL_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+using ::testing::Test;
+using namespace xmol::io;
+using namespace xmol;
+
+class CompressedInputTests : public Test {
+public:
+  static constexpr const char* pdb = //
+      "MODEL        1\n"
+      "ATOM      1  N   GLY A   1      11.281  86.699  94.383  1.00 35.88           N\n"
+      "ATOM      2  CA  GLY A   1      -1.000   0.500  -0.250  1.00 35.88           C\n"
+      "ENDMDL\n"
+      "MODEL        2\n"
+      "ATOM      1  N   GLY A   1      21.281  96.699  04.383  1.00 35.88           N\n"
+      "ATOM      2  CA  GLY A   1      -2.000   1.500  -1.250  1.00 35.88           C\n"
+      "ENDMDL\n";
+
+  /// Single gzip member
+  static std::string gzip(const std::string& data, int window_bits = 16 + MAX_WBITS) {
+    z_stream stream{};
+    EXPECT_EQ(deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY), Z_OK);
+    std::string out(deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = data.size();
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = out.size();
+    EXPECT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+  }
+
+  /// BGZF file (as written by `bgzip`) with blocks of @p block_size bytes and trailing empty block
+  static std::string bgzf(const std::string& data, size_t block_size) {
+    auto le = [](std::string& out, uint32_t value, int n_bytes) {
+      for (int i = 0; i < n_bytes; ++i) {
+        out += char((value >> (8 * i)) & 0xFF);
+      }
+    };
+    std::string out;
+    for (size_t begin = 0; begin <= data.size(); begin += block_size) {
+      const std::string block = data.substr(begin, block_size);
+      const std::string deflated = gzip(block, -MAX_WBITS);
+      out += std::string("\x1f\x8b\x08\x04\0\0\0\0\0\xff\x06\0BC\x02\0", 16);
+      le(out, 18 + deflated.size() + 8 - 1, 2);
+      out += deflated;
+      le(out, crc32(0, reinterpret_cast<const Bytef*>(block.data()), block.size()), 4);
+      le(out, block.size(), 4);
+      if (block.empty()) {
+        break;
+      }
+    }
+    return out;
+  }
+
+#ifdef XMOL_WITH_ZSTD
+  /// zstd file of independent frames of @p frame_size bytes (as written by `zstd -T`), sizes stored in frame headers
+  static std::string zstd_frames(const std::string& data, size_t frame_size) {
+    std::string out;
+    for (size_t begin = 0; begin < data.size(); begin += frame_size) {
+      const std::string frame = data.substr(begin, frame_size);
+      std::string compressed(ZSTD_compressBound(frame.size()), '\0');
+      const size_t size = ZSTD_compress(compressed.data(), compressed.size(), frame.data(), frame.size(), 1);
+      EXPECT_FALSE(ZSTD_isError(size));
+      out += compressed.substr(0, size);
+    }
+    return out;
+  }
+
+  /// Single zstd frame without content size in header (as written by `zstd` reading from pipe)
+  static std::string zstd_without_size(const std::string& data) {
+    std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> context(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    EXPECT_FALSE(ZSTD_isError(ZSTD_CCtx_setParameter(context.get(), ZSTD_c_contentSizeFlag, 0)));
+    std::string out(ZSTD_compressBound(data.size()), '\0');
+    const size_t size = ZSTD_compress2(context.get(), out.data(), out.size(), data.data(), data.size());
+    EXPECT_FALSE(ZSTD_isError(size));
+    EXPECT_EQ(ZSTD_getFrameContentSize(out.data(), size), ZSTD_CONTENTSIZE_UNKNOWN);
+    out.resize(size);
+    return out;
+  }
+#endif
+
+  static std::string write_file(const std::string& name, const std::string& content) {
+    const std::string filename = ::testing::TempDir() + name;
+    std::ofstream(filename, std::ios::binary) << content;
+    return filename;
+  }
+
+  static std::string repeated_pdb(int n) {
+    std::string result;
+    for (int i = 0; i < n; ++i) {
+      result += pdb;
+    }
+    return result;
+  }
+};
+
+TEST_F(CompressedInputTests, file_content) {
+  const std::string data = repeated_pdb(1000);
+
+  utils::FileContent plain(write_file("content.pdb", data));
+  EXPECT_FALSE(plain.compressed());
+  EXPECT_EQ(plain.view(), data);
+
+  utils::FileContent gz(write_file("content.pdb.gz", gzip(data)));
+  EXPECT_TRUE(gz.compressed());
+  EXPECT_EQ(gz.view(), data);
+
+  utils::FileContent members(write_file("members.pdb.gz", gzip(data) + gzip(pdb)));
+  EXPECT_EQ(members.view(), data + pdb);
+
+  for (int n_threads : {1, 4}) {
+    utils::FileContent blocks(write_file("content.pdb.bgz", bgzf(data, 1000)), n_threads);
+    EXPECT_TRUE(blocks.compressed());
+    EXPECT_EQ(blocks.view(), data);
+  }
+
+  utils::FileContent empty(write_file("empty.pdb.gz", gzip("")));
+  EXPECT_TRUE(empty.view().empty());
+}
+
+TEST_F(CompressedInputTests, file_content_errors) {
+  const std::string data = repeated_pdb(100);
+  const std::string compressed = gzip(data);
+  EXPECT_THROW(utils::FileContent(write_file("truncated.pdb.gz", compressed.substr(0, compressed.size() / 2))),
+               std::runtime_error);
+
+  std::string corrupted = bgzf(data, 1000);
+  corrupted[100] ^= 0x55;
+  EXPECT_THROW(utils::FileContent(write_file("corrupted.pdb.bgz", corrupted)), std::runtime_error);
+  EXPECT_THROW(utils::FileContent("does_not_exist.gz"), std::runtime_error);
+}
+
+TEST_F(CompressedInputTests, file_content_stream) {
+  const std::string data = repeated_pdb(1000);
+  std::vector<std::string> filenames = {write_file("stream.pdb", data), write_file("stream.pdb.gz", gzip(data)),
+                                        write_file("stream.pdb.bgz", bgzf(data, 1000))};
+#ifdef XMOL_WITH_ZSTD
+  filenames.push_back(write_file("stream.pdb.zst", zstd_frames(data, 1000)));
+  filenames.push_back(write_file("stream-no-size.pdb.zst", zstd_without_size(data)));
+#endif
+  for (auto& filename : filenames) {
+    std::string streamed;
+    EXPECT_EQ(utils::FileContent::stream(filename,
+                                         [&](std::string_view chunk) {
+                                           streamed.append(chunk);
+                                           return true;
+                                         }),
+              data.size());
+    EXPECT_EQ(streamed, data);
+
+    int n_calls = 0;
+    EXPECT_EQ(utils::FileContent::stream(filename,
+                                         [&](std::string_view chunk) {
+                                           ++n_calls;
+                                           EXPECT_EQ(chunk.substr(0, 5), "MODEL");
+                                           return false;
+                                         }),
+              data.size());
+    EXPECT_EQ(n_calls, 1);
+
+    try {
+      utils::FileContent::stream(filename, [](std::string_view) -> bool { throw std::runtime_error("stop"); });
+      FAIL() << "exception expected";
+    } catch (std::runtime_error& e) {
+      EXPECT_STREQ(e.what(), "stop");
+    }
+  }
+
+  const std::string compressed = gzip(data);
+  EXPECT_THROW(utils::FileContent::stream(write_file("truncated.pdb.gz", compressed.substr(0, compressed.size() / 2)),
+                                          [](std::string_view) { return true; }),
+               std::runtime_error);
+}
+
+TEST_F(CompressedInputTests, pdb_file) {
+  const std::string data = repeated_pdb(1);
+  auto expected = PdbInputFile(write_file("models.pdb", data)).frames();
+  for (auto& filename : {write_file("models.pdb.gz", gzip(data)), write_file("models.pdb.bgz", bgzf(data, 100))}) {
+    auto frames = PdbInputFile(filename).frames();
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_TRUE(frames[1].coords()._eigen().isApprox(expected[1].coords()._eigen()));
+
+    trajectory::Trajectory traj(expected[0]);
+    traj.extend(PdbInputFile(filename, PdbInputFile::Dialect::STANDARD_V3, false));
+    std::vector<double> x;
+    for (auto& frame : traj) {
+      x.push_back(frame.atoms()[0].r().x());
+    }
+    EXPECT_EQ(x, std::vector<double>({11.281, 21.281}));
+  }
+  EXPECT_THROW(PdbInputFile(write_file("truncated.pdb.gz", gzip(data).substr(0, 20))), PdbReadError);
+}
+
+TEST_F(CompressedInputTests, gro_file) {
+  const std::string data = "title t= 1.0\n"
+                           "1\n"
+                           "    1ALA      N    1   0.100   0.200   0.300\n"
+                           "   1.00000   1.00000   1.00000\n";
+  auto frames = GromacsGroFile(write_file("frame.gro.gz", gzip(data))).frames();
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_DOUBLE_EQ(frames[0].atoms()[0].r().z(), 3.0);
+}
+
+TEST_F(CompressedInputTests, trjtool_dat_file) {
+  const int32_t n_atoms = 2;
+  const int32_t n_frames = 3;
+  std::string data;
+  auto append = [&](const auto& value) { data.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+  append(n_atoms);
+  append(int32_t(3));
+  append(int32_t(5));
+  for (int i = 0; i < n_atoms; ++i) {
+    append(int32_t(8));
+    data += "atominfo";
+  }
+  for (int f = 0; f < n_frames; ++f) {
+    for (int i = 0; i < n_atoms * 3; ++i) {
+      append(float(f * 10 + i));
+    }
+  }
+
+  Frame frame;
+  auto residue = frame.add_molecule().add_residue();
+  residue.add_atom();
+  residue.add_atom();
+
+  std::vector<std::string> filenames = {write_file("traj.dat", data), write_file("traj.dat.gz", gzip(data))};
+#ifdef XMOL_WITH_ZSTD
+  // frames are smaller than header, file size is found from frame headers
+  filenames.push_back(write_file("traj.dat.zst", zstd_frames(data, 16)));
+  filenames.push_back(write_file("traj-no-size.dat.zst", zstd_without_size(data)));
+#endif
+  for (auto& filename : filenames) {
+    TrjtoolDatFile file(filename);
+    EXPECT_EQ(file.n_frames(), n_frames);
+    EXPECT_EQ(file.n_atoms(), n_atoms);
+
+    trajectory::Trajectory traj(frame);
+    traj.extend(TrjtoolDatFile(filename));
+    std::vector<double> z;
+    for (auto& f : traj) {
+      z.push_back(f.atoms()[1].r().z());
+    }
+    EXPECT_EQ(z, std::vector<double>({5, 15, 25}));
+  }
+
+  EXPECT_THROW(TrjtoolDatFile(write_file("truncated.dat.gz", gzip(data.substr(0, 20)))), std::runtime_error);
+}
+
+TEST_F(CompressedInputTests, zstd) {
+  // single ATOM line compressed by `zstd -19`
+  const std::string compressed("\x28\xb5\x2f\xfd\x20\x4f\xbd\x01\x00\x52\xc4\x0b\x10\x90\x6d\x31\x2b\x6e\x1f\x50\x9f"
+                               "\x7d\xf6\x5b\x0e\xc5\x63\x56\x02\x40\xad\x7a\x24\x0f\xe1\xf0\x53\xf3\xc6\xfe\x6e\xb9"
+                               "\xa2\x8f\x2a\x0e\xf1\xff\xf1\x37\x37\x74\x7e\xf5\xf8\xff\x69\x31\x13\x01\x00\xc3\x06"
+                               "\xa2",
+                               64);
+  const std::string filename = write_file("atom.pdb.zst", compressed);
+#ifdef XMOL_WITH_ZSTD
+  auto frames = PdbInputFile(filename).frames();
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_DOUBLE_EQ(frames[0].atoms()[0].r().x(), 11.281);
+
+  const std::string data = repeated_pdb(1000);
+  for (int n_threads : {1, 4}) {
+    utils::FileContent multi_frame(write_file("frames.pdb.zst", zstd_frames(data, 1000)), n_threads);
+    EXPECT_TRUE(multi_frame.compressed());
+    EXPECT_EQ(multi_frame.view(), data);
+  }
+  utils::FileContent without_size(write_file("no-size.pdb.zst", zstd_without_size(data)));
+  EXPECT_EQ(without_size.view(), data);
+  EXPECT_EQ(PdbInputFile(write_file("no-size-models.pdb.zst", zstd_without_size(pdb))).frames().size(), 2);
+#else
+  EXPECT_THROW(PdbInputFile{filename}, PdbReadError);
+#endif
+}
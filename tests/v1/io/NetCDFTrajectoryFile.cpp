@@ -1,8 +1,13 @@
 #include <gtest/gtest.h>
 
+#include "xmol/geom/affine/Transformation3d.h"
 #include "xmol/io/AmberNetCDF.h"
+#include "xmol/io/AmberNetCDFWriter.h"
 #include "xmol/io/PdbInputFile.h"
+#include "xmol/proxy/spans.h"
 #include "xmol/trajectory/Trajectory.h"
+#include <csignal>
+#include <sys/resource.h>
 
 using ::testing::Test;
 using namespace xmol::io;
@@ -83,4 +88,152 @@ TEST_F(AmberNetCDFTrajectoryFileTests, trajectory) {
               << frame.cell.gamma().degrees() << std::endl;
     //    frame.to_pdb("frames/"+std::to_string(frame.index)+".pdb");
   }
-}
\ No newline at end of file
+}
+
+class AmberNetCDFWriterTests : public Test {
+public:
+  AmberNetCDFWriterTests() {
+    auto residue = frame.add_molecule().add_residue();
+    for (int i = 0; i < 5; ++i) {
+      residue.add_atom().r(XYZ(i, -i * 0.5, i * 1.25 + 0.001));
+    }
+    frame.cell = geom::UnitCell(30, 40, 50, geom::Degrees(80), geom::Degrees(90), geom::Degrees(100));
+  }
+
+  static std::string filename(const std::string& name) { return ::testing::TempDir() + name; }
+
+  /// Write frames shifted by `i` along x with time `10 * i`
+  void write(AmberNetCDFWriter& writer, int n_frames) {
+    for (int i = 0; i < n_frames; ++i) {
+      Frame copy = frame;
+      copy.time = 10 * i;
+      copy.coords().apply(geom::affine::Translation3d(XYZ(i, 0, 0)));
+      writer.write(copy);
+    }
+  }
+
+  void check(const std::string& filename, int n_frames) {
+    AmberNetCDF nc(filename);
+    ASSERT_TRUE(nc.has_cell());
+    ASSERT_EQ(nc.n_frames(), n_frames);
+    ASSERT_EQ(nc.n_atoms(), frame.n_atoms());
+
+    trajectory::Trajectory traj(frame);
+    traj.extend(AmberNetCDF(filename));
+    int i = 0;
+    for (auto& f : traj) {
+      EXPECT_FLOAT_EQ(f.time, 10 * i);
+      EXPECT_NEAR(f.cell.a(), 30, 1e-9);
+      EXPECT_NEAR(f.cell.gamma().degrees(), 100, 1e-9);
+      for (size_t j = 0; j < frame.n_atoms(); ++j) {
+        EXPECT_NEAR(f.coords()[j].distance(frame.coords()[j] + XYZ(i, 0, 0)), 0, 1e-5);
+      }
+      ++i;
+    }
+    EXPECT_EQ(i, n_frames);
+  }
+
+  Frame frame;
+};
+
+TEST_F(AmberNetCDFWriterTests, write_read) {
+  {
+    AmberNetCDFWriter writer(filename("classic.nc"), AmberNetCDFWriter::Format::CLASSIC_64BIT);
+    write(writer, 7);
+    EXPECT_EQ(writer.n_frames(), 7);
+  }
+  check(filename("classic.nc"), 7);
+
+  {
+    AmberNetCDFWriter writer(filename("per_frame.nc"), AmberNetCDFWriter::Format::NETCDF4, true, 1, 0, 0, 3);
+    write(writer, 7);
+  }
+  check(filename("per_frame.nc"), 7);
+
+  {
+    // time series layout, last chunk is partially filled
+    AmberNetCDFWriter writer(filename("per_atom.nc"), AmberNetCDFWriter::Format::NETCDF4, true, 4, 2, 6);
+    write(writer, 10);
+    writer.close();
+    writer.close();
+  }
+  check(filename("per_atom.nc"), 10);
+}
+
+TEST_F(AmberNetCDFWriterTests, no_cell) {
+  {
+    AmberNetCDFWriter writer(filename("no_cell.nc"), AmberNetCDFWriter::Format::NETCDF4, false);
+    write(writer, 2);
+  }
+  AmberNetCDF nc(filename("no_cell.nc"));
+  EXPECT_FALSE(nc.has_cell());
+  EXPECT_EQ(nc.n_frames(), 2);
+}
+
+TEST_F(AmberNetCDFWriterTests, no_box) {
+  Frame no_box = frame;
+  no_box.cell = geom::UnitCell::unit_cubic_cell();
+  {
+    AmberNetCDFWriter writer(filename("no_box.nc"));
+    writer.write(no_box);
+    writer.write(no_box);
+  }
+  AmberNetCDF nc(filename("no_box.nc"));
+  EXPECT_FALSE(nc.has_cell());
+  EXPECT_EQ(nc.n_frames(), 2);
+
+  AmberNetCDFWriter writer(filename("box_then_no_box.nc"));
+  writer.write(frame);
+  EXPECT_THROW(writer.write(no_box), AmberNetCDFWriteError);
+  EXPECT_EQ(writer.n_frames(), 1);
+}
+
+TEST_F(AmberNetCDFWriterTests, errors) {
+  using Format = AmberNetCDFWriter::Format;
+  EXPECT_THROW(AmberNetCDFWriter("/does_not_exist/file.nc"), AmberNetCDFWriteError);
+  EXPECT_THROW(AmberNetCDFWriter(filename("error.nc"), Format::NETCDF4, true, 1, 0, 10), AmberNetCDFWriteError);
+  EXPECT_THROW(AmberNetCDFWriter(filename("error.nc"), Format::NETCDF4, true, 0), AmberNetCDFWriteError);
+  EXPECT_THROW(AmberNetCDFWriter(filename("error.nc"), Format::CLASSIC_64BIT, true, 1, 0, 1), AmberNetCDFWriteError);
+
+  AmberNetCDFWriter writer(filename("error.nc"));
+  writer.write(frame);
+  Frame other = frame;
+  other.molecules()[0].residues()[0].add_atom();
+  EXPECT_THROW(writer.write(other), AmberNetCDFWriteError);
+  writer.close();
+  EXPECT_THROW(writer.write(frame), AmberNetCDFWriteError);
+}
+
+TEST_F(AmberNetCDFWriterTests, no_frames) {
+  // layout is defined by first frame, file without frames has no `frame`, `atom` and `coordinates`
+  using Format = AmberNetCDFWriter::Format;
+  for (auto format : {Format::NETCDF4, Format::CLASSIC_64BIT}) {
+    AmberNetCDFWriter(filename("no_frames.nc"), format).close();
+    EXPECT_THROW(AmberNetCDF{filename("no_frames.nc")}, std::runtime_error);
+  }
+}
+
+TEST_F(AmberNetCDFWriterTests, write_failure) {
+  Frame large;
+  auto residue = large.add_molecule().add_residue();
+  for (int i = 0; i < 10000; ++i) {
+    residue.add_atom();
+  }
+  AmberNetCDFWriter writer(filename("failure.nc"), AmberNetCDFWriter::Format::CLASSIC_64BIT, true, 1, 0, 0, 2);
+  writer.write(large);
+
+  // file size limit makes next writes fail as on full disk
+  rlimit limit{};
+  ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &limit), 0);
+  const rlimit small_limit{64 * 1024, limit.rlim_max};
+  const auto old_handler = std::signal(SIGXFSZ, SIG_IGN);
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &small_limit), 0);
+  EXPECT_THROW(writer.write(large), AmberNetCDFWriteError);
+  // buffer of failed flush is still full, writer must refuse next frames
+  EXPECT_THROW(writer.write(large), AmberNetCDFWriteError);
+  EXPECT_THROW(writer.flush(), AmberNetCDFWriteError);
+  setrlimit(RLIMIT_FSIZE, &limit);
+  std::signal(SIGXFSZ, old_handler);
+  EXPECT_NO_THROW(writer.close());
+  EXPECT_THROW(writer.write(large), AmberNetCDFWriteError);
+}
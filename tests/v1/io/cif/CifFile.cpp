@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+
+#include "xmol/io/CifInputFile.h"
+#include "xmol/proxy/spans.h"
+#include "xmol/trajectory/Trajectory.h"
+#include <clocale>
+#include <fstream>
+
+using ::testing::Test;
+using namespace xmol::io::cif;
+using namespace xmol::io;
+using namespace xmol;
+
+class CifFileTests : public Test {
+public:
+  static constexpr const char* two_models = R"(data_TEST
+#
+_cell.entry_id    TEST
+_cell.length_a    40.000
+_cell.length_b    50.000
+_cell.length_c    60.000
+_cell.angle_alpha 90.00
+_cell.angle_beta  90.00
+_cell.angle_gamma 120.00
+#
+loop_
+_struct_keywords.entry_id
+_struct_keywords.text
+TEST
+;multi-line text
+_atom_site.fake tag inside text field
+;
+TEST 'quoted value with loop_ inside'
+#
+loop_
+_atom_site.group_PDB
+_atom_site.id
+_atom_site.type_symbol
+_atom_site.label_atom_id
+_atom_site.label_alt_id
+_atom_site.label_comp_id
+_atom_site.label_asym_id
+_atom_site.label_seq_id
+_atom_site.pdbx_PDB_ins_code
+_atom_site.Cartn_x
+_atom_site.Cartn_y
+_atom_site.Cartn_z
+_atom_site.occupancy
+_atom_site.auth_seq_id
+_atom_site.auth_asym_id
+_atom_site.pdbx_PDB_model_num
+ATOM   1 N N     . ALA A 1 ? 1.000 2.000 3.000 1.00 10 AAAA 1
+ATOM   2 C CA    . ALA A 1 ? 1.500 2.500 3.500 1.00 10 AAAA 1
+ATOM   3 C C     . GLY A 2 A -1.25 0.5e1 7     1.00 10 AAAA 1
+ATOM   4 O "O5'" . GLY A 2 A 0.000 0.000 0.000 1.00
+10 AAAA 1
+HETATM 5 O O     . HOH B . ? 9.000 9.000 9.000 1.00 101 AAAA 1
+HETATM 6 O O     . HOH B . ? 8.000 8.000 8.000 1.00 102 AAAA 1
+ATOM   7 N N     . ALA C 1 ? 5.000 5.000 5.000 1.00 1 B 1
+ATOM   1 N N     . ALA A 1 ? 2.000 2.000 3.000 1.00 10 AAAA 2
+ATOM   2 C CA    . ALA A 1 ? 2.500 2.500 3.500 1.00 10 AAAA 2
+ATOM   3 C C     . GLY A 2 A -2.25 0.5e1 7     1.00 10 AAAA 2
+ATOM   4 O "O5'" . GLY A 2 A 1.000 0.000 0.000 1.00 10 AAAA 2
+HETATM 5 O O     . HOH B . ? 9.000 9.000 9.000 1.00 101 AAAA 2
+HETATM 6 O O     . HOH B . ? 8.000 8.000 8.000 1.00 102 AAAA 2
+ATOM   7 N N     . ALA C 1 ? 6.000 5.000 5.000 1.00 1 B 2
+#
+loop_
+_atom_type.symbol
+C
+N
+O
+#
+data_SECOND
+loop_
+_atom_site.id
+1
+)";
+
+  static std::string write_file(const std::string& name, const std::string& content) {
+    const std::string filename = ::testing::TempDir() + name;
+    std::ofstream(filename) << content;
+    return filename;
+  }
+
+  static std::string atom_site(const std::string& rows) {
+    return "data_X\nloop_\n_atom_site.id\n_atom_site.label_atom_id\n_atom_site.label_comp_id\n"
+           "_atom_site.label_asym_id\n_atom_site.label_seq_id\n"
+           "_atom_site.Cartn_x\n_atom_site.Cartn_y\n_atom_site.Cartn_z\n" +
+           rows;
+  }
+};
+
+TEST_F(CifFileTests, read_models) {
+  CifBufferReader reader(two_models);
+  ASSERT_EQ(reader.models().size(), 2);
+  EXPECT_EQ(reader.models()[0].n_atoms, 7);
+  EXPECT_EQ(reader.models()[0].n_residues, 5);
+  EXPECT_EQ(reader.models()[0].n_molecules, 3);
+
+  auto frames = reader.read_frames(2);
+  ASSERT_EQ(frames.size(), 2);
+  auto& frame = frames[0];
+
+  EXPECT_DOUBLE_EQ(frame.cell.a(), 40);
+  EXPECT_DOUBLE_EQ(frame.cell.c(), 60);
+  EXPECT_DOUBLE_EQ(frame.cell.gamma().degrees(), 120);
+
+  ASSERT_EQ(frame.n_molecules(), 3);
+  ASSERT_EQ(frame.n_residues(), 5);
+  ASSERT_EQ(frame.n_atoms(), 7);
+
+  auto molecules = frame.molecules();
+  EXPECT_EQ(molecules[0].name(), MoleculeName("AAAA"));
+  EXPECT_EQ(molecules[1].name(), MoleculeName("AAAA")); // waters of same chain, but other entity instance
+  EXPECT_EQ(molecules[2].name(), MoleculeName("B"));
+  EXPECT_EQ(molecules[0].size(), 2);
+  EXPECT_EQ(molecules[1].size(), 2);
+
+  auto residues = frame.residues();
+  EXPECT_EQ(residues[0].name(), ResidueName("ALA"));
+  EXPECT_EQ(residues[1].name(), ResidueName("GLY"));
+  EXPECT_EQ(residues[1].id(), ResidueId(10, ResidueInsertionCode("A")));
+  EXPECT_EQ(residues[2].id(), ResidueId(101));
+  EXPECT_EQ(residues[3].id(), ResidueId(102));
+
+  auto atoms = frame.atoms();
+  EXPECT_EQ(atoms[1].name(), AtomName("CA"));
+  EXPECT_EQ(atoms[3].name(), AtomName("O5'"));
+  EXPECT_EQ(atoms[6].id(), 7);
+  EXPECT_DOUBLE_EQ(atoms[1].r().x(), 1.5);
+  EXPECT_DOUBLE_EQ(atoms[2].r().x(), -1.25);
+  EXPECT_DOUBLE_EQ(atoms[2].r().y(), 5);
+  EXPECT_DOUBLE_EQ(atoms[2].r().z(), 7);
+
+  EXPECT_DOUBLE_EQ(frames[1].atoms()[0].r().x(), 2);
+  EXPECT_DOUBLE_EQ(frames[1].atoms()[6].r().x(), 6);
+}
+
+TEST_F(CifFileTests, streaming_input_file) {
+  auto filename = write_file("cif_file_test.cif", two_models);
+  CifInputFile file(filename, false);
+  EXPECT_TRUE(file.frames().empty());
+  ASSERT_EQ(file.n_frames(), 2);
+  ASSERT_EQ(file.n_atoms(), 7);
+
+  auto frame = CifInputFile(filename).frames()[0];
+  trajectory::Trajectory traj(frame);
+  traj.extend(CifInputFile(filename, false));
+  traj.extend(CifInputFile(filename, true));
+  std::vector<double> x;
+  for (auto& f : traj) {
+    x.push_back(f.atoms()[0].r().x());
+    EXPECT_DOUBLE_EQ(f.cell.b(), 50);
+  }
+  EXPECT_EQ(x, std::vector<double>({1, 2, 1, 2}));
+}
+
+TEST_F(CifFileTests, read_values) {
+  // five-character chemical component id, numbers in exponent form and with standard uncertainty
+  auto frames =
+      CifBufferReader(atom_site("1 C1 A1AAB A 1 1.5e1 -2E-1 3.25(4)\n2 C2 A1AAB A 1 7 .5 -0.0\n3 C3 A1AAB A 1 12. 0 0\n"))
+          .read_frames();
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0].residues()[0].name(), ResidueName("A1AAB"));
+  auto atoms = frames[0].atoms();
+  EXPECT_DOUBLE_EQ(atoms[0].r().x(), 15);
+  EXPECT_DOUBLE_EQ(atoms[0].r().y(), -0.2);
+  EXPECT_DOUBLE_EQ(atoms[0].r().z(), 3.25);
+  EXPECT_DOUBLE_EQ(atoms[1].r().x(), 7);
+  EXPECT_DOUBLE_EQ(atoms[1].r().y(), 0.5);
+  EXPECT_DOUBLE_EQ(atoms[2].r().x(), 12);
+
+  // decimal point doesn't depend on global locale
+  const std::string old_locale = std::setlocale(LC_NUMERIC, nullptr);
+  if (std::setlocale(LC_NUMERIC, "de_DE.UTF-8")) {
+    auto frame = CifBufferReader(atom_site("1 C1 ALA A 1 1.5e1 2 3\n")).read_frames()[0];
+    std::setlocale(LC_NUMERIC, old_locale.c_str());
+    EXPECT_DOUBLE_EQ(frame.atoms()[0].r().x(), 15);
+  }
+}
+
+TEST_F(CifFileTests, read_errors) {
+  EXPECT_THROW(CifInputFile("does_not_exist.cif"), CifReadError);
+  EXPECT_EQ(CifBufferReader("").models().size(), 0);
+  EXPECT_EQ(CifBufferReader("data_X\n_entry.id X\n").models().size(), 0);
+
+  // incomplete row
+  EXPECT_THROW(CifBufferReader(atom_site("1 N ALA A 1 0.0 0.0 0.0\n2 CA ALA A 1 0.0 0.0\n")), CifReadError);
+  // missing coordinates
+  EXPECT_THROW(CifBufferReader("data_X\nloop_\n_atom_site.id\n_atom_site.label_atom_id\n1 N\n"), CifReadError);
+  // residue name is too long
+  try {
+    (void)CifBufferReader(atom_site("1 N ALAAAA A 1 0.0 0.0 0.0\n")).read_frames();
+    FAIL();
+  } catch (CifReadError& e) {
+    EXPECT_NE(std::string(e.what()).find("`ALAAAA`"), std::string::npos) << e.what();
+  }
+  // bad number
+  EXPECT_THROW(CifBufferReader(atom_site("1 N ALA A 1 0.0 x 0.0\n")).read_frames(), CifReadError);
+  // unterminated quote
+  EXPECT_THROW(CifBufferReader(atom_site("1 'N ALA A 1 0.0 0.0 0.0\n")), CifReadError);
+
+  try {
+    (void)CifBufferReader(atom_site("1 N ALA A 1 0.0 0.0 0.0\n2 CA ALA A 1 0.0 0.0 ?\n")).read_frames();
+    FAIL();
+  } catch (CifReadError& e) {
+    EXPECT_NE(std::string(e.what()).find("line 12"), std::string::npos) << e.what();
+  }
+
+  CifBufferReader reader(atom_site("1 N ALA A 1 0.0 0.0 0.0\n2 CA ALA A 1 0.0 0.0 0.0\n"));
+  auto frame = reader.read_model(reader.models()[0]);
+  CifBufferReader other(atom_site("1 N ALA A 1 0.0 0.0 0.0\n2 CB ALA A 1 0.0 0.0 0.0\n"));
+  EXPECT_THROW(other.read_model_coords(other.models()[0], frame), CifReadError);
+  CifBufferReader shorter(atom_site("1 N ALA A 1 0.0 0.0 0.0\n"));
+  EXPECT_THROW(shorter.read_model_coords(shorter.models()[0], frame), CifReadError);
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+
+#include "xmol/io/GromacsGroFile.h"
+#include "xmol/geom/affine/Transformation3d.h"
+#include "xmol/io/gro/GroWriter.h"
+#include "xmol/proxy/spans.h"
+#include "xmol/trajectory/Trajectory.h"
+#include <fstream>
+#include <sstream>
+
+using ::testing::Test;
+using namespace xmol::io::gro;
+using namespace xmol::io;
+using namespace xmol;
+
+class GromacsGroFileTests : public Test {
+public:
+  static constexpr const char* two_frames = "Protein in water t=   10.00000 step= 5000\n"
+                                            "    7\n"
+                                            "    1ALA      N    1   0.100   0.200   0.300  0.1000  0.2000  0.3000\n"
+                                            "    1ALA     CA    2   0.150  -0.250   1.350\n"
+                                            "    2DPPC    C1    3   1.000   2.000   3.000\n"
+                                            "    1GLY      N    4   4.000   5.000   6.000\n"
+                                            "99999SOL     OW    5   0.000   0.000   0.000\n"
+                                            "    0SOL     OW99999   0.000   0.000   0.000\n"
+                                            "    0SOL    HW1    7   0.000   0.000   0.000\n"
+                                            "   5.00000   6.00000   7.00000\n"
+                                            "Protein in water t=   20.00000 step= 10000\n"
+                                            "    7\n"
+                                            "    1ALA      N    1   1.100   0.200   0.300\n"
+                                            "    1ALA     CA    2   0.150  -0.250   1.350\n"
+                                            "    2DPPC    C1    3   1.000   2.000   3.000\n"
+                                            "    1GLY      N    4   4.000   5.000   6.000\n"
+                                            "99999SOL     OW    5   0.000   0.000   0.000\n"
+                                            "    0SOL     OW99999   0.000   0.000   0.000\n"
+                                            "    0SOL    HW1    7   0.000   0.000   0.000\n"
+                                            "   5.00000   6.00000   7.00000   0.00000   0.00000   1.00000   0.00000   "
+                                            "2.00000   3.00000\n";
+
+  static std::string write_file(const std::string& name, const std::string& content) {
+    const std::string filename = ::testing::TempDir() + name;
+    std::ofstream(filename) << content;
+    return filename;
+  }
+
+  static std::string read_file(const std::string& filename) {
+    std::ifstream in(filename);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+};
+
+TEST_F(GromacsGroFileTests, read_frames) {
+  GroBufferReader reader(two_frames);
+  auto frames = reader.read_frames();
+  ASSERT_EQ(frames.size(), 2);
+  auto& frame = frames[0];
+
+  ASSERT_EQ(frame.n_atoms(), 7);
+  ASSERT_EQ(frame.n_residues(), 5);
+  ASSERT_EQ(frame.n_molecules(), 2); // residue serial decreases from 2 to 1, but not from 99999 to 0
+  EXPECT_DOUBLE_EQ(frame.time, 10);
+  EXPECT_DOUBLE_EQ(frames[1].time, 20);
+
+  auto residues = frame.residues();
+  EXPECT_EQ(residues[0].name(), ResidueName("ALA"));
+  EXPECT_EQ(residues[1].name(), ResidueName("DPPC"));
+  EXPECT_EQ(residues[3].id(), ResidueId(99999));
+  EXPECT_EQ(residues[4].id(), ResidueId(0));
+  EXPECT_EQ(residues[4].size(), 2);
+  EXPECT_EQ(frame.molecules()[1].size(), 3);
+
+  auto atoms = frame.atoms();
+  EXPECT_EQ(atoms[1].name(), AtomName("CA"));
+  EXPECT_EQ(atoms[5].id(), 99999);
+  EXPECT_DOUBLE_EQ(atoms[0].r().x(), 1.0);
+  EXPECT_DOUBLE_EQ(atoms[1].r().y(), -2.5);
+  EXPECT_DOUBLE_EQ(atoms[1].r().z(), 13.5);
+  EXPECT_DOUBLE_EQ(frames[1].atoms()[0].r().x(), 11.0);
+
+  EXPECT_DOUBLE_EQ(frame.cell.a(), 50);
+  EXPECT_DOUBLE_EQ(frame.cell.b(), 60);
+  EXPECT_DOUBLE_EQ(frame.cell.c(), 70);
+  EXPECT_DOUBLE_EQ(frames[1].cell[1].x(), 10);
+  EXPECT_DOUBLE_EQ(frames[1].cell[2].x(), 20);
+  EXPECT_DOUBLE_EQ(frames[1].cell[2].y(), 30);
+}
+
+TEST_F(GromacsGroFileTests, read_high_precision) {
+  GroBufferReader reader("title\n"
+                         "1\n"
+                         "    1ALA      N    1   0.10000   0.20000  -0.30001\n"
+                         "   0.00000   0.00000   0.00000\n");
+  auto frames = reader.read_frames();
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_DOUBLE_EQ(frames[0].atoms()[0].r().z(), -3.0001);
+  EXPECT_DOUBLE_EQ(frames[0].cell.volume(), 1); // no box
+}
+
+TEST_F(GromacsGroFileTests, write_read) {
+  auto frame = GroBufferReader(two_frames).read_frames()[1];
+  const std::string filename = ::testing::TempDir() + "gro_writer_test.gro";
+  {
+    GroWriter writer(filename);
+    writer.write(frame, "Protein in water");
+    frame.time = 30;
+    frame.coords().apply(geom::affine::Translation3d(XYZ(1, 0, 0)));
+    writer.write(frame, "Protein in water");
+  }
+  auto content = read_file(filename);
+  EXPECT_EQ(content.substr(0, content.find("    1ALA     CA")),
+            "Protein in water t= 20.00000\n"
+            "7\n"
+            "    1ALA      N    1   1.100   0.200   0.300\n");
+  EXPECT_NE(content.find("99999SOL     OW    5"), std::string::npos);
+  EXPECT_NE(content.find("    0SOL     OW99999"), std::string::npos);
+  EXPECT_NE(content.find("   5.00000   6.00000   7.00000   0.00000   0.00000   1.00000   0.00000   "
+                         "2.00000   3.00000\n"),
+            std::string::npos);
+
+  auto written = GromacsGroFile(filename).frames();
+  ASSERT_EQ(written.size(), 2);
+  EXPECT_DOUBLE_EQ(written[1].time, 30);
+  ASSERT_EQ(written[0].n_atoms(), frame.n_atoms());
+  ASSERT_EQ(written[0].n_residues(), frame.n_residues());
+  for (size_t i = 0; i < frame.n_atoms(); ++i) {
+    EXPECT_EQ(written[1].atoms()[i].name(), frame.atoms()[i].name());
+    EXPECT_EQ(written[1].atoms()[i].residue().name(), frame.atoms()[i].residue().name());
+    EXPECT_NEAR(written[1].atoms()[i].r().distance(frame.atoms()[i].r()), 0, 1e-9);
+  }
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_NEAR(written[0].cell[i].distance(frame.cell[i]), 0, 1e-9);
+  }
+}
+
+TEST_F(GromacsGroFileTests, write_read_no_box) {
+  auto frame = GroBufferReader("title\n"
+                               "1\n"
+                               "    1ALA      N    1   0.100   0.200   0.300\n"
+                               "   0.00000   0.00000   0.00000\n")
+                   .read_frames()[0];
+  ASSERT_DOUBLE_EQ(frame.cell.volume(), 1);
+  const std::string filename = ::testing::TempDir() + "gro_writer_no_box_test.gro";
+  {
+    GroWriter writer(filename);
+    writer.write(frame, "title");
+  }
+  auto content = read_file(filename);
+  EXPECT_EQ(content.substr(content.rfind('\n', content.size() - 2) + 1), "   0.00000   0.00000   0.00000\n");
+  auto written = GromacsGroFile(filename).frames();
+  ASSERT_EQ(written.size(), 1);
+  EXPECT_DOUBLE_EQ(written[0].cell.volume(), 1);
+  EXPECT_DOUBLE_EQ(written[0].atoms()[0].r().z(), 3);
+}
+
+TEST_F(GromacsGroFileTests, write_overflow_leaves_file_intact) {
+  auto frame = GroBufferReader(two_frames).read_frames()[0];
+  const std::string filename = ::testing::TempDir() + "gro_writer_overflow_test.gro";
+  {
+    GroWriter writer(filename);
+    writer.write(frame);
+  }
+  const std::string single_frame = read_file(filename);
+  {
+    GroWriter writer(filename);
+    writer.write(frame);
+    const XYZ last_atom = frame.atoms()[frame.n_atoms() - 1].r();
+    frame.atoms()[frame.n_atoms() - 1].r(last_atom + XYZ(1e6, 0, 0));
+    EXPECT_THROW(writer.write(frame), GroWriteError);
+    frame.atoms()[frame.n_atoms() - 1].r(last_atom);
+    writer.write(frame);
+  }
+  EXPECT_EQ(read_file(filename), single_frame + single_frame);
+  EXPECT_EQ(GromacsGroFile(filename).frames().size(), 2);
+}
+
+TEST_F(GromacsGroFileTests, streaming_input_file) {
+  auto filename = write_file("gro_file_test.gro", two_frames);
+  GromacsGroFile file(filename, false);
+  EXPECT_TRUE(file.frames().empty());
+  ASSERT_EQ(file.n_frames(), 2);
+  ASSERT_EQ(file.n_atoms(), 7);
+
+  trajectory::Trajectory traj(GromacsGroFile(filename).frames()[0]);
+  traj.extend(GromacsGroFile(filename, false));
+  traj.extend(GromacsGroFile(filename, true));
+  std::vector<double> x;
+  for (auto& f : traj) {
+    x.push_back(f.atoms()[0].r().x());
+  }
+  EXPECT_EQ(x, std::vector<double>({1, 11, 1, 11}));
+}
+
+TEST_F(GromacsGroFileTests, errors) {
+  EXPECT_THROW(GromacsGroFile("does_not_exist.gro"), GroReadError);
+  EXPECT_THROW(GroWriter("/does_not_exist/file.gro"), GroWriteError);
+  EXPECT_EQ(GroBufferReader("").find_blocks().size(), 0);
+  EXPECT_EQ(GroBufferReader("\n\n").find_blocks().size(), 0);
+
+  // missing atoms
+  EXPECT_THROW((void)GroBufferReader("title\n2\n    1ALA      N    1   0.100   0.200   0.300\n").find_blocks(),
+               GroReadError);
+  // bad number of atoms
+  EXPECT_THROW((void)GroBufferReader("title\nx\n").find_blocks(), GroReadError);
+  // bad box
+  EXPECT_THROW((void)GroBufferReader("title\n0\n1.0 2.0\n").find_blocks(), GroReadError);
+  // short line
+  EXPECT_THROW((void)GroBufferReader("title\n1\n    1ALA      N    1   0.100   0.200\n1 1 1\n").read_frames(),
+               GroReadError);
+  // bad coordinate
+  EXPECT_THROW((void)GroBufferReader("title\n1\n    1ALA      N    1   0.100   x.200   0.300\n1 1 1\n").read_frames(),
+               GroReadError);
+
+  auto frame = GroBufferReader(two_frames).read_frames()[0];
+  GroBufferReader other("title\n1\n    1ALA      N    1   0.100   0.200   0.300\n1 1 1\n");
+  EXPECT_THROW(other.read_block_coords(other.find_blocks()[0], frame), GroReadError);
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+
+#include "xmol/io/PdbInputFile.h"
+#include "xmol/io/pdb/PdbBufferReader.h"
+#include "xmol/io/pdb/PdbReader.h"
+#include "xmol/io/pdb/exceptions.h"
+#include "xmol/trajectory/Trajectory.h"
+#include <fstream>
+#include <sstream>
+
+using ::testing::Test;
+using namespace xmol::io::pdb;
+using namespace xmol::io;
+using namespace xmol;
+
+class PdbBufferReaderTests : public Test {
+public:
+  static constexpr const char* ensemble = //
+      "HEADER    TEST\n"
+      "CRYST1   30.000   40.000   50.000  90.00  90.00 120.00 P 1           1\n"
+      "MODEL        1\n"
+      "ATOM      1  N   GLY A   1      11.281  86.699  94.383  1.00 35.88           N\n"
+      "ATOM      2  CA  GLY A   1      -1.000   0.500  -0.250  1.00 35.88           C\n"
+      "ANISOU    2  CA  GLY A   1     2406   1892   1614    198    519   -328       C\n"
+      "ATOM      3  N   ARG A  -3Z     12.000  13.000  14.000  0.50 35.88           N\n"
+      "ATOM      4  N   ARG A  -3      15.000  16.000  17.000  0.50 35.88           N\n"
+      "TER       5      ARG A  -3\n"
+      "ATOM      6  N   ALA A   5       1.000   2.000   3.000  1.00  0.00           N\n"
+      "ATOM      7  N   ALA B   5       4.000   5.000   6.000  1.00  0.00           N\n"
+      "HETATM    8  O   HOH B 101       7.123   8.456   9.789  1.00  0.00           O\n"
+      "ENDMDL\n"
+      "MODEL        2\n"
+      "ATOM      1  N   GLY A   1      21.281  96.699  04.383  1.00 35.88           N\n"
+      "ATOM      2  CA  GLY A   1      -2.000   1.500  -1.250  1.00 35.88           C\n"
+      "ANISOU    2  CA  GLY A   1     2406   1892   1614    198    519   -328       C\n"
+      "ATOM      3  N   ARG A  -3Z     22.000  23.000  24.000  0.50 35.88           N\n"
+      "ATOM      4  N   ARG A  -3      25.000  26.000  27.000  0.50 35.88           N\n"
+      "TER       5      ARG A  -3\n"
+      "ATOM      6  N   ALA A   5      11.000  12.000  13.000  1.00  0.00           N\n"
+      "ATOM      7  N   ALA B   5      14.000  15.000  16.000  1.00  0.00           N\n"
+      "HETATM    8  O   HOH B 101      17.123  18.456  19.789  1.00  0.00           O\n"
+      "ENDMDL\n"
+      "END\n";
+
+  /// Ensemble of models with increasing number of atoms
+  static std::string make_ensemble(int n_models, bool same_atoms = false) {
+    std::string text;
+    char line[128];
+    for (int model = 0; model < n_models; ++model) {
+      if (model % 10 == 0) {
+        std::snprintf(line, sizeof(line), "CRYST1%9.3f%9.3f%9.3f  90.00  90.00  90.00 P 1           1\n", 10.0 + model,
+                      20.0, 30.0);
+        text += line;
+      }
+      std::snprintf(line, sizeof(line), "MODEL     %4d\n", model + 1);
+      text += line;
+      for (int i = 0; i < 100 + (same_atoms ? 0 : model); ++i) {
+        std::snprintf(line, sizeof(line), "ATOM  %5d  CA  GLY %c%4d    %8.3f%8.3f%8.3f  1.00  0.00           C\n", i + 1,
+                      'A' + i / 50, i / 3, model + i * 0.125, -i * 0.5, 0.001 * i);
+        text += line;
+      }
+      text += "ENDMDL\n";
+    }
+    return text;
+  }
+
+  static void expect_same(Frame& expected, Frame& actual) {
+    ASSERT_EQ(expected.n_molecules(), actual.n_molecules());
+    ASSERT_EQ(expected.n_residues(), actual.n_residues());
+    ASSERT_EQ(expected.n_atoms(), actual.n_atoms());
+    for (size_t i = 0; i < expected.n_molecules(); ++i) {
+      EXPECT_EQ(expected.molecules()[i].name(), actual.molecules()[i].name());
+      EXPECT_EQ(expected.molecules()[i].size(), actual.molecules()[i].size());
+    }
+    for (size_t i = 0; i < expected.n_residues(); ++i) {
+      EXPECT_EQ(expected.residues()[i].name(), actual.residues()[i].name());
+      EXPECT_EQ(expected.residues()[i].id(), actual.residues()[i].id());
+      EXPECT_EQ(expected.residues()[i].size(), actual.residues()[i].size());
+    }
+    for (size_t i = 0; i < expected.n_atoms(); ++i) {
+      EXPECT_EQ(expected.atoms()[i].name(), actual.atoms()[i].name());
+      EXPECT_EQ(expected.atoms()[i].id(), actual.atoms()[i].id());
+      EXPECT_EQ(expected.atoms()[i].r().x(), actual.atoms()[i].r().x());
+      EXPECT_EQ(expected.atoms()[i].r().y(), actual.atoms()[i].r().y());
+      EXPECT_EQ(expected.atoms()[i].r().z(), actual.atoms()[i].r().z());
+    }
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(expected.cell[i].x(), actual.cell[i].x());
+      EXPECT_EQ(expected.cell[i].y(), actual.cell[i].y());
+      EXPECT_EQ(expected.cell[i].z(), actual.cell[i].z());
+    }
+  }
+};
+
+TEST_F(PdbBufferReaderTests, matches_stream_reader) {
+  std::stringstream ss(ensemble);
+  auto expected = PdbReader(ss).read_frames();
+  auto actual = PdbBufferReader(ensemble).read_frames();
+
+  ASSERT_EQ(expected.size(), 2);
+  ASSERT_EQ(actual.size(), 2);
+  EXPECT_EQ(actual[0].n_molecules(), 3);
+  EXPECT_EQ(actual[0].n_residues(), 6);
+  EXPECT_EQ(actual[0].n_atoms(), 7);
+  EXPECT_DOUBLE_EQ(actual[1].cell.c(), 50.0);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    expect_same(expected[i], actual[i]);
+  }
+}
+
+TEST_F(PdbBufferReaderTests, parallel_models) {
+  auto text = make_ensemble(40);
+  std::stringstream ss(text);
+  auto expected = PdbReader(ss).read_frames();
+  auto serial = PdbBufferReader(text).read_frames(1);
+  auto parallel = PdbBufferReader(text).read_frames(4);
+  ASSERT_EQ(expected.size(), 40);
+  ASSERT_EQ(serial.size(), 40);
+  ASSERT_EQ(parallel.size(), 40);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(parallel[i].n_atoms(), 100 + i);
+    expect_same(expected[i], serial[i]);
+    expect_same(expected[i], parallel[i]);
+  }
+
+  auto broken = text;
+  broken[broken.rfind("GLY") + 16] = 'x'; // x coordinate of last atom
+  EXPECT_THROW(PdbBufferReader(broken).read_frames(4), PdbException);
+}
+
+TEST_F(PdbBufferReaderTests, frame_without_model_records) {
+  std::string text = "ATOM      1  N   GLY A   1      11.281  86.699  94.383  1.00 35.88           N\r\n"
+                     "ATOM      2  CA  GLY A   1      -1.000   0.500  -0.250  1.00 35.88           C\r\n"
+                     "TER\r\n"
+                     "HETATM    3  O   HOH A   2       7.123   8.456   9.789  1.00  0.00           O";
+  std::stringstream ss(text);
+  auto expected = PdbReader(ss).read_frames();
+  auto actual = PdbBufferReader(text).read_frames();
+  ASSERT_EQ(actual.size(), 1);
+  EXPECT_EQ(actual[0].n_molecules(), 2);
+  expect_same(expected[0], actual[0]);
+}
+
+TEST_F(PdbBufferReaderTests, altered_records) {
+  AlteredPdbRecords records(StandardPdbRecords::instance());
+  records.alter_record(RecordName("ATOM"), FieldName("serial"), {7, 12});
+  std::string text = "ATOM  100000 N   GLY A   1      11.281  86.699  94.383  1.00 35.88           N\n"
+                     "ATOM  100001 CA  GLY A   1      -1.000   0.500  -0.250  1.00 35.88           C\n";
+  auto frames = PdbBufferReader(text, records).read_frames();
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0].atoms()[0].id(), 100000);
+  EXPECT_EQ(frames[0].atoms()[1].id(), 100001);
+  EXPECT_EQ(PdbBufferReader(text).read_frames()[0].atoms()[1].id(), 10000);
+}
+
+TEST_F(PdbBufferReaderTests, field_error) {
+  std::string text = "REMARK\n"
+                     "ATOM      1  N   GLY A   1      11.281  86.6x9  94.383  1.00 35.88           N\n";
+  try {
+    PdbBufferReader(text).read_frames();
+    FAIL() << "exception expected";
+  } catch (PdbException& e) {
+    EXPECT_NE(std::string(e.what()).find("at line 2:38-45"), std::string::npos) << e.what();
+  }
+  EXPECT_THROW(PdbBufferReader("ATOM      1  N   GLY A   1      11.281").read_frames(), PdbException);
+
+  // no digits after decimal point, rejected by stream reader too
+  const std::string no_fraction = "ATOM      1  N   GLY A   1      11.281     86.  94.383  1.00 35.88           N\n";
+  EXPECT_THROW(PdbBufferReader(no_fraction).read_frames(), PdbException);
+  std::istringstream in(no_fraction);
+  EXPECT_THROW(PdbReader(in).read_frames(), PdbException);
+}
+
+TEST_F(PdbBufferReaderTests, input_file) {
+  const std::string filename = ::testing::TempDir() + "pdb_buffer_reader_test.pdb";
+  std::ofstream(filename) << ensemble;
+  std::stringstream ss(ensemble);
+  auto expected = PdbReader(ss).read_frames();
+  PdbInputFile file(filename);
+  ASSERT_EQ(file.n_frames(), 2);
+  ASSERT_EQ(file.n_atoms(), 7);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    expect_same(expected[i], const_cast<Frame&>(file.frames()[i]));
+  }
+  EXPECT_THROW(PdbInputFile(filename + ".missing"), PdbReadError);
+}
+
+TEST_F(PdbBufferReaderTests, streaming_input_file) {
+  const std::string filename = ::testing::TempDir() + "pdb_buffer_reader_streaming_test.pdb";
+  std::ofstream(filename) << make_ensemble(20, true);
+  auto frames = PdbInputFile(filename).frames();
+
+  PdbInputFile file(filename, PdbInputFile::Dialect::STANDARD_V3, false);
+  EXPECT_TRUE(file.frames().empty());
+  ASSERT_EQ(file.n_frames(), 20);
+  ASSERT_EQ(file.n_atoms(), 100);
+
+  trajectory::Trajectory traj(frames[0]);
+  traj.extend(std::move(file));
+  for (int pass = 0; pass < 2; ++pass) { // file is re-entered on second pass
+    size_t i = 0;
+    for (auto& frame : traj) {
+      ASSERT_EQ(frame.n_atoms(), 100);
+      for (size_t j = 0; j < frame.n_atoms(); ++j) {
+        EXPECT_EQ(frame.coords()[j].x(), frames[i].coords()[j].x());
+        EXPECT_EQ(frame.coords()[j].y(), frames[i].coords()[j].y());
+      }
+      EXPECT_EQ(frame.cell[0].x(), frames[i].cell[0].x());
+      ++i;
+    }
+    EXPECT_EQ(i, 20);
+  }
+
+  Frame renamed = frames[0];
+  renamed.atoms()[5].name(AtomName("CB"));
+  trajectory::Trajectory mismatched(renamed);
+  mismatched.extend(PdbInputFile(filename, PdbInputFile::Dialect::STANDARD_V3, false));
+  EXPECT_THROW(mismatched.at(0), PdbException);
+}
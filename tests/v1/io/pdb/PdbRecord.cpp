@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "xmol/io/pdb/PdbRecord.h"
+#include "xmol/io/pdb/exceptions.h"
+#include <vector>
+
+using ::testing::Test;
+using namespace xmol::io::pdb;
+
+class PdbRecordTests : public Test {
+public:
+  static std::vector<int> colons(const basic_PdbRecords& db, const char* record, const char* field) {
+    auto v = db.get_record(RecordName(record)).getFieldColons(FieldName(field));
+    return {v.begin(), v.end()};
+  }
+};
+
+TEST_F(PdbRecordTests, standard_records) {
+  auto& db = StandardPdbRecords::instance();
+  EXPECT_EQ(colons(db, "ATOM", "serial"), std::vector<int>({7, 11}));
+  EXPECT_EQ(colons(db, "HETATM", "z"), std::vector<int>({47, 54}));
+  EXPECT_EQ(colons(db, "CRYST1", "gamma"), std::vector<int>({48, 54}));
+  EXPECT_EQ(colons(db, "CONECT", "serial"), std::vector<int>({7, 11, 12, 16, 17, 21, 22, 26, 27, 31}));
+  EXPECT_EQ(colons(db, "TITLE", "continua"), std::vector<int>({9, 10})); // names are truncated to 8 characters
+  EXPECT_EQ(db.get_record(RecordName("ENDMDL")).fields().size(), 0);
+  EXPECT_EQ(db.get_record(RecordName("ATOM")).fields().size(), 14);
+
+  EXPECT_THROW(db.get_record(RecordName("XXX")), PdbUknownRecord);
+  EXPECT_THROW(db.get_record(RecordName("ATOM")).getFieldColons(FieldName("alpha")), PdbUknownRecordField);
+  EXPECT_THROW(db.get_record(RecordName("END")).getFieldColons(FieldName("serial")), PdbUknownRecordField);
+}
+
+TEST_F(PdbRecordTests, altered_records) {
+  auto& standard = StandardPdbRecords::instance();
+  AlteredPdbRecords altered(standard);
+  altered.alter_record(RecordName("ATOM"), FieldName("serial"), {7, 12});
+  altered.alter_record(RecordName("ATOM"), FieldName("extra"), {81, 85});
+  altered.alter_record(RecordName("NEWREC"), FieldName("value"), {7, 10});
+
+  EXPECT_EQ(colons(altered, "ATOM", "serial"), std::vector<int>({7, 12}));
+  EXPECT_EQ(colons(altered, "ATOM", "extra"), std::vector<int>({81, 85}));
+  EXPECT_EQ(colons(altered, "ATOM", "x"), std::vector<int>({31, 38}));
+  EXPECT_EQ(colons(altered, "HETATM", "serial"), std::vector<int>({7, 11}));
+  EXPECT_EQ(colons(altered, "NEWREC", "value"), std::vector<int>({7, 10}));
+  EXPECT_EQ(colons(standard, "ATOM", "serial"), std::vector<int>({7, 11}));
+  EXPECT_THROW(altered.get_record(RecordName("XXX")), PdbUknownRecord);
+
+  AlteredPdbRecords layer(altered);
+  layer.alter_record(RecordName("ATOM"), FieldName("x"), {30, 38});
+  EXPECT_EQ(colons(layer, "ATOM", "serial"), std::vector<int>({7, 12}));
+  EXPECT_EQ(colons(layer, "ATOM", "x"), std::vector<int>({30, 38}));
+
+  AlteredPdbRecords copy = layer;
+  layer.alter_record(RecordName("ATOM"), FieldName("x"), {29, 38});
+  EXPECT_EQ(colons(copy, "ATOM", "x"), std::vector<int>({30, 38}));
+  EXPECT_EQ(colons(layer, "ATOM", "x"), std::vector<int>({29, 38}));
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "xmol/Frame.h"
+#include "xmol/geom/affine/Transformation3d.h"
+#include "xmol/io/PdbInputFile.h"
+#include "xmol/io/pdb/PdbTrajectoryWriter.h"
+#include "xmol/io/pdb/exceptions.h"
+#include "xmol/proxy/spans.h"
+#include <fstream>
+#include <sstream>
+
+using ::testing::Test;
+using namespace xmol::io::pdb;
+using namespace xmol::io;
+using namespace xmol;
+
+class PdbTrajectoryWriterTests : public Test {
+public:
+  static Frame make_frame() {
+    Frame frame;
+    for (char chain : {'A', 'B'}) {
+      auto molecule = frame.add_molecule().name(MoleculeName(std::string(1, chain)));
+      for (int i = 0; i < 3; ++i) {
+        auto residue = molecule.add_residue().name(ResidueName("ALA")).id(i + 1);
+        residue.add_atom().name(AtomName("N")).id(i * 2 + 1).r(XYZ(i, chain, 0));
+        residue.add_atom().name(AtomName("CA")).id(i * 2 + 2).r(XYZ(i, chain, 1));
+      }
+    }
+    return frame;
+  }
+
+  static std::string read_file(const std::string& filename) {
+    std::ifstream in(filename);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+};
+
+TEST_F(PdbTrajectoryWriterTests, write_models) {
+  const std::string filename = ::testing::TempDir() + "pdb_trajectory_writer_test.pdb";
+  auto frame = make_frame();
+  std::stringstream expected;
+  {
+    PdbTrajectoryWriter writer(filename);
+    for (int model = 0; model < 5; ++model) {
+      frame.coords().apply(geom::affine::Translation3d(XYZ(0.5, -1, 0.125)));
+      frame.cell = geom::UnitCell(10 + model, 20, 30, geom::Degrees(90), geom::Degrees(90), geom::Degrees(90));
+      writer.write(frame);
+
+      PdbWriter expected_writer(expected);
+      expected_writer.write(frame.cell, StandardPdbRecords::instance());
+      expected << "MODEL        " << model + 1 << "\n";
+      auto molecules = frame.molecules();
+      expected_writer.write(molecules, StandardPdbRecords::instance());
+      expected << "ENDMDL\n";
+    }
+    EXPECT_EQ(writer.n_models(), 5);
+  }
+  expected << "END\n";
+  EXPECT_EQ(read_file(filename), expected.str());
+
+  auto frames = PdbInputFile(filename, PdbInputFile::Dialect::STANDARD_V3).frames();
+  ASSERT_EQ(frames.size(), 5);
+  EXPECT_EQ(frames[4].n_molecules(), 2);
+  EXPECT_DOUBLE_EQ(frames[4].cell.a(), 14);
+  EXPECT_DOUBLE_EQ(frames[4].coords()[11].x(), frame.coords()[11].x());
+  EXPECT_DOUBLE_EQ(frames[4].coords()[11].z(), frame.coords()[11].z());
+}
+
+TEST_F(PdbTrajectoryWriterTests, errors) {
+  EXPECT_THROW(PdbTrajectoryWriter("/nonexistent/dir/file.pdb"), PdbWriteError);
+
+  const std::string filename = ::testing::TempDir() + "pdb_trajectory_writer_errors_test.pdb";
+  auto frame = make_frame();
+  PdbTrajectoryWriter writer(filename, false);
+  writer.write(frame);
+  frame.coords()[3].set(XYZ(1e5, 0, 0));
+  EXPECT_THROW(writer.write(frame), PdbException);
+  EXPECT_EQ(writer.n_models(), 1);
+}
+
+TEST_F(PdbTrajectoryWriterTests, close) {
+  const std::string filename = ::testing::TempDir() + "pdb_trajectory_writer_close_test.pdb";
+  auto frame = make_frame();
+  PdbTrajectoryWriter writer(filename, false);
+  writer.write(frame);
+  writer.close();
+  writer.close();
+  EXPECT_THROW(writer.write(frame), PdbWriteError);
+  EXPECT_EQ(writer.n_models(), 1);
+
+  const std::string content = read_file(filename);
+  EXPECT_EQ(content.substr(content.size() - 11), "ENDMDL\nEND\n");
+  EXPECT_EQ(PdbInputFile(filename, PdbInputFile::Dialect::STANDARD_V3).frames().size(), 1);
+}
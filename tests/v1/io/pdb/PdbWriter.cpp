@@ -1,12 +1,20 @@
 #include <gtest/gtest.h>
 
 #include "xmol/io/pdb/PdbReader.h"
+#include "xmol/io/pdb/PdbRecord.h"
 #include "xmol/io/pdb/PdbWriter.h"
+#include "xmol/io/pdb/exceptions.h"
+#include "xmol/proxy/selections.h"
+#include "xmol/proxy/spans-impl.h"
+#include "xmol/utils/formatting.h"
 #include "xmol/Frame.h"
+#include <random>
 
 using ::testing::Test;
 using namespace xmol::io::pdb;
+using xmol::io::PdbWriteError;
 using namespace xmol;
+using namespace xmol::proxy;
 
 class PdbWriterTests : public Test {
 public:
@@ -52,4 +60,134 @@ TEST_F(PdbWriterTests, write_unit_cell) {
   frame.cell = geom::UnitCell(111.11, 222.22, 333.333, geom::Degrees(60), geom::Degrees(90), geom::Degrees(120));
   writer.write(frame);
   EXPECT_EQ(ss.str(), "CRYST1  111.110  222.220  333.333  60.00  90.00 120.00                          \n");
-}
\ No newline at end of file
+}
+
+TEST_F(PdbWriterTests, format_fields) {
+  using xmol::utils::format_fixed_point_field;
+  using xmol::utils::format_int_field;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-999.0, 9999.0);
+  char field[9] = {};
+  char expected[32];
+  for (int i = 0; i < 100000; ++i) {
+    double value = distribution(generator);
+    ASSERT_TRUE(format_fixed_point_field(field, 8, 3, value));
+    std::snprintf(expected, sizeof(expected), "%8.3f", value);
+    ASSERT_STREQ(field, expected);
+  }
+  // decimal half-way values x.xxx5 are not representable and lie close to rounding boundary
+  std::uniform_int_distribution<int> thousandths(-999'999, 9'999'999);
+  for (int i = 0; i < 100000; ++i) {
+    double value = (thousandths(generator) + 0.5) / 1000;
+    ASSERT_TRUE(format_fixed_point_field(field, 8, 3, value));
+    std::snprintf(expected, sizeof(expected), "%8.3f", value);
+    ASSERT_STREQ(field, expected) << value;
+  }
+  char wide_field[11] = {};
+  for (double value : {193.78749999999999, -713.2415, 0.0625, -2.5005, 0.0005, 1.0}) {
+    for (int precision : {0, 1, 3, 5}) {
+      ASSERT_TRUE(format_fixed_point_field(wide_field, 10, precision, value));
+      std::snprintf(expected, sizeof(expected), "%*.*f", 10, precision, value);
+      ASSERT_STREQ(wide_field, expected) << value << " " << precision;
+    }
+  }
+  ASSERT_TRUE(format_fixed_point_field(field, 8, 3, -0.0001));
+  EXPECT_STREQ(field, "  -0.000");
+  EXPECT_FALSE(format_fixed_point_field(field, 8, 3, 10000.0));
+  EXPECT_FALSE(format_fixed_point_field(field, 8, 3, -1000.0));
+  EXPECT_FALSE(format_fixed_point_field(field, 8, 3, std::nan("")));
+  EXPECT_STREQ(field, "  -0.000");
+
+  ASSERT_TRUE(format_int_field(field, 5, -12));
+  EXPECT_STREQ(field, "  -12000");
+  EXPECT_FALSE(format_int_field(field, 5, 100000));
+  EXPECT_STREQ(field, "  -12000");
+}
+
+TEST_F(PdbWriterTests, write_lines) {
+  Frame frame;
+  auto residue = frame.add_molecule().name(MoleculeName("B")).add_residue().name(ResidueName("GLY")).id(
+      ResidueId(-3, ResidueInsertionCode("Z")));
+  residue.add_atom().name(AtomName("CA")).id(123456).r(XYZ(-1.0, 0.5, 1234.5678));
+  residue.add_atom().name(AtomName("HD21")).id(7).r(XYZ(0, 0, 0));
+  std::stringstream ss;
+  PdbWriter(ss).write(frame);
+  EXPECT_EQ(ss.str(), "ATOM  23456  CA  GLY B  -3Z     -1.000   0.5001234.568                          \n"
+                      "ATOM      7 HD21 GLY B  -3Z      0.000   0.000   0.000                          \n"
+                      "TER\n");
+
+  frame.coords()[1].set(XYZ(0, 0, -1000));
+  std::stringstream ss2;
+  EXPECT_THROW(PdbWriter(ss2).write(frame), PdbException);
+  EXPECT_EQ(ss2.str().size(), 81); // complete lines before failed one are written
+}
+
+TEST_F(PdbWriterTests, names_are_not_truncated) {
+  Frame frame;
+  auto chain = frame.add_molecule().name(MoleculeName("A"));
+  auto residue = chain.add_residue().name(ResidueName("DPPC")).id(1);
+  residue.add_atom().name(AtomName("P")).id(1).r(XYZ(1, 2, 3));
+  {
+    std::stringstream ss;
+    EXPECT_THROW(PdbWriter(ss).write(frame), PdbWriteError);
+    EXPECT_THROW(PdbWriter(ss).write(frame), PdbException);
+  }
+
+  // four-column resName extension (columns 18-21)
+  AlteredPdbRecords records(StandardPdbRecords::instance());
+  records.alter_record(RecordName("ATOM"), FieldName("resName"), {18, 21});
+  std::stringstream ss;
+  PdbWriter(ss).write(frame, records);
+  EXPECT_EQ(ss.str().substr(0, 27), "ATOM      1  P   DPPCA   1 ");
+  auto frames = PdbReader(ss).read_frames(records);
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0].residues()[0].name(), ResidueName("DPPC"));
+
+  residue.name(ResidueName("GLY"));
+  chain.name(MoleculeName("AB"));
+  std::stringstream chain_ss;
+  EXPECT_THROW(PdbWriter(chain_ss).write(frame), PdbWriteError);
+  EXPECT_THROW(PdbWriter(chain_ss).write(frame, records), PdbWriteError);
+}
+
+TEST_F(PdbWriterTests, write_altered_records) {
+  Frame frame;
+  auto residue = frame.add_molecule().name(MoleculeName("A")).add_residue().name(ResidueName("GLY")).id(1);
+  residue.add_atom().name(AtomName("N")).id(100000).r(XYZ(1, 2, 3));
+  AlteredPdbRecords records(StandardPdbRecords::instance());
+  records.alter_record(RecordName("ATOM"), FieldName("serial"), {7, 12});
+  std::stringstream ss;
+  PdbWriter(ss).write(frame, records);
+  EXPECT_EQ(ss.str().substr(0, 16), "ATOM  100000 N  ");
+}
+
+TEST_F(PdbWriterTests, write_selections) {
+  Frame frame;
+  for (char chain : {'A', 'B'}) {
+    auto molecule = frame.add_molecule().name(MoleculeName(std::string(1, chain)));
+    for (int i = 0; i < 3; ++i) {
+      auto residue = molecule.add_residue().name(ResidueName("ALA")).id(i + 1);
+      residue.add_atom().name(AtomName("N")).id(i * 2 + 1).r(XYZ(i, chain, 0));
+      residue.add_atom().name(AtomName("CA")).id(i * 2 + 2).r(XYZ(i, chain, 1));
+    }
+  }
+  std::stringstream expected;
+  PdbWriter expected_writer(expected);
+  for (auto& a : frame.atoms()) {
+    expected_writer.write(a);
+  }
+
+  std::stringstream span;
+  auto atoms = frame.atoms();
+  PdbWriter(span).write(atoms, StandardPdbRecords::instance());
+  EXPECT_EQ(span.str(), expected.str());
+
+  std::stringstream selection;
+  auto atom_selection = frame.atoms().filter([](const AtomRef& a) { return a.name() == AtomName("CA"); });
+  PdbWriter(selection).write(atom_selection, StandardPdbRecords::instance());
+  auto frame2 = PdbReader(selection).read_frame();
+  ASSERT_EQ(frame2.n_atoms(), 6);
+  EXPECT_EQ(frame2.n_molecules(), 2);
+  EXPECT_EQ(frame2.n_residues(), 6);
+  EXPECT_DOUBLE_EQ(frame2.atoms()[5].r().y(), 'B');
+}
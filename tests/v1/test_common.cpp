@@ -18,3 +18,10 @@ void xmol::test::add_polyglycines(const std::vector<std::pair<std::string, int>>
     }
   }
 }
+
+void xmol::test::InMemoryTrajectoryFile::read_frame(size_t index, Frame& frame) {
+  auto coords = frame.coords();
+  for (size_t i = 0; i < coords.size(); ++i) {
+    coords[i]._eigen() = m_frames[index][i]._eigen();
+  }
+}
@@ -1,10 +1,25 @@
 #pragma once
 
 #include "xmol/fwd.h"
+#include "xmol/geom/XYZ.h"
+#include "xmol/trajectory/TrajectoryFile.h"
 #include <vector>
 
 namespace xmol::test {
 
 void add_polyglycines(const std::vector<std::pair<std::string, int>>& chain_sizes, Frame& frame);
 
+/// Trajectory file which serves coordinates from memory
+class InMemoryTrajectoryFile : public trajectory::TrajectoryInputFile {
+public:
+  explicit InMemoryTrajectoryFile(std::vector<std::vector<geom::XYZ>> frames) : m_frames(std::move(frames)) {}
+  [[nodiscard]] size_t n_frames() const final { return m_frames.size(); }
+  [[nodiscard]] size_t n_atoms() const final { return m_frames.front().size(); }
+  void read_frame(size_t index, Frame& frame) final;
+  void advance(size_t) final {}
+
+private:
+  std::vector<std::vector<geom::XYZ>> m_frames;
+};
+
 } // namespace xmol::test
\ No newline at end of file
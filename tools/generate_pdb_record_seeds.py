@@ -0,0 +1,83 @@
+"""Regenerates perfect hash seeds of bundled PDB records table
+
+Usage: python tools/generate_pdb_record_seeds.py [path/to/BundledPDBRecordTypesBaseInit.cpp]
+
+Reads `rows` table of the source, finds seeds which map record and field names
+to distinct slots (same hash as xmol/utils/perfect_hash.h) and rewrites
+`record_seed` and `field_seeds` constants of the source in place.
+"""
+
+import re
+import sys
+import textwrap
+
+SOURCE = "src/xmol/io/pdb/BundledPDBRecordTypesBaseInit.cpp"
+MASK = (1 << 64) - 1
+EMPTY_SLOT = 0xFF
+
+
+def short_string_value(name, max_length):
+    value = 0
+    for i, c in enumerate(name[:max_length]):
+        value += ord(c) << (8 * i)
+    return value
+
+
+def perfect_hash_slot(key, seed, bits):
+    x = (key + seed * 0x9E3779B97F4A7C15) & MASK
+    x = ((x ^ (x >> 30)) * 0xBF58476D1CE4E5B9) & MASK
+    x = ((x ^ (x >> 27)) * 0x94D049BB133111EB) & MASK
+    x = x ^ (x >> 31)
+    return x >> (64 - bits)
+
+
+def perfect_hash_bits(n):
+    bits = 1
+    while (1 << bits) < 4 * n:
+        bits += 1
+    return bits
+
+
+def find_perfect_hash_seed(keys, bits):
+    assert len(keys) < EMPTY_SLOT
+    for seed in range(1 << 20):
+        if len({perfect_hash_slot(key, seed, bits) for key in keys}) == len(keys):
+            return seed
+    raise ValueError("no seed found, keys are not distinct?")
+
+
+def read_records(source):
+    records = {}
+    table = source[source.index("constexpr Row rows[] = {"):]
+    table = table[:table.index("};")]
+    for match in re.finditer(r'\{"([^"]*)"(?:, "([^"]*)")?', table):
+        record, field = match.groups()
+        fields = records.setdefault(record, [])
+        if field is not None:
+            fields.append(field)
+    return records
+
+
+def main(path):
+    with open(path) as f:
+        source = f.read()
+    records = read_records(source)
+    record_keys = [short_string_value(name, 6) for name in records]
+    record_seed = find_perfect_hash_seed(record_keys, perfect_hash_bits(len(record_keys)))
+    field_seeds = []
+    for fields in records.values():
+        keys = [short_string_value(name, 8) for name in fields]
+        field_seeds.append(find_perfect_hash_seed(keys, perfect_hash_bits(len(keys))))
+
+    source = re.sub(r"constexpr uint64_t record_seed = \d+;",
+                    "constexpr uint64_t record_seed = %d;" % record_seed, source)
+    seeds = textwrap.fill(", ".join(map(str, field_seeds)), width=116, initial_indent="    ",
+                          subsequent_indent="    ")
+    source = re.sub(r"constexpr uint64_t field_seeds\[\] = \{[^}]*\};",
+                    lambda _: "constexpr uint64_t field_seeds[] = {\n%s\n};" % seeds, source)
+    with open(path, "w") as f:
+        f.write(source)
+
+
+if __name__ == "__main__":
+    main(sys.argv[1] if len(sys.argv) > 1 else SOURCE)